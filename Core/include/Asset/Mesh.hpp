@@ -1,6 +1,8 @@
 #pragma once
 #include "Asset/Asset.hpp"
-#include <glad/glad.h>
+#include "Bounds.hpp"
+#include <cstddef>
+#include <cstdint>
 #include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <vector>
@@ -17,20 +19,82 @@ struct Vertex
     glm::vec3 tangent;
     glm::vec3 bitangent;
 };
+/**
+ * @brief 上传到GPU时使用的顶点布局，CPU端始终保存完整的Vertex
+ */
+enum class VertexFormat : uint32_t
+{
+    Standard, // 56字节，与Vertex相同
+    Compact,  // 20字节的CompactVertex，见 Geometry/VertexQuantization.hpp
+};
+/**
+ * @brief GPU索引缓冲区的元素类型，CPU端始终保存32位索引
+ */
+enum class IndexType : uint32_t
+{
+    UInt16,
+    UInt32,
+};
+// 不开启图元重启时16位索引可以寻址全部65536个顶点
+constexpr size_t MaxUInt16IndexedVertices = 65536;
+inline size_t GetIndexSize(IndexType type)
+{
+    return type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+/**
+ * @brief 简化后的网格级别，与原网格共用顶点，只保存索引
+ */
+struct MeshLod
+{
+    std::vector<uint32_t> Indices{};
+    // 相对于包围球半径的几何误差
+    float Error = 0.0f;
+};
+/**
+ * @brief LOD0中一段连续的三角形，用于簇级剔除，由 Geometry/MeshletBuilder.hpp 生成
+ */
+struct Meshlet
+{
+    uint32_t firstIndex = 0; // 在Mesh::Indices中的起始位置
+    uint32_t triangleCount = 0;
+    uint32_t vertexCount = 0;
+    BoundingSphere sphere{};
+    // 三角形法线所在的圆锥，coneCutoff为圆锥半角的正弦，等于1时不做背面剔除
+    glm::vec3 coneAxis{0.0f, 0.0f, 1.0f};
+    float coneCutoff = 1.0f;
+};
 class Mesh final : public Asset
 {
   public:
+    // GPU资源由RenderSystem的GeometryArena统一管理，Mesh只保存CPU端数据
     std::vector<Vertex> Vertices{};
     std::vector<uint32_t> Indices{};
-
-  private:
-    GLuint VAO = 0;
-    GLuint VBO = 0;
-    GLuint EBO = 0;
+    // 模型空间包围体，导入时计算并随资源保存
+    AABB Bounds{};
+    BoundingSphere Sphere{};
+    // 由导入器按网格选择
+    VertexFormat Format = VertexFormat::Standard;
+    IndexType IndexFormat = IndexType::UInt32;
+    // 导入时生成的LOD1及之后的级别，逐级变粗，LOD0即Indices
+    std::vector<MeshLod> Lods{};
+    // 只对稠密网格生成，此时Indices已按簇重排；为空时整体绘制
+    std::vector<Meshlet> Meshlets{};
 
   public:
-    Mesh();
-    ~Mesh();
+    Mesh() = default;
+    ~Mesh() override = default;
+    inline void RecalculateBounds()
+    {
+        Bounds = ComputeAABB(Vertices);
+        Sphere = ComputeBoundingSphere(Vertices);
+    }
+    /**
+     * @brief 顶点数允许时使用16位索引
+     */
+    inline void ChooseIndexFormat()
+    {
+        IndexFormat = Vertices.size() <= MaxUInt16IndexedVertices ? IndexType::UInt16 : IndexType::UInt32;
+    }
 };
 } // namespace Core
 } // namespace MEngine
@@ -55,6 +119,40 @@ template <> struct adl_serializer<MEngine::Core::Vertex>
         v.texCoord = glm::vec2(tex[0], tex[1]);
     }
 };
+template <> struct adl_serializer<MEngine::Core::MeshLod>
+{
+    static void to_json(json &j, const MEngine::Core::MeshLod &lod)
+    {
+        j = json{{"Indices", lod.Indices}, {"Error", lod.Error}};
+    }
+    static void from_json(const json &j, MEngine::Core::MeshLod &lod)
+    {
+        lod.Indices = j.at("Indices").get<std::vector<uint32_t>>();
+        lod.Error = j.value("Error", 0.0f);
+    }
+};
+template <> struct adl_serializer<MEngine::Core::Meshlet>
+{
+    static void to_json(json &j, const MEngine::Core::Meshlet &meshlet)
+    {
+        j = json{{"FirstIndex", meshlet.firstIndex},
+                 {"TriangleCount", meshlet.triangleCount},
+                 {"VertexCount", meshlet.vertexCount},
+                 {"Sphere", meshlet.sphere},
+                 {"ConeAxis", {meshlet.coneAxis.x, meshlet.coneAxis.y, meshlet.coneAxis.z}},
+                 {"ConeCutoff", meshlet.coneCutoff}};
+    }
+    static void from_json(const json &j, MEngine::Core::Meshlet &meshlet)
+    {
+        meshlet.firstIndex = j.at("FirstIndex").get<uint32_t>();
+        meshlet.triangleCount = j.at("TriangleCount").get<uint32_t>();
+        meshlet.vertexCount = j.value("VertexCount", 0u);
+        meshlet.sphere = j.at("Sphere").get<MEngine::Core::BoundingSphere>();
+        auto axis = j.at("ConeAxis");
+        meshlet.coneAxis = glm::vec3(axis[0], axis[1], axis[2]);
+        meshlet.coneCutoff = j.value("ConeCutoff", 1.0f);
+    }
+};
 template <> struct adl_serializer<MEngine::Core::Mesh>
 {
     static void to_json(json &j, const MEngine::Core::Mesh &mesh)
@@ -62,12 +160,43 @@ template <> struct adl_serializer<MEngine::Core::Mesh>
         j = static_cast<MEngine::Core::Asset>(mesh);
         j["Vertices"] = mesh.Vertices;
         j["Indices"] = mesh.Indices;
+        j["Bounds"] = mesh.Bounds;
+        j["BoundingSphere"] = mesh.Sphere;
+        j["Lods"] = mesh.Lods;
+        j["Meshlets"] = mesh.Meshlets;
+        j["VertexFormat"] = static_cast<uint32_t>(mesh.Format);
+        j["IndexType"] = static_cast<uint32_t>(mesh.IndexFormat);
     }
     static void from_json(const json &j, MEngine::Core::Mesh &mesh)
     {
         static_cast<MEngine::Core::Asset &>(mesh) = j;
         mesh.Vertices = j.at("Vertices").get<std::vector<MEngine::Core::Vertex>>();
         mesh.Indices = j.at("Indices").get<std::vector<uint32_t>>();
+        if (j.contains("Bounds") && j.contains("BoundingSphere"))
+        {
+            mesh.Bounds = j.at("Bounds").get<MEngine::Core::AABB>();
+            mesh.Sphere = j.at("BoundingSphere").get<MEngine::Core::BoundingSphere>();
+        }
+        else
+        {
+            mesh.RecalculateBounds();
+        }
+        mesh.Format = static_cast<MEngine::Core::VertexFormat>(j.value("VertexFormat", 0u));
+        mesh.IndexFormat = static_cast<MEngine::Core::IndexType>(
+            j.value("IndexType", static_cast<uint32_t>(MEngine::Core::IndexType::UInt32)));
+        // 顶点数超出16位范围的旧资源或手工修改的资源回退到32位
+        if (mesh.Vertices.size() > MEngine::Core::MaxUInt16IndexedVertices)
+        {
+            mesh.IndexFormat = MEngine::Core::IndexType::UInt32;
+        }
+        if (j.contains("Lods"))
+        {
+            mesh.Lods = j.at("Lods").get<std::vector<MEngine::Core::MeshLod>>();
+        }
+        if (j.contains("Meshlets"))
+        {
+            mesh.Meshlets = j.at("Meshlets").get<std::vector<MEngine::Core::Meshlet>>();
+        }
     }
 };
 } // namespace nlohmann
\ No newline at end of file
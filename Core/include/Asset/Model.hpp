@@ -1,23 +1,69 @@
 #pragma once
 #include "Asset/Asset.hpp"
 #include "UUID.hpp"
-#include <assimp/Importer.hpp>
-#include <assimp/postprocess.h>
-#include <assimp/scene.h>
+#include <cstdint>
 #include <glm/mat4x4.hpp>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace MEngine
 {
 namespace Core
 {
-struct Node
+/**
+ * @brief 节点引用的网格在ModelHierarchy::MeshIndices中的区间
+ */
+struct MeshRange
 {
-    std::string Name;
-    std::vector<Node *> Children;
-    std::vector<int> MesheIndices; // Mesh indices in the model
-    glm::mat4 LocalTransform;
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+/**
+ * @brief 按深度优先先序平铺存储的节点层级，父节点总在子节点之前，根节点的父索引为-1
+ *
+ * 每个子树在数组中连续，按下标顺序遍历一遍即可完成实例化或计算世界矩阵。
+ */
+struct ModelHierarchy
+{
+    std::vector<std::string> Names;
+    std::vector<int32_t> Parents;
+    std::vector<glm::mat4> LocalTransforms;
+    std::vector<MeshRange> MeshRanges;
+    // 各节点引用的网格在Model::Meshes中的下标，按节点顺序连续存放
+    std::vector<uint32_t> MeshIndices;
+
+    inline size_t GetNodeCount() const
+    {
+        return Names.size();
+    }
+    inline bool IsEmpty() const
+    {
+        return Names.empty();
+    }
+    inline std::span<const uint32_t> GetMeshes(size_t node) const
+    {
+        const auto &range = MeshRanges[node];
+        return std::span<const uint32_t>(MeshIndices).subspan(range.offset, range.count);
+    }
+    void Reserve(size_t nodeCount, size_t meshCount);
+    void Clear();
+    /**
+     * @brief 追加节点，parent必须是已添加的节点或-1，按深度优先先序调用
+     *
+     * @return 新节点的下标
+     */
+    int32_t AddNode(std::string name, int32_t parent, const glm::mat4 &localTransform,
+                    std::span<const uint32_t> meshes = {});
+    /**
+     * @brief 检查数组长度一致、父节点在前、网格区间不越界，meshCount为模型的网格数
+     */
+    bool IsValid(size_t meshCount) const;
+    /**
+     * @brief 按下标顺序一遍计算所有节点相对模型根的变换
+     */
+    std::vector<glm::mat4> ComputeGlobalTransforms() const;
 };
 class Model : public Asset
 {
@@ -25,13 +71,68 @@ class Model : public Asset
     Model();
     std::vector<UUID> Meshes;
     std::vector<UUID> Materials;
-    std::unique_ptr<Node> RootNode;
+    ModelHierarchy Hierarchy;
 };
 } // namespace Core
 } // namespace MEngine
 
 namespace nlohmann
 {
+template <> struct adl_serializer<MEngine::Core::ModelHierarchy>
+{
+    static void to_json(json &j, const MEngine::Core::ModelHierarchy &hierarchy)
+    {
+        // 矩阵按列主序展开成一个数组，区间按(offset, count)成对展开
+        std::vector<float> transforms;
+        transforms.reserve(hierarchy.LocalTransforms.size() * 16);
+        for (const auto &transform : hierarchy.LocalTransforms)
+        {
+            for (int column = 0; column < 4; column++)
+            {
+                for (int row = 0; row < 4; row++)
+                {
+                    transforms.push_back(transform[column][row]);
+                }
+            }
+        }
+        std::vector<uint32_t> ranges;
+        ranges.reserve(hierarchy.MeshRanges.size() * 2);
+        for (const auto &range : hierarchy.MeshRanges)
+        {
+            ranges.push_back(range.offset);
+            ranges.push_back(range.count);
+        }
+        j["Names"] = hierarchy.Names;
+        j["Parents"] = hierarchy.Parents;
+        j["LocalTransforms"] = transforms;
+        j["MeshRanges"] = ranges;
+        j["MeshIndices"] = hierarchy.MeshIndices;
+    }
+    static void from_json(const json &j, MEngine::Core::ModelHierarchy &hierarchy)
+    {
+        hierarchy.Names = j.at("Names").get<std::vector<std::string>>();
+        hierarchy.Parents = j.at("Parents").get<std::vector<int32_t>>();
+        hierarchy.MeshIndices = j.at("MeshIndices").get<std::vector<uint32_t>>();
+        auto transforms = j.at("LocalTransforms").get<std::vector<float>>();
+        hierarchy.LocalTransforms.resize(transforms.size() / 16);
+        for (size_t i = 0; i < hierarchy.LocalTransforms.size(); i++)
+        {
+            for (int column = 0; column < 4; column++)
+            {
+                for (int row = 0; row < 4; row++)
+                {
+                    hierarchy.LocalTransforms[i][column][row] = transforms[i * 16 + column * 4 + row];
+                }
+            }
+        }
+        auto ranges = j.at("MeshRanges").get<std::vector<uint32_t>>();
+        hierarchy.MeshRanges.resize(ranges.size() / 2);
+        for (size_t i = 0; i < hierarchy.MeshRanges.size(); i++)
+        {
+            hierarchy.MeshRanges[i] = MEngine::Core::MeshRange{ranges[i * 2], ranges[i * 2 + 1]};
+        }
+    }
+};
 template <> struct adl_serializer<MEngine::Core::Model>
 {
     static void to_json(json &j, const MEngine::Core::Model &model)
@@ -39,6 +140,7 @@ template <> struct adl_serializer<MEngine::Core::Model>
         j = static_cast<MEngine::Core::Asset>(model);
         j["Meshes"] = model.Meshes;
         j["Materials"] = model.Materials;
+        j["Hierarchy"] = model.Hierarchy;
     }
 
     static void from_json(const json &j, MEngine::Core::Model &model)
@@ -46,6 +148,10 @@ template <> struct adl_serializer<MEngine::Core::Model>
         static_cast<MEngine::Core::Asset &>(model) = j;
         model.Meshes = j.at("Meshes").get<std::vector<MEngine::Core::UUID>>();
         model.Materials = j.at("Materials").get<std::vector<MEngine::Core::UUID>>();
+        if (j.contains("Hierarchy"))
+        {
+            model.Hierarchy = j.at("Hierarchy").get<MEngine::Core::ModelHierarchy>();
+        }
     }
 };
-} // namespace nlohmann
\ No newline at end of file
+} // namespace nlohmann
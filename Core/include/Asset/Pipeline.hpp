@@ -1,7 +1,12 @@
 #pragma once
 #include "Asset/Asset.hpp"
+#include <chrono>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <glad/glad.h>
+#include <string>
+#include <vector>
 namespace MEngine
 {
 namespace Core
@@ -15,8 +20,22 @@ enum class PipelineType
     TransparentPhong,
     Custom
 };
+enum class PipelineCompileStatus
+{
+    NotCompiled,
+    Compiling, // 已提交编译链接，等待驱动完成
+    Ready,
+    Failed,
+};
 class Pipeline final : public Asset
 {
+  public:
+    /**
+     * @brief 读取着色器源码并插入宏定义，返回空字符串表示失败
+     */
+    using SourceLoader =
+        std::function<std::string(const std::filesystem::path &path, const std::vector<std::string> &defines)>;
+
   private:
     GLuint UBO;
 
@@ -24,6 +43,10 @@ class Pipeline final : public Asset
     std::filesystem::path VertexShaderPath{};
     std::filesystem::path FragmentShaderPath{};
     std::filesystem::path GeometryShaderPath{};
+    // 编译时插入到 #version 之后的宏，"NAME" 或 "NAME=VALUE"
+    std::vector<std::string> Defines{};
+    // 可开关的关键字，变体按位掩码选择其中的子集作为额外的宏
+    std::vector<std::string> Keywords{};
     bool blendingEnabled = false;
     GLenum blendSrc = GL_SRC_ALPHA;
     GLenum blendDest = GL_ONE_MINUS_SRC_ALPHA;
@@ -33,9 +56,66 @@ class Pipeline final : public Asset
     GLuint fragmentShader = 0;
     GLuint geometryShader = 0;
     GLuint program = 0;
+    GLuint pendingProgram = 0;
+    uint64_t cacheKey = 0;
+    PipelineCompileStatus status = PipelineCompileStatus::NotCompiled;
+    // 编译期间源文件又被修改，当前编译完成后需要重新提交
+    bool recompilePending = false;
+    std::chrono::high_resolution_clock::time_point compileStart;
 
   public:
-    ~Pipeline() override = default;
+    ~Pipeline() override;
+    /**
+     * @brief 同步创建program，优先从程序二进制缓存加载，未命中时从源文件编译链接并写入缓存
+     *
+     * @return 链接成功返回true
+     */
+    bool Compile();
+    /**
+     * @brief 提交编译和链接但不等待结果，缓存命中时直接就绪。重新编译期间旧program仍可使用
+     *
+     * @return 源文件读取失败返回false
+     */
+    bool CompileAsync();
+    /**
+     * @brief 不阻塞地查询异步编译是否完成；驱动不支持并行编译时总是返回true，由 FinishCompile 阻塞完成
+     */
+    bool IsCompileComplete() const;
+    /**
+     * @brief 取回编译结果并替换program，必要时阻塞；失败时保留旧program
+     *
+     * @return 编译链接成功返回true
+     */
+    bool FinishCompile();
+    /**
+     * @brief 源文件修改后重新编译；正在编译时只做标记，由 FinishCompile 在当前编译完成后重新提交
+     */
+    void Recompile();
+    /**
+     * @brief 替换着色器源码加载方式，例如支持 #include 的预处理器；传入空函数恢复直接读取文件
+     */
+    static void SetSourceLoader(SourceLoader loader);
+    /**
+     * @brief 驱动是否支持 GL_KHR_parallel_shader_compile 或 GL_ARB_parallel_shader_compile
+     */
+    static bool SupportsParallelCompile();
+
+    inline GLuint GetProgram() const
+    {
+        return program;
+    }
+    inline bool IsReady() const
+    {
+        return program != 0;
+    }
+    inline PipelineCompileStatus GetCompileStatus() const
+    {
+        return status;
+    }
+    inline bool IsRecompilePending() const
+    {
+        return recompilePending;
+    }
 };
 } // namespace Core
 } // namespace MEngine
@@ -50,6 +130,8 @@ template <> struct adl_serializer<MEngine::Core::Pipeline>
         j["vertexShaderPath"] = shader.VertexShaderPath.string();
         j["fragmentShaderPath"] = shader.FragmentShaderPath.string();
         j["geometryShaderPath"] = shader.GeometryShaderPath.string();
+        j["defines"] = shader.Defines;
+        j["keywords"] = shader.Keywords;
     }
     static void from_json(const json &j, MEngine::Core::Pipeline &shader)
     {
@@ -57,6 +139,14 @@ template <> struct adl_serializer<MEngine::Core::Pipeline>
         shader.VertexShaderPath = j.at("vertexShaderPath").get<std::string>();
         shader.FragmentShaderPath = j.at("fragmentShaderPath").get<std::string>();
         shader.GeometryShaderPath = j.at("geometryShaderPath").get<std::string>();
+        if (j.contains("defines"))
+        {
+            shader.Defines = j.at("defines").get<std::vector<std::string>>();
+        }
+        if (j.contains("keywords"))
+        {
+            shader.Keywords = j.at("keywords").get<std::vector<std::string>>();
+        }
     }
 };
 } // namespace nlohmann
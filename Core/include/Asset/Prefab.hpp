@@ -9,7 +9,7 @@ class Prefab final : public Asset
   public:
     std::vector<UUID> Meshes;
     std::vector<UUID> Materials;
-    std::unique_ptr<Node> RootNode;
+    ModelHierarchy Hierarchy;
 };
 } // namespace Core
 } // namespace MEngine
@@ -22,6 +22,7 @@ template <> struct adl_serializer<MEngine::Core::Prefab>
         j = static_cast<MEngine::Core::Asset>(prefab);
         j["Meshes"] = prefab.Meshes;
         j["Materials"] = prefab.Materials;
+        j["Hierarchy"] = prefab.Hierarchy;
     }
 
     static void from_json(const json &j, MEngine::Core::Prefab &prefab)
@@ -29,6 +30,10 @@ template <> struct adl_serializer<MEngine::Core::Prefab>
         static_cast<MEngine::Core::Asset &>(prefab) = j;
         prefab.Meshes = j.at("Meshes").get<std::vector<MEngine::Core::UUID>>();
         prefab.Materials = j.at("Materials").get<std::vector<MEngine::Core::UUID>>();
+        if (j.contains("Hierarchy"))
+        {
+            prefab.Hierarchy = j.at("Hierarchy").get<MEngine::Core::ModelHierarchy>();
+        }
     }
 };
 } // namespace nlohmann
@@ -0,0 +1,181 @@
+#pragma once
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 轴对齐包围盒，默认构造为空盒（min > max）
+ */
+struct AABB
+{
+    glm::vec3 min{FLT_MAX};
+    glm::vec3 max{-FLT_MAX};
+
+    inline bool IsValid() const
+    {
+        return min.x <= max.x && min.y <= max.y && min.z <= max.z;
+    }
+    inline glm::vec3 GetCenter() const
+    {
+        return (min + max) * 0.5f;
+    }
+    inline glm::vec3 GetExtents() const
+    {
+        return (max - min) * 0.5f;
+    }
+    inline float GetSurfaceArea() const
+    {
+        auto d = max - min;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+    inline void Expand(const glm::vec3 &point)
+    {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    inline void Merge(const AABB &other)
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+    inline bool Contains(const AABB &other) const
+    {
+        return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z && max.x >= other.max.x &&
+               max.y >= other.max.y && max.z >= other.max.z;
+    }
+    inline bool Overlaps(const AABB &other) const
+    {
+        return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y &&
+               min.z <= other.max.z && max.z >= other.min.z;
+    }
+    static inline AABB Union(const AABB &a, const AABB &b)
+    {
+        return AABB{glm::min(a.min, b.min), glm::max(a.max, b.max)};
+    }
+};
+struct BoundingSphere
+{
+    glm::vec3 center{0.0f};
+    float radius = 0.0f;
+};
+
+/**
+ * @brief 计算顶点集合的AABB，TVertex需要有 position 成员
+ */
+template <typename TVertex> AABB ComputeAABB(const std::vector<TVertex> &vertices)
+{
+    AABB aabb;
+    for (const auto &vertex : vertices)
+    {
+        aabb.Expand(vertex.position);
+    }
+    return aabb;
+}
+/**
+ * @brief Ritter 近似最小包围球，结果比AABB外接球更紧
+ */
+template <typename TVertex> BoundingSphere ComputeBoundingSphere(const std::vector<TVertex> &vertices)
+{
+    if (vertices.empty())
+    {
+        return BoundingSphere{};
+    }
+    // 从任意点找到最远点a，再找离a最远的点b，ab作为初始直径
+    auto farthest = [&](const glm::vec3 &from) {
+        auto result = vertices.front().position;
+        float maxDistance = -1.0f;
+        for (const auto &vertex : vertices)
+        {
+            auto d = vertex.position - from;
+            float distance = glm::dot(d, d);
+            if (distance > maxDistance)
+            {
+                maxDistance = distance;
+                result = vertex.position;
+            }
+        }
+        return result;
+    };
+    auto a = farthest(vertices.front().position);
+    auto b = farthest(a);
+    BoundingSphere sphere{(a + b) * 0.5f, glm::length(b - a) * 0.5f};
+    for (const auto &vertex : vertices)
+    {
+        auto d = vertex.position - sphere.center;
+        float distance = glm::length(d);
+        if (distance > sphere.radius)
+        {
+            float newRadius = (sphere.radius + distance) * 0.5f;
+            sphere.center += d * ((newRadius - sphere.radius) / distance);
+            sphere.radius = newRadius;
+        }
+    }
+    return sphere;
+}
+/**
+ * @brief 变换AABB（Arvo方法），结果为变换后盒子的AABB
+ */
+inline AABB TransformAABB(const AABB &aabb, const glm::mat4 &matrix)
+{
+    if (!aabb.IsValid())
+    {
+        return aabb;
+    }
+    auto center = glm::vec3(matrix * glm::vec4(aabb.GetCenter(), 1.0f));
+    auto extents = aabb.GetExtents();
+    glm::vec3 worldExtents;
+    for (int i = 0; i < 3; i++)
+    {
+        worldExtents[i] = std::abs(matrix[0][i]) * extents.x + std::abs(matrix[1][i]) * extents.y +
+                          std::abs(matrix[2][i]) * extents.z;
+    }
+    return AABB{center - worldExtents, center + worldExtents};
+}
+inline BoundingSphere TransformBoundingSphere(const BoundingSphere &sphere, const glm::mat4 &matrix)
+{
+    float scale = std::max({glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])),
+                            glm::length(glm::vec3(matrix[2]))});
+    return BoundingSphere{glm::vec3(matrix * glm::vec4(sphere.center, 1.0f)), sphere.radius * scale};
+}
+} // namespace Core
+} // namespace MEngine
+
+namespace nlohmann
+{
+template <> struct adl_serializer<MEngine::Core::AABB>
+{
+    static void to_json(json &j, const MEngine::Core::AABB &aabb)
+    {
+        j["min"] = {aabb.min.x, aabb.min.y, aabb.min.z};
+        j["max"] = {aabb.max.x, aabb.max.y, aabb.max.z};
+    }
+    static void from_json(const json &j, MEngine::Core::AABB &aabb)
+    {
+        auto min = j.at("min");
+        aabb.min = glm::vec3(min[0], min[1], min[2]);
+        auto max = j.at("max");
+        aabb.max = glm::vec3(max[0], max[1], max[2]);
+    }
+};
+template <> struct adl_serializer<MEngine::Core::BoundingSphere>
+{
+    static void to_json(json &j, const MEngine::Core::BoundingSphere &sphere)
+    {
+        j["center"] = {sphere.center.x, sphere.center.y, sphere.center.z};
+        j["radius"] = sphere.radius;
+    }
+    static void from_json(const json &j, MEngine::Core::BoundingSphere &sphere)
+    {
+        auto center = j.at("center");
+        sphere.center = glm::vec3(center[0], center[1], center[2]);
+        sphere.radius = j.at("radius").get<float>();
+    }
+};
+} // namespace nlohmann
@@ -0,0 +1,90 @@
+#pragma once
+#include "Bounds.hpp"
+#include "Frustum.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 批量视锥剔除
+ *
+ * 包围盒以SoA（中心、半长）保存，AVX2一次测试8个，SSE一次4个，其余走标量路径。
+ * AVX2路径在运行时按CPUID选择，不支持的CPU上自动使用SSE。
+ * 不依赖GL上下文，可以单独测试。
+ */
+class FrustumCuller final
+{
+  public:
+    enum class SimdLevel
+    {
+        Scalar,
+        SSE,
+        AVX2
+    };
+
+  private:
+    std::vector<float> mCenterX;
+    std::vector<float> mCenterY;
+    std::vector<float> mCenterZ;
+    std::vector<float> mExtentX;
+    std::vector<float> mExtentY;
+    std::vector<float> mExtentZ;
+    std::vector<uint8_t> mVisibility;
+    size_t mVisibleCount = 0;
+
+  public:
+    // 超过该数量才分发到工作线程
+    static constexpr size_t ParallelThreshold = 4096;
+
+  public:
+    void Clear();
+    void Reserve(size_t count);
+    /**
+     * @brief 添加一个包围盒，返回其索引；无效包围盒视为始终可见
+     */
+    uint32_t Add(const AABB &aabb);
+    /**
+     * @brief 执行剔除，返回可见数量，结果通过IsVisible/GetVisibility读取
+     *
+     * @param parallel 数量超过ParallelThreshold时是否使用线程池
+     */
+    size_t Cull(const Frustum &frustum, bool parallel = true);
+    /**
+     * @brief 指定SIMD路径执行，主要用于测试各路径结果一致；CPU不支持的路径降级为可用的最高路径
+     */
+    size_t Cull(const Frustum &frustum, SimdLevel level, bool parallel);
+
+    inline size_t GetCount() const
+    {
+        return mCenterX.size();
+    }
+    inline bool IsVisible(size_t index) const
+    {
+        return mVisibility[index] != 0;
+    }
+    inline const std::vector<uint8_t> &GetVisibility() const
+    {
+        return mVisibility;
+    }
+    inline size_t GetVisibleCount() const
+    {
+        return mVisibleCount;
+    }
+    inline size_t GetCulledCount() const
+    {
+        return GetCount() - mVisibleCount;
+    }
+    /**
+     * @brief 当前CPU可用的最高SIMD路径，首次调用时检测
+     */
+    static SimdLevel GetSimdLevel();
+
+  private:
+    void CullRange(const Frustum &frustum, SimdLevel level, size_t begin, size_t end);
+};
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,135 @@
+#pragma once
+#include "Bounds.hpp"
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+enum class PackedLightType : uint32_t
+{
+    Directional = 0,
+    Point = 1,
+    Spot = 2,
+};
+/**
+ * @brief 上传到SSBO的光源，std430下64字节，与着色器中的 LightData 一致
+ */
+struct PackedLight
+{
+    glm::vec4 positionRange{0.0f};  // xyz 世界空间位置，w 影响半径
+    glm::vec4 colorIntensity{1.0f}; // rgb 颜色，a 强度
+    glm::vec4 directionType{0.0f};  // xyz 世界空间方向，w 类型（PackedLightType）
+    glm::vec4 spotAngles{0.0f};     // x cos(内角) y cos(外角)
+};
+static_assert(sizeof(PackedLight) == 64, "PackedLight must match std430 layout");
+/**
+ * @brief 每个簇在光源索引列表中的区间
+ */
+struct ClusterRange
+{
+    uint32_t offset = 0;
+    uint32_t count = 0;
+};
+/**
+ * @brief 簇式光照的CPU光源分配
+ *
+ * 视锥按屏幕分块和指数深度切片划分为froxel，每个有范围的光源只分配到与其包围球相交的簇。
+ * 方向光排在光源数组最前面，对所有像素生效，不参与分簇。按深度切片并行，结果与串行一致。
+ */
+class LightClusterGrid final
+{
+  public:
+    struct Config
+    {
+        uint32_t tilesX = 16;
+        uint32_t tilesY = 9;
+        uint32_t slices = 24;
+    };
+
+  private:
+    Config mConfig;
+    float mNear = 0.1f;
+    float mFar = 1000.0f;
+    std::vector<AABB> mClusterBounds; // 视图空间
+    glm::mat4 mProjection{0.0f};
+
+    std::vector<PackedLight> mLights;
+    std::vector<ClusterRange> mClusters;
+    std::vector<uint32_t> mLightIndices;
+    uint32_t mDirectionalCount = 0;
+    uint32_t mMaxLightsPerCluster = 0;
+
+  public:
+    LightClusterGrid();
+    explicit LightClusterGrid(const Config &config);
+
+    /**
+     * @brief 分配光源
+     *
+     * @param lights 世界空间光源，顺序任意
+     * @param view 视图矩阵
+     * @param projection 透视投影矩阵，变化时重建簇包围盒
+     * @param nearPlane 与projection一致的近平面
+     * @param farPlane 与projection一致的远平面
+     */
+    void Build(const std::vector<PackedLight> &lights, const glm::mat4 &view, const glm::mat4 &projection,
+               float nearPlane, float farPlane, bool parallel = true);
+
+    inline const Config &GetConfig() const
+    {
+        return mConfig;
+    }
+    inline uint32_t GetClusterCount() const
+    {
+        return mConfig.tilesX * mConfig.tilesY * mConfig.slices;
+    }
+    inline uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const
+    {
+        return (slice * mConfig.tilesY + y) * mConfig.tilesX + x;
+    }
+    /**
+     * @brief 视图空间距离（正值）对应的深度切片，着色器使用相同公式
+     */
+    uint32_t GetSlice(float viewDepth) const;
+    /**
+     * @brief 着色器中 slice = log(depth) * scale + bias
+     */
+    inline glm::vec2 GetSliceScaleBias() const
+    {
+        float scale = static_cast<float>(mConfig.slices) / std::log(mFar / mNear);
+        return glm::vec2(scale, -std::log(mNear) * scale);
+    }
+    inline const AABB &GetClusterBounds(uint32_t clusterIndex) const
+    {
+        return mClusterBounds[clusterIndex];
+    }
+    inline const std::vector<PackedLight> &GetLights() const
+    {
+        return mLights;
+    }
+    inline const std::vector<ClusterRange> &GetClusters() const
+    {
+        return mClusters;
+    }
+    inline const std::vector<uint32_t> &GetLightIndices() const
+    {
+        return mLightIndices;
+    }
+    inline uint32_t GetDirectionalCount() const
+    {
+        return mDirectionalCount;
+    }
+    inline uint32_t GetMaxLightsPerCluster() const
+    {
+        return mMaxLightsPerCluster;
+    }
+
+  private:
+    void BuildClusterBounds(const glm::mat4 &projection);
+};
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,77 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include "Frustum.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+struct MeshletCullSettings
+{
+    bool enabled = true;
+    // 渲染器不开启GL_CULL_FACE，其他路径都按双面绘制；只有确认场景网格都是单面时才打开
+    bool coneCulling = false;
+};
+/**
+ * @brief 剔除后合并的连续索引区间，相对网格LOD0索引的起始位置
+ */
+struct MeshletRange
+{
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
+struct MeshletCullStats
+{
+    uint32_t visible = 0;
+    uint32_t frustumCulled = 0;
+    uint32_t backfaceCulled = 0;
+    uint32_t visibleTriangles = 0;
+};
+/**
+ * @brief 逐簇的视锥和法线圆锥剔除，在模型空间中进行，非均匀缩放下结果也正确
+ *
+ * 存活的相邻簇合并成一个索引区间，直接用于间接绘制命令。不依赖GL上下文，可以单独测试。
+ */
+class MeshletCuller final
+{
+  public:
+    /**
+     * @brief 相机在模型空间中的表示，透视投影时w为1、xyz为相机位置，正交投影时w为0、xyz为观察方向
+     */
+    static glm::vec4 GetModelSpaceCamera(const glm::mat4 &view, const glm::mat4 &projection,
+                                         const glm::mat4 &model);
+    /**
+     * @brief 剔除并把结果追加到ranges
+     *
+     * @param frustum 模型空间的视锥，即 Frustum::FromMatrix(projection * view * model)
+     * @param camera GetModelSpaceCamera 的结果
+     */
+    static MeshletCullStats Cull(std::span<const Meshlet> meshlets, const Frustum &frustum, const glm::vec4 &camera,
+                                 bool coneCulling, std::vector<MeshletRange> &ranges);
+    /**
+     * @brief 簇内所有三角形都背向相机时返回true，保守测试
+     */
+    static inline bool IsBackfacing(const Meshlet &meshlet, const glm::vec4 &camera)
+    {
+        if (meshlet.coneCutoff >= 1.0f)
+        {
+            return false;
+        }
+        // 正交投影的视线方向处处相同，与包围球大小无关
+        if (camera.w == 0.0f)
+        {
+            return glm::dot(glm::vec3(camera), meshlet.coneAxis) >= glm::length(glm::vec3(camera)) * meshlet.coneCutoff;
+        }
+        // 球内任意一点的视线与圆锥轴的夹角都不超过90度减圆锥半角
+        auto direction = meshlet.sphere.center - glm::vec3(camera);
+        float distance = glm::length(direction);
+        return glm::dot(direction, meshlet.coneAxis) >=
+               distance * meshlet.coneCutoff + meshlet.sphere.radius * (1.0f + meshlet.coneCutoff);
+    }
+};
+} // namespace Core
+} // namespace MEngine
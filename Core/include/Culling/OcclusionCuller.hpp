@@ -0,0 +1,99 @@
+#pragma once
+#include "Bounds.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief CPU软件遮挡剔除
+ *
+ * 把少量大遮挡体光栅化到256x128的深度缓冲（SSE一次4个像素），按32x32的屏幕分块并行，
+ * 每块同时生成自己的HiZ层级（取最远深度）。被遮挡体用投影后的屏幕矩形和最近深度在HiZ上做保守测试。
+ * 深度使用z/w，只要求随视距单调，因此与投影矩阵的深度范围约定无关。
+ */
+class OcclusionCuller final
+{
+  public:
+    static constexpr int Width = 256;
+    static constexpr int Height = 128;
+    static constexpr int TileSize = 32;
+    static constexpr int TilesX = Width / TileSize;
+    static constexpr int TilesY = Height / TileSize;
+    // 0级为全分辨率，最后一级每块一个像素
+    static constexpr int MipCount = 6;
+
+  private:
+    struct Triangle
+    {
+        // 三条边的边函数 E(x, y) = a * x + b * y + c，内部为非负
+        glm::vec3 edgeA, edgeB, edgeC;
+        // 深度平面 z = zPlane.x * x + zPlane.y * y + zPlane.z
+        glm::vec3 zPlane;
+        int minX, minY, maxX, maxY;
+    };
+    glm::mat4 mViewProjection{1.0f};
+    std::vector<Triangle> mTriangles;
+    std::array<std::vector<uint32_t>, TilesX * TilesY> mTileBins;
+    std::array<std::vector<float>, MipCount> mDepthMips;
+
+  public:
+    OcclusionCuller();
+    /**
+     * @brief 开始新的一帧，清空深度和遮挡体
+     */
+    void BeginFrame(const glm::mat4 &viewProjection);
+    /**
+     * @brief 添加遮挡体三角形，position按stride字节步长读取
+     */
+    void AddOccluder(const uint8_t *positions, size_t stride, const uint32_t *indices, size_t indexCount,
+                     const glm::mat4 &modelMatrix);
+    template <typename TVertex>
+    void AddOccluder(const std::vector<TVertex> &vertices, const std::vector<uint32_t> &indices,
+                     const glm::mat4 &modelMatrix)
+    {
+        if (vertices.empty())
+        {
+            return;
+        }
+        AddOccluder(reinterpret_cast<const uint8_t *>(&vertices.front().position), sizeof(TVertex), indices.data(),
+                    indices.size(), modelMatrix);
+    }
+    /**
+     * @brief 以世界空间盒子作为遮挡体，适合墙体等简单几何
+     */
+    void AddOccluder(const AABB &aabb);
+    /**
+     * @brief 光栅化所有遮挡体并生成HiZ
+     */
+    void Rasterize(bool parallel = true);
+    /**
+     * @brief 测试包围盒是否可能可见，跨越近平面或不在屏幕内的包围盒视为可见
+     */
+    bool IsVisible(const AABB &aabb) const;
+    /**
+     * @brief 批量测试，只测试visibility中为1的项，被遮挡的置0，返回可见数量
+     */
+    size_t Cull(const std::vector<AABB> &bounds, std::vector<uint8_t> &visibility, bool parallel = true) const;
+
+    inline uint32_t GetTriangleCount() const
+    {
+        return static_cast<uint32_t>(mTriangles.size());
+    }
+    inline float GetDepth(int x, int y, int level = 0) const
+    {
+        return mDepthMips[level][static_cast<size_t>(y) * (Width >> level) + x];
+    }
+
+  private:
+    void AddTriangle(const glm::vec4 &clip0, const glm::vec4 &clip1, const glm::vec4 &clip2);
+    void RasterizeTile(int tileIndex);
+    void BuildTileMips(int tileX, int tileY);
+};
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,123 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <optional>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 基于空闲链表的区间分配器，只管理偏移量，不持有实际内存
+ *
+ * 用于在一块大的GPU缓冲区中子分配顶点/索引区间，释放时自动合并相邻的空闲块。
+ */
+class FreeListAllocator final
+{
+  private:
+    uint32_t mCapacity = 0;
+    uint32_t mUsed = 0;
+    std::map<uint32_t, uint32_t> mFreeBlocks; // offset -> size
+
+  public:
+    FreeListAllocator() = default;
+    explicit FreeListAllocator(uint32_t capacity) : mCapacity(capacity)
+    {
+        if (capacity > 0)
+        {
+            mFreeBlocks.emplace(0, capacity);
+        }
+    }
+    /**
+     * @brief 分配一段连续区间（best-fit），空间不足时返回 std::nullopt
+     */
+    std::optional<uint32_t> Allocate(uint32_t size)
+    {
+        if (size == 0)
+        {
+            return std::nullopt;
+        }
+        auto best = mFreeBlocks.end();
+        for (auto it = mFreeBlocks.begin(); it != mFreeBlocks.end(); ++it)
+        {
+            if (it->second >= size && (best == mFreeBlocks.end() || it->second < best->second))
+            {
+                best = it;
+                if (it->second == size)
+                {
+                    break;
+                }
+            }
+        }
+        if (best == mFreeBlocks.end())
+        {
+            return std::nullopt;
+        }
+        auto offset = best->first;
+        auto remain = best->second - size;
+        mFreeBlocks.erase(best);
+        if (remain > 0)
+        {
+            mFreeBlocks.emplace(offset + size, remain);
+        }
+        mUsed += size;
+        return offset;
+    }
+    /**
+     * @brief 释放区间并与前后相邻的空闲块合并
+     */
+    void Free(uint32_t offset, uint32_t size)
+    {
+        if (size == 0)
+        {
+            return;
+        }
+        mUsed -= size;
+        auto next = mFreeBlocks.lower_bound(offset);
+        if (next != mFreeBlocks.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset)
+            {
+                offset = prev->first;
+                size += prev->second;
+                mFreeBlocks.erase(prev);
+            }
+        }
+        if (next != mFreeBlocks.end() && offset + size == next->first)
+        {
+            size += next->second;
+            mFreeBlocks.erase(next);
+        }
+        mFreeBlocks.emplace(offset, size);
+    }
+    /**
+     * @brief 扩容，新增的尾部空间并入空闲链表
+     */
+    void Grow(uint32_t newCapacity)
+    {
+        if (newCapacity <= mCapacity)
+        {
+            return;
+        }
+        auto oldCapacity = mCapacity;
+        mCapacity = newCapacity;
+        mUsed += newCapacity - oldCapacity;
+        Free(oldCapacity, newCapacity - oldCapacity);
+    }
+    inline uint32_t GetCapacity() const
+    {
+        return mCapacity;
+    }
+    inline uint32_t GetUsed() const
+    {
+        return mUsed;
+    }
+    inline size_t GetFreeBlockCount() const
+    {
+        return mFreeBlocks.size();
+    }
+};
+} // namespace Core
+} // namespace MEngine
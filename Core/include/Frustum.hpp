@@ -0,0 +1,89 @@
+#pragma once
+#include "Bounds.hpp"
+#include <array>
+#include <glm/glm.hpp>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 视锥体，六个平面法线朝内，平面以vec4(normal, d)表示，dot(normal, p) + d >= 0 为内侧
+ */
+struct Frustum
+{
+    enum PlaneIndex
+    {
+        Left = 0,
+        Right,
+        Bottom,
+        Top,
+        Near,
+        Far,
+        Count
+    };
+    std::array<glm::vec4, Count> planes{};
+
+    /**
+     * @brief 从 projection * view 提取平面（Gribb-Hartmann）
+     *
+     * 近平面使用 row3 + row2，对[-1,1]和[0,1]两种深度范围都是保守的
+     */
+    static inline Frustum FromMatrix(const glm::mat4 &viewProjection)
+    {
+        auto row = [&](int i) {
+            return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        };
+        auto row0 = row(0), row1 = row(1), row2 = row(2), row3 = row(3);
+        Frustum frustum;
+        frustum.planes[Left] = row3 + row0;
+        frustum.planes[Right] = row3 - row0;
+        frustum.planes[Bottom] = row3 + row1;
+        frustum.planes[Top] = row3 - row1;
+        frustum.planes[Near] = row3 + row2;
+        frustum.planes[Far] = row3 - row2;
+        for (auto &plane : frustum.planes)
+        {
+            float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+            {
+                plane /= length;
+            }
+        }
+        return frustum;
+    }
+    inline bool Intersects(const AABB &aabb) const
+    {
+        // 无效包围盒视为总是可见，与FrustumCuller一致
+        if (!aabb.IsValid())
+        {
+            return true;
+        }
+        auto center = aabb.GetCenter();
+        auto extents = aabb.GetExtents();
+        for (const auto &plane : planes)
+        {
+            auto normal = glm::vec3(plane);
+            float distance = glm::dot(normal, center) + plane.w;
+            float radius = glm::dot(glm::abs(normal), extents);
+            if (distance < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    inline bool Intersects(const BoundingSphere &sphere) const
+    {
+        for (const auto &plane : planes)
+        {
+            if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+} // namespace Core
+} // namespace MEngine
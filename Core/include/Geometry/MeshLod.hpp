@@ -0,0 +1,74 @@
+#pragma once
+#include "Bounds.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+#include <span>
+
+namespace MEngine
+{
+namespace Core
+{
+// 包括原网格在内的最大LOD级数
+constexpr uint32_t MaxMeshLods = 8;
+
+struct MeshLodSettings
+{
+    // 允许的屏幕空间误差，单位像素
+    float pixelError = 1.0f;
+    // 切换到更粗级别时要求误差低于阈值的比例余量，防止在阈值附近来回切换
+    float hysteresis = 0.25f;
+};
+/**
+ * @brief 包围球在屏幕上投影的直径，单位像素；相机在球内时返回无穷大
+ *
+ * @param viewPosition 球心在观察空间中的位置
+ */
+inline float ProjectSphereSize(const glm::vec3 &viewPosition, float radius, const glm::mat4 &projection,
+                               float viewportHeight)
+{
+    // 正交投影与距离无关
+    if (projection[3][3] == 1.0f)
+    {
+        return radius * projection[1][1] * viewportHeight;
+    }
+    float distanceSquared = glm::dot(viewPosition, viewPosition);
+    float radiusSquared = radius * radius;
+    if (distanceSquared <= radiusSquared)
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+    // 切线方向的投影半径 r / sqrt(d^2 - r^2)，乘以 cot(fov/2) 得到NDC半径
+    return radius * projection[1][1] / std::sqrt(distanceSquared - radiusSquared) * viewportHeight;
+}
+/**
+ * @brief 按投影大小选择LOD
+ *
+ * lodErrors为各级相对于包围球半径的几何误差，第0级为原网格，误差应随级别递增。
+ * 误差投影到屏幕上不超过settings.pixelError的最粗级别被选中；
+ * 变粗时要求误差再低于hysteresis比例，变细则在当前级别超过阈值时立即发生。
+ */
+inline uint32_t SelectLod(std::span<const float> lodErrors, float projectedSize, uint32_t currentLod,
+                          const MeshLodSettings &settings)
+{
+    if (lodErrors.empty())
+    {
+        return 0;
+    }
+    auto pixels = [&](uint32_t lod) { return lodErrors[lod] * projectedSize * 0.5f; };
+    uint32_t lod = std::min(currentLod, static_cast<uint32_t>(lodErrors.size() - 1));
+    while (lod > 0 && pixels(lod) > settings.pixelError)
+    {
+        lod--;
+    }
+    float coarserThreshold = settings.pixelError * (1.0f - settings.hysteresis);
+    while (lod + 1 < lodErrors.size() && pixels(lod + 1) <= coarserThreshold)
+    {
+        lod++;
+    }
+    return lod;
+}
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,135 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 顶点缓存统计，按FIFO缓存模拟
+ */
+struct VertexCacheStats
+{
+    uint32_t misses = 0;
+    // 每个三角形平均的缓存未命中数，理想值接近0.5，最差为3
+    float acmr = 0.0f;
+    // 未命中数与被引用顶点数之比，理想值为1
+    float atvr = 0.0f;
+};
+/**
+ * @brief 导入后的网格优化
+ *
+ * 依次执行：整顶点去重、Tipsify三角形重排提高变换后缓存命中、按簇排序减少过度绘制、
+ * 按首次使用顺序重排顶点提高顶点读取的局部性。所有步骤都不改变三角形集合和绕序。
+ */
+class MeshOptimizer final
+{
+  public:
+    static constexpr uint32_t CacheSize = 16;
+
+    static VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t> &indices, size_t vertexCount,
+                                               uint32_t cacheSize = CacheSize);
+    /**
+     * @brief 按字节比较整个顶点生成去重映射，remap[i]为顶点i去重后的索引
+     *
+     * @return 去重后的顶点数
+     */
+    static size_t GenerateVertexRemap(std::vector<uint32_t> &remap, const uint8_t *vertices, size_t stride,
+                                      size_t vertexCount);
+    /**
+     * @brief Tipsify (Sander 2007)，线性时间的三角形重排
+     */
+    static void OptimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount,
+                                    uint32_t cacheSize = CacheSize);
+    /**
+     * @brief 在缓存优化后的顺序上按缓存重启点切分成簇，朝外的簇先画，减少过度绘制
+     *
+     * @param threshold 簇内ACMR不超过整体的threshold倍时允许在缓存未重启处切分更小的簇
+     */
+    static void OptimizeOverdraw(std::vector<uint32_t> &indices, const uint8_t *positions, size_t stride,
+                                 size_t vertexCount, float threshold = 1.05f, uint32_t cacheSize = CacheSize);
+    /**
+     * @brief 按索引中首次出现的顺序生成顶点映射，未使用的顶点映射为~0u
+     *
+     * @return 被使用的顶点数
+     */
+    static size_t GenerateFetchRemap(std::vector<uint32_t> &remap, const std::vector<uint32_t> &indices,
+                                     size_t vertexCount);
+    /**
+     * @brief 按三角形顺序切分成顶点数都不超过maxVertices的连续段，用于让超大网格也能使用16位索引
+     *
+     * @return 各段的起始索引位置，最后一个元素为indices.size()；不需要切分时只有一段
+     */
+    static std::vector<size_t> SplitByVertexLimit(const std::vector<uint32_t> &indices, size_t vertexCount,
+                                                  size_t maxVertices);
+
+    /**
+     * @brief 按映射重排顶点并改写索引，多个顶点映射到同一位置时保留任意一个
+     */
+    template <typename TVertex>
+    static void RemapVertices(std::vector<TVertex> &vertices, std::vector<uint32_t> &indices,
+                              const std::vector<uint32_t> &remap, size_t newVertexCount)
+    {
+        std::vector<TVertex> remapped(newVertexCount);
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            if (remap[i] != ~0u)
+            {
+                remapped[remap[i]] = vertices[i];
+            }
+        }
+        vertices = std::move(remapped);
+        for (auto &index : indices)
+        {
+            index = remap[index];
+        }
+    }
+    /**
+     * @brief 取出索引区间[first, last)引用的顶点，按首次使用顺序排列，段之间共享的顶点会被复制
+     */
+    template <typename TVertex>
+    static void ExtractRange(const std::vector<TVertex> &vertices, const std::vector<uint32_t> &indices, size_t first,
+                             size_t last, std::vector<TVertex> &outVertices, std::vector<uint32_t> &outIndices)
+    {
+        outIndices.assign(indices.begin() + first, indices.begin() + last);
+        std::vector<uint32_t> remap;
+        auto usedCount = GenerateFetchRemap(remap, outIndices, vertices.size());
+        outVertices.resize(usedCount);
+        for (size_t i = 0; i < vertices.size(); i++)
+        {
+            if (remap[i] != ~0u)
+            {
+                outVertices[remap[i]] = vertices[i];
+            }
+        }
+        for (auto &index : outIndices)
+        {
+            index = remap[index];
+        }
+    }
+    /**
+     * @brief 执行完整的优化流程
+     */
+    template <typename TVertex> static void Optimize(std::vector<TVertex> &vertices, std::vector<uint32_t> &indices)
+    {
+        if (vertices.empty() || indices.empty())
+        {
+            return;
+        }
+        std::vector<uint32_t> remap;
+        auto uniqueCount =
+            GenerateVertexRemap(remap, reinterpret_cast<const uint8_t *>(vertices.data()), sizeof(TVertex),
+                                vertices.size());
+        RemapVertices(vertices, indices, remap, uniqueCount);
+        OptimizeVertexCache(indices, vertices.size());
+        OptimizeOverdraw(indices, reinterpret_cast<const uint8_t *>(&vertices.front().position), sizeof(TVertex),
+                         vertices.size());
+        auto usedCount = GenerateFetchRemap(remap, indices, vertices.size());
+        RemapVertices(vertices, indices, remap, usedCount);
+    }
+};
+} // namespace Core
+} // namespace MEngine
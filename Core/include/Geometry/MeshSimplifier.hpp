@@ -0,0 +1,49 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 基于二次误差度量（QEM）的网格简化
+ *
+ * 每次把一个顶点折叠到相邻顶点上（半边折叠），不产生新顶点，结果只是新的索引缓冲，
+ * 因此各级LOD可以与原网格共用同一份顶点数据。每个顶点的二次误差矩阵为其周围三角形平面的平方距离之和，
+ * 折叠代价 (Qu + Qv)(pv) 的平方根作为该次折叠的几何误差，单位与顶点坐标相同。
+ * 边界、非流形边以及同一位置上有多个顶点（UV或法线接缝）的顶点保持不动，避免撕开网格。
+ * 折叠前检查三角形翻转和拓扑（link condition），不会产生重复或翻面的三角形。
+ */
+class MeshSimplifier final
+{
+  public:
+    /**
+     * @brief 简化到目标索引数，或下一次折叠的误差超过maxError为止
+     *
+     * @param positions 顶点位置，按stride字节步长读取
+     * @param resultError 可选，输出实际发生的最大折叠误差
+     * @return 新的三角形索引，引用原顶点
+     */
+    static std::vector<uint32_t> Simplify(const uint8_t *positions, size_t stride, size_t vertexCount,
+                                          const uint32_t *indices, size_t indexCount, size_t targetIndexCount,
+                                          float maxError, float *resultError = nullptr);
+    template <typename TVertex>
+    static std::vector<uint32_t> Simplify(const std::vector<TVertex> &vertices, const std::vector<uint32_t> &indices,
+                                          size_t targetIndexCount, float maxError, float *resultError = nullptr)
+    {
+        if (vertices.empty())
+        {
+            if (resultError)
+            {
+                *resultError = 0.0f;
+            }
+            return {};
+        }
+        return Simplify(reinterpret_cast<const uint8_t *>(&vertices.front().position), sizeof(TVertex),
+                        vertices.size(), indices.data(), indices.size(), targetIndexCount, maxError, resultError);
+    }
+};
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,47 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 把网格切分成小簇（meshlet），每簇带包围球和法线圆锥，用于绘制前按簇做视锥和背面剔除
+ *
+ * 从未分配的三角形开始，贪心地加入与簇共享顶点最多的相邻三角形，直到顶点或三角形数达到上限。
+ * 索引按簇重排，每簇在索引缓冲区中连续，可以直接作为间接绘制命令的区间。
+ */
+class MeshletBuilder final
+{
+  public:
+    static constexpr uint32_t MaxVertices = 64;
+    static constexpr uint32_t MaxTriangles = 124;
+
+    /**
+     * @brief 生成簇并按簇重排indices
+     */
+    static std::vector<Meshlet> Build(std::vector<uint32_t> &indices, const uint8_t *positions, size_t stride,
+                                      size_t vertexCount, uint32_t maxVertices = MaxVertices,
+                                      uint32_t maxTriangles = MaxTriangles);
+    template <typename TVertex>
+    static std::vector<Meshlet> Build(const std::vector<TVertex> &vertices, std::vector<uint32_t> &indices,
+                                      uint32_t maxVertices = MaxVertices, uint32_t maxTriangles = MaxTriangles)
+    {
+        if (vertices.empty())
+        {
+            return {};
+        }
+        return Build(indices, reinterpret_cast<const uint8_t *>(&vertices.front().position), sizeof(TVertex),
+                     vertices.size(), maxVertices, maxTriangles);
+    }
+    /**
+     * @brief 计算簇的包围球和法线圆锥，firstIndex和triangleCount需已设置
+     */
+    static void ComputeBounds(Meshlet &meshlet, const std::vector<uint32_t> &indices, const uint8_t *positions,
+                              size_t stride);
+};
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,48 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <span>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+struct StaticBatchSettings
+{
+    bool enabled = true;
+    // 合批按世界空间网格划分，每格每种材质单独合并，保证合并后的包围盒仍能有效剔除
+    float cellSize = 32.0f;
+    // 只合并小网格，大网格保留逐实体的LOD和簇级剔除
+    uint32_t maxSourceVertices = 4096;
+    // 所有来源都是紧凑格式时，合并结果按此误差决定是否仍用紧凑格式
+    float maxPositionError = 0.0005f;
+};
+struct StaticBatchSource
+{
+    const Mesh *mesh = nullptr;
+    glm::mat4 modelMatrix{1.0f};
+};
+/**
+ * @brief 把不动的网格变换到世界空间后合并成少量大网格
+ *
+ * 合并结果没有LOD和簇，顶点数不超过上限以便使用16位索引；单个来源本身超过上限时独占一个网格。
+ */
+class StaticBatchBuilder final
+{
+  public:
+    /**
+     * @brief 包含position的网格单元
+     */
+    static glm::ivec3 GetCell(const glm::vec3 &position, float cellSize);
+    static std::vector<Mesh> Merge(std::span<const StaticBatchSource> sources, float maxPositionError = 0.0005f,
+                                   size_t maxVertices = MaxUInt16IndexedVertices);
+    /**
+     * @brief 把网格的顶点变换到世界空间追加到target，镜像变换时翻转三角形绕序
+     */
+    static void Append(Mesh &target, const Mesh &source, const glm::mat4 &modelMatrix);
+};
+} // namespace Core
+} // namespace MEngine
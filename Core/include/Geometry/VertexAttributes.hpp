@@ -0,0 +1,21 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 按面积加权累加三角形法线得到平滑顶点法线，用于源文件没有法线的网格
+ */
+void ComputeNormals(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices);
+/**
+ * @brief 由纹理坐标计算切线和副切线，切线对法线正交化，副切线保留纹理空间的镜像方向
+ *
+ * 没有纹理坐标变化的顶点取与法线正交的任意方向
+ */
+void ComputeTangents(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices);
+} // namespace Core
+} // namespace MEngine
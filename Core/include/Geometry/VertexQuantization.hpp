@@ -0,0 +1,71 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include "Bounds.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 紧凑顶点布局，GPU端按归一化整数和半精度读取
+ *
+ * 副切线不保存，由 cross(normal, tangent) * tangent.w 重建
+ */
+struct CompactVertex
+{
+    uint16_t position[4]; // 相对网格包围盒量化的unorm16，w未使用
+    uint16_t normal[2];   // 八面体编码的unorm16
+    int8_t tangent[4];    // 切线xyz为snorm8，w为副切线方向的符号
+    uint16_t texCoord[2]; // 半精度浮点
+};
+static_assert(sizeof(CompactVertex) == 20);
+/**
+ * @brief 位置反量化 position = offset + unorm * scale，所有轴使用同一缩放，
+ * 可以合并进模型矩阵而不影响法线方向
+ */
+struct PositionQuantization
+{
+    glm::vec3 offset{0.0f};
+    float scale = 1.0f;
+
+    inline glm::mat4 GetMatrix() const
+    {
+        glm::mat4 matrix(scale);
+        matrix[3] = glm::vec4(offset, 1.0f);
+        return matrix;
+    }
+    /**
+     * @brief 量化步长，即最大位置误差的两倍
+     */
+    inline float GetStep() const
+    {
+        return scale / 65535.0f;
+    }
+};
+
+PositionQuantization ComputePositionQuantization(const AABB &bounds);
+/**
+ * @brief 单位向量的八面体映射，结果在[0,1]，与 Shaders/Include/Octahedral.glsl 一致
+ */
+glm::vec2 EncodeOctahedral(const glm::vec3 &normal);
+glm::vec3 DecodeOctahedral(const glm::vec2 &encoded);
+uint16_t FloatToHalf(float value);
+float HalfToFloat(uint16_t value);
+CompactVertex EncodeCompactVertex(const Vertex &vertex, const PositionQuantization &quantization);
+/**
+ * @brief 还原为完整顶点，用于校验和CPU端读取
+ */
+Vertex DecodeCompactVertex(const CompactVertex &vertex, const PositionQuantization &quantization);
+std::vector<CompactVertex> EncodeCompactVertices(const std::vector<Vertex> &vertices,
+                                                 const PositionQuantization &quantization);
+// 半精度在[-4,4]内的步长不超过1/512，超出此范围的平铺UV改用标准格式
+constexpr float MaxCompactTexCoord = 4.0f;
+/**
+ * @brief 量化后的位置误差不超过maxPositionError且UV在半精度的精确范围内时选择紧凑格式
+ */
+VertexFormat ChooseVertexFormat(const Mesh &mesh, float maxPositionError);
+} // namespace Core
+} // namespace MEngine
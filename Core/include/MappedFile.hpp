@@ -0,0 +1,66 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 只读内存映射文件，导入器直接在映射上解析，不把整个文件读入内存
+ *
+ * 空文件可以打开，此时数据为空。
+ */
+class MappedFile final
+{
+  private:
+    const uint8_t *mData = nullptr;
+    size_t mSize = 0;
+    bool mOpen = false;
+#ifdef _WIN32
+    void *mFile = nullptr;
+    void *mMapping = nullptr;
+#endif
+
+  public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path &path);
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+
+    bool Open(const std::filesystem::path &path);
+    void Close();
+    /**
+     * @brief 提示内核按顺序预读，之后访问的页不再保留，用于只扫描一遍的大文件
+     */
+    void AdviseSequential() const;
+    /**
+     * @brief 已经解析完的范围不再访问，归还其物理页，分段扫描大文件时常驻内存不随文件增长
+     *
+     * Linux下用MADV_DONTNEED丢弃，Windows下用VirtualUnlock移出工作集。
+     */
+    void Discard(size_t offset, size_t size) const;
+    inline bool IsOpen() const
+    {
+        return mOpen;
+    }
+    inline const uint8_t *GetData() const
+    {
+        return mData;
+    }
+    inline size_t GetSize() const
+    {
+        return mSize;
+    }
+    inline std::span<const uint8_t> GetSpan() const
+    {
+        return {mData, mSize};
+    }
+};
+} // namespace Core
+} // namespace MEngine
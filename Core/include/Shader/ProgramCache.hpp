@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 程序二进制磁盘缓存
+ *
+ * 以预处理后的着色器源码、宏定义和驱动字符串的哈希为键，保存 glGetProgramBinary 的结果。
+ * 加载失败（驱动更新、格式不符）时删除缓存文件并返回0，由调用者回退到源码编译。
+ */
+class ProgramCache final
+{
+  public:
+    struct Stats
+    {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        uint32_t stores = 0;
+        float loadTimeMs = 0.0f; // 命中时 glProgramBinary 的累计耗时
+    };
+
+  private:
+    std::filesystem::path mDirectory;
+    std::string mDriver;
+    int mSupported = -1; // -1 未查询
+    Stats mStats;
+
+  public:
+    static ProgramCache &Get();
+
+    /**
+     * @brief 设置缓存目录，不存在时创建；未设置目录时缓存不生效
+     */
+    void SetDirectory(const std::filesystem::path &directory);
+    inline const std::filesystem::path &GetDirectory() const
+    {
+        return mDirectory;
+    }
+    /**
+     * @brief 驱动至少支持一种程序二进制格式且已设置目录
+     */
+    bool IsEnabled();
+    /**
+     * @brief 计算缓存键，需要当前线程有GL上下文以获取驱动字符串
+     */
+    uint64_t ComputeKey(const std::vector<std::string> &sources, const std::vector<std::string> &defines);
+    /**
+     * @brief 与驱动无关的哈希，FNV-1a 64位，各段之间插入分隔符
+     */
+    static uint64_t Hash(const std::vector<std::string> &sources, const std::vector<std::string> &defines,
+                         const std::string &driver);
+    /**
+     * @brief 从缓存创建program，未命中或二进制失效返回0
+     */
+    GLuint Load(uint64_t key);
+    /**
+     * @brief 保存已链接program的二进制，program链接前需设置 GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+     */
+    void Store(uint64_t key, GLuint program);
+    /**
+     * @brief 删除目录下的所有缓存文件
+     */
+    void Clear();
+
+    inline const Stats &GetStats() const
+    {
+        return mStats;
+    }
+
+  private:
+    std::filesystem::path GetCachePath(uint64_t key) const;
+    const std::string &GetDriver();
+};
+} // namespace Core
+} // namespace MEngine
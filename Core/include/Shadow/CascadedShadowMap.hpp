@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace MEngine
+{
+namespace Core
+{
+struct ShadowCascade
+{
+    glm::mat4 viewProjection{1.0f};
+    float splitDistance = 0.0f; // 该级联覆盖到的视图空间距离
+    float texelSize = 0.0f;     // 每个阴影贴图texel对应的世界空间尺寸
+};
+/**
+ * @brief 方向光级联阴影的CPU部分：划分、稳定拟合以及静态投射体缓存的有效性
+ *
+ * 每个级联用视锥切片的包围球拟合，半径只取决于切片形状，相机旋转时投影尺寸不变；
+ * 包围球中心在光源空间按snapTexels个texel的步长取整，平移只以整数texel变化，消除边缘闪烁。
+ * 取整会让投影在步长内保持不变，静态投射体可以缓存到投影下一次跳变，代价是每边多留一个步长的边距。
+ * 不依赖GL上下文，可以单独测试。
+ */
+class CascadedShadowMap final
+{
+  public:
+    static constexpr uint32_t MaxCascades = 4;
+    struct Config
+    {
+        uint32_t cascadeCount = 4;
+        uint32_t resolution = 2048;
+        float splitLambda = 0.75f;     // 对数划分与均匀划分的混合比例
+        float shadowDistance = 100.0f; // 超出该距离不再有阴影
+        uint32_t snapTexels = 64;      // 投影中心的取整步长，越大静态缓存越少失效，有效分辨率越低
+        float casterDistance = 200.0f; // 级联包围球朝光源方向额外包含的投射体距离
+    };
+
+  private:
+    Config mConfig;
+    uint32_t mCascadeCount = 0;
+    std::array<ShadowCascade, MaxCascades> mCascades{};
+    // 静态层上次渲染时使用的矩阵
+    std::array<glm::mat4, MaxCascades> mStaticMatrices{};
+    std::array<bool, MaxCascades> mStaticValid{};
+
+  public:
+    CascadedShadowMap();
+    explicit CascadedShadowMap(const Config &config);
+
+    /**
+     * @brief 修改配置，所有静态层失效
+     */
+    void SetConfig(const Config &config);
+    /**
+     * @brief 根据相机和光源方向重新计算级联
+     *
+     * @param view 相机视图矩阵
+     * @param projection 相机透视投影，只用来确定视锥形状
+     * @param lightDirection 光线传播方向
+     */
+    void Update(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane,
+                const glm::vec3 &lightDirection);
+    /**
+     * @brief 级联矩阵与上次渲染静态层时不同，或静态层已失效
+     */
+    bool NeedsStaticUpdate(uint32_t cascade) const;
+    /**
+     * @brief 静态投射体已按当前矩阵渲染到缓存层
+     */
+    void MarkStaticUpdated(uint32_t cascade);
+    /**
+     * @brief 静态投射体增删或移动后调用，所有静态层下次重新渲染
+     */
+    void InvalidateStatic();
+
+    inline const Config &GetConfig() const
+    {
+        return mConfig;
+    }
+    inline uint32_t GetCascadeCount() const
+    {
+        return mCascadeCount;
+    }
+    inline const ShadowCascade &GetCascade(uint32_t cascade) const
+    {
+        return mCascades[cascade];
+    }
+    /**
+     * @brief 各级联的划分距离，未使用的分量为0，直接上传给着色器
+     */
+    glm::vec4 GetSplitDistances() const;
+    /**
+     * @brief near到far之间按lambda混合对数与均匀划分，返回count个远端距离
+     */
+    static void ComputeSplits(float nearPlane, float farPlane, uint32_t count, float lambda, float *splits);
+};
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,47 @@
+#pragma once
+// SIMD能力检测：SSE是x64基线，编译期决定；AVX2内核只在函数上用MENGINE_TARGET_AVX2启用，调用前需检查CpuSupportsAVX2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MENGINE_SIMD_SSE 1
+#endif
+#if defined(MENGINE_ENABLE_AVX2) && (defined(__x86_64__) || defined(_M_X64))
+#include <immintrin.h>
+#define MENGINE_SIMD_AVX2 1
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC不需要/arch即可使用AVX2内建函数
+#include <intrin.h>
+#define MENGINE_TARGET_AVX2
+#else
+#define MENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 运行时检测CPU和操作系统是否支持AVX2
+ */
+inline bool CpuSupportsAVX2()
+{
+#if defined(MENGINE_SIMD_AVX2) && defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    // OSXSAVE和AVX位，并确认操作系统保存了YMM寄存器
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(MENGINE_SIMD_AVX2)
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+} // namespace Core
+} // namespace MEngine
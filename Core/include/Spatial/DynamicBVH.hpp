@@ -0,0 +1,320 @@
+#pragma once
+#include "Bounds.hpp"
+#include "Frustum.hpp"
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 动态AABB树，用于场景空间查询
+ *
+ * 节点保存在连续的节点池中，通过空闲链表复用。插入时按SAH代价下降寻找最佳兄弟节点，
+ * 回溯时做树旋转降低表面积。叶子保存外扩（fat）的包围盒，物体小幅移动时无需重新插入；
+ * 查询在叶子处使用精确包围盒，因此结果与逐个测试一致。
+ */
+class DynamicBVH final
+{
+  public:
+    static constexpr int32_t NullNode = -1;
+    struct Node
+    {
+        AABB aabb;                // 叶子为外扩包围盒
+        int32_t parent = NullNode; // 空闲节点时作为空闲链表的next
+        int32_t child1 = NullNode;
+        int32_t child2 = NullNode;
+        int32_t height = 0; // 叶子为0，空闲节点为-1
+        uint32_t userData = 0;
+        inline bool IsLeaf() const
+        {
+            return child1 == NullNode;
+        }
+    };
+
+  private:
+    std::vector<Node> mNodes;
+    std::vector<AABB> mTightBounds; // 与mNodes下标对应，仅叶子有效
+    int32_t mRoot = NullNode;
+    int32_t mFreeList = NullNode;
+    uint32_t mProxyCount = 0;
+    float mMargin;
+
+  public:
+    explicit DynamicBVH(float margin = 0.1f);
+
+    /**
+     * @brief 创建代理，返回节点ID，userData在查询时回传
+     */
+    int32_t CreateProxy(const AABB &aabb, uint32_t userData);
+    void DestroyProxy(int32_t proxyID);
+    /**
+     * @brief 更新代理包围盒，仍在外扩包围盒内时只更新精确包围盒
+     *
+     * @return 是否重新插入了树
+     */
+    bool MoveProxy(int32_t proxyID, const AABB &aabb);
+    void Clear();
+
+    inline const AABB &GetFatAABB(int32_t proxyID) const
+    {
+        return mNodes[proxyID].aabb;
+    }
+    inline const AABB &GetAABB(int32_t proxyID) const
+    {
+        return mTightBounds[proxyID];
+    }
+    inline uint32_t GetUserData(int32_t proxyID) const
+    {
+        return mNodes[proxyID].userData;
+    }
+    inline uint32_t GetProxyCount() const
+    {
+        return mProxyCount;
+    }
+    inline int32_t GetHeight() const
+    {
+        return mRoot == NullNode ? 0 : mNodes[mRoot].height;
+    }
+    inline size_t GetNodeCapacity() const
+    {
+        return mNodes.size();
+    }
+    /**
+     * @brief 所有节点表面积之和与根节点表面积的比值，即SAH代价，越小树质量越好
+     */
+    float GetAreaRatio() const;
+    /**
+     * @brief 检查父子关系、高度和包含关系，用于测试
+     */
+    bool Validate() const;
+
+    /**
+     * @brief 查询与aabb相交的代理，callback(userData)返回false时终止
+     */
+    template <typename TCallback> void QueryAABB(const AABB &aabb, TCallback &&callback) const;
+    /**
+     * @brief 查询与视锥相交的代理，完全在视锥内的子树不再逐个测试
+     */
+    template <typename TCallback> void QueryFrustum(const Frustum &frustum, TCallback &&callback) const;
+    /**
+     * @brief 射线查询，callback(userData, distance)返回新的最大距离，返回值<=0时终止
+     *
+     * distance为射线进入包围盒的距离，调用方可以在回调中做精确相交并缩短射线
+     */
+    template <typename TCallback>
+    void RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance, TCallback &&callback) const;
+    /**
+     * @brief 查询距离point最近的k个代理（到包围盒的距离），结果按距离从近到远
+     */
+    void QueryKNearest(const glm::vec3 &point, size_t k, std::vector<uint32_t> &result) const;
+
+  private:
+    int32_t AllocateNode();
+    void FreeNode(int32_t nodeID);
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    int32_t FindBestSibling(const AABB &aabb);
+    void Rotate(int32_t nodeID);
+    void Refit(int32_t nodeID);
+
+    /**
+     * @brief 遍历栈，深度较小时不分配堆内存
+     */
+    class NodeStack
+    {
+      private:
+        std::array<int32_t, 128> mInline;
+        std::vector<int32_t> mHeap;
+        size_t mSize = 0;
+
+      public:
+        inline void Push(int32_t value)
+        {
+            if (mSize < mInline.size())
+            {
+                mInline[mSize] = value;
+            }
+            else
+            {
+                mHeap.push_back(value);
+            }
+            mSize++;
+        }
+        inline int32_t Pop()
+        {
+            mSize--;
+            if (mSize < mInline.size())
+            {
+                return mInline[mSize];
+            }
+            auto value = mHeap.back();
+            mHeap.pop_back();
+            return value;
+        }
+        inline bool Empty() const
+        {
+            return mSize == 0;
+        }
+    };
+};
+
+template <typename TCallback> void DynamicBVH::QueryAABB(const AABB &aabb, TCallback &&callback) const
+{
+    if (mRoot == NullNode)
+    {
+        return;
+    }
+    NodeStack stack;
+    stack.Push(mRoot);
+    while (!stack.Empty())
+    {
+        int32_t nodeID = stack.Pop();
+        const auto &node = mNodes[nodeID];
+        if (!node.aabb.Overlaps(aabb))
+        {
+            continue;
+        }
+        if (node.IsLeaf())
+        {
+            if (mTightBounds[nodeID].Overlaps(aabb) && !callback(node.userData))
+            {
+                return;
+            }
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
+template <typename TCallback> void DynamicBVH::QueryFrustum(const Frustum &frustum, TCallback &&callback) const
+{
+    if (mRoot == NullNode)
+    {
+        return;
+    }
+    // 0 外部 1 相交 2 完全在内部
+    auto classify = [&](const AABB &aabb) {
+        auto center = aabb.GetCenter();
+        auto extents = aabb.GetExtents();
+        int result = 2;
+        for (const auto &plane : frustum.planes)
+        {
+            auto normal = glm::vec3(plane);
+            float distance = glm::dot(normal, center) + plane.w;
+            float radius = glm::dot(glm::abs(normal), extents);
+            if (distance < -radius)
+            {
+                return 0;
+            }
+            if (distance < radius)
+            {
+                result = 1;
+            }
+        }
+        return result;
+    };
+    // 完全在内部的子树用最高位标记
+    constexpr int32_t InsideFlag = 0x40000000;
+    NodeStack stack;
+    stack.Push(mRoot);
+    while (!stack.Empty())
+    {
+        int32_t entry = stack.Pop();
+        bool inside = (entry & InsideFlag) != 0;
+        int32_t nodeID = entry & ~InsideFlag;
+        const auto &node = mNodes[nodeID];
+        if (!inside)
+        {
+            int classification = classify(node.aabb);
+            if (classification == 0)
+            {
+                continue;
+            }
+            inside = classification == 2;
+        }
+        if (node.IsLeaf())
+        {
+            // 外扩包围盒相交时仍需精确测试
+            if ((inside || frustum.Intersects(mTightBounds[nodeID])) && !callback(node.userData))
+            {
+                return;
+            }
+        }
+        else
+        {
+            int32_t flag = inside ? InsideFlag : 0;
+            stack.Push(node.child1 | flag);
+            stack.Push(node.child2 | flag);
+        }
+    }
+}
+template <typename TCallback>
+void DynamicBVH::RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance,
+                         TCallback &&callback) const
+{
+    if (mRoot == NullNode)
+    {
+        return;
+    }
+    const glm::vec3 inverseDirection = 1.0f / direction;
+    // slab测试，返回进入距离，不相交返回负数
+    auto intersect = [&](const AABB &aabb) {
+        float enter = 0.0f;
+        float exit = maxDistance;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            // 与slab平行时起点落在平面上会得到0*inf=NaN，单独判断起点是否在slab内
+            if (direction[axis] == 0.0f)
+            {
+                if (origin[axis] < aabb.min[axis] || origin[axis] > aabb.max[axis])
+                {
+                    return -1.0f;
+                }
+                continue;
+            }
+            float t1 = (aabb.min[axis] - origin[axis]) * inverseDirection[axis];
+            float t2 = (aabb.max[axis] - origin[axis]) * inverseDirection[axis];
+            enter = std::max(enter, std::min(t1, t2));
+            exit = std::min(exit, std::max(t1, t2));
+        }
+        return enter <= exit ? enter : -1.0f;
+    };
+    NodeStack stack;
+    stack.Push(mRoot);
+    while (!stack.Empty())
+    {
+        int32_t nodeID = stack.Pop();
+        const auto &node = mNodes[nodeID];
+        if (intersect(node.aabb) < 0.0f)
+        {
+            continue;
+        }
+        if (node.IsLeaf())
+        {
+            float distance = intersect(mTightBounds[nodeID]);
+            if (distance >= 0.0f)
+            {
+                maxDistance = callback(node.userData, distance);
+                if (maxDistance <= 0.0f)
+                {
+                    return;
+                }
+            }
+        }
+        else
+        {
+            stack.Push(node.child1);
+            stack.Push(node.child2);
+        }
+    }
+}
+} // namespace Core
+} // namespace MEngine
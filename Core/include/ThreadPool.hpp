@@ -0,0 +1,57 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace MEngine
+{
+namespace Core
+{
+/**
+ * @brief 常驻工作线程池，用于剔除、网格处理等可以按区间拆分的计算
+ */
+class ThreadPool final
+{
+  private:
+    std::vector<std::thread> mWorkers;
+    std::queue<std::function<void()>> mTasks;
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mStop = false;
+
+  public:
+    explicit ThreadPool(unsigned int threadCount = DefaultThreadCount());
+    ~ThreadPool();
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void Submit(std::function<void()> task);
+    /**
+     * @brief 将[0, count)按grainSize切块并行执行，调用线程也参与计算，返回时所有块都已完成
+     *
+     * @param count 元素总数
+     * @param grainSize 每块最少元素数，count不超过grainSize时直接在调用线程执行
+     * @param func func(begin, end)
+     */
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &func);
+    inline unsigned int GetThreadCount() const
+    {
+        return static_cast<unsigned int>(mWorkers.size());
+    }
+    /**
+     * @brief 引擎共享的线程池
+     */
+    static ThreadPool &Get();
+    static unsigned int DefaultThreadCount();
+
+  private:
+    void WorkerLoop();
+};
+} // namespace Core
+} // namespace MEngine
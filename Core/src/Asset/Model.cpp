@@ -0,0 +1,74 @@
+#include "Asset/Model.hpp"
+
+namespace MEngine
+{
+namespace Core
+{
+void ModelHierarchy::Reserve(size_t nodeCount, size_t meshCount)
+{
+    Names.reserve(nodeCount);
+    Parents.reserve(nodeCount);
+    LocalTransforms.reserve(nodeCount);
+    MeshRanges.reserve(nodeCount);
+    MeshIndices.reserve(meshCount);
+}
+void ModelHierarchy::Clear()
+{
+    Names.clear();
+    Parents.clear();
+    LocalTransforms.clear();
+    MeshRanges.clear();
+    MeshIndices.clear();
+}
+int32_t ModelHierarchy::AddNode(std::string name, int32_t parent, const glm::mat4 &localTransform,
+                                std::span<const uint32_t> meshes)
+{
+    auto index = static_cast<int32_t>(Names.size());
+    Names.push_back(std::move(name));
+    Parents.push_back(parent < index ? parent : -1);
+    LocalTransforms.push_back(localTransform);
+    MeshRanges.push_back(MeshRange{static_cast<uint32_t>(MeshIndices.size()), static_cast<uint32_t>(meshes.size())});
+    MeshIndices.insert(MeshIndices.end(), meshes.begin(), meshes.end());
+    return index;
+}
+bool ModelHierarchy::IsValid(size_t meshCount) const
+{
+    auto nodeCount = Names.size();
+    if (Parents.size() != nodeCount || LocalTransforms.size() != nodeCount || MeshRanges.size() != nodeCount)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        if (Parents[i] < -1 || Parents[i] >= static_cast<int32_t>(i))
+        {
+            return false;
+        }
+        const auto &range = MeshRanges[i];
+        if (static_cast<size_t>(range.offset) + range.count > MeshIndices.size())
+        {
+            return false;
+        }
+    }
+    for (auto mesh : MeshIndices)
+    {
+        if (mesh >= meshCount)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+std::vector<glm::mat4> ModelHierarchy::ComputeGlobalTransforms() const
+{
+    std::vector<glm::mat4> transforms(LocalTransforms.size());
+    for (size_t i = 0; i < transforms.size(); i++)
+    {
+        // 父节点下标更小，已经计算完毕
+        transforms[i] = Parents[i] < 0 ? LocalTransforms[i] : transforms[Parents[i]] * LocalTransforms[i];
+    }
+    return transforms;
+}
+Model::Model() = default;
+} // namespace Core
+} // namespace MEngine
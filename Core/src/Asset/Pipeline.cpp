@@ -0,0 +1,257 @@
+#include "Asset/Pipeline.hpp"
+#include "Logger.hpp"
+#include "Shader/ProgramCache.hpp"
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+Pipeline::SourceLoader &GetSourceLoader()
+{
+    static Pipeline::SourceLoader loader;
+    return loader;
+}
+/**
+ * @brief 读取着色器源码并在 #version 行之后插入宏定义
+ */
+std::string ReadShaderSource(const std::filesystem::path &path, const std::vector<std::string> &defines)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        LogError("Failed to open shader file: {}", path.string());
+        return {};
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    auto source = buffer.str();
+    if (defines.empty())
+    {
+        return source;
+    }
+    std::string defineBlock;
+    for (const auto &define : defines)
+    {
+        auto separator = define.find('=');
+        if (separator == std::string::npos)
+        {
+            defineBlock += "#define " + define + "\n";
+        }
+        else
+        {
+            defineBlock += "#define " + define.substr(0, separator) + " " + define.substr(separator + 1) + "\n";
+        }
+    }
+    size_t insertPos = 0;
+    if (auto versionPos = source.find("#version"); versionPos != std::string::npos)
+    {
+        auto lineEnd = source.find('\n', versionPos);
+        insertPos = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    }
+    source.insert(insertPos, defineBlock);
+    return source;
+}
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+/**
+ * @brief 只提交编译，结果在链接完成后统一检查，避免在提交阶段等待驱动
+ */
+GLuint SubmitShader(GLenum stage, const std::string &source)
+{
+    auto sourcePtr = source.c_str();
+    GLuint shader = glCreateShader(stage);
+    glShaderSource(shader, 1, &sourcePtr, nullptr);
+    glCompileShader(shader);
+    return shader;
+}
+void LogShaderError(GLuint shader, const std::filesystem::path &path)
+{
+    if (shader == 0)
+    {
+        return;
+    }
+    GLint success = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        char infoLog[1024];
+        glGetShaderInfoLog(shader, sizeof(infoLog), nullptr, infoLog);
+        LogError("Shader compile failed: {}\n{}", path.string(), infoLog);
+    }
+}
+std::string LoadShaderSource(const std::filesystem::path &path, const std::vector<std::string> &defines)
+{
+    auto &loader = GetSourceLoader();
+    return loader ? loader(path, defines) : ReadShaderSource(path, defines);
+}
+} // namespace
+Pipeline::~Pipeline()
+{
+    if (program != 0)
+    {
+        glDeleteProgram(program);
+    }
+    if (pendingProgram != 0)
+    {
+        glDeleteProgram(pendingProgram);
+    }
+}
+void Pipeline::SetSourceLoader(SourceLoader loader)
+{
+    GetSourceLoader() = std::move(loader);
+}
+bool Pipeline::SupportsParallelCompile()
+{
+    static const bool supported = []() {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+        for (GLint i = 0; i < count; i++)
+        {
+            auto name = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i));
+            if (name && (std::string_view(name) == "GL_KHR_parallel_shader_compile" ||
+                         std::string_view(name) == "GL_ARB_parallel_shader_compile"))
+            {
+                return true;
+            }
+        }
+        LogInfo("Parallel shader compile not supported, pipelines are finished one at a time");
+        return false;
+    }();
+    return supported;
+}
+bool Pipeline::Compile()
+{
+    return CompileAsync() && FinishCompile();
+}
+bool Pipeline::CompileAsync()
+{
+    if (status == PipelineCompileStatus::Compiling)
+    {
+        return true;
+    }
+    compileStart = std::chrono::high_resolution_clock::now();
+    std::vector<std::string> sources;
+    sources.push_back(LoadShaderSource(VertexShaderPath, Defines));
+    sources.push_back(LoadShaderSource(FragmentShaderPath, Defines));
+    if (!GeometryShaderPath.empty())
+    {
+        sources.push_back(LoadShaderSource(GeometryShaderPath, Defines));
+    }
+    if (sources[0].empty() || sources[1].empty() || (sources.size() > 2 && sources[2].empty()))
+    {
+        status = PipelineCompileStatus::Failed;
+        return false;
+    }
+
+    auto &cache = ProgramCache::Get();
+    cacheKey = cache.ComputeKey(sources, Defines);
+    if (GLuint cached = cache.Load(cacheKey); cached != 0)
+    {
+        if (program != 0)
+        {
+            glDeleteProgram(program);
+        }
+        program = cached;
+        status = PipelineCompileStatus::Ready;
+        auto end = std::chrono::high_resolution_clock::now();
+        LogInfo("Pipeline {} loaded from cache in {:.2f} ms", Name,
+                std::chrono::duration<float, std::milli>(end - compileStart).count());
+        return true;
+    }
+
+    vertexShader = SubmitShader(GL_VERTEX_SHADER, sources[0]);
+    fragmentShader = SubmitShader(GL_FRAGMENT_SHADER, sources[1]);
+    if (sources.size() > 2)
+    {
+        geometryShader = SubmitShader(GL_GEOMETRY_SHADER, sources[2]);
+    }
+    pendingProgram = glCreateProgram();
+    glProgramParameteri(pendingProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glAttachShader(pendingProgram, vertexShader);
+    glAttachShader(pendingProgram, fragmentShader);
+    if (geometryShader != 0)
+    {
+        glAttachShader(pendingProgram, geometryShader);
+    }
+    // 编译失败时链接同样失败，错误在 FinishCompile 中统一报告
+    glLinkProgram(pendingProgram);
+    status = PipelineCompileStatus::Compiling;
+    return true;
+}
+bool Pipeline::IsCompileComplete() const
+{
+    if (status != PipelineCompileStatus::Compiling || !SupportsParallelCompile())
+    {
+        return true;
+    }
+    GLint completed = GL_FALSE;
+    glGetProgramiv(pendingProgram, GL_COMPLETION_STATUS_KHR, &completed);
+    return completed == GL_TRUE;
+}
+bool Pipeline::FinishCompile()
+{
+    if (status != PipelineCompileStatus::Compiling)
+    {
+        return status == PipelineCompileStatus::Ready;
+    }
+    GLint success = GL_FALSE;
+    glGetProgramiv(pendingProgram, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        LogShaderError(vertexShader, VertexShaderPath);
+        LogShaderError(fragmentShader, FragmentShaderPath);
+        LogShaderError(geometryShader, GeometryShaderPath);
+        char infoLog[1024];
+        glGetProgramInfoLog(pendingProgram, sizeof(infoLog), nullptr, infoLog);
+        LogError("Program link failed: {}\n{}", Name, infoLog);
+    }
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    glDeleteShader(geometryShader);
+    vertexShader = fragmentShader = geometryShader = 0;
+    if (!success)
+    {
+        glDeleteProgram(pendingProgram);
+        pendingProgram = 0;
+        status = PipelineCompileStatus::Failed;
+    }
+    else
+    {
+        ProgramCache::Get().Store(cacheKey, pendingProgram);
+        if (program != 0)
+        {
+            glDeleteProgram(program);
+        }
+        program = pendingProgram;
+        pendingProgram = 0;
+        status = PipelineCompileStatus::Ready;
+        auto end = std::chrono::high_resolution_clock::now();
+        LogInfo("Pipeline {} compiled in {:.2f} ms", Name,
+                std::chrono::duration<float, std::milli>(end - compileStart).count());
+    }
+    // 编译期间源文件有修改，刚完成的结果已经过时，立即用新源码重新提交
+    if (recompilePending)
+    {
+        recompilePending = false;
+        CompileAsync();
+    }
+    return success == GL_TRUE;
+}
+void Pipeline::Recompile()
+{
+    if (status == PipelineCompileStatus::Compiling)
+    {
+        recompilePending = true;
+        return;
+    }
+    CompileAsync();
+}
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,207 @@
+#include "Culling/FrustumCuller.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+struct PlaneSoA
+{
+    float nx[Frustum::Count], ny[Frustum::Count], nz[Frustum::Count], d[Frustum::Count];
+    // 法线分量的绝对值，用于计算包围盒在法线上的投影半径
+    float ax[Frustum::Count], ay[Frustum::Count], az[Frustum::Count];
+};
+PlaneSoA ToSoA(const Frustum &frustum)
+{
+    PlaneSoA soa;
+    for (int i = 0; i < Frustum::Count; i++)
+    {
+        const auto &plane = frustum.planes[i];
+        soa.nx[i] = plane.x;
+        soa.ny[i] = plane.y;
+        soa.nz[i] = plane.z;
+        soa.d[i] = plane.w;
+        soa.ax[i] = std::abs(plane.x);
+        soa.ay[i] = std::abs(plane.y);
+        soa.az[i] = std::abs(plane.z);
+    }
+    return soa;
+}
+#if defined(MENGINE_SIMD_AVX2)
+/**
+ * @brief AVX2内核，一次测试8个包围盒，返回未处理部分的起始下标；只能在CpuSupportsAVX2为真时调用
+ */
+MENGINE_TARGET_AVX2 size_t CullAVX2(const PlaneSoA &planes, const float *centerX, const float *centerY,
+                                    const float *centerZ, const float *extentX, const float *extentY,
+                                    const float *extentZ, uint8_t *visibility, size_t begin, size_t end)
+{
+    size_t i = begin;
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(centerX + i);
+        __m256 cy = _mm256_loadu_ps(centerY + i);
+        __m256 cz = _mm256_loadu_ps(centerZ + i);
+        __m256 ex = _mm256_loadu_ps(extentX + i);
+        __m256 ey = _mm256_loadu_ps(extentY + i);
+        __m256 ez = _mm256_loadu_ps(extentZ + i);
+        __m256 outside = _mm256_setzero_ps();
+        for (int p = 0; p < Frustum::Count; p++)
+        {
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(cx, _mm256_set1_ps(planes.nx[p])),
+                              _mm256_mul_ps(cy, _mm256_set1_ps(planes.ny[p]))),
+                _mm256_add_ps(_mm256_mul_ps(cz, _mm256_set1_ps(planes.nz[p])), _mm256_set1_ps(planes.d[p])));
+            __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_set1_ps(planes.ax[p])),
+                                                        _mm256_mul_ps(ey, _mm256_set1_ps(planes.ay[p]))),
+                                          _mm256_mul_ps(ez, _mm256_set1_ps(planes.az[p])));
+            // distance + radius < 0 则完全在平面外侧
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(),
+                                                          _CMP_LT_OQ));
+        }
+        int mask = _mm256_movemask_ps(outside);
+        for (int lane = 0; lane < 8; lane++)
+        {
+            visibility[i + lane] = ((mask >> lane) & 1) ? 0 : 1;
+        }
+    }
+    return i;
+}
+#endif
+} // namespace
+void FrustumCuller::Clear()
+{
+    mCenterX.clear();
+    mCenterY.clear();
+    mCenterZ.clear();
+    mExtentX.clear();
+    mExtentY.clear();
+    mExtentZ.clear();
+    mVisibility.clear();
+    mVisibleCount = 0;
+}
+void FrustumCuller::Reserve(size_t count)
+{
+    mCenterX.reserve(count);
+    mCenterY.reserve(count);
+    mCenterZ.reserve(count);
+    mExtentX.reserve(count);
+    mExtentY.reserve(count);
+    mExtentZ.reserve(count);
+}
+uint32_t FrustumCuller::Add(const AABB &aabb)
+{
+    auto index = static_cast<uint32_t>(mCenterX.size());
+    glm::vec3 center(0.0f);
+    glm::vec3 extents(FLT_MAX);
+    if (aabb.IsValid())
+    {
+        center = aabb.GetCenter();
+        extents = aabb.GetExtents();
+    }
+    mCenterX.push_back(center.x);
+    mCenterY.push_back(center.y);
+    mCenterZ.push_back(center.z);
+    mExtentX.push_back(extents.x);
+    mExtentY.push_back(extents.y);
+    mExtentZ.push_back(extents.z);
+    return index;
+}
+size_t FrustumCuller::Cull(const Frustum &frustum, bool parallel)
+{
+    return Cull(frustum, GetSimdLevel(), parallel);
+}
+size_t FrustumCuller::Cull(const Frustum &frustum, SimdLevel level, bool parallel)
+{
+    // CPU不支持的路径降级到可用的最高路径
+    level = std::min(level, GetSimdLevel());
+    auto count = GetCount();
+    mVisibility.resize(count);
+    if (parallel && count > ParallelThreshold)
+    {
+        ThreadPool::Get().ParallelFor(count, ParallelThreshold,
+                                      [&](size_t begin, size_t end) { CullRange(frustum, level, begin, end); });
+    }
+    else
+    {
+        CullRange(frustum, level, 0, count);
+    }
+    mVisibleCount = std::accumulate(mVisibility.begin(), mVisibility.end(), size_t(0));
+    return mVisibleCount;
+}
+FrustumCuller::SimdLevel FrustumCuller::GetSimdLevel()
+{
+    static const SimdLevel level = [] {
+        if (CpuSupportsAVX2())
+        {
+            return SimdLevel::AVX2;
+        }
+#if defined(MENGINE_SIMD_SSE)
+        return SimdLevel::SSE;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }();
+    return level;
+}
+void FrustumCuller::CullRange(const Frustum &frustum, SimdLevel level, size_t begin, size_t end)
+{
+    const auto planes = ToSoA(frustum);
+    size_t i = begin;
+#if defined(MENGINE_SIMD_AVX2)
+    if (level == SimdLevel::AVX2)
+    {
+        i = CullAVX2(planes, mCenterX.data(), mCenterY.data(), mCenterZ.data(), mExtentX.data(), mExtentY.data(),
+                     mExtentZ.data(), mVisibility.data(), begin, end);
+    }
+#endif
+#if defined(MENGINE_SIMD_SSE)
+    if (level == SimdLevel::AVX2 || level == SimdLevel::SSE)
+    {
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128 cx = _mm_loadu_ps(mCenterX.data() + i);
+            __m128 cy = _mm_loadu_ps(mCenterY.data() + i);
+            __m128 cz = _mm_loadu_ps(mCenterZ.data() + i);
+            __m128 ex = _mm_loadu_ps(mExtentX.data() + i);
+            __m128 ey = _mm_loadu_ps(mExtentY.data() + i);
+            __m128 ez = _mm_loadu_ps(mExtentZ.data() + i);
+            __m128 outside = _mm_setzero_ps();
+            for (int p = 0; p < Frustum::Count; p++)
+            {
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(planes.nx[p])), _mm_mul_ps(cy, _mm_set1_ps(planes.ny[p]))),
+                    _mm_add_ps(_mm_mul_ps(cz, _mm_set1_ps(planes.nz[p])), _mm_set1_ps(planes.d[p])));
+                __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(ex, _mm_set1_ps(planes.ax[p])), _mm_mul_ps(ey, _mm_set1_ps(planes.ay[p]))),
+                    _mm_mul_ps(ez, _mm_set1_ps(planes.az[p])));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+            }
+            int mask = _mm_movemask_ps(outside);
+            for (int lane = 0; lane < 4; lane++)
+            {
+                mVisibility[i + lane] = ((mask >> lane) & 1) ? 0 : 1;
+            }
+        }
+    }
+#endif
+    for (; i < end; i++)
+    {
+        bool visible = true;
+        for (int p = 0; p < Frustum::Count && visible; p++)
+        {
+            float distance = mCenterX[i] * planes.nx[p] + mCenterY[i] * planes.ny[p] + mCenterZ[i] * planes.nz[p] +
+                             planes.d[p];
+            float radius = mExtentX[i] * planes.ax[p] + mExtentY[i] * planes.ay[p] + mExtentZ[i] * planes.az[p];
+            visible = distance + radius >= 0.0f;
+        }
+        mVisibility[i] = visible ? 1 : 0;
+    }
+}
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,219 @@
+#include "Culling/LightClusterGrid.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+struct LocalLight
+{
+    glm::vec3 center; // 视图空间
+    float radius;
+    uint32_t index;
+    uint32_t minTileX, maxTileX, minTileY, maxTileY;
+};
+} // namespace
+LightClusterGrid::LightClusterGrid() : LightClusterGrid(Config{})
+{
+}
+LightClusterGrid::LightClusterGrid(const Config &config) : mConfig(config)
+{
+}
+uint32_t LightClusterGrid::GetSlice(float viewDepth) const
+{
+    if (viewDepth <= mNear)
+    {
+        return 0;
+    }
+    auto scaleBias = GetSliceScaleBias();
+    float slice = std::floor(std::log(viewDepth) * scaleBias.x + scaleBias.y);
+    return static_cast<uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(mConfig.slices - 1)));
+}
+void LightClusterGrid::BuildClusterBounds(const glm::mat4 &projection)
+{
+    mProjection = projection;
+    mClusterBounds.resize(GetClusterCount());
+    auto inverseProjection = glm::inverse(projection);
+    // NDC上一点对应的视线方向，缩放到z=-1
+    auto rayDirection = [&](float ndcX, float ndcY) {
+        auto point = inverseProjection * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+        auto direction = glm::vec3(point) / point.w;
+        return direction / -direction.z;
+    };
+    for (uint32_t slice = 0; slice < mConfig.slices; slice++)
+    {
+        float sliceNear = mNear * std::pow(mFar / mNear, static_cast<float>(slice) / mConfig.slices);
+        float sliceFar = mNear * std::pow(mFar / mNear, static_cast<float>(slice + 1) / mConfig.slices);
+        for (uint32_t y = 0; y < mConfig.tilesY; y++)
+        {
+            float ndcY0 = -1.0f + 2.0f * y / mConfig.tilesY;
+            float ndcY1 = -1.0f + 2.0f * (y + 1) / mConfig.tilesY;
+            for (uint32_t x = 0; x < mConfig.tilesX; x++)
+            {
+                float ndcX0 = -1.0f + 2.0f * x / mConfig.tilesX;
+                float ndcX1 = -1.0f + 2.0f * (x + 1) / mConfig.tilesX;
+                AABB bounds;
+                for (auto direction : {rayDirection(ndcX0, ndcY0), rayDirection(ndcX1, ndcY0),
+                                       rayDirection(ndcX0, ndcY1), rayDirection(ndcX1, ndcY1)})
+                {
+                    bounds.Expand(direction * sliceNear);
+                    bounds.Expand(direction * sliceFar);
+                }
+                mClusterBounds[GetClusterIndex(x, y, slice)] = bounds;
+            }
+        }
+    }
+}
+void LightClusterGrid::Build(const std::vector<PackedLight> &lights, const glm::mat4 &view,
+                             const glm::mat4 &projection, float nearPlane, float farPlane, bool parallel)
+{
+    if (projection != mProjection || nearPlane != mNear || farPlane != mFar ||
+        mClusterBounds.size() != GetClusterCount())
+    {
+        mNear = nearPlane;
+        mFar = farPlane;
+        BuildClusterBounds(projection);
+    }
+    // 方向光在前
+    mLights.clear();
+    mLights.reserve(lights.size());
+    for (const auto &light : lights)
+    {
+        if (static_cast<PackedLightType>(light.directionType.w) == PackedLightType::Directional)
+        {
+            mLights.push_back(light);
+        }
+    }
+    mDirectionalCount = static_cast<uint32_t>(mLights.size());
+
+    // 计算每个局部光源覆盖的分块与切片范围
+    std::vector<LocalLight> localLights;
+    std::vector<std::vector<uint32_t>> sliceLights(mConfig.slices);
+    for (const auto &light : lights)
+    {
+        if (static_cast<PackedLightType>(light.directionType.w) == PackedLightType::Directional)
+        {
+            continue;
+        }
+        auto center = glm::vec3(view * glm::vec4(glm::vec3(light.positionRange), 1.0f));
+        float radius = light.positionRange.w;
+        float depth = -center.z;
+        if (depth + radius < mNear || depth - radius > mFar || radius <= 0.0f)
+        {
+            continue;
+        }
+        LocalLight local{center, radius, static_cast<uint32_t>(mLights.size()), 0, mConfig.tilesX - 1, 0,
+                         mConfig.tilesY - 1};
+        if (depth - radius > mNear)
+        {
+            // 投影包围球的视图空间AABB，得到保守的屏幕范围
+            glm::vec2 ndcMin(1.0f), ndcMax(-1.0f);
+            for (int i = 0; i < 8; i++)
+            {
+                glm::vec3 corner = center + glm::vec3(i & 1 ? radius : -radius, i & 2 ? radius : -radius,
+                                                      i & 4 ? radius : -radius);
+                auto clip = projection * glm::vec4(corner, 1.0f);
+                auto ndc = glm::vec2(clip.x, clip.y) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+            if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f)
+            {
+                continue;
+            }
+            auto toTile = [](float ndc, uint32_t tiles) {
+                float tile = std::floor((ndc * 0.5f + 0.5f) * tiles);
+                return static_cast<uint32_t>(std::clamp(tile, 0.0f, static_cast<float>(tiles - 1)));
+            };
+            local.minTileX = toTile(ndcMin.x, mConfig.tilesX);
+            local.maxTileX = toTile(ndcMax.x, mConfig.tilesX);
+            local.minTileY = toTile(ndcMin.y, mConfig.tilesY);
+            local.maxTileY = toTile(ndcMax.y, mConfig.tilesY);
+        }
+        auto localIndex = static_cast<uint32_t>(localLights.size());
+        localLights.push_back(local);
+        mLights.push_back(light);
+        for (uint32_t slice = GetSlice(depth - radius); slice <= GetSlice(depth + radius); slice++)
+        {
+            sliceLights[slice].push_back(localIndex);
+        }
+    }
+
+    // 每个切片独立生成索引列表，最后按切片顺序拼接
+    mClusters.assign(GetClusterCount(), ClusterRange{});
+    std::vector<std::vector<uint32_t>> sliceIndices(mConfig.slices);
+    uint32_t clustersPerSlice = mConfig.tilesX * mConfig.tilesY;
+    auto assignSlices = [&](size_t begin, size_t end) {
+        std::vector<std::pair<uint32_t, uint32_t>> hits; // (切片内簇序号, 光源索引)
+        for (size_t slice = begin; slice < end; slice++)
+        {
+            hits.clear();
+            auto clusterBase = static_cast<uint32_t>(slice) * clustersPerSlice;
+            // 只遍历光源屏幕范围内的分块
+            for (auto localIndex : sliceLights[slice])
+            {
+                const auto &light = localLights[localIndex];
+                for (uint32_t y = light.minTileY; y <= light.maxTileY; y++)
+                {
+                    for (uint32_t x = light.minTileX; x <= light.maxTileX; x++)
+                    {
+                        auto tile = y * mConfig.tilesX + x;
+                        const auto &bounds = mClusterBounds[clusterBase + tile];
+                        auto closest = glm::clamp(light.center, bounds.min, bounds.max);
+                        auto d = closest - light.center;
+                        if (glm::dot(d, d) <= light.radius * light.radius)
+                        {
+                            hits.emplace_back(tile, light.index);
+                        }
+                    }
+                }
+            }
+            // 计数排序，保持簇内光源顺序稳定
+            for (const auto &hit : hits)
+            {
+                mClusters[clusterBase + hit.first].count++;
+            }
+            uint32_t offset = 0;
+            for (uint32_t tile = 0; tile < clustersPerSlice; tile++)
+            {
+                auto &cluster = mClusters[clusterBase + tile];
+                cluster.offset = offset;
+                offset += cluster.count;
+            }
+            auto &indices = sliceIndices[slice];
+            indices.resize(hits.size());
+            std::vector<uint32_t> cursor(clustersPerSlice, 0);
+            for (const auto &hit : hits)
+            {
+                indices[mClusters[clusterBase + hit.first].offset + cursor[hit.first]++] = hit.second;
+            }
+        }
+    };
+    if (parallel)
+    {
+        ThreadPool::Get().ParallelFor(mConfig.slices, 1, assignSlices);
+    }
+    else
+    {
+        assignSlices(0, mConfig.slices);
+    }
+
+    mLightIndices.clear();
+    mMaxLightsPerCluster = 0;
+    for (uint32_t slice = 0; slice < mConfig.slices; slice++)
+    {
+        auto base = static_cast<uint32_t>(mLightIndices.size());
+        for (uint32_t i = 0; i < clustersPerSlice; i++)
+        {
+            auto &cluster = mClusters[slice * clustersPerSlice + i];
+            cluster.offset += base;
+            mMaxLightsPerCluster = std::max(mMaxLightsPerCluster, cluster.count);
+        }
+        mLightIndices.insert(mLightIndices.end(), sliceIndices[slice].begin(), sliceIndices[slice].end());
+    }
+}
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,52 @@
+#include "Culling/MeshletCuller.hpp"
+
+namespace MEngine
+{
+namespace Core
+{
+glm::vec4 MeshletCuller::GetModelSpaceCamera(const glm::mat4 &view, const glm::mat4 &projection,
+                                             const glm::mat4 &model)
+{
+    auto viewToModel = glm::inverse(model) * glm::inverse(view);
+    if (projection[3][3] == 1.0f)
+    {
+        // 相机看向观察空间的-Z
+        return glm::vec4(glm::vec3(viewToModel * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f)), 0.0f);
+    }
+    return glm::vec4(glm::vec3(viewToModel * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)), 1.0f);
+}
+MeshletCullStats MeshletCuller::Cull(std::span<const Meshlet> meshlets, const Frustum &frustum,
+                                     const glm::vec4 &camera, bool coneCulling, std::vector<MeshletRange> &ranges)
+{
+    MeshletCullStats stats;
+    // 上一个存活簇所在的区间，索引连续时直接延长
+    size_t open = ranges.size();
+    for (const auto &meshlet : meshlets)
+    {
+        if (!frustum.Intersects(meshlet.sphere))
+        {
+            stats.frustumCulled++;
+            continue;
+        }
+        if (coneCulling && IsBackfacing(meshlet, camera))
+        {
+            stats.backfaceCulled++;
+            continue;
+        }
+        stats.visible++;
+        stats.visibleTriangles += meshlet.triangleCount;
+        auto indexCount = meshlet.triangleCount * 3;
+        if (open < ranges.size() && ranges[open].firstIndex + ranges[open].indexCount == meshlet.firstIndex)
+        {
+            ranges[open].indexCount += indexCount;
+        }
+        else
+        {
+            open = ranges.size();
+            ranges.push_back(MeshletRange{meshlet.firstIndex, indexCount});
+        }
+    }
+    return stats;
+}
+} // namespace Core
+} // namespace MEngine
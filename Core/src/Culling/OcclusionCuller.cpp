@@ -0,0 +1,317 @@
+#include "Culling/OcclusionCuller.hpp"
+#include "Simd.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+constexpr float ClearDepth = std::numeric_limits<float>::infinity();
+// w小于该值的顶点视为在近平面后方
+constexpr float MinW = 1e-4f;
+} // namespace
+OcclusionCuller::OcclusionCuller()
+{
+    for (int level = 0; level < MipCount; level++)
+    {
+        mDepthMips[level].assign(static_cast<size_t>(Width >> level) * (Height >> level), ClearDepth);
+    }
+}
+void OcclusionCuller::BeginFrame(const glm::mat4 &viewProjection)
+{
+    mViewProjection = viewProjection;
+    mTriangles.clear();
+    for (auto &bin : mTileBins)
+    {
+        bin.clear();
+    }
+    for (auto &mip : mDepthMips)
+    {
+        std::fill(mip.begin(), mip.end(), ClearDepth);
+    }
+}
+void OcclusionCuller::AddOccluder(const uint8_t *positions, size_t stride, const uint32_t *indices,
+                                  size_t indexCount, const glm::mat4 &modelMatrix)
+{
+    auto mvp = mViewProjection * modelMatrix;
+    auto toClip = [&](uint32_t index) {
+        auto position = *reinterpret_cast<const glm::vec3 *>(positions + static_cast<size_t>(index) * stride);
+        return mvp * glm::vec4(position, 1.0f);
+    };
+    for (size_t i = 0; i + 2 < indexCount; i += 3)
+    {
+        AddTriangle(toClip(indices[i]), toClip(indices[i + 1]), toClip(indices[i + 2]));
+    }
+}
+void OcclusionCuller::AddOccluder(const AABB &aabb)
+{
+    static constexpr uint32_t BoxIndices[] = {0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1,
+                                              2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3};
+    std::array<glm::vec3, 8> corners;
+    for (int i = 0; i < 8; i++)
+    {
+        corners[i] = glm::vec3(i & 4 ? aabb.max.x : aabb.min.x, i & 2 ? aabb.max.y : aabb.min.y,
+                               i & 1 ? aabb.max.z : aabb.min.z);
+    }
+    AddOccluder(reinterpret_cast<const uint8_t *>(corners.data()), sizeof(glm::vec3), BoxIndices,
+                std::size(BoxIndices), glm::mat4(1.0f));
+}
+void OcclusionCuller::AddTriangle(const glm::vec4 &clip0, const glm::vec4 &clip1, const glm::vec4 &clip2)
+{
+    // 不做近平面裁剪，跨越近平面的三角形直接丢弃，只会减少遮挡，结果仍然保守
+    if (clip0.w < MinW || clip1.w < MinW || clip2.w < MinW)
+    {
+        return;
+    }
+    auto toScreen = [](const glm::vec4 &clip) {
+        float inverseW = 1.0f / clip.w;
+        return glm::vec3((clip.x * inverseW * 0.5f + 0.5f) * Width, (clip.y * inverseW * 0.5f + 0.5f) * Height,
+                         clip.z * inverseW);
+    };
+    auto v0 = toScreen(clip0);
+    auto v1 = toScreen(clip1);
+    auto v2 = toScreen(clip2);
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (std::abs(area) < 1e-6f)
+    {
+        return;
+    }
+    // 遮挡体不剔除背面，统一成逆时针
+    if (area < 0.0f)
+    {
+        std::swap(v1, v2);
+        area = -area;
+    }
+    int minX = std::max(0, static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x}))));
+    int minY = std::max(0, static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y}))));
+    int maxX = std::min(Width - 1, static_cast<int>(std::floor(std::max({v0.x, v1.x, v2.x}))));
+    int maxY = std::min(Height - 1, static_cast<int>(std::floor(std::max({v0.y, v1.y, v2.y}))));
+    if (minX > maxX || minY > maxY)
+    {
+        return;
+    }
+    Triangle triangle;
+    auto edge = [](const glm::vec3 &a, const glm::vec3 &b) {
+        float edgeA = -(b.y - a.y);
+        float edgeB = b.x - a.x;
+        return glm::vec3(edgeA, edgeB, -(edgeA * a.x + edgeB * a.y));
+    };
+    auto e0 = edge(v0, v1);
+    auto e1 = edge(v1, v2);
+    auto e2 = edge(v2, v0);
+    triangle.edgeA = glm::vec3(e0.x, e1.x, e2.x);
+    triangle.edgeB = glm::vec3(e0.y, e1.y, e2.y);
+    triangle.edgeC = glm::vec3(e0.z, e1.z, e2.z);
+    float dz1 = v1.z - v0.z;
+    float dz2 = v2.z - v0.z;
+    float zA = (dz1 * (v2.y - v0.y) - dz2 * (v1.y - v0.y)) / area;
+    float zB = (dz2 * (v1.x - v0.x) - dz1 * (v2.x - v0.x)) / area;
+    triangle.zPlane = glm::vec3(zA, zB, v0.z - zA * v0.x - zB * v0.y);
+    triangle.minX = minX;
+    triangle.minY = minY;
+    triangle.maxX = maxX;
+    triangle.maxY = maxY;
+
+    auto triangleIndex = static_cast<uint32_t>(mTriangles.size());
+    mTriangles.push_back(triangle);
+    for (int tileY = minY / TileSize; tileY <= maxY / TileSize; tileY++)
+    {
+        for (int tileX = minX / TileSize; tileX <= maxX / TileSize; tileX++)
+        {
+            mTileBins[tileY * TilesX + tileX].push_back(triangleIndex);
+        }
+    }
+}
+void OcclusionCuller::Rasterize(bool parallel)
+{
+    constexpr int TileCount = TilesX * TilesY;
+    if (parallel)
+    {
+        ThreadPool::Get().ParallelFor(TileCount, 1, [this](size_t begin, size_t end) {
+            for (size_t tile = begin; tile < end; tile++)
+            {
+                RasterizeTile(static_cast<int>(tile));
+            }
+        });
+    }
+    else
+    {
+        for (int tile = 0; tile < TileCount; tile++)
+        {
+            RasterizeTile(tile);
+        }
+    }
+}
+void OcclusionCuller::RasterizeTile(int tileIndex)
+{
+    int tileX = tileIndex % TilesX;
+    int tileY = tileIndex / TilesX;
+    int tileMinX = tileX * TileSize;
+    int tileMinY = tileY * TileSize;
+    auto &depth = mDepthMips[0];
+    for (auto triangleIndex : mTileBins[tileIndex])
+    {
+        const auto &triangle = mTriangles[triangleIndex];
+        // 起点对齐到4像素，分块边界也是4的倍数，不会越过分块
+        int minX = std::max(triangle.minX, tileMinX) & ~3;
+        int maxX = std::min(triangle.maxX, tileMinX + TileSize - 1);
+        int minY = std::max(triangle.minY, tileMinY);
+        int maxY = std::min(triangle.maxY, tileMinY + TileSize - 1);
+        for (int y = minY; y <= maxY; y++)
+        {
+            float py = static_cast<float>(y) + 0.5f;
+            float *row = depth.data() + static_cast<size_t>(y) * Width;
+#if defined(MENGINE_SIMD_SSE)
+            __m128 rowE0 = _mm_set1_ps(triangle.edgeB.x * py + triangle.edgeC.x);
+            __m128 rowE1 = _mm_set1_ps(triangle.edgeB.y * py + triangle.edgeC.y);
+            __m128 rowE2 = _mm_set1_ps(triangle.edgeB.z * py + triangle.edgeC.z);
+            __m128 rowZ = _mm_set1_ps(triangle.zPlane.y * py + triangle.zPlane.z);
+            __m128 a0 = _mm_set1_ps(triangle.edgeA.x);
+            __m128 a1 = _mm_set1_ps(triangle.edgeA.y);
+            __m128 a2 = _mm_set1_ps(triangle.edgeA.z);
+            __m128 zA = _mm_set1_ps(triangle.zPlane.x);
+            __m128 zero = _mm_setzero_ps();
+            for (int x = minX; x <= maxX; x += 4)
+            {
+                float fx = static_cast<float>(x);
+                __m128 px = _mm_add_ps(_mm_set1_ps(fx), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+                __m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), rowE0);
+                __m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), rowE1);
+                __m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), rowE2);
+                __m128 inside =
+                    _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+                if (_mm_movemask_ps(inside) == 0)
+                {
+                    continue;
+                }
+                __m128 z = _mm_add_ps(_mm_mul_ps(zA, px), rowZ);
+                __m128 current = _mm_loadu_ps(row + x);
+                __m128 nearest = _mm_min_ps(current, z);
+                // 三角形外的像素保持原值
+                __m128 result = _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current));
+                _mm_storeu_ps(row + x, result);
+            }
+#else
+            for (int x = minX; x <= maxX; x++)
+            {
+                float px = static_cast<float>(x) + 0.5f;
+                float e0 = triangle.edgeA.x * px + triangle.edgeB.x * py + triangle.edgeC.x;
+                float e1 = triangle.edgeA.y * px + triangle.edgeB.y * py + triangle.edgeC.y;
+                float e2 = triangle.edgeA.z * px + triangle.edgeB.z * py + triangle.edgeC.z;
+                if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f)
+                {
+                    float z = triangle.zPlane.x * px + triangle.zPlane.y * py + triangle.zPlane.z;
+                    row[x] = std::min(row[x], z);
+                }
+            }
+#endif
+        }
+    }
+    BuildTileMips(tileX, tileY);
+}
+void OcclusionCuller::BuildTileMips(int tileX, int tileY)
+{
+    // 每级取2x2中最远的深度，分块内独立完成，不需要等待其他分块
+    for (int level = 1; level < MipCount; level++)
+    {
+        int size = TileSize >> level;
+        int width = Width >> level;
+        int parentWidth = Width >> (level - 1);
+        const auto &parent = mDepthMips[level - 1];
+        auto &mip = mDepthMips[level];
+        for (int y = tileY * size; y < (tileY + 1) * size; y++)
+        {
+            for (int x = tileX * size; x < (tileX + 1) * size; x++)
+            {
+                size_t parentIndex = static_cast<size_t>(y * 2) * parentWidth + x * 2;
+                mip[static_cast<size_t>(y) * width + x] =
+                    std::max({parent[parentIndex], parent[parentIndex + 1], parent[parentIndex + parentWidth],
+                              parent[parentIndex + parentWidth + 1]});
+            }
+        }
+    }
+}
+bool OcclusionCuller::IsVisible(const AABB &aabb) const
+{
+    if (!aabb.IsValid())
+    {
+        return true;
+    }
+    float minX = std::numeric_limits<float>::max(), minY = minX, minZ = minX;
+    float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+    for (int i = 0; i < 8; i++)
+    {
+        glm::vec4 corner(i & 4 ? aabb.max.x : aabb.min.x, i & 2 ? aabb.max.y : aabb.min.y,
+                         i & 1 ? aabb.max.z : aabb.min.z, 1.0f);
+        auto clip = mViewProjection * corner;
+        if (clip.w < MinW)
+        {
+            return true;
+        }
+        float inverseW = 1.0f / clip.w;
+        float x = (clip.x * inverseW * 0.5f + 0.5f) * Width;
+        float y = (clip.y * inverseW * 0.5f + 0.5f) * Height;
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, clip.z * inverseW);
+    }
+    int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    int x1 = std::min(Width - 1, static_cast<int>(std::floor(maxX)));
+    int y1 = std::min(Height - 1, static_cast<int>(std::floor(maxY)));
+    if (x0 > x1 || y0 > y1)
+    {
+        // 屏幕外交给视锥剔除处理
+        return true;
+    }
+    // 选择矩形覆盖不超过4x4像素的层级
+    int level = 0;
+    while (level < MipCount - 1 && ((x1 >> level) - (x0 >> level) >= 4 || (y1 >> level) - (y0 >> level) >= 4))
+    {
+        level++;
+    }
+    const auto &mip = mDepthMips[level];
+    int width = Width >> level;
+    for (int y = y0 >> level; y <= (y1 >> level); y++)
+    {
+        for (int x = x0 >> level; x <= (x1 >> level); x++)
+        {
+            if (minZ < mip[static_cast<size_t>(y) * width + x])
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+size_t OcclusionCuller::Cull(const std::vector<AABB> &bounds, std::vector<uint8_t> &visibility, bool parallel) const
+{
+    visibility.resize(bounds.size(), 1);
+    auto cullRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            if (visibility[i] && !IsVisible(bounds[i]))
+            {
+                visibility[i] = 0;
+            }
+        }
+    };
+    if (parallel)
+    {
+        ThreadPool::Get().ParallelFor(bounds.size(), 1024, cullRange);
+    }
+    else
+    {
+        cullRange(0, bounds.size());
+    }
+    return static_cast<size_t>(std::count(visibility.begin(), visibility.end(), 1));
+}
+} // namespace Core
+} // namespace MEngine
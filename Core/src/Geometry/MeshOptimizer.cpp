@@ -0,0 +1,374 @@
+#include "Geometry/MeshOptimizer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <numeric>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+/**
+ * @brief 用时间戳模拟FIFO缓存，顶点在最近cacheSize次未命中内进入过缓存即命中
+ */
+class CacheSimulator
+{
+  private:
+    std::vector<uint32_t> mTimestamps;
+    uint32_t mTime;
+    uint32_t mCacheSize;
+
+  public:
+    CacheSimulator(size_t vertexCount, uint32_t cacheSize)
+        : mTimestamps(vertexCount, 0), mTime(cacheSize + 1), mCacheSize(cacheSize)
+    {
+    }
+    bool Access(uint32_t vertex)
+    {
+        if (mTime - mTimestamps[vertex] > mCacheSize)
+        {
+            mTimestamps[vertex] = mTime++;
+            return false;
+        }
+        return true;
+    }
+    uint32_t AccessTriangle(const uint32_t *triangle)
+    {
+        return !Access(triangle[0]) + !Access(triangle[1]) + !Access(triangle[2]);
+    }
+    /**
+     * @brief 清空缓存
+     */
+    void Reset()
+    {
+        mTime += mCacheSize + 1;
+    }
+};
+} // namespace
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t> &indices, size_t vertexCount,
+                                                   uint32_t cacheSize)
+{
+    VertexCacheStats stats;
+    if (indices.size() < 3)
+    {
+        return stats;
+    }
+    CacheSimulator cache(vertexCount, cacheSize);
+    std::vector<uint8_t> used(vertexCount, 0);
+    size_t usedCount = 0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        stats.misses += cache.AccessTriangle(&indices[i]);
+        for (int k = 0; k < 3; k++)
+        {
+            usedCount += !used[indices[i + k]];
+            used[indices[i + k]] = 1;
+        }
+    }
+    stats.acmr = static_cast<float>(stats.misses) / static_cast<float>(indices.size() / 3);
+    stats.atvr = static_cast<float>(stats.misses) / static_cast<float>(usedCount);
+    return stats;
+}
+size_t MeshOptimizer::GenerateVertexRemap(std::vector<uint32_t> &remap, const uint8_t *vertices, size_t stride,
+                                          size_t vertexCount)
+{
+    remap.assign(vertexCount, ~0u);
+    // 开放寻址哈希表，存放每个唯一顶点第一次出现的位置
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2)
+    {
+        tableSize <<= 1;
+    }
+    std::vector<uint32_t> table(tableSize, ~0u);
+    auto hash = [&](uint32_t vertex) {
+        // FNV-1a
+        const uint8_t *bytes = vertices + vertex * stride;
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < stride; i++)
+        {
+            h = (h ^ bytes[i]) * 16777619u;
+        }
+        return h;
+    };
+    size_t uniqueCount = 0;
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        size_t slot = hash(i) & (tableSize - 1);
+        while (table[slot] != ~0u && std::memcmp(vertices + table[slot] * stride, vertices + i * stride, stride) != 0)
+        {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] == ~0u)
+        {
+            table[slot] = i;
+            remap[i] = static_cast<uint32_t>(uniqueCount++);
+        }
+        else
+        {
+            remap[i] = remap[table[slot]];
+        }
+    }
+    return uniqueCount;
+}
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t> &indices, size_t vertexCount, uint32_t cacheSize)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0)
+    {
+        return;
+    }
+    // 顶点到三角形的邻接表（CSR）
+    std::vector<uint32_t> liveCount(vertexCount, 0);
+    for (auto index : indices)
+    {
+        liveCount[index]++;
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        offsets[v + 1] = offsets[v] + liveCount[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (uint32_t t = 0; t < triangleCount; t++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            adjacency[fill[indices[t * 3 + k]]++] = t;
+        }
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    uint32_t time = cacheSize + 1;
+    uint32_t cursor = 0;
+    int64_t fanning = indices[0];
+    while (fanning >= 0)
+    {
+        candidates.clear();
+        auto vertex = static_cast<uint32_t>(fanning);
+        for (uint32_t a = offsets[vertex]; a < offsets[vertex + 1]; a++)
+        {
+            uint32_t t = adjacency[a];
+            if (emitted[t])
+            {
+                continue;
+            }
+            emitted[t] = 1;
+            for (int k = 0; k < 3; k++)
+            {
+                uint32_t v = indices[t * 3 + k];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                liveCount[v]--;
+                if (time - cacheTime[v] > cacheSize)
+                {
+                    cacheTime[v] = time++;
+                }
+            }
+        }
+        // 优先选择仍在缓存中、且发出剩余三角形后不会被挤出缓存的顶点
+        fanning = -1;
+        int64_t bestPriority = -1;
+        for (auto v : candidates)
+        {
+            if (liveCount[v] == 0)
+            {
+                continue;
+            }
+            int64_t priority = 0;
+            if (time - cacheTime[v] + 2 * liveCount[v] <= cacheSize)
+            {
+                priority = time - cacheTime[v];
+            }
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                fanning = v;
+            }
+        }
+        if (fanning >= 0)
+        {
+            continue;
+        }
+        // 死胡同：先回溯最近发出的顶点，再按输入顺序找下一个还有三角形的顶点
+        while (!deadEnd.empty())
+        {
+            uint32_t v = deadEnd.back();
+            deadEnd.pop_back();
+            if (liveCount[v] > 0)
+            {
+                fanning = v;
+                break;
+            }
+        }
+        while (fanning < 0 && cursor < vertexCount)
+        {
+            if (liveCount[cursor] > 0)
+            {
+                fanning = cursor;
+            }
+            cursor++;
+        }
+    }
+    indices = std::move(result);
+}
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t> &indices, const uint8_t *positions, size_t stride,
+                                     size_t vertexCount, float threshold, uint32_t cacheSize)
+{
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+    // 三个顶点都未命中的三角形是缓存重启点，在这里切分不会增加未命中
+    std::vector<uint32_t> hardBoundaries;
+    std::vector<uint32_t> triangleMisses(triangleCount);
+    CacheSimulator cache(vertexCount, cacheSize);
+    for (uint32_t t = 0; t < triangleCount; t++)
+    {
+        triangleMisses[t] = cache.AccessTriangle(&indices[t * 3]);
+        if (t == 0 || triangleMisses[t] == 3)
+        {
+            hardBoundaries.push_back(t);
+        }
+    }
+    hardBoundaries.push_back(static_cast<uint32_t>(triangleCount));
+
+    // 在硬簇内部，若从冷缓存开始的子簇ACMR不超过硬簇的threshold倍，继续切分
+    std::vector<uint32_t> clusters;
+    CacheSimulator localCache(vertexCount, cacheSize);
+    for (size_t c = 0; c + 1 < hardBoundaries.size(); c++)
+    {
+        uint32_t begin = hardBoundaries[c], end = hardBoundaries[c + 1];
+        uint32_t clusterMisses = 0;
+        for (uint32_t t = begin; t < end; t++)
+        {
+            clusterMisses += triangleMisses[t];
+        }
+        float maxAcmr = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+        clusters.push_back(begin);
+        localCache.Reset();
+        uint32_t start = begin;
+        uint32_t misses = 0;
+        for (uint32_t t = begin; t + 1 < end; t++)
+        {
+            misses += localCache.AccessTriangle(&indices[t * 3]);
+            if (static_cast<float>(misses) <= maxAcmr * static_cast<float>(t + 1 - start))
+            {
+                clusters.push_back(t + 1);
+                localCache.Reset();
+                start = t + 1;
+                misses = 0;
+            }
+        }
+    }
+    clusters.push_back(static_cast<uint32_t>(triangleCount));
+
+    // 簇的面积加权中心和法线，中心在网格中心外侧、法线朝外的簇更可能在前面，先画
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+    std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    auto position = [&](uint32_t index) {
+        glm::vec3 p;
+        std::memcpy(&p, positions + index * stride, sizeof(glm::vec3));
+        return p;
+    };
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        float clusterArea = 0.0f;
+        for (uint32_t t = clusters[c]; t < clusters[c + 1]; t++)
+        {
+            auto a = position(indices[t * 3]), b = position(indices[t * 3 + 1]), c2 = position(indices[t * 3 + 2]);
+            auto normal = glm::cross(b - a, c2 - a);
+            float area = glm::length(normal);
+            centroids[c] += (a + b + c2) * (area / 3.0f);
+            normals[c] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += centroids[c];
+        meshArea += clusterArea;
+        centroids[c] = clusterArea > 0.0f ? centroids[c] / clusterArea : position(indices[clusters[c] * 3]);
+    }
+    if (meshArea > 0.0f)
+    {
+        meshCentroid /= meshArea;
+    }
+    std::vector<float> sortKeys(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++)
+    {
+        float length = glm::length(normals[c]);
+        sortKeys[c] = length > 0.0f ? glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+    }
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    std::vector<uint32_t> result;
+    result.reserve(indices.size());
+    for (auto c : order)
+    {
+        result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    }
+    indices = std::move(result);
+}
+size_t MeshOptimizer::GenerateFetchRemap(std::vector<uint32_t> &remap, const std::vector<uint32_t> &indices,
+                                         size_t vertexCount)
+{
+    remap.assign(vertexCount, ~0u);
+    uint32_t next = 0;
+    for (auto index : indices)
+    {
+        if (remap[index] == ~0u)
+        {
+            remap[index] = next++;
+        }
+    }
+    return next;
+}
+std::vector<size_t> MeshOptimizer::SplitByVertexLimit(const std::vector<uint32_t> &indices, size_t vertexCount,
+                                                      size_t maxVertices)
+{
+    std::vector<size_t> offsets{0};
+    // 顶点所属段的编号+1，切换段时无需清空
+    std::vector<uint32_t> partOf(vertexCount, 0);
+    uint32_t part = 1;
+    size_t used = 0;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        size_t added = 0;
+        for (size_t k = 0; k < 3; k++)
+        {
+            auto index = indices[i + k];
+            bool repeated = (k > 0 && index == indices[i]) || (k > 1 && index == indices[i + 1]);
+            added += partOf[index] != part && !repeated ? 1 : 0;
+        }
+        if (used + added > maxVertices && i > offsets.back())
+        {
+            offsets.push_back(i);
+            part++;
+            used = 0;
+        }
+        for (size_t k = 0; k < 3; k++)
+        {
+            if (partOf[indices[i + k]] != part)
+            {
+                partOf[indices[i + k]] = part;
+                used++;
+            }
+        }
+    }
+    offsets.push_back(indices.size());
+    return offsets;
+}
+} // namespace Core
+} // namespace MEngine
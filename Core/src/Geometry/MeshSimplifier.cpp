@@ -0,0 +1,399 @@
+#include "Geometry/MeshSimplifier.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+#include <queue>
+#include <unordered_map>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+/**
+ * @brief 对称4x4矩阵，Q(p) = p^T A p + 2 b^T p + c 为点到累加平面的平方距离之和
+ */
+struct Quadric
+{
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+
+    void AddPlane(double nx, double ny, double nz, double d)
+    {
+        a00 += nx * nx;
+        a01 += nx * ny;
+        a02 += nx * nz;
+        a11 += ny * ny;
+        a12 += ny * nz;
+        a22 += nz * nz;
+        b0 += nx * d;
+        b1 += ny * d;
+        b2 += nz * d;
+        c += d * d;
+    }
+    Quadric &operator+=(const Quadric &other)
+    {
+        a00 += other.a00;
+        a01 += other.a01;
+        a02 += other.a02;
+        a11 += other.a11;
+        a12 += other.a12;
+        a22 += other.a22;
+        b0 += other.b0;
+        b1 += other.b1;
+        b2 += other.b2;
+        c += other.c;
+        return *this;
+    }
+    double Evaluate(const glm::vec3 &p) const
+    {
+        double x = p.x, y = p.y, z = p.z;
+        double result = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                        2.0 * (b0 * x + b1 * y + b2 * z) + c;
+        // 浮点误差可能得到极小的负数
+        return std::max(result, 0.0);
+    }
+};
+struct Collapse
+{
+    double cost;
+    uint32_t from;
+    uint32_t to;
+    uint32_t fromVersion;
+    uint32_t toVersion;
+
+    bool operator>(const Collapse &other) const
+    {
+        return cost > other.cost;
+    }
+};
+struct PositionHash
+{
+    size_t operator()(const glm::vec3 &p) const
+    {
+        uint32_t bits[3];
+        std::memcpy(bits, &p, sizeof(bits));
+        return (bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u);
+    }
+};
+
+class Simplifier
+{
+  private:
+    std::vector<glm::vec3> mPositions;
+    // 同一位置的顶点映射到同一个代表顶点，拓扑判断都在代表顶点上进行
+    std::vector<uint32_t> mRemap;
+    std::vector<uint8_t> mLocked;
+    std::vector<uint8_t> mRemoved;
+    std::vector<uint32_t> mVersions;
+    std::vector<Quadric> mQuadrics;
+    std::vector<uint32_t> mTriangles;
+    std::vector<uint8_t> mTriangleAlive;
+    // 顶点所在的三角形，折叠后可能残留已删除的三角形，遍历时跳过
+    std::vector<std::vector<uint32_t>> mVertexTriangles;
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> mQueue;
+    size_t mAliveTriangles = 0;
+    std::vector<uint32_t> mNeighborsA;
+    std::vector<uint32_t> mNeighborsB;
+
+  public:
+    Simplifier(const uint8_t *positions, size_t stride, size_t vertexCount, const uint32_t *indices,
+               size_t indexCount)
+    {
+        mPositions.resize(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            std::memcpy(&mPositions[i], positions + i * stride, sizeof(glm::vec3));
+        }
+        std::vector<uint8_t> referenced(vertexCount, 0);
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            if (indices[i] < vertexCount)
+            {
+                referenced[indices[i]] = 1;
+            }
+        }
+        // 只在被引用的顶点之间合并位置，未使用的重复顶点不应导致锁定
+        mRemap.resize(vertexCount);
+        std::vector<uint32_t> wedgeCounts(vertexCount, 0);
+        std::unordered_map<glm::vec3, uint32_t, PositionHash> positionMap;
+        positionMap.reserve(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; i++)
+        {
+            mRemap[i] = referenced[i] ? positionMap.try_emplace(mPositions[i], i).first->second : i;
+            wedgeCounts[mRemap[i]] += referenced[i];
+        }
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            uint32_t a = indices[i], b = indices[i + 1], c = indices[i + 2];
+            if (a >= vertexCount || b >= vertexCount || c >= vertexCount)
+            {
+                continue;
+            }
+            // 退化三角形直接丢弃
+            if (mRemap[a] == mRemap[b] || mRemap[b] == mRemap[c] || mRemap[a] == mRemap[c])
+            {
+                continue;
+            }
+            mTriangles.insert(mTriangles.end(), {a, b, c});
+        }
+        size_t triangleCount = mTriangles.size() / 3;
+        mAliveTriangles = triangleCount;
+        mTriangleAlive.assign(triangleCount, 1);
+        mLocked.assign(vertexCount, 0);
+        mRemoved.assign(vertexCount, 0);
+        mVersions.assign(vertexCount, 0);
+        mQuadrics.resize(vertexCount);
+        mVertexTriangles.resize(vertexCount);
+
+        std::unordered_map<uint64_t, uint32_t> edgeCounts;
+        edgeCounts.reserve(mTriangles.size());
+        for (uint32_t t = 0; t < triangleCount; t++)
+        {
+            const uint32_t *triangle = &mTriangles[t * 3];
+            for (int k = 0; k < 3; k++)
+            {
+                mVertexTriangles[triangle[k]].push_back(t);
+                uint64_t a = mRemap[triangle[k]], b = mRemap[triangle[(k + 1) % 3]];
+                edgeCounts[std::min(a, b) << 32 | std::max(a, b)]++;
+            }
+            auto &p0 = mPositions[triangle[0]];
+            auto normal = glm::cross(mPositions[triangle[1]] - p0, mPositions[triangle[2]] - p0);
+            float length = glm::length(normal);
+            if (length <= 0.0f)
+            {
+                continue;
+            }
+            normal /= length;
+            Quadric quadric;
+            quadric.AddPlane(normal.x, normal.y, normal.z, -static_cast<double>(glm::dot(normal, p0)));
+            for (int k = 0; k < 3; k++)
+            {
+                mQuadrics[triangle[k]] += quadric;
+            }
+        }
+        // 同一位置有多个顶点的接缝，以及边界和非流形边上的顶点不参与折叠；
+        // 接缝处的所有顶点都已锁定，边界只需锁定代表顶点
+        for (uint32_t i = 0; i < vertexCount; i++)
+        {
+            mLocked[i] = wedgeCounts[mRemap[i]] > 1 ? 1 : 0;
+        }
+        for (auto &[key, count] : edgeCounts)
+        {
+            if (count != 2)
+            {
+                mLocked[key >> 32] = 1;
+                mLocked[key & 0xffffffffu] = 1;
+            }
+        }
+        for (uint32_t t = 0; t < triangleCount; t++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                PushCollapse(mTriangles[t * 3 + k], mTriangles[t * 3 + (k + 1) % 3]);
+                PushCollapse(mTriangles[t * 3 + (k + 1) % 3], mTriangles[t * 3 + k]);
+            }
+        }
+    }
+    std::vector<uint32_t> Run(size_t targetIndexCount, float maxError, float *resultError)
+    {
+        double maxCost = static_cast<double>(maxError) * static_cast<double>(maxError);
+        double error = 0.0;
+        while (mAliveTriangles * 3 > targetIndexCount && !mQueue.empty())
+        {
+            auto collapse = mQueue.top();
+            if (collapse.cost > maxCost)
+            {
+                break;
+            }
+            mQueue.pop();
+            if (mRemoved[collapse.from] || mRemoved[collapse.to] || mVersions[collapse.from] != collapse.fromVersion ||
+                mVersions[collapse.to] != collapse.toVersion || !CanCollapse(collapse.from, collapse.to))
+            {
+                continue;
+            }
+            ApplyCollapse(collapse.from, collapse.to);
+            error = std::max(error, collapse.cost);
+        }
+        if (resultError)
+        {
+            *resultError = static_cast<float>(std::sqrt(error));
+        }
+        std::vector<uint32_t> result;
+        result.reserve(mAliveTriangles * 3);
+        for (size_t t = 0; t < mTriangleAlive.size(); t++)
+        {
+            if (mTriangleAlive[t])
+            {
+                result.insert(result.end(), mTriangles.begin() + t * 3, mTriangles.begin() + t * 3 + 3);
+            }
+        }
+        return result;
+    }
+
+  private:
+    void PushCollapse(uint32_t from, uint32_t to)
+    {
+        if (mLocked[from])
+        {
+            return;
+        }
+        auto quadric = mQuadrics[from];
+        quadric += mQuadrics[to];
+        mQueue.push(Collapse{
+            .cost = quadric.Evaluate(mPositions[to]),
+            .from = from,
+            .to = to,
+            .fromVersion = mVersions[from],
+            .toVersion = mVersions[to],
+        });
+    }
+    void CollectNeighbors(uint32_t vertex, std::vector<uint32_t> &neighbors) const
+    {
+        neighbors.clear();
+        for (auto t : mVertexTriangles[vertex])
+        {
+            if (!mTriangleAlive[t])
+            {
+                continue;
+            }
+            for (int k = 0; k < 3; k++)
+            {
+                auto other = mRemap[mTriangles[t * 3 + k]];
+                if (other != mRemap[vertex])
+                {
+                    neighbors.push_back(other);
+                }
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    }
+    bool CanCollapse(uint32_t from, uint32_t to)
+    {
+        // 两端共享的邻居必须恰好是共边两个三角形的对顶点，否则折叠会产生非流形
+        uint32_t sharedTriangles = 0;
+        for (auto t : mVertexTriangles[from])
+        {
+            if (mTriangleAlive[t] && HasVertex(t, mRemap[to]))
+            {
+                sharedTriangles++;
+            }
+        }
+        if (sharedTriangles != 2)
+        {
+            return false;
+        }
+        CollectNeighbors(from, mNeighborsA);
+        CollectNeighbors(to, mNeighborsB);
+        size_t common = 0;
+        for (size_t i = 0, j = 0; i < mNeighborsA.size() && j < mNeighborsB.size();)
+        {
+            if (mNeighborsA[i] == mNeighborsB[j])
+            {
+                common++;
+                i++;
+                j++;
+            }
+            else if (mNeighborsA[i] < mNeighborsB[j])
+            {
+                i++;
+            }
+            else
+            {
+                j++;
+            }
+        }
+        if (common != 2)
+        {
+            return false;
+        }
+        const auto &target = mPositions[to];
+        for (auto t : mVertexTriangles[from])
+        {
+            if (!mTriangleAlive[t] || HasVertex(t, mRemap[to]))
+            {
+                continue;
+            }
+            const uint32_t *triangle = &mTriangles[t * 3];
+            glm::vec3 before[3], after[3];
+            for (int k = 0; k < 3; k++)
+            {
+                before[k] = mPositions[triangle[k]];
+                after[k] = triangle[k] == from ? target : before[k];
+            }
+            auto normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+            auto normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+            // 翻面或退化为零面积
+            if (glm::dot(normalBefore, normalAfter) <= 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool HasVertex(uint32_t triangle, uint32_t representative) const
+    {
+        return mRemap[mTriangles[triangle * 3]] == representative ||
+               mRemap[mTriangles[triangle * 3 + 1]] == representative ||
+               mRemap[mTriangles[triangle * 3 + 2]] == representative;
+    }
+    void ApplyCollapse(uint32_t from, uint32_t to)
+    {
+        for (auto t : mVertexTriangles[from])
+        {
+            if (!mTriangleAlive[t])
+            {
+                continue;
+            }
+            if (HasVertex(t, mRemap[to]))
+            {
+                mTriangleAlive[t] = 0;
+                mAliveTriangles--;
+                continue;
+            }
+            for (int k = 0; k < 3; k++)
+            {
+                if (mTriangles[t * 3 + k] == from)
+                {
+                    mTriangles[t * 3 + k] = to;
+                }
+            }
+            mVertexTriangles[to].push_back(t);
+        }
+        mVertexTriangles[from].clear();
+        mRemoved[from] = 1;
+        mQuadrics[to] += mQuadrics[from];
+        // to的误差矩阵变化，与它相连的边都要重新计算代价，旧条目通过版本号失效
+        mVersions[to]++;
+        auto &triangles = mVertexTriangles[to];
+        triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
+                                       [this](uint32_t t) { return !mTriangleAlive[t]; }),
+                        triangles.end());
+        for (auto t : triangles)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                auto other = mTriangles[t * 3 + k];
+                if (other != to)
+                {
+                    PushCollapse(to, other);
+                    PushCollapse(other, to);
+                }
+            }
+        }
+    }
+};
+} // namespace
+std::vector<uint32_t> MeshSimplifier::Simplify(const uint8_t *positions, size_t stride, size_t vertexCount,
+                                               const uint32_t *indices, size_t indexCount, size_t targetIndexCount,
+                                               float maxError, float *resultError)
+{
+    Simplifier simplifier(positions, stride, vertexCount, indices, indexCount);
+    return simplifier.Run(targetIndexCount, maxError, resultError);
+}
+} // namespace Core
+} // namespace MEngine
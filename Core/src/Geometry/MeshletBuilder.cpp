@@ -0,0 +1,199 @@
+#include "Geometry/MeshletBuilder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/glm.hpp>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+struct Point
+{
+    glm::vec3 position;
+};
+// 圆锥半角超过约84度时几乎不可能整体背向相机，不值得测试
+constexpr float MinConeDot = 0.1f;
+} // namespace
+std::vector<Meshlet> MeshletBuilder::Build(std::vector<uint32_t> &indices, const uint8_t *positions, size_t stride,
+                                           size_t vertexCount, uint32_t maxVertices, uint32_t maxTriangles)
+{
+    std::vector<Meshlet> meshlets;
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || maxVertices < 3 || maxTriangles == 0)
+    {
+        return meshlets;
+    }
+    // 顶点到三角形的邻接表（CSR）
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++)
+    {
+        adjacencyOffsets[indices[i] + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++)
+    {
+        adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+    }
+    std::vector<uint32_t> adjacency(adjacencyOffsets.back());
+    {
+        auto fill = adjacencyOffsets;
+        for (size_t i = 0; i < triangleCount * 3; i++)
+        {
+            adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    // 顶点所在簇的编号+1，开始新簇时无需清空
+    std::vector<uint32_t> vertexMeshlet(vertexCount, 0);
+    std::vector<uint32_t> meshletVertices;
+    std::vector<uint32_t> meshletTriangles;
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    size_t nextSeed = 0;
+    uint32_t meshletID = 0;
+
+    auto newVertexCount = [&](uint32_t triangle) {
+        uint32_t count = 0;
+        for (size_t k = 0; k < 3; k++)
+        {
+            auto index = indices[triangle * 3 + k];
+            bool repeated = (k > 0 && index == indices[triangle * 3]) || (k > 1 && index == indices[triangle * 3 + 1]);
+            count += vertexMeshlet[index] != meshletID && !repeated ? 1 : 0;
+        }
+        return count;
+    };
+    auto addTriangle = [&](uint32_t triangle) {
+        emitted[triangle] = 1;
+        meshletTriangles.push_back(triangle);
+        for (size_t k = 0; k < 3; k++)
+        {
+            auto index = indices[triangle * 3 + k];
+            if (vertexMeshlet[index] != meshletID)
+            {
+                vertexMeshlet[index] = meshletID;
+                meshletVertices.push_back(index);
+            }
+        }
+    };
+    auto finishMeshlet = [&]() {
+        Meshlet meshlet;
+        meshlet.firstIndex = static_cast<uint32_t>(result.size());
+        meshlet.triangleCount = static_cast<uint32_t>(meshletTriangles.size());
+        meshlet.vertexCount = static_cast<uint32_t>(meshletVertices.size());
+        for (auto triangle : meshletTriangles)
+        {
+            result.insert(result.end(), indices.begin() + triangle * 3, indices.begin() + triangle * 3 + 3);
+        }
+        meshlets.push_back(meshlet);
+        meshletTriangles.clear();
+        meshletVertices.clear();
+    };
+
+    while (true)
+    {
+        if (meshletTriangles.empty())
+        {
+            // 按原顺序取下一个未分配的三角形作为种子，保留缓存优化后的局部性
+            while (nextSeed < triangleCount && emitted[nextSeed])
+            {
+                nextSeed++;
+            }
+            if (nextSeed == triangleCount)
+            {
+                break;
+            }
+            meshletID++;
+            addTriangle(static_cast<uint32_t>(nextSeed));
+            continue;
+        }
+        // 在与簇共享顶点的三角形中选新增顶点最少的，相同时取原顺序靠前的
+        uint32_t best = ~0u;
+        uint32_t bestCost = 4;
+        for (auto vertex : meshletVertices)
+        {
+            for (uint32_t a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; a++)
+            {
+                auto triangle = adjacency[a];
+                if (emitted[triangle])
+                {
+                    continue;
+                }
+                auto cost = newVertexCount(triangle);
+                if (cost < bestCost || (cost == bestCost && triangle < best))
+                {
+                    best = triangle;
+                    bestCost = cost;
+                }
+            }
+        }
+        if (best == ~0u || meshletVertices.size() + bestCost > maxVertices ||
+            meshletTriangles.size() + 1 > maxTriangles)
+        {
+            finishMeshlet();
+            continue;
+        }
+        addTriangle(best);
+    }
+    if (!meshletTriangles.empty())
+    {
+        finishMeshlet();
+    }
+    indices = std::move(result);
+    for (auto &meshlet : meshlets)
+    {
+        ComputeBounds(meshlet, indices, positions, stride);
+    }
+    return meshlets;
+}
+void MeshletBuilder::ComputeBounds(Meshlet &meshlet, const std::vector<uint32_t> &indices, const uint8_t *positions,
+                                   size_t stride)
+{
+    auto position = [&](uint32_t index) {
+        glm::vec3 result;
+        std::memcpy(&result, positions + index * stride, sizeof(result));
+        return result;
+    };
+    std::vector<Point> points;
+    points.reserve(meshlet.triangleCount * 3);
+    std::vector<glm::vec3> normals;
+    normals.reserve(meshlet.triangleCount);
+    glm::vec3 axis(0.0f);
+    for (uint32_t t = 0; t < meshlet.triangleCount; t++)
+    {
+        auto base = meshlet.firstIndex + t * 3;
+        auto a = position(indices[base]), b = position(indices[base + 1]), c = position(indices[base + 2]);
+        points.insert(points.end(), {{a}, {b}, {c}});
+        auto normal = glm::cross(b - a, c - a);
+        float length = glm::length(normal);
+        // 退化三角形不可见，不影响圆锥
+        if (length > 0.0f)
+        {
+            normals.push_back(normal / length);
+            axis += normal / length;
+        }
+    }
+    meshlet.sphere = ComputeBoundingSphere(points);
+    meshlet.coneAxis = glm::vec3(0.0f, 0.0f, 1.0f);
+    meshlet.coneCutoff = 1.0f;
+    float axisLength = glm::length(axis);
+    if (normals.empty() || axisLength <= 0.0f)
+    {
+        return;
+    }
+    axis /= axisLength;
+    float minDot = 1.0f;
+    for (const auto &normal : normals)
+    {
+        minDot = std::min(minDot, glm::dot(axis, normal));
+    }
+    meshlet.coneAxis = axis;
+    if (minDot >= MinConeDot)
+    {
+        meshlet.coneCutoff = std::sqrt(std::max(0.0f, 1.0f - minDot * minDot));
+    }
+}
+} // namespace Core
+} // namespace MEngine
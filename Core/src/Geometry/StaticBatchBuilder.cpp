@@ -0,0 +1,81 @@
+#include "Geometry/StaticBatchBuilder.hpp"
+#include "Geometry/VertexQuantization.hpp"
+#include <utility>
+
+namespace MEngine
+{
+namespace Core
+{
+glm::ivec3 StaticBatchBuilder::GetCell(const glm::vec3 &position, float cellSize)
+{
+    return glm::ivec3(glm::floor(position / cellSize));
+}
+std::vector<Mesh> StaticBatchBuilder::Merge(std::span<const StaticBatchSource> sources, float maxPositionError,
+                                            size_t maxVertices)
+{
+    std::vector<Mesh> meshes;
+    bool allCompact = true;
+    auto finish = [&](Mesh &mesh) {
+        mesh.RecalculateBounds();
+        mesh.ChooseIndexFormat();
+        mesh.Format = allCompact ? ChooseVertexFormat(mesh, maxPositionError) : VertexFormat::Standard;
+    };
+    Mesh current;
+    for (const auto &source : sources)
+    {
+        if (!source.mesh || source.mesh->Indices.empty())
+        {
+            continue;
+        }
+        if (!current.Vertices.empty() && current.Vertices.size() + source.mesh->Vertices.size() > maxVertices)
+        {
+            finish(current);
+            meshes.push_back(std::move(current));
+            current = Mesh();
+            allCompact = true;
+        }
+        allCompact = allCompact && source.mesh->Format == VertexFormat::Compact;
+        Append(current, *source.mesh, source.modelMatrix);
+    }
+    if (!current.Vertices.empty())
+    {
+        finish(current);
+        meshes.push_back(std::move(current));
+    }
+    return meshes;
+}
+void StaticBatchBuilder::Append(Mesh &target, const Mesh &source, const glm::mat4 &modelMatrix)
+{
+    auto linear = glm::mat3(modelMatrix);
+    auto normalMatrix = glm::transpose(glm::inverse(linear));
+    auto safeNormalize = [](const glm::vec3 &v) {
+        float length = glm::length(v);
+        return length > 0.0f ? v / length : v;
+    };
+    auto baseVertex = static_cast<uint32_t>(target.Vertices.size());
+    target.Vertices.reserve(target.Vertices.size() + source.Vertices.size());
+    for (const auto &vertex : source.Vertices)
+    {
+        Vertex world = vertex;
+        world.position = glm::vec3(modelMatrix * glm::vec4(vertex.position, 1.0f));
+        world.normal = safeNormalize(normalMatrix * vertex.normal);
+        world.tangent = safeNormalize(linear * vertex.tangent);
+        world.bitangent = safeNormalize(linear * vertex.bitangent);
+        target.Vertices.push_back(world);
+    }
+    // 行列式为负时变换是镜像，三角形绕序随之反转
+    bool mirrored = glm::determinant(linear) < 0.0f;
+    target.Indices.reserve(target.Indices.size() + source.Indices.size());
+    for (size_t i = 0; i + 2 < source.Indices.size(); i += 3)
+    {
+        auto a = source.Indices[i] + baseVertex, b = source.Indices[i + 1] + baseVertex,
+             c = source.Indices[i + 2] + baseVertex;
+        if (mirrored)
+        {
+            std::swap(b, c);
+        }
+        target.Indices.insert(target.Indices.end(), {a, b, c});
+    }
+}
+} // namespace Core
+} // namespace MEngine
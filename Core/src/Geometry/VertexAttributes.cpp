@@ -0,0 +1,78 @@
+#include "Geometry/VertexAttributes.hpp"
+#include <cmath>
+#include <glm/glm.hpp>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+glm::vec3 AnyOrthogonal(const glm::vec3 &normal)
+{
+    auto axis = std::abs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    return glm::normalize(glm::cross(axis, normal));
+}
+} // namespace
+void ComputeNormals(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
+{
+    std::vector<glm::vec3> normals(vertices.size(), glm::vec3(0.0f));
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        auto a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        // 叉积长度是面积的两倍，直接累加即为面积加权
+        auto normal = glm::cross(vertices[b].position - vertices[a].position,
+                                 vertices[c].position - vertices[a].position);
+        normals[a] += normal;
+        normals[b] += normal;
+        normals[c] += normal;
+    }
+    for (size_t v = 0; v < vertices.size(); v++)
+    {
+        float length = glm::length(normals[v]);
+        vertices[v].normal = length > 0.0f ? normals[v] / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+}
+void ComputeTangents(std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices)
+{
+    std::vector<glm::vec3> tangents(vertices.size(), glm::vec3(0.0f));
+    std::vector<glm::vec3> bitangents(vertices.size(), glm::vec3(0.0f));
+    for (size_t i = 0; i + 2 < indices.size(); i += 3)
+    {
+        auto a = indices[i], b = indices[i + 1], c = indices[i + 2];
+        auto edge1 = vertices[b].position - vertices[a].position;
+        auto edge2 = vertices[c].position - vertices[a].position;
+        auto uv1 = vertices[b].texCoord - vertices[a].texCoord;
+        auto uv2 = vertices[c].texCoord - vertices[a].texCoord;
+        float determinant = uv1.x * uv2.y - uv2.x * uv1.y;
+        if (std::abs(determinant) < 1e-12f)
+        {
+            continue;
+        }
+        // 不除以行列式的绝对值，较大的三角形权重更高
+        float sign = determinant > 0.0f ? 1.0f : -1.0f;
+        auto tangent = (edge1 * uv2.y - edge2 * uv1.y) * sign;
+        auto bitangent = (edge2 * uv1.x - edge1 * uv2.x) * sign;
+        for (auto index : {a, b, c})
+        {
+            tangents[index] += tangent;
+            bitangents[index] += bitangent;
+        }
+    }
+    for (size_t v = 0; v < vertices.size(); v++)
+    {
+        auto &vertex = vertices[v];
+        auto tangent = tangents[v] - vertex.normal * glm::dot(vertex.normal, tangents[v]);
+        float length = glm::length(tangent);
+        tangent = length > 1e-12f ? tangent / length : AnyOrthogonal(vertex.normal);
+        auto bitangent = glm::cross(vertex.normal, tangent);
+        if (glm::dot(bitangent, bitangents[v]) < 0.0f)
+        {
+            bitangent = -bitangent;
+        }
+        vertex.tangent = tangent;
+        vertex.bitangent = bitangent;
+    }
+}
+} // namespace Core
+} // namespace MEngine
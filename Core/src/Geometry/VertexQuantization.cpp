@@ -0,0 +1,199 @@
+#include "Geometry/VertexQuantization.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+uint16_t QuantizeUnorm16(float value)
+{
+    return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+}
+int8_t QuantizeSnorm8(float value)
+{
+    return static_cast<int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+float SignNotZero(float value)
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+} // namespace
+PositionQuantization ComputePositionQuantization(const AABB &bounds)
+{
+    if (!bounds.IsValid())
+    {
+        return PositionQuantization{};
+    }
+    auto size = bounds.max - bounds.min;
+    float scale = std::max({size.x, size.y, size.z});
+    return PositionQuantization{bounds.min, scale > 0.0f ? scale : 1.0f};
+}
+glm::vec2 EncodeOctahedral(const glm::vec3 &normal)
+{
+    float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (sum <= 0.0f)
+    {
+        return glm::vec2(0.5f, 0.5f);
+    }
+    auto n = normal / sum;
+    glm::vec2 e(n.x, n.y);
+    if (n.z < 0.0f)
+    {
+        e = glm::vec2((1.0f - std::abs(n.y)) * SignNotZero(n.x), (1.0f - std::abs(n.x)) * SignNotZero(n.y));
+    }
+    return e * 0.5f + glm::vec2(0.5f);
+}
+glm::vec3 DecodeOctahedral(const glm::vec2 &encoded)
+{
+    auto e = encoded * 2.0f - glm::vec2(1.0f);
+    glm::vec3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+    float t = std::clamp(-n.z, 0.0f, 1.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return glm::normalize(n);
+}
+uint16_t FloatToHalf(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t mantissa = bits & 0x7fffffu;
+    int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xffu) - 127 + 15;
+    if (((bits >> 23) & 0xffu) == 0xffu)
+    {
+        // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+    }
+    if (exponent >= 31)
+    {
+        return static_cast<uint16_t>(sign | 0x7c00u);
+    }
+    if (exponent <= 0)
+    {
+        // 非规格化数，太小则为0
+        if (exponent < -10)
+        {
+            return static_cast<uint16_t>(sign);
+        }
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        // 舍入到最近，平局取偶
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1u);
+        if (remainder > halfway || (remainder == halfway && (half & 1u)))
+        {
+            half++;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1fffu;
+    // 进位可能溢出到指数，结果仍然正确（最大时变为Inf）
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u)))
+    {
+        half++;
+    }
+    return static_cast<uint16_t>(half);
+}
+float HalfToFloat(uint16_t value)
+{
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1fu;
+    uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        if (mantissa == 0)
+        {
+            bits = sign;
+        }
+        else
+        {
+            // 非规格化数，规格化后存为单精度
+            exponent = 127 - 15 + 1;
+            while (!(mantissa & 0x400u))
+            {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+        }
+    }
+    else if (exponent == 31)
+    {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    }
+    else
+    {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+CompactVertex EncodeCompactVertex(const Vertex &vertex, const PositionQuantization &quantization)
+{
+    CompactVertex result{};
+    auto position = (vertex.position - quantization.offset) / quantization.scale;
+    result.position[0] = QuantizeUnorm16(position.x);
+    result.position[1] = QuantizeUnorm16(position.y);
+    result.position[2] = QuantizeUnorm16(position.z);
+    auto normal = EncodeOctahedral(vertex.normal);
+    result.normal[0] = QuantizeUnorm16(normal.x);
+    result.normal[1] = QuantizeUnorm16(normal.y);
+    float tangentLength = glm::length(vertex.tangent);
+    auto tangent = tangentLength > 0.0f ? vertex.tangent / tangentLength : glm::vec3(0.0f);
+    result.tangent[0] = QuantizeSnorm8(tangent.x);
+    result.tangent[1] = QuantizeSnorm8(tangent.y);
+    result.tangent[2] = QuantizeSnorm8(tangent.z);
+    // 镜像UV时副切线与 cross(N, T) 反向
+    result.tangent[3] = glm::dot(glm::cross(vertex.normal, vertex.tangent), vertex.bitangent) < 0.0f ? -127 : 127;
+    result.texCoord[0] = FloatToHalf(vertex.texCoord.x);
+    result.texCoord[1] = FloatToHalf(vertex.texCoord.y);
+    return result;
+}
+Vertex DecodeCompactVertex(const CompactVertex &vertex, const PositionQuantization &quantization)
+{
+    Vertex result{};
+    result.position = quantization.offset +
+                      glm::vec3(vertex.position[0], vertex.position[1], vertex.position[2]) *
+                          (quantization.scale / 65535.0f);
+    result.normal = DecodeOctahedral(glm::vec2(vertex.normal[0], vertex.normal[1]) / 65535.0f);
+    result.tangent = glm::vec3(vertex.tangent[0], vertex.tangent[1], vertex.tangent[2]) / 127.0f;
+    float sign = vertex.tangent[3] < 0 ? -1.0f : 1.0f;
+    result.bitangent = glm::cross(result.normal, result.tangent) * sign;
+    result.texCoord = glm::vec2(HalfToFloat(vertex.texCoord[0]), HalfToFloat(vertex.texCoord[1]));
+    return result;
+}
+std::vector<CompactVertex> EncodeCompactVertices(const std::vector<Vertex> &vertices,
+                                                 const PositionQuantization &quantization)
+{
+    std::vector<CompactVertex> result(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        result[i] = EncodeCompactVertex(vertices[i], quantization);
+    }
+    return result;
+}
+VertexFormat ChooseVertexFormat(const Mesh &mesh, float maxPositionError)
+{
+    if (ComputePositionQuantization(mesh.Bounds).GetStep() * 0.5f > maxPositionError)
+    {
+        return VertexFormat::Standard;
+    }
+    for (const auto &vertex : mesh.Vertices)
+    {
+        if (std::abs(vertex.texCoord.x) > MaxCompactTexCoord || std::abs(vertex.texCoord.y) > MaxCompactTexCoord)
+        {
+            return VertexFormat::Standard;
+        }
+    }
+    return VertexFormat::Compact;
+}
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,192 @@
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <utility>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+size_t GetPageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+} // namespace
+MappedFile::MappedFile(const std::filesystem::path &path)
+{
+    Open(path);
+}
+MappedFile::~MappedFile()
+{
+    Close();
+}
+MappedFile::MappedFile(MappedFile &&other) noexcept
+{
+    *this = std::move(other);
+}
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+        mOpen = std::exchange(other.mOpen, false);
+#ifdef _WIN32
+        mFile = std::exchange(other.mFile, nullptr);
+        mMapping = std::exchange(other.mMapping, nullptr);
+#endif
+    }
+    return *this;
+}
+bool MappedFile::Open(const std::filesystem::path &path)
+{
+    Close();
+#ifdef _WIN32
+    auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    mFile = file;
+    mSize = static_cast<size_t>(size.QuadPart);
+    mOpen = true;
+    // 大小为0的文件不能创建映射
+    if (mSize == 0)
+    {
+        return true;
+    }
+    mMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mMapping)
+    {
+        Close();
+        return false;
+    }
+    mData = static_cast<const uint8_t *>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+    if (!mData)
+    {
+        Close();
+        return false;
+    }
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    mSize = static_cast<size_t>(info.st_size);
+    mOpen = true;
+    if (mSize > 0)
+    {
+        void *data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            ::close(fd);
+            mSize = 0;
+            mOpen = false;
+            return false;
+        }
+        mData = static_cast<const uint8_t *>(data);
+    }
+    // 映射建立后不再需要文件描述符
+    ::close(fd);
+#endif
+    return true;
+}
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+    }
+    if (mMapping)
+    {
+        CloseHandle(mMapping);
+    }
+    if (mFile)
+    {
+        CloseHandle(mFile);
+    }
+    mMapping = nullptr;
+    mFile = nullptr;
+#else
+    if (mData)
+    {
+        munmap(const_cast<uint8_t *>(mData), mSize);
+    }
+#endif
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+}
+void MappedFile::AdviseSequential() const
+{
+#ifndef _WIN32
+    if (mData)
+    {
+        madvise(const_cast<uint8_t *>(mData), mSize, MADV_SEQUENTIAL);
+    }
+#endif
+}
+void MappedFile::Discard(size_t offset, size_t size) const
+{
+    if (!mData || offset >= mSize)
+    {
+        return;
+    }
+    // 起始地址需要页对齐，只归还完整落在范围内的页
+    auto pageSize = GetPageSize();
+    size = std::min(size, mSize - offset);
+    auto begin = reinterpret_cast<uintptr_t>(mData + offset);
+    auto end = reinterpret_cast<uintptr_t>(mData + offset + size);
+    auto alignedBegin = (begin + pageSize - 1) / pageSize * pageSize;
+    auto alignedEnd = end / pageSize * pageSize;
+    if (offset + size == mSize)
+    {
+        alignedEnd = end;
+    }
+    if (alignedEnd <= alignedBegin)
+    {
+        return;
+    }
+#ifdef _WIN32
+    // 对未锁定的页调用VirtualUnlock会把它们移出工作集；映射只读，页可以直接丢弃
+    VirtualUnlock(reinterpret_cast<void *>(alignedBegin), alignedEnd - alignedBegin);
+#else
+    madvise(reinterpret_cast<void *>(alignedBegin), alignedEnd - alignedBegin, MADV_DONTNEED);
+#endif
+}
+} // namespace Core
+} // namespace MEngine
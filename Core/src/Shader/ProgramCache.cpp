@@ -0,0 +1,223 @@
+#include "Shader/ProgramCache.hpp"
+#include "Logger.hpp"
+#include <chrono>
+#include <fstream>
+
+namespace MEngine
+{
+namespace Core
+{
+namespace
+{
+constexpr uint32_t CacheMagic = 0x4350424D; // "MBPC"
+constexpr uint32_t CacheVersion = 1;
+struct CacheHeader
+{
+    uint32_t magic = CacheMagic;
+    uint32_t version = CacheVersion;
+    uint64_t key = 0;
+    uint32_t format = 0;
+    uint32_t length = 0;
+};
+constexpr uint64_t FNVOffset = 14695981039346656037ull;
+constexpr uint64_t FNVPrime = 1099511628211ull;
+void HashBytes(uint64_t &hash, const void *data, size_t size)
+{
+    auto bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= FNVPrime;
+    }
+}
+void HashString(uint64_t &hash, const std::string &value)
+{
+    HashBytes(hash, value.data(), value.size());
+    // 分隔符，避免 "ab"+"c" 与 "a"+"bc" 相同
+    uint8_t separator = 0xFF;
+    HashBytes(hash, &separator, 1);
+}
+} // namespace
+ProgramCache &ProgramCache::Get()
+{
+    static ProgramCache cache;
+    return cache;
+}
+void ProgramCache::SetDirectory(const std::filesystem::path &directory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error)
+    {
+        LogError("Failed to create program cache directory {}: {}", directory.string(), error.message());
+        return;
+    }
+    mDirectory = directory;
+}
+bool ProgramCache::IsEnabled()
+{
+    if (mSupported < 0)
+    {
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        mSupported = formats > 0 ? 1 : 0;
+        if (!mSupported)
+        {
+            LogWarn("Driver does not support program binaries, program cache disabled");
+        }
+    }
+    return mSupported == 1 && !mDirectory.empty();
+}
+const std::string &ProgramCache::GetDriver()
+{
+    if (mDriver.empty())
+    {
+        auto getString = [](GLenum name) {
+            auto value = reinterpret_cast<const char *>(glGetString(name));
+            return value ? std::string(value) : std::string();
+        };
+        mDriver = getString(GL_VENDOR) + "|" + getString(GL_RENDERER) + "|" + getString(GL_VERSION);
+    }
+    return mDriver;
+}
+uint64_t ProgramCache::Hash(const std::vector<std::string> &sources, const std::vector<std::string> &defines,
+                            const std::string &driver)
+{
+    uint64_t hash = FNVOffset;
+    HashBytes(hash, &CacheVersion, sizeof(CacheVersion));
+    for (const auto &source : sources)
+    {
+        HashString(hash, source);
+    }
+    for (const auto &define : defines)
+    {
+        HashString(hash, define);
+    }
+    HashString(hash, driver);
+    return hash;
+}
+uint64_t ProgramCache::ComputeKey(const std::vector<std::string> &sources, const std::vector<std::string> &defines)
+{
+    return Hash(sources, defines, GetDriver());
+}
+std::filesystem::path ProgramCache::GetCachePath(uint64_t key) const
+{
+    return mDirectory / fmt::format("{:016x}.bin", key);
+}
+GLuint ProgramCache::Load(uint64_t key)
+{
+    if (!IsEnabled())
+    {
+        return 0;
+    }
+    auto path = GetCachePath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        mStats.misses++;
+        return 0;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    CacheHeader header;
+    file.read(reinterpret_cast<char *>(&header), sizeof(header));
+    std::vector<char> binary;
+    // 长度字段来自磁盘，与文件大小不符时视为损坏，避免按错误长度分配
+    std::error_code sizeError;
+    auto fileSize = std::filesystem::file_size(path, sizeError);
+    if (file && header.magic == CacheMagic && header.version == CacheVersion && header.key == key && !sizeError &&
+        fileSize >= sizeof(header) && header.length == fileSize - sizeof(header))
+    {
+        binary.resize(header.length);
+        file.read(binary.data(), header.length);
+    }
+    file.close();
+    GLuint program = 0;
+    if (!binary.empty() && file)
+    {
+        program = glCreateProgram();
+        glProgramBinary(program, header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+        GLint success = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &success);
+        if (!success)
+        {
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+    if (program == 0)
+    {
+        // 二进制与当前驱动不兼容或文件损坏
+        LogWarn("Discard invalid program binary: {}", path.string());
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        mStats.misses++;
+        return 0;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    mStats.hits++;
+    mStats.loadTimeMs += std::chrono::duration<float, std::milli>(end - start).count();
+    return program;
+}
+void ProgramCache::Store(uint64_t key, GLuint program)
+{
+    if (!IsEnabled())
+    {
+        return;
+    }
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+    {
+        return;
+    }
+    std::vector<char> binary(static_cast<size_t>(length));
+    CacheHeader header;
+    header.key = key;
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &format, binary.data());
+    if (written <= 0)
+    {
+        return;
+    }
+    header.format = format;
+    header.length = static_cast<uint32_t>(written);
+    // 先写临时文件再重命名，避免中途退出留下半个文件
+    auto path = GetCachePath(key);
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            LogError("Failed to write program cache: {}", tempPath.string());
+            return;
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(binary.data(), written);
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        LogError("Failed to write program cache {}: {}", path.string(), error.message());
+        return;
+    }
+    mStats.stores++;
+}
+void ProgramCache::Clear()
+{
+    if (mDirectory.empty() || !std::filesystem::exists(mDirectory))
+    {
+        return;
+    }
+    for (auto &entry : std::filesystem::directory_iterator(mDirectory))
+    {
+        if (entry.path().extension() == ".bin")
+        {
+            std::filesystem::remove(entry.path());
+        }
+    }
+}
+} // namespace Core
+} // namespace MEngine
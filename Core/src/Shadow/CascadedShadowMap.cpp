@@ -0,0 +1,127 @@
+#include "Shadow/CascadedShadowMap.hpp"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace MEngine
+{
+namespace Core
+{
+CascadedShadowMap::CascadedShadowMap() : CascadedShadowMap(Config{})
+{
+}
+CascadedShadowMap::CascadedShadowMap(const Config &config)
+{
+    SetConfig(config);
+}
+void CascadedShadowMap::SetConfig(const Config &config)
+{
+    mConfig = config;
+    mConfig.cascadeCount = std::clamp(config.cascadeCount, 1u, MaxCascades);
+    // 两侧边距至少留一半分辨率给级联本身
+    mConfig.snapTexels = std::clamp(config.snapTexels, 1u, std::max(config.resolution / 4, 1u));
+    mCascadeCount = 0;
+    InvalidateStatic();
+}
+void CascadedShadowMap::ComputeSplits(float nearPlane, float farPlane, uint32_t count, float lambda, float *splits)
+{
+    for (uint32_t i = 1; i <= count; i++)
+    {
+        float fraction = static_cast<float>(i) / static_cast<float>(count);
+        float logarithmic = nearPlane * std::pow(farPlane / nearPlane, fraction);
+        float uniform = nearPlane + (farPlane - nearPlane) * fraction;
+        splits[i - 1] = lambda * logarithmic + (1.0f - lambda) * uniform;
+    }
+}
+void CascadedShadowMap::Update(const glm::mat4 &view, const glm::mat4 &projection, float nearPlane, float farPlane,
+                               const glm::vec3 &lightDirection)
+{
+    mCascadeCount = mConfig.cascadeCount;
+    float shadowFar = std::min(farPlane, mConfig.shadowDistance);
+    std::array<float, MaxCascades> splits{};
+    ComputeSplits(nearPlane, shadowFar, mCascadeCount, mConfig.splitLambda, splits.data());
+
+    // 近平面四角在视图空间中的射线，按 -z 归一化后乘以距离即得到该距离处的角点
+    auto inverseProjection = glm::inverse(projection);
+    auto inverseView = glm::inverse(view);
+    std::array<glm::vec3, 4> rays;
+    const glm::vec2 ndcCorners[4] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+    for (int i = 0; i < 4; i++)
+    {
+        auto corner = inverseProjection * glm::vec4(ndcCorners[i].x, ndcCorners[i].y, -1.0f, 1.0f);
+        auto point = glm::vec3(corner) / corner.w;
+        rays[i] = point / -point.z;
+    }
+
+    // 光源空间只取旋转，原点固定，保证取整网格在世界空间中不动
+    auto direction = glm::normalize(lightDirection);
+    auto up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    auto lightView = glm::lookAt(glm::vec3(0.0f), direction, up);
+    float resolution = static_cast<float>(mConfig.resolution);
+    float snapTexels = static_cast<float>(mConfig.snapTexels);
+
+    float sliceNear = nearPlane;
+    for (uint32_t cascade = 0; cascade < mCascadeCount; cascade++)
+    {
+        float sliceFar = splits[cascade];
+        std::array<glm::vec3, 8> corners;
+        glm::vec3 center(0.0f);
+        for (int i = 0; i < 4; i++)
+        {
+            corners[i] = glm::vec3(inverseView * glm::vec4(rays[i] * sliceNear, 1.0f));
+            corners[i + 4] = glm::vec3(inverseView * glm::vec4(rays[i] * sliceFar, 1.0f));
+        }
+        for (auto &corner : corners)
+        {
+            center += corner;
+        }
+        center /= 8.0f;
+        float radius = 0.0f;
+        for (auto &corner : corners)
+        {
+            radius = std::max(radius, glm::length(corner - center));
+        }
+        // 量化半径，避免浮点误差让投影尺寸逐帧抖动
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        float texelSize = 2.0f * radius / (resolution - 2.0f * snapTexels);
+        float step = texelSize * snapTexels;
+        float halfExtent = 0.5f * resolution * texelSize;
+        auto lightCenter = glm::vec3(lightView * glm::vec4(center, 1.0f));
+        float x = std::floor(lightCenter.x / step) * step;
+        float y = std::floor(lightCenter.y / step) * step;
+        float depth = std::floor(-lightCenter.z / step) * step;
+        auto lightProjection = glm::ortho(x - halfExtent, x + halfExtent, y - halfExtent, y + halfExtent,
+                                          depth - halfExtent - mConfig.casterDistance, depth + halfExtent);
+
+        auto &result = mCascades[cascade];
+        result.viewProjection = lightProjection * lightView;
+        result.splitDistance = sliceFar;
+        result.texelSize = texelSize;
+        sliceNear = sliceFar;
+    }
+}
+bool CascadedShadowMap::NeedsStaticUpdate(uint32_t cascade) const
+{
+    return !mStaticValid[cascade] || mStaticMatrices[cascade] != mCascades[cascade].viewProjection;
+}
+void CascadedShadowMap::MarkStaticUpdated(uint32_t cascade)
+{
+    mStaticMatrices[cascade] = mCascades[cascade].viewProjection;
+    mStaticValid[cascade] = true;
+}
+void CascadedShadowMap::InvalidateStatic()
+{
+    mStaticValid.fill(false);
+}
+glm::vec4 CascadedShadowMap::GetSplitDistances() const
+{
+    glm::vec4 splits(0.0f);
+    for (uint32_t i = 0; i < mCascadeCount; i++)
+    {
+        splits[i] = mCascades[i].splitDistance;
+    }
+    return splits;
+}
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,402 @@
+#include "Spatial/DynamicBVH.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace MEngine
+{
+namespace Core
+{
+DynamicBVH::DynamicBVH(float margin) : mMargin(margin)
+{
+}
+int32_t DynamicBVH::AllocateNode()
+{
+    if (mFreeList == NullNode)
+    {
+        // 节点池扩容，新节点串成空闲链表
+        auto oldCapacity = static_cast<int32_t>(mNodes.size());
+        auto newCapacity = std::max<int32_t>(16, oldCapacity * 2);
+        mNodes.resize(newCapacity);
+        mTightBounds.resize(newCapacity);
+        for (int32_t i = oldCapacity; i < newCapacity; i++)
+        {
+            mNodes[i].parent = i + 1 < newCapacity ? i + 1 : NullNode;
+            mNodes[i].height = -1;
+        }
+        mFreeList = oldCapacity;
+    }
+    int32_t nodeID = mFreeList;
+    mFreeList = mNodes[nodeID].parent;
+    mNodes[nodeID] = Node{};
+    return nodeID;
+}
+void DynamicBVH::FreeNode(int32_t nodeID)
+{
+    mNodes[nodeID].parent = mFreeList;
+    mNodes[nodeID].height = -1;
+    mFreeList = nodeID;
+}
+int32_t DynamicBVH::CreateProxy(const AABB &aabb, uint32_t userData)
+{
+    int32_t proxyID = AllocateNode();
+    auto &node = mNodes[proxyID];
+    node.aabb = AABB{aabb.min - glm::vec3(mMargin), aabb.max + glm::vec3(mMargin)};
+    node.userData = userData;
+    node.height = 0;
+    mTightBounds[proxyID] = aabb;
+    InsertLeaf(proxyID);
+    mProxyCount++;
+    return proxyID;
+}
+void DynamicBVH::DestroyProxy(int32_t proxyID)
+{
+    RemoveLeaf(proxyID);
+    FreeNode(proxyID);
+    mProxyCount--;
+}
+bool DynamicBVH::MoveProxy(int32_t proxyID, const AABB &aabb)
+{
+    mTightBounds[proxyID] = aabb;
+    AABB fatAABB{aabb.min - glm::vec3(mMargin), aabb.max + glm::vec3(mMargin)};
+    const auto &treeAABB = mNodes[proxyID].aabb;
+    if (treeAABB.Contains(aabb))
+    {
+        // 外扩包围盒明显大于需要时（物体缩小）也重新插入，避免查询退化
+        AABB hugeAABB{fatAABB.min - glm::vec3(4.0f * mMargin), fatAABB.max + glm::vec3(4.0f * mMargin)};
+        if (hugeAABB.Contains(treeAABB))
+        {
+            return false;
+        }
+    }
+    RemoveLeaf(proxyID);
+    mNodes[proxyID].aabb = fatAABB;
+    InsertLeaf(proxyID);
+    return true;
+}
+void DynamicBVH::Clear()
+{
+    mNodes.clear();
+    mTightBounds.clear();
+    mRoot = NullNode;
+    mFreeList = NullNode;
+    mProxyCount = 0;
+}
+int32_t DynamicBVH::FindBestSibling(const AABB &aabb)
+{
+    // SAH代价 = 新父节点面积 + 祖先因包含新叶子而增加的面积
+    // 沿代价下界较小的子节点贪心下降，下界不优于当前最优时停止
+    float leafArea = aabb.GetSurfaceArea();
+    int32_t bestSibling = mRoot;
+    float bestCost = AABB::Union(mNodes[mRoot].aabb, aabb).GetSurfaceArea();
+    float inheritedCost = 0.0f;
+    int32_t index = mRoot;
+    while (!mNodes[index].IsLeaf())
+    {
+        const auto &node = mNodes[index];
+        float directCost = AABB::Union(node.aabb, aabb).GetSurfaceArea();
+        float cost = directCost + inheritedCost;
+        if (cost < bestCost)
+        {
+            bestCost = cost;
+            bestSibling = index;
+        }
+        inheritedCost += directCost - node.aabb.GetSurfaceArea();
+
+        auto lowerCost = [&](int32_t childID) {
+            const auto &child = mNodes[childID];
+            float directChildCost = AABB::Union(child.aabb, aabb).GetSurfaceArea();
+            if (child.IsLeaf())
+            {
+                return directChildCost + inheritedCost;
+            }
+            // 子树内部任意位置的代价下界
+            return leafArea + directChildCost - child.aabb.GetSurfaceArea() + inheritedCost;
+        };
+        float lowerCost1 = lowerCost(node.child1);
+        float lowerCost2 = lowerCost(node.child2);
+        if (lowerCost1 >= bestCost && lowerCost2 >= bestCost)
+        {
+            return bestSibling;
+        }
+        index = lowerCost1 <= lowerCost2 ? node.child1 : node.child2;
+    }
+    float cost = AABB::Union(mNodes[index].aabb, aabb).GetSurfaceArea() + inheritedCost;
+    if (cost < bestCost)
+    {
+        bestSibling = index;
+    }
+    return bestSibling;
+}
+void DynamicBVH::InsertLeaf(int32_t leaf)
+{
+    if (mRoot == NullNode)
+    {
+        mRoot = leaf;
+        mNodes[leaf].parent = NullNode;
+        return;
+    }
+    auto leafAABB = mNodes[leaf].aabb;
+    int32_t sibling = FindBestSibling(leafAABB);
+
+    int32_t oldParent = mNodes[sibling].parent;
+    int32_t newParent = AllocateNode();
+    auto &parentNode = mNodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.aabb = AABB::Union(leafAABB, mNodes[sibling].aabb);
+    parentNode.height = mNodes[sibling].height + 1;
+    parentNode.child1 = sibling;
+    parentNode.child2 = leaf;
+    if (oldParent != NullNode)
+    {
+        auto &oldParentNode = mNodes[oldParent];
+        (oldParentNode.child1 == sibling ? oldParentNode.child1 : oldParentNode.child2) = newParent;
+    }
+    else
+    {
+        mRoot = newParent;
+    }
+    mNodes[sibling].parent = newParent;
+    mNodes[leaf].parent = newParent;
+
+    // 回溯更新包围盒并旋转
+    for (int32_t index = newParent; index != NullNode; index = mNodes[index].parent)
+    {
+        Refit(index);
+        Rotate(index);
+    }
+}
+void DynamicBVH::RemoveLeaf(int32_t leaf)
+{
+    if (leaf == mRoot)
+    {
+        mRoot = NullNode;
+        return;
+    }
+    int32_t parent = mNodes[leaf].parent;
+    int32_t grandParent = mNodes[parent].parent;
+    int32_t sibling = mNodes[parent].child1 == leaf ? mNodes[parent].child2 : mNodes[parent].child1;
+    if (grandParent != NullNode)
+    {
+        auto &grandParentNode = mNodes[grandParent];
+        (grandParentNode.child1 == parent ? grandParentNode.child1 : grandParentNode.child2) = sibling;
+        mNodes[sibling].parent = grandParent;
+        FreeNode(parent);
+        for (int32_t index = grandParent; index != NullNode; index = mNodes[index].parent)
+        {
+            Refit(index);
+            Rotate(index);
+        }
+    }
+    else
+    {
+        mRoot = sibling;
+        mNodes[sibling].parent = NullNode;
+        FreeNode(parent);
+    }
+}
+void DynamicBVH::Refit(int32_t nodeID)
+{
+    auto &node = mNodes[nodeID];
+    const auto &child1 = mNodes[node.child1];
+    const auto &child2 = mNodes[node.child2];
+    node.aabb = AABB::Union(child1.aabb, child2.aabb);
+    node.height = 1 + std::max(child1.height, child2.height);
+}
+void DynamicBVH::Rotate(int32_t nodeID)
+{
+    //       A
+    //     /   \
+    //    B     C
+    //   / \   / \
+    //  D   E F   G
+    // 尝试把B与F/G交换，或把C与D/E交换，选择面积减少最多的一种
+    auto &nodeA = mNodes[nodeID];
+    if (nodeA.height < 2)
+    {
+        return;
+    }
+    int32_t b = nodeA.child1;
+    int32_t c = nodeA.child2;
+    const auto &nodeB = mNodes[b];
+    const auto &nodeC = mNodes[c];
+
+    enum class Rotation
+    {
+        None,
+        BF,
+        BG,
+        CD,
+        CE
+    };
+    Rotation bestRotation = Rotation::None;
+    float bestDelta = 0.0f;
+    if (!nodeC.IsLeaf())
+    {
+        float areaC = nodeC.aabb.GetSurfaceArea();
+        const auto &f = mNodes[nodeC.child1].aabb;
+        const auto &g = mNodes[nodeC.child2].aabb;
+        // B与F交换后C = B ∪ G
+        float deltaBF = AABB::Union(nodeB.aabb, g).GetSurfaceArea() - areaC;
+        float deltaBG = AABB::Union(nodeB.aabb, f).GetSurfaceArea() - areaC;
+        if (deltaBF < bestDelta)
+        {
+            bestDelta = deltaBF;
+            bestRotation = Rotation::BF;
+        }
+        if (deltaBG < bestDelta)
+        {
+            bestDelta = deltaBG;
+            bestRotation = Rotation::BG;
+        }
+    }
+    if (!nodeB.IsLeaf())
+    {
+        float areaB = nodeB.aabb.GetSurfaceArea();
+        const auto &d = mNodes[nodeB.child1].aabb;
+        const auto &e = mNodes[nodeB.child2].aabb;
+        float deltaCD = AABB::Union(nodeC.aabb, e).GetSurfaceArea() - areaB;
+        float deltaCE = AABB::Union(nodeC.aabb, d).GetSurfaceArea() - areaB;
+        if (deltaCD < bestDelta)
+        {
+            bestDelta = deltaCD;
+            bestRotation = Rotation::CD;
+        }
+        if (deltaCE < bestDelta)
+        {
+            bestDelta = deltaCE;
+            bestRotation = Rotation::CE;
+        }
+    }
+    // 交换A的直接子节点child与另一个子节点other下的孙节点grandChild
+    auto swap = [&](int32_t child, int32_t other, int32_t grandChild) {
+        auto &otherNode = mNodes[other];
+        (otherNode.child1 == grandChild ? otherNode.child1 : otherNode.child2) = child;
+        mNodes[child].parent = other;
+        auto &node = mNodes[nodeID];
+        (node.child1 == child ? node.child1 : node.child2) = grandChild;
+        mNodes[grandChild].parent = nodeID;
+        Refit(other);
+        Refit(nodeID);
+    };
+    switch (bestRotation)
+    {
+    case Rotation::BF:
+        swap(b, c, nodeC.child1);
+        break;
+    case Rotation::BG:
+        swap(b, c, nodeC.child2);
+        break;
+    case Rotation::CD:
+        swap(c, b, nodeB.child1);
+        break;
+    case Rotation::CE:
+        swap(c, b, nodeB.child2);
+        break;
+    case Rotation::None:
+        break;
+    }
+}
+float DynamicBVH::GetAreaRatio() const
+{
+    if (mRoot == NullNode)
+    {
+        return 0.0f;
+    }
+    float rootArea = mNodes[mRoot].aabb.GetSurfaceArea();
+    float totalArea = 0.0f;
+    for (const auto &node : mNodes)
+    {
+        if (node.height > 0)
+        {
+            totalArea += node.aabb.GetSurfaceArea();
+        }
+    }
+    return rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+}
+bool DynamicBVH::Validate() const
+{
+    if (mRoot == NullNode)
+    {
+        return mProxyCount == 0;
+    }
+    if (mNodes[mRoot].parent != NullNode)
+    {
+        return false;
+    }
+    uint32_t leafCount = 0;
+    std::function<bool(int32_t)> validate = [&](int32_t nodeID) {
+        const auto &node = mNodes[nodeID];
+        if (node.IsLeaf())
+        {
+            leafCount++;
+            return node.height == 0 && node.aabb.Contains(mTightBounds[nodeID]);
+        }
+        const auto &child1 = mNodes[node.child1];
+        const auto &child2 = mNodes[node.child2];
+        if (child1.parent != nodeID || child2.parent != nodeID)
+        {
+            return false;
+        }
+        if (node.height != 1 + std::max(child1.height, child2.height))
+        {
+            return false;
+        }
+        if (!node.aabb.Contains(child1.aabb) || !node.aabb.Contains(child2.aabb))
+        {
+            return false;
+        }
+        return validate(node.child1) && validate(node.child2);
+    };
+    return validate(mRoot) && leafCount == mProxyCount;
+}
+void DynamicBVH::QueryKNearest(const glm::vec3 &point, size_t k, std::vector<uint32_t> &result) const
+{
+    result.clear();
+    if (mRoot == NullNode || k == 0)
+    {
+        return;
+    }
+    auto distanceSquared = [&](const AABB &aabb) {
+        auto d = glm::max(glm::max(aabb.min - point, point - aabb.max), glm::vec3(0.0f));
+        return glm::dot(d, d);
+    };
+    using Entry = std::pair<float, int32_t>;
+    // 待访问节点按距离从近到远，已找到的结果保留最远的在堆顶
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    std::priority_queue<std::pair<float, uint32_t>> nearest;
+    open.emplace(distanceSquared(mNodes[mRoot].aabb), mRoot);
+    while (!open.empty())
+    {
+        auto [distance, nodeID] = open.top();
+        open.pop();
+        if (nearest.size() == k && distance >= nearest.top().first)
+        {
+            break;
+        }
+        const auto &node = mNodes[nodeID];
+        if (node.IsLeaf())
+        {
+            float leafDistance = distanceSquared(mTightBounds[nodeID]);
+            if (nearest.size() < k)
+            {
+                nearest.emplace(leafDistance, node.userData);
+            }
+            else if (leafDistance < nearest.top().first)
+            {
+                nearest.pop();
+                nearest.emplace(leafDistance, node.userData);
+            }
+            continue;
+        }
+        open.emplace(distanceSquared(mNodes[node.child1].aabb), node.child1);
+        open.emplace(distanceSquared(mNodes[node.child2].aabb), node.child2);
+    }
+    result.resize(nearest.size());
+    for (size_t i = result.size(); i > 0; i--)
+    {
+        result[i - 1] = nearest.top().second;
+        nearest.pop();
+    }
+}
+} // namespace Core
+} // namespace MEngine
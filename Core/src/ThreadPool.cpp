@@ -0,0 +1,111 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace MEngine
+{
+namespace Core
+{
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    mWorkers.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++)
+    {
+        mWorkers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mMutex);
+        mStop = true;
+    }
+    mCondition.notify_all();
+    for (auto &worker : mWorkers)
+    {
+        worker.join();
+    }
+}
+void ThreadPool::Submit(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(mMutex);
+        mTasks.push(std::move(task));
+    }
+    mCondition.notify_one();
+}
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)> &func)
+{
+    grainSize = std::max<size_t>(grainSize, 1);
+    size_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (chunkCount <= 1 || mWorkers.empty())
+    {
+        if (count > 0)
+        {
+            func(0, count);
+        }
+        return;
+    }
+    // 块数不超过线程数+1，避免过细的切分
+    chunkCount = std::min<size_t>(chunkCount, mWorkers.size() + 1);
+    size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    chunkCount = (count + chunkSize - 1) / chunkSize;
+
+    // 状态放在堆上，晚启动的任务在调用返回后访问也是安全的
+    struct State
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> finished{0};
+    };
+    auto state = std::make_shared<State>();
+    auto runChunks = [state, chunkCount, chunkSize, count, &func]() {
+        for (size_t chunk = state->next.fetch_add(1); chunk < chunkCount; chunk = state->next.fetch_add(1))
+        {
+            size_t begin = chunk * chunkSize;
+            func(begin, std::min(begin + chunkSize, count));
+            if (state->finished.fetch_add(1) + 1 == chunkCount)
+            {
+                state->finished.notify_all();
+            }
+        }
+    };
+    for (size_t i = 1; i < chunkCount; i++)
+    {
+        Submit(runChunks);
+    }
+    runChunks();
+    // 调用线程只等待已被领取的块，不依赖排队任务被调度，嵌套调用不会死锁
+    for (size_t finished = state->finished.load(); finished < chunkCount; finished = state->finished.load())
+    {
+        state->finished.wait(finished);
+    }
+}
+ThreadPool &ThreadPool::Get()
+{
+    static ThreadPool pool;
+    return pool;
+}
+unsigned int ThreadPool::DefaultThreadCount()
+{
+    auto hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+}
+void ThreadPool::WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mMutex);
+            mCondition.wait(lock, [this]() { return mStop || !mTasks.empty(); });
+            if (mStop && mTasks.empty())
+            {
+                return;
+            }
+            task = std::move(mTasks.front());
+            mTasks.pop();
+        }
+        task();
+    }
+}
+} // namespace Core
+} // namespace MEngine
@@ -0,0 +1,20 @@
+#pragma once
+#include "Bounds.hpp"
+#include "Component/Component.hpp"
+
+namespace MEngine
+{
+namespace Function
+{
+/**
+ * @brief 实体包围体，local来自网格资源，world仅在变换改变时由TransformSystem更新
+ */
+struct BoundsComponent : public Component
+{
+    Core::AABB localBounds;
+    Core::BoundingSphere localSphere;
+    Core::AABB worldBounds;
+    Core::BoundingSphere worldSphere;
+};
+} // namespace Function
+} // namespace MEngine
@@ -7,6 +7,11 @@ namespace MEngine
 {
 namespace Function
 {
+enum class RenderPath
+{
+    Forward,
+    Deferred, // 不透明物体先写G-buffer再统一计算光照，光源多时更便宜
+};
 struct CameraComponent : public Component
 {
     glm::vec3 target = {0.0f, 0.0f, 0.0f};
@@ -20,6 +25,7 @@ struct CameraComponent : public Component
 
     bool isMainCamera = false;
     bool isEditorCamera = false;
+    RenderPath renderPath = RenderPath::Forward;
     glm::mat4 viewMatrix = glm::mat4(1.0f);
     glm::mat4 projectionMatrix = glm::mat4(1.0f);
 };
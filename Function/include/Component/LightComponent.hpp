@@ -17,8 +17,16 @@ struct LightComponent final : public Component
     LightType LightType = LightType::Directional;
     float Intensity = 1.0f;
     glm::vec3 Color = glm::vec3(1.0f);
-    // point
+    // point / spot
     float Radius = 10.0f;
+    // spot，角度制的半角
+    float InnerAngle = 15.0f;
+    float OuterAngle = 25.0f;
+    // 阴影，目前只有第一个投射阴影的方向光使用级联阴影
+    bool CastShadows = true;
+    float ShadowDistance = 100.0f;
+    float ShadowBias = 0.002f;      // 深度偏移，单位为阴影贴图深度
+    float ShadowNormalBias = 1.5f;  // 沿法线的偏移，单位为texel
 };
 } // namespace Function
 } // namespace MEngine
\ No newline at end of file
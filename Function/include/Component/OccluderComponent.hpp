@@ -0,0 +1,15 @@
+#pragma once
+#include "Component/Component.hpp"
+
+namespace MEngine
+{
+namespace Function
+{
+/**
+ * @brief 标记实体的网格作为遮挡体参与CPU遮挡剔除，只应挂在墙体、地形等大而简单的物体上
+ */
+struct OccluderComponent : public Component
+{
+};
+} // namespace Function
+} // namespace MEngine
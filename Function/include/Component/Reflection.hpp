@@ -4,10 +4,13 @@
 #include "Asset/Material.hpp"
 #include "Asset/PBRMaterial.hpp"
 #include "Asset/Texture2D.hpp"
+#include "Component/BoundsComponent.hpp"
 #include "Component/CameraComponent.hpp"
 #include "Component/Component.hpp"
 #include "Component/MaterialComponent.hpp"
 #include "Component/MeshComponent.hpp"
+#include "Component/OccluderComponent.hpp"
+#include "Component/StaticComponent.hpp"
 #include "Component/TextureComponent.hpp"
 #include "Component/TransformComponent.hpp"
 #include <entt/entt.hpp>
@@ -152,6 +155,11 @@ static void RegisterMeta()
         .custom<Info>(Info{
             .DisplayName = "zoom",
             .Editable = true,
+        })
+        .data<&CameraComponent::renderPath>("renderPath"_hs)
+        .custom<Info>(Info{
+            .DisplayName = "renderPath",
+            .Editable = true,
         });
     entt::meta<MeshComponent>()
         .type("MeshComponent"_hs)
@@ -169,6 +177,25 @@ static void RegisterMeta()
             .DisplayName = "meshIndex",
             .Editable = true,
         });
+    entt::meta<BoundsComponent>()
+        .type("BoundsComponent"_hs)
+        .custom<Info>(Info{
+            .DisplayName = "BoundsComponent",
+            .Serializable = false,
+        })
+        .base<Component>();
+    entt::meta<OccluderComponent>()
+        .type("OccluderComponent"_hs)
+        .custom<Info>(Info{
+            .DisplayName = "OccluderComponent",
+        })
+        .base<Component>();
+    entt::meta<StaticComponent>()
+        .type("StaticComponent"_hs)
+        .custom<Info>(Info{
+            .DisplayName = "StaticComponent",
+        })
+        .base<Component>();
     // entt::meta<MaterialComponent>()
     //     .type("MaterialComponent"_hs)
     //     .custom<Info>(Info{
@@ -243,6 +270,18 @@ static void RegisterMeta()
         .data<&LightComponent::Intensity>("Intensity"_hs)
         .custom<Info>(Info{.DisplayName = "Intensity", .Editable = true})
         .data<&LightComponent::Radius>("Radius"_hs)
-        .custom<Info>(Info{.DisplayName = "Radius", .Editable = true});
+        .custom<Info>(Info{.DisplayName = "Radius", .Editable = true})
+        .data<&LightComponent::InnerAngle>("InnerAngle"_hs)
+        .custom<Info>(Info{.DisplayName = "InnerAngle", .Editable = true})
+        .data<&LightComponent::OuterAngle>("OuterAngle"_hs)
+        .custom<Info>(Info{.DisplayName = "OuterAngle", .Editable = true})
+        .data<&LightComponent::CastShadows>("CastShadows"_hs)
+        .custom<Info>(Info{.DisplayName = "CastShadows", .Editable = true})
+        .data<&LightComponent::ShadowDistance>("ShadowDistance"_hs)
+        .custom<Info>(Info{.DisplayName = "ShadowDistance", .Editable = true})
+        .data<&LightComponent::ShadowBias>("ShadowBias"_hs)
+        .custom<Info>(Info{.DisplayName = "ShadowBias", .Editable = true})
+        .data<&LightComponent::ShadowNormalBias>("ShadowNormalBias"_hs)
+        .custom<Info>(Info{.DisplayName = "ShadowNormalBias", .Editable = true});
 }
 } // namespace MEngine
\ No newline at end of file
@@ -0,0 +1,15 @@
+#pragma once
+#include "Component/Component.hpp"
+
+namespace MEngine
+{
+namespace Function
+{
+/**
+ * @brief 标记实体不会移动，阴影等可以缓存其渲染结果，移动后相关缓存会被重建
+ */
+struct StaticComponent : public Component
+{
+};
+} // namespace Function
+} // namespace MEngine
@@ -0,0 +1,26 @@
+#pragma once
+#include "Asset/Model.hpp"
+#include "UUID.hpp"
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace MEngine
+{
+/**
+ * @brief 把模型的平铺层级批量实例化为实体
+ *
+ * 预先为实体和组件存储分配容量，一次create出全部实体，再按区间insert组件，层级关系按下标顺序一遍连接。
+ */
+class ModelInstantiator final
+{
+  public:
+    /**
+     * @brief 实例化模型，每个节点一个实体，节点引用的每个网格作为该节点的子实体
+     *
+     * @param parent 根节点挂到的父实体，为entt::null时根节点即为场景根
+     * @return 前GetNodeCount()个为节点实体（与层级下标一致），其后为按MeshIndices顺序排列的网格实体
+     */
+    static std::vector<entt::entity> Instantiate(entt::registry &registry, const Core::Model &model,
+                                                 const Core::UUID &modelID, entt::entity parent = entt::null);
+};
+} // namespace MEngine
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <glm/mat4x4.hpp>
+#include <glm/vec4.hpp>
+
+namespace MEngine
+{
+namespace Function
+{
+// 与 glMultiDrawElementsIndirect 要求的内存布局一致
+struct DrawElementsIndirectCommand
+{
+    uint32_t count = 0;
+    uint32_t instanceCount = 1;
+    uint32_t firstIndex = 0;
+    int32_t baseVertex = 0;
+    uint32_t baseInstance = 0;
+};
+static_assert(sizeof(DrawElementsIndirectCommand) == 20);
+
+// 每个实例的数据，着色器中通过 gl_BaseInstance + gl_InstanceID 索引（std430）
+struct DrawData
+{
+    glm::mat4 modelMatrix{1.0f}; // 紧凑顶点的位置反量化矩阵已右乘进来
+    uint32_t materialIndex = 0;
+    uint32_t vertexFormat = 0; // Core::VertexFormat，着色器据此解码法线
+    uint32_t padding[2] = {0, 0};
+};
+static_assert(sizeof(DrawData) == 80);
+
+// 材质参数，着色器中通过 DrawData::materialIndex 索引（std430）
+struct MaterialData
+{
+    glm::vec4 albedo{1.0f};
+    glm::vec4 emissive{0.0f};
+    glm::vec4 parameters{0.0f, 0.5f, 0.0f, 0.0f}; // metallic, roughness, ao, emissiveIntensity
+};
+static_assert(sizeof(MaterialData) == 48);
+} // namespace Function
+} // namespace MEngine
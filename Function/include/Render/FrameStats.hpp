@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace MEngine
+{
+namespace Function
+{
+/**
+ * @brief 每帧渲染统计，由RenderSystem在每帧开始时清零
+ */
+struct FrameStats
+{
+    uint32_t drawCalls = 0;    // 实际提交给驱动的绘制调用次数
+    uint32_t drawCommands = 0; // 间接绘制命令数（相同网格合并为一条实例化命令）
+    uint32_t instances = 0;    // 绘制的实例总数，与drawCommands之差即合批节省的命令数
+    uint32_t triangles = 0;
+    uint32_t visibleObjects = 0; // 通过视锥剔除的渲染实体
+    uint32_t culledObjects = 0;
+    uint32_t lodObjects = 0;    // 使用简化LOD绘制的实体
+    uint32_t staticBatches = 0; // 通过视锥剔除的静态合批网格
+    uint32_t culledStaticBatches = 0;
+    uint32_t staticBatchedObjects = 0; // 被合批的静态实体，不再逐个剔除和绘制
+    uint32_t staticBatchRebuilds = 0;  // 本帧因静态实体变化重建的合批
+    float staticBatchTimeMs = 0.0f;
+    uint32_t meshlets = 0;       // 参与簇级剔除的簇
+    uint32_t culledMeshlets = 0; // 被视锥或法线圆锥剔除的簇
+    float meshletCullTimeMs = 0.0f;
+    float cullTimeMs = 0.0f;
+    uint32_t occluderTriangles = 0;
+    uint32_t occludedObjects = 0; // 通过视锥但被遮挡体挡住的实体
+    float occlusionTimeMs = 0.0f;
+    uint32_t lights = 0;
+    uint32_t maxLightsPerCluster = 0;
+    float lightAssignTimeMs = 0.0f;
+    uint32_t streamBytes = 0;           // 本帧写入流式缓冲区的字节数
+    float streamStallMs = 0.0f;         // 等待GPU释放流式缓冲区段的时间
+    uint32_t compilingPipelines = 0;    // 仍在异步编译、使用回退管线绘制的管线数
+    uint32_t stateChanges = 0;          // 实际发出的GL状态切换
+    uint32_t redundantStateChanges = 0; // 被状态缓存跳过的重复切换
+    uint32_t renderPasses = 0;          // 执行的渲染图通道
+    uint32_t culledRenderPasses = 0;    // 输出未被使用而剔除的通道
+    size_t renderTargetBytes = 0;       // 本帧临时渲染目标按生命周期别名后的占用
+    size_t renderTargetPoolBytes = 0;   // 渲染目标纹理池总占用
+    float renderGraphSetupMs = 0.0f;    // 渲染图编译和通道绑定的CPU时间
+    uint32_t shadowCasters = 0;         // 本帧绘制到阴影贴图的投射体（静态层重绘时包括静态投射体）
+    uint32_t staticShadowUpdates = 0;   // 重绘了静态层的级联数
+    float shadowTimeMs = 0.0f;          // 阴影通道的CPU时间
+    bool deferred = false;              // 本帧不透明物体是否走延迟着色
+    float gpuTimeMs = 0.0f;             // 渲染图在GPU上的耗时，延迟几帧读回
+    size_t geometryBytes = 0;           // 几何池中常驻的顶点和索引数据
+    uint32_t compactInstances = 0;      // 本帧绘制中使用紧凑顶点格式的实例
+};
+} // namespace Function
+} // namespace MEngine
@@ -0,0 +1,123 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <glad/glad.h>
+
+namespace MEngine
+{
+namespace Function
+{
+/**
+ * @brief 状态切换计数，每帧由RenderSystem清零
+ */
+struct GLStateStats
+{
+    uint32_t changes = 0; // 实际发出的状态切换调用
+    uint32_t skipped = 0; // 与当前状态相同而跳过的调用
+};
+/**
+ * @brief 跟踪当前上下文的GL状态，跳过与当前值相同的状态设置
+ *
+ * 渲染代码必须通过它修改这里覆盖的状态，否则缓存会与驱动状态不一致。
+ * 外部代码（例如不恢复状态的第三方库）修改状态后调用Invalidate，下一次设置会无条件发出。
+ */
+class GLStateCache final
+{
+  public:
+    static constexpr uint32_t MaxTextureUnits = 32;
+    static constexpr uint32_t MaxBufferBindings = 16;
+
+  private:
+    // 未知状态，保证下一次设置一定会发出
+    static constexpr GLuint Unknown = ~0u;
+    struct BufferRange
+    {
+        GLuint buffer = Unknown;
+        GLintptr offset = 0;
+        GLsizeiptr size = 0;
+    };
+    GLuint mProgram = Unknown;
+    GLuint mVertexArray = Unknown;
+    GLuint mDrawFramebuffer = Unknown;
+    GLuint mReadFramebuffer = Unknown;
+    GLuint mDrawIndirectBuffer = Unknown;
+    std::array<GLuint, MaxTextureUnits> mTextures;
+    std::array<GLuint, MaxTextureUnits> mSamplers;
+    std::array<BufferRange, MaxBufferBindings> mStorageBuffers;
+    std::array<BufferRange, MaxBufferBindings> mUniformBuffers;
+    std::array<GLint, 4> mViewport;
+    // 开关状态：0关闭，1开启，-1未知
+    int8_t mBlend = -1;
+    int8_t mDepthTest = -1;
+    int8_t mDepthWrite = -1;
+    int8_t mCullFace = -1;
+    GLenum mBlendSrc = Unknown;
+    GLenum mBlendDest = Unknown;
+    GLenum mDepthFunc = Unknown;
+    GLenum mCullMode = Unknown;
+
+    GLStateStats mStats;
+
+  public:
+    GLStateCache();
+
+    /**
+     * @brief 将所有状态标记为未知
+     */
+    void Invalidate();
+
+    void UseProgram(GLuint program);
+    void BindVertexArray(GLuint vertexArray);
+    /**
+     * @brief GL_FRAMEBUFFER 同时设置绘制和读取目标
+     */
+    void BindFramebuffer(GLenum target, GLuint framebuffer);
+    void BindDrawIndirectBuffer(GLuint buffer);
+    void BindTexture(GLuint unit, GLuint texture);
+    void BindSampler(GLuint unit, GLuint sampler);
+    /**
+     * @brief target 为 GL_SHADER_STORAGE_BUFFER 或 GL_UNIFORM_BUFFER
+     */
+    void BindBufferRange(GLenum target, GLuint binding, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+    void SetBlend(bool enabled, GLenum src = GL_SRC_ALPHA, GLenum dest = GL_ONE_MINUS_SRC_ALPHA);
+    void SetDepthTest(bool enabled, GLenum func = GL_LESS);
+    void SetDepthWrite(bool enabled);
+    void SetCullFace(bool enabled, GLenum mode = GL_BACK);
+
+    inline GLuint GetProgram() const
+    {
+        return mProgram;
+    }
+    inline GLuint GetDrawFramebuffer() const
+    {
+        return mDrawFramebuffer;
+    }
+    inline const GLStateStats &GetStats() const
+    {
+        return mStats;
+    }
+    inline void ResetStats()
+    {
+        mStats = {};
+    }
+
+  private:
+    /**
+     * @brief 当前值与目标相同时记为跳过并返回false，否则更新缓存值并返回true
+     */
+    template <typename T> bool Change(T &current, T value)
+    {
+        if (current == value)
+        {
+            mStats.skipped++;
+            return false;
+        }
+        current = value;
+        mStats.changes++;
+        return true;
+    }
+    bool SetCapability(int8_t &current, GLenum capability, bool enabled);
+};
+} // namespace Function
+} // namespace MEngine
@@ -0,0 +1,139 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include "FreeListAllocator.hpp"
+#include "Geometry/MeshLod.hpp"
+#include "Geometry/VertexQuantization.hpp"
+#include "UUID.hpp"
+#include <array>
+#include <glad/glad.h>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace MEngine
+{
+namespace Function
+{
+/**
+ * @brief 网格在共享缓冲区中的区间，单位分别为顶点和索引
+ *
+ * 各级LOD的索引紧接在LOD0之后，共用同一段顶点；firstIndex和indexCount为LOD0
+ */
+struct GeometryRange
+{
+    Core::VertexFormat format = Core::VertexFormat::Standard;
+    Core::IndexType indexType = Core::IndexType::UInt32;
+    // 紧凑格式的位置反量化，绘制时合并进模型矩阵
+    Core::PositionQuantization quantization{};
+    uint32_t baseVertex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    uint32_t lodCount = 1;
+    std::array<uint32_t, Core::MaxMeshLods> lodFirstIndex{};
+    std::array<uint32_t, Core::MaxMeshLods> lodIndexCount{};
+    std::array<float, Core::MaxMeshLods> lodErrors{};
+    // LOD0的簇，firstIndex相对LOD0的firstIndex；为空时整体绘制
+    std::vector<Core::Meshlet> meshlets;
+
+    inline std::span<const float> GetLodErrors() const
+    {
+        return {lodErrors.data(), lodCount};
+    }
+    /**
+     * @brief 所有LOD占用的索引总数
+     */
+    inline uint32_t GetAllocatedIndexCount() const
+    {
+        return lodFirstIndex[lodCount - 1] + lodIndexCount[lodCount - 1] - firstIndex;
+    }
+};
+/**
+ * @brief 几何体内存池
+ *
+ * 同一顶点格式的网格共享一个大的顶点缓冲区和索引缓冲区，
+ * 通过空闲链表子分配。整个池只有一个VAO，配合 glMultiDrawElementsIndirect 一次提交多个网格。
+ * 每种 Core::VertexFormat 和 Core::IndexType 的组合使用各自的池，上传时按池的格式编码顶点和索引，
+ * 索引区间的单位是池的索引类型。
+ */
+class GeometryArena final
+{
+  private:
+    Core::VertexFormat mFormat;
+    Core::IndexType mIndexType;
+    size_t mVertexStride;
+    size_t mIndexSize;
+    GLuint mVAO = 0;
+    GLuint mVBO = 0;
+    GLuint mEBO = 0;
+    Core::FreeListAllocator mVertexAllocator;
+    Core::FreeListAllocator mIndexAllocator;
+    std::unordered_map<Core::UUID, GeometryRange> mRanges;
+
+  public:
+    GeometryArena(Core::VertexFormat format = Core::VertexFormat::Standard,
+                  Core::IndexType indexType = Core::IndexType::UInt32, uint32_t vertexCapacity = 1 << 20,
+                  uint32_t indexCapacity = 1 << 22);
+    ~GeometryArena();
+    GeometryArena(const GeometryArena &) = delete;
+    GeometryArena &operator=(const GeometryArena &) = delete;
+
+    /**
+     * @brief 查询网格是否已常驻，未上传返回nullptr
+     */
+    const GeometryRange *Find(const Core::UUID &meshID) const;
+    /**
+     * @brief 上传网格数据及其LOD，已上传则直接返回已有区间；空间不足时自动扩容
+     *
+     * 16位索引的池要求网格顶点数不超过 Core::MaxUInt16IndexedVertices
+     */
+    const GeometryRange &Upload(const Core::UUID &meshID, const Core::Mesh &mesh);
+    void Release(const Core::UUID &meshID);
+
+    inline GLuint GetVAO() const
+    {
+        return mVAO;
+    }
+    inline Core::VertexFormat GetFormat() const
+    {
+        return mFormat;
+    }
+    inline Core::IndexType GetIndexType() const
+    {
+        return mIndexType;
+    }
+    /**
+     * @brief 绘制调用使用的索引类型
+     */
+    inline GLenum GetGLIndexType() const
+    {
+        return mIndexType == Core::IndexType::UInt16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    }
+    inline size_t GetVertexStride() const
+    {
+        return mVertexStride;
+    }
+    inline uint32_t GetVertexUsed() const
+    {
+        return mVertexAllocator.GetUsed();
+    }
+    inline uint32_t GetIndexUsed() const
+    {
+        return mIndexAllocator.GetUsed();
+    }
+    /**
+     * @brief 已分配的顶点和索引数据字节数
+     */
+    inline size_t GetUsedBytes() const
+    {
+        return mVertexAllocator.GetUsed() * mVertexStride + mIndexAllocator.GetUsed() * mIndexSize;
+    }
+
+  private:
+    void GrowBuffer(GLuint &buffer, Core::FreeListAllocator &allocator, uint32_t required, size_t stride);
+    void BindBuffers();
+    void SetupStandardAttributes();
+    void SetupCompactAttributes();
+};
+} // namespace Function
+} // namespace MEngine
@@ -0,0 +1,243 @@
+#pragma once
+#include "Render/GLStateCache.hpp"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace MEngine
+{
+namespace Function
+{
+struct RenderGraphTextureDesc
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    GLenum format = GL_RGBA8;
+
+    bool operator==(const RenderGraphTextureDesc &other) const = default;
+    /**
+     * @brief 按格式估算的显存占用
+     */
+    size_t GetSize() const;
+};
+/**
+ * @brief 渲染图中的虚拟纹理，只在声明它的那一帧有效
+ */
+struct RenderGraphTexture
+{
+    static constexpr uint32_t Invalid = ~0u;
+    uint32_t index = Invalid;
+
+    inline bool IsValid() const
+    {
+        return index != Invalid;
+    }
+};
+enum class AttachmentLoadOp
+{
+    Load,     // 保留之前的内容，视为对该纹理的读取
+    Clear,    // 清除为指定值
+    DontCare, // 内容将被完全覆盖
+};
+/**
+ * @brief 每帧渲染图统计
+ */
+struct RenderGraphStats
+{
+    uint32_t passes = 0;
+    uint32_t culledPasses = 0;
+    uint32_t transientTextures = 0; // 本帧声明的临时纹理
+    uint32_t physicalTextures = 0;  // 按生命周期别名后实际使用的纹理
+    size_t transientBytes = 0;      // 别名后临时渲染目标占用
+    size_t unaliasedBytes = 0;      // 不做别名时临时渲染目标的占用
+    size_t poolBytes = 0;           // 纹理池总占用，包括暂时空闲等待复用的纹理
+    uint32_t framebuffers = 0;      // 缓存中的帧缓冲数
+    float setupTimeMs = 0.0f;       // 编译渲染图以及各通道绑定帧缓冲、清除所用的CPU时间
+};
+
+class RenderGraph;
+/**
+ * @brief 在通道的设置回调中声明读写关系
+ */
+class RenderGraphBuilder final
+{
+  private:
+    RenderGraph &mGraph;
+    uint32_t mPass;
+
+  public:
+    RenderGraphBuilder(RenderGraph &graph, uint32_t pass) : mGraph(graph), mPass(pass)
+    {
+    }
+    RenderGraphTexture CreateTexture(const std::string &name, const RenderGraphTextureDesc &desc);
+    /**
+     * @brief 声明在着色器中采样该纹理
+     */
+    void Read(RenderGraphTexture texture);
+    /**
+     * @brief 声明以附件之外的方式写入（例如自行管理的逐层帧缓冲），保留原有内容
+     */
+    void Write(RenderGraphTexture texture);
+    void WriteColor(RenderGraphTexture texture, AttachmentLoadOp loadOp = AttachmentLoadOp::Load,
+                    const glm::vec4 &clearColor = glm::vec4(0.0f));
+    void WriteDepth(RenderGraphTexture texture, AttachmentLoadOp loadOp = AttachmentLoadOp::Load,
+                    float clearDepth = 1.0f);
+    /**
+     * @brief 通道有渲染图之外可见的效果（例如写入缓冲区），不会被剔除
+     */
+    void SetSideEffect();
+};
+/**
+ * @brief 通道执行时可用的资源，帧缓冲和视口已经绑定
+ */
+class RenderPassContext final
+{
+  private:
+    RenderGraph &mGraph;
+
+  public:
+    explicit RenderPassContext(RenderGraph &graph) : mGraph(graph)
+    {
+    }
+    GLuint GetTexture(RenderGraphTexture texture) const;
+    const RenderGraphTextureDesc &GetDesc(RenderGraphTexture texture) const;
+    GLStateCache &GetStateCache() const;
+};
+/**
+ * @brief 每帧重建的渲染图
+ *
+ * 通道按添加顺序执行。Compile从导入的纹理和有副作用的通道反向标记需要的通道，其余被剔除；
+ * 临时纹理按首次和最后一次使用的通道确定生命周期，生命周期不重叠且描述相同的纹理共用同一张物理纹理。
+ * 物理纹理和帧缓冲跨帧缓存，分辨率变化时只新建需要的尺寸，闲置若干帧的纹理才被释放。
+ */
+class RenderGraph final
+{
+  public:
+    using SetupFunction = std::function<void(RenderGraphBuilder &builder)>;
+    using ExecuteFunction = std::function<void(RenderPassContext &context)>;
+    static constexpr uint32_t MaxColorAttachments = 8;
+    // 纹理闲置超过该帧数后释放
+    static constexpr uint64_t MaxIdleFrames = 8;
+
+  private:
+    friend class RenderGraphBuilder;
+    friend class RenderPassContext;
+    struct Attachment
+    {
+        RenderGraphTexture texture;
+        AttachmentLoadOp loadOp = AttachmentLoadOp::Load;
+        glm::vec4 clearValue = glm::vec4(0.0f);
+    };
+    struct Pass
+    {
+        std::string name;
+        ExecuteFunction execute;
+        std::vector<RenderGraphTexture> reads;
+        std::vector<RenderGraphTexture> writes;
+        std::vector<Attachment> colorAttachments;
+        Attachment depthAttachment;
+        bool sideEffect = false;
+        bool culled = false;
+    };
+    struct VirtualTexture
+    {
+        std::string name;
+        RenderGraphTextureDesc desc;
+        GLuint imported = 0;
+        uint32_t physical = RenderGraphTexture::Invalid; // 本帧物理纹理槽
+        uint32_t firstPass = RenderGraphTexture::Invalid;
+        uint32_t lastPass = 0;
+    };
+    struct PooledTexture
+    {
+        GLuint texture = 0;
+        RenderGraphTextureDesc desc;
+        uint64_t lastUsedFrame = 0;
+        bool inUse = false;
+    };
+    struct FramebufferKey
+    {
+        std::array<GLuint, MaxColorAttachments> colors{};
+        GLuint depth = 0;
+        uint32_t colorCount = 0;
+
+        bool operator==(const FramebufferKey &other) const = default;
+    };
+    struct FramebufferKeyHash
+    {
+        size_t operator()(const FramebufferKey &key) const;
+    };
+
+    GLStateCache &mStateCache;
+    std::vector<Pass> mPasses;
+    std::vector<VirtualTexture> mTextures;
+    // 本帧物理纹理槽的描述，Execute时从池中取出对应的纹理
+    std::vector<RenderGraphTextureDesc> mPhysicalDescs;
+    std::vector<GLuint> mPhysicalTextures;
+    std::vector<PooledTexture> mPool;
+    std::unordered_map<FramebufferKey, GLuint, FramebufferKeyHash> mFramebuffers;
+    uint64_t mFrame = 0;
+    bool mCompiled = false;
+    RenderGraphStats mStats;
+
+  public:
+    explicit RenderGraph(GLStateCache &stateCache);
+    ~RenderGraph();
+    RenderGraph(const RenderGraph &) = delete;
+    RenderGraph &operator=(const RenderGraph &) = delete;
+
+    /**
+     * @brief 清空上一帧声明的通道和纹理，缓存的物理纹理和帧缓冲保留
+     */
+    void Reset();
+    RenderGraphTexture CreateTexture(const std::string &name, const RenderGraphTextureDesc &desc);
+    /**
+     * @brief 导入外部纹理，写入它的通道视为渲染图的输出
+     */
+    RenderGraphTexture ImportTexture(const std::string &name, GLuint texture, const RenderGraphTextureDesc &desc);
+    /**
+     * @brief 立即调用setup声明资源，execute在Execute时按添加顺序调用
+     *
+     * @return 通道索引
+     */
+    uint32_t AddPass(const std::string &name, const SetupFunction &setup, ExecuteFunction execute);
+    /**
+     * @brief 剔除无用通道并为临时纹理分配物理纹理槽，不调用GL
+     */
+    void Compile();
+    void Execute();
+    /**
+     * @brief 外部纹理删除前调用，释放引用它的缓存帧缓冲
+     */
+    void ReleaseTexture(GLuint texture);
+
+    inline bool IsPassCulled(uint32_t pass) const
+    {
+        return mPasses[pass].culled;
+    }
+    /**
+     * @brief 临时纹理的物理纹理槽，生命周期不重叠的纹理可能相同；被剔除的纹理返回Invalid
+     */
+    inline uint32_t GetPhysicalIndex(RenderGraphTexture texture) const
+    {
+        return mTextures[texture.index].physical;
+    }
+    inline const RenderGraphStats &GetStats() const
+    {
+        return mStats;
+    }
+
+  private:
+    GLuint AcquireTexture(const RenderGraphTextureDesc &desc);
+    GLuint GetFramebuffer(const Pass &pass);
+    void BeginPass(const Pass &pass);
+    void ReleaseIdleTextures();
+    void DeleteFramebuffers(GLuint texture);
+};
+} // namespace Function
+} // namespace MEngine
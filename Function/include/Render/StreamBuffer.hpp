@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <glad/glad.h>
+#include <vector>
+
+namespace MEngine
+{
+namespace Function
+{
+/**
+ * @brief 环形缓冲区中的一次子分配，data指向持久映射的内存，写入后对GPU直接可见，在本帧结束前有效
+ */
+struct StreamAllocation
+{
+    GLuint buffer = 0;
+    GLintptr offset = 0;
+    GLsizeiptr size = 0;
+    void *data = nullptr;
+};
+/**
+ * @brief 每帧流式上传缓冲区
+ *
+ * 一个持久、一致映射的缓冲区被划分为FrameCount段，每帧使用一段并在帧末插入栅栏，
+ * 重新使用某段前等待其栅栏，避免 glNamedBufferSubData 造成的隐式同步。
+ * 单帧空间不足时立即换用更大的缓冲区，旧缓冲区在GPU用完后释放。
+ */
+class StreamBuffer final
+{
+  public:
+    static constexpr uint32_t FrameCount = 3;
+
+  private:
+    struct RetiredBuffer
+    {
+        GLuint buffer;
+        uint64_t frame;
+    };
+    GLuint mBuffer = 0;
+    uint8_t *mMapped = nullptr;
+    size_t mFrameSize = 0;
+    size_t mOffset = 0; // 当前帧段内的偏移
+    uint32_t mFrameIndex = 0;
+    uint64_t mFrameNumber = 0;
+    std::array<GLsync, FrameCount> mFences{};
+    std::vector<RetiredBuffer> mRetiredBuffers;
+    GLint mUniformAlignment = 256;
+    GLint mStorageAlignment = 16;
+
+    float mStallTimeMs = 0.0f; // 本帧等待栅栏的时间
+    uint32_t mStallCount = 0;  // 累计发生等待的帧数
+
+  public:
+    explicit StreamBuffer(size_t frameSize = 4 << 20);
+    ~StreamBuffer();
+    StreamBuffer(const StreamBuffer &) = delete;
+    StreamBuffer &operator=(const StreamBuffer &) = delete;
+
+    /**
+     * @brief 切换到下一段，必要时等待GPU用完该段
+     */
+    void BeginFrame();
+    /**
+     * @brief 为当前段插入栅栏，本帧的绘制命令必须在此之前提交
+     */
+    void EndFrame();
+
+    StreamAllocation Allocate(size_t size, size_t alignment);
+    /**
+     * @brief 按UBO偏移对齐分配，用于 glBindBufferRange(GL_UNIFORM_BUFFER)
+     */
+    inline StreamAllocation AllocateUniform(size_t size)
+    {
+        return Allocate(size, static_cast<size_t>(mUniformAlignment));
+    }
+    /**
+     * @brief 按SSBO偏移对齐分配，用于 glBindBufferRange(GL_SHADER_STORAGE_BUFFER)
+     */
+    inline StreamAllocation AllocateStorage(size_t size)
+    {
+        return Allocate(size, static_cast<size_t>(mStorageAlignment));
+    }
+    /**
+     * @brief 分配并拷贝数组，空数组也会分配最小区间以便绑定
+     */
+    template <typename T> StreamAllocation WriteStorage(const T *data, size_t count)
+    {
+        auto allocation = AllocateStorage(sizeof(T) * count);
+        if (count > 0)
+        {
+            std::memcpy(allocation.data, data, sizeof(T) * count);
+        }
+        return allocation;
+    }
+    template <typename T> StreamAllocation WriteStorage(const std::vector<T> &data)
+    {
+        return WriteStorage(data.data(), data.size());
+    }
+
+    inline GLuint GetBuffer() const
+    {
+        return mBuffer;
+    }
+    inline size_t GetFrameSize() const
+    {
+        return mFrameSize;
+    }
+    inline size_t GetUsed() const
+    {
+        return mOffset;
+    }
+    inline float GetStallTimeMs() const
+    {
+        return mStallTimeMs;
+    }
+    inline uint32_t GetStallCount() const
+    {
+        return mStallCount;
+    }
+
+  private:
+    void CreateBuffer(size_t frameSize);
+    /**
+     * @brief 等待并删除栅栏，返回是否发生了阻塞
+     */
+    bool WaitFence(GLsync &fence);
+};
+} // namespace Function
+} // namespace MEngine
@@ -1,39 +1,206 @@
 #pragma once
 
+#include "Asset/Mesh.hpp"
+#include "Asset/Pipeline.hpp"
+#include "Component/BoundsComponent.hpp"
 #include "Component/CameraComponent.hpp"
 #include "Component/MaterialComponent.hpp"
 #include "Component/MeshComponent.hpp"
 #include "Component/TransformComponent.hpp"
+#include "Component/OccluderComponent.hpp"
+#include "Culling/FrustumCuller.hpp"
+#include "Culling/LightClusterGrid.hpp"
+#include "Culling/MeshletCuller.hpp"
+#include "Culling/OcclusionCuller.hpp"
+#include "Geometry/StaticBatchBuilder.hpp"
+#include "Render/DrawCommand.hpp"
+#include "Render/FrameStats.hpp"
+#include "Render/GLStateCache.hpp"
+#include "Render/GeometryArena.hpp"
+#include "Render/RenderGraph.hpp"
+#include "Render/StreamBuffer.hpp"
+#include "Shadow/CascadedShadowMap.hpp"
 #include "System/System.hpp"
+#include <array>
+#include <filesystem>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace MEngine
 {
 class RenderSystem final : public System
 {
+  private:
+    struct DrawItem
+    {
+        entt::entity entity;
+        UUID meshID;
+        GeometryArena *arena;
+        uint32_t materialIndex;
+        uint32_t lod;
+    };
+    struct InstanceItem
+    {
+        const GeometryArena *arena;
+        const GeometryRange *range;
+        entt::entity entity;
+        uint32_t materialIndex;
+        uint32_t lod;
+    };
+    struct DrawBatch
+    {
+        PipelineType pipelineType;
+        const GeometryArena *arena; // 不同几何池的VAO和索引类型不同
+        uint32_t firstCommand;
+        uint32_t commandCount;
+    };
+    struct ShadowCaster
+    {
+        const GeometryArena *arena;
+        const GeometryRange *range;
+        entt::entity entity;
+        Core::AABB bounds;
+        bool isStatic;
+    };
+    // 静态合批按材质和世界网格单元分组
+    struct StaticBatchKey
+    {
+        const Material *material;
+        glm::ivec3 cell;
+        inline bool operator==(const StaticBatchKey &other) const
+        {
+            return material == other.material && cell == other.cell;
+        }
+    };
+    struct StaticBatchKeyHash
+    {
+        size_t operator()(const StaticBatchKey &key) const;
+    };
+    // 合并结果超过16位索引的顶点上限时拆成多个部分，各自上传和剔除
+    struct StaticBatchPart
+    {
+        UUID meshID;
+        GeometryArena *arena;
+        Core::AABB bounds;
+    };
+    struct StaticBatch
+    {
+        std::shared_ptr<Material> material;
+        std::vector<entt::entity> entities;
+        std::vector<StaticBatchPart> parts;
+        bool dirty = false;
+    };
+    // 投射阴影的方向光，只支持第一个开启CastShadows的方向光
+    struct ShadowLight
+    {
+        bool enabled = false;
+        uint32_t directionalIndex = 0; // 在光源缓冲区方向光部分中的索引
+        glm::vec3 direction{0.0f, -1.0f, 0.0f};
+        float bias = 0.0f;
+        float normalBias = 0.0f;
+        float distance = 0.0f;
+    };
+
   private:
     CameraComponent mMainCamera;
-    std::unordered_map<UUID, std::vector<entt::entity>> mRenderQueue;
+    std::unordered_map<PipelineType, std::vector<DrawItem>> mRenderQueue;
+    std::unordered_map<PipelineType, std::shared_ptr<Pipeline>> mPipelines;
+    std::shared_ptr<Pipeline> mFallbackPipeline; // 管线异步编译期间代替绘制
+    // 各管线类型的基础管线，实际绘制使用 ShaderVariantCache 中的变体
+    std::unordered_map<PipelineType, std::shared_ptr<Pipeline>> mBasePipelines;
+    // 每种顶点格式和索引类型的组合一个几何池，见 GetGeometryArenaIndex
+    std::array<std::unique_ptr<GeometryArena>, 4> mGeometryArenas;
+    // 所有每帧数据（间接命令、DrawData、材质、光源）都从流式缓冲区子分配
+    std::unique_ptr<StreamBuffer> mStreamBuffer;
+    // 渲染代码的状态修改都经过它，跳过重复的绑定和开关
+    GLStateCache mStateCache;
+    // 每帧重建，中间渲染目标从其纹理池分配
+    RenderGraph mRenderGraph;
+
+    // 每帧重建的间接绘制数据
+    std::vector<MaterialData> mMaterialData;
+    std::unordered_map<const Material *, uint32_t> mMaterialIndices;
+    // 材质句柄取不到材质时使用，为空则跳过这些实体
+    std::shared_ptr<Material> mDefaultMaterial;
+    std::vector<DrawBatch> mDrawBatches;
+    std::vector<InstanceItem> mInstanceItems;
+    StreamAllocation mCommandAllocation;
+    StreamAllocation mDrawDataAllocation;
+    StreamAllocation mMaterialAllocation;
+
+    // 延迟着色，相机选择Deferred且两个管线都就绪时使用，否则退回前向
+    // G-buffer: 反照率+AO (RGBA8)、八面体法线 (RG16)、粗糙度+金属度 (RG8)，位置由深度重建
+    static constexpr GLuint GBufferTextureUnit = 9; // 深度、反照率、法线、材质依次占用 9-12
+    std::shared_ptr<Pipeline> mGBufferBase;
+    std::shared_ptr<Pipeline> mGBufferPipeline;
+    std::shared_ptr<Pipeline> mDeferredLightingBase;
+    std::shared_ptr<Pipeline> mDeferredLightingPipeline;
+    GLuint mEmptyVAO = 0; // 全屏三角形不需要顶点数据，但核心模式要求绑定VAO
+    bool mDeferredFrame = false;
+    // GPU计时，环形使用避免读取结果时等待
+    std::array<GLuint, 3> mGpuTimerQueries{};
+    uint64_t mGpuTimerFrame = 0;
+    float mGpuTimeMs = 0.0f;
+
+    // 视锥剔除，按实体索引记录可见性，没有包围体的实体视为可见
+    Core::FrustumCuller mFrustumCuller;
+    std::vector<entt::entity> mCullEntities;
+    std::vector<uint8_t> mEntityVisibility;
+    // 遮挡剔除，仅在场景中存在OccluderComponent时执行
+    Core::OcclusionCuller mOcclusionCuller;
+    std::vector<Core::AABB> mOccludeeBounds;
+    std::vector<uint8_t> mOccludeeVisibility;
+    // 网格LOD，按实体索引记录上一帧的级别用于滞后切换；阴影始终使用LOD0，与静态缓存保持一致
+    Core::MeshLodSettings mLodSettings;
+    std::vector<uint8_t> mEntityLods;
+    // 簇级剔除只用于主相机的LOD0，阴影仍整体绘制
+    Core::MeshletCullSettings mMeshletSettings;
+    std::vector<Core::MeshletRange> mMeshletRanges;
+    // 静态合批，被合并的实体不再逐个剔除和进入渲染队列，按合批的包围盒剔除后绘制合并网格
+    // 静态实体的增删、移动、网格或材质变化只标记所在合批，下一帧重建这些合批
+    Core::StaticBatchSettings mStaticBatchSettings;
+    std::unordered_map<StaticBatchKey, StaticBatch, StaticBatchKeyHash> mStaticBatches;
+    std::unordered_map<entt::entity, StaticBatchKey> mStaticBatchKeys;
+    std::vector<uint8_t> mEntityStaticBatched; // 按实体索引
+    std::vector<entt::entity> mDirtyStaticEntities;
+    // 网格或材质尚未加载的静态实体，每帧重试直到可以合批
+    std::unordered_set<entt::entity> mPendingStaticEntities;
+    bool mRebuildStaticBatches = true;
+    UUIDGenerator mUUIDGenerator;
+    // 簇式光照，光源、簇区间和光源索引分别上传到 binding 2/3/4
+    Core::LightClusterGrid mLightGrid;
+    std::vector<Core::PackedLight> mPackedLights;
+    StreamAllocation mLightAllocation;
+    StreamAllocation mClusterAllocation;
+    StreamAllocation mLightIndexAllocation;
+    int mFrameBufferWidth = 0;
+    int mFrameBufferHeight = 0;
+    // 级联阴影，静态投射体画在缓存层中，只在级联矩阵或静态投射体变化时重绘，
+    // 最终阴影贴图每帧从缓存层复制后再叠加动态投射体
+    Core::CascadedShadowMap mShadowCascades;
+    ShadowLight mShadowLight;
+    std::shared_ptr<Pipeline> mShadowPipeline;
+    GLuint mShadowMap = 0;
+    GLuint mStaticShadowMap = 0;
+    uint32_t mShadowMapResolution = 0;
+    std::array<GLuint, Core::CascadedShadowMap::MaxCascades> mShadowFramebuffers{};
+    std::array<GLuint, Core::CascadedShadowMap::MaxCascades> mStaticShadowFramebuffers{};
+    // 最终阴影贴图的该层与缓存层内容相同（上一帧没有动态投射体），可以跳过复制
+    std::array<bool, Core::CascadedShadowMap::MaxCascades> mShadowLayerMatchesStatic{};
+    bool mShadowVariantsEnabled = false;
+    std::vector<ShadowCaster> mShadowCasters;
+    std::vector<const ShadowCaster *> mCascadeCasters;
+
+    FrameStats mFrameStats;
 
   public:
-    GLuint FBO = 0;
-    GLuint ColorAttachment;
-    GLuint DepthAttachment;
-    struct Light
-    {
-        glm::vec3 position;
-        glm::vec3 direction;
-        glm::vec3 color;
-        float intensity;
-        float radius;
-        int type;
-    };
-    GLuint LightUBO;
+    // 渲染图的最终输出，编辑器视口直接显示
+    GLuint ColorAttachment = 0;
 
   public:
-    RenderSystem(std::shared_ptr<entt::registry> registry);
+    RenderSystem(std::shared_ptr<entt::registry> registry, std::shared_ptr<IAssetManager> assetManager);
     ~RenderSystem();
 
     void Init() override;
@@ -41,13 +208,162 @@ class RenderSystem final : public System
     void Shutdown() override;
 
     void GetMainCamera();
+    /**
+     * @brief 处理上一帧以来变化的静态实体，只重建受影响的合批
+     */
+    void UpdateStaticBatches();
+    void CullScene();
+    void CullOccluded(const glm::mat4 &viewProjection);
+    void BuildLightClusters();
+    /**
+     * @brief 更新级联矩阵并收集投射体，没有投射阴影的方向光时关闭阴影
+     */
+    void UpdateShadows();
+    /**
+     * @brief 按分辨率重建输出纹理，尺寸不变时不做任何事；深度等中间目标由渲染图按尺寸分配
+     */
     void CreateFrameBuffer(int width = 1280, int height = 720);
+    /**
+     * @brief 声明本帧的渲染通道及其读写的纹理
+     */
+    void BuildRenderGraph();
     void UpdateSource();
+    /**
+     * @brief 设置管线，未编译的管线会提交异步编译，完成前使用回退管线绘制
+     */
+    void SetPipeline(PipelineType type, std::shared_ptr<Pipeline> pipeline);
+    /**
+     * @brief 着色器源文件或包含文件修改后调用，只重编译依赖该文件的管线
+     */
+    void ReloadShader(const std::filesystem::path &path);
+    /**
+     * @brief 检查着色器及其包含文件是否被修改，对修改过的文件调用 ReloadShader
+     */
+    void PollShaderChanges();
+    inline const FrameStats &GetFrameStats() const
+    {
+        return mFrameStats;
+    }
+    inline const Core::MeshLodSettings &GetLodSettings() const
+    {
+        return mLodSettings;
+    }
+    inline void SetLodSettings(const Core::MeshLodSettings &settings)
+    {
+        mLodSettings = settings;
+    }
+    inline const Core::StaticBatchSettings &GetStaticBatchSettings() const
+    {
+        return mStaticBatchSettings;
+    }
+    /**
+     * @brief 修改设置后下一帧重建所有静态合批
+     */
+    inline void SetStaticBatchSettings(const Core::StaticBatchSettings &settings)
+    {
+        mStaticBatchSettings = settings;
+        mRebuildStaticBatches = true;
+    }
+    /**
+     * @brief 材质句柄为空的实体改用该材质绘制，不参与静态合批；传入nullptr恢复为跳过
+     */
+    inline void SetDefaultMaterial(std::shared_ptr<Material> material)
+    {
+        mDefaultMaterial = std::move(material);
+    }
+    inline const Core::MeshletCullSettings &GetMeshletSettings() const
+    {
+        return mMeshletSettings;
+    }
+    inline void SetMeshletSettings(const Core::MeshletCullSettings &settings)
+    {
+        mMeshletSettings = settings;
+    }
+    /**
+     * @brief 在渲染系统之外直接修改GL状态且不恢复时，需调用其Invalidate
+     */
+    inline GLStateCache &GetStateCache()
+    {
+        return mStateCache;
+    }
 
     void RenderQueue();
     void RenderShadowPass();
-    void RenderDeferredPass();
     void RenderForwardPass();
-    void RenderPostProcessPass();
+    void RenderGBufferPass();
+    /**
+     * @brief 依次为深度、反照率、法线、材质纹理
+     */
+    void RenderDeferredLightingPass(const std::array<GLuint, 4> &gbuffer);
+
+  private:
+    bool IsEntityVisible(entt::entity entity) const;
+    bool IsStaticBatched(entt::entity entity) const;
+    void AddToStaticBatch(entt::entity entity);
+    void RemoveFromStaticBatch(entt::entity entity);
+    void RebuildStaticBatch(StaticBatch &batch);
+    /**
+     * @brief 按网格同步实体的模型空间和世界包围体
+     */
+    void UpdateEntityBounds(entt::entity entity, const Mesh &mesh);
+    static inline size_t GetGeometryArenaIndex(Core::VertexFormat format, Core::IndexType indexType)
+    {
+        return static_cast<size_t>(format) * 2 + static_cast<size_t>(indexType);
+    }
+    /**
+     * @brief 网格所属的几何池，顶点数超出16位范围时总是使用32位索引的池
+     */
+    GeometryArena &GetGeometryArena(const Mesh &mesh) const;
+    /**
+     * @brief 静态合批已在世界空间，没有对应实体，entity为entt::null时返回单位矩阵
+     */
+    const glm::mat4 &GetModelMatrix(entt::entity entity) const;
+    /**
+     * @brief 实例的DrawData，紧凑格式的位置反量化合并进模型矩阵
+     */
+    DrawData MakeDrawData(entt::entity entity, const GeometryRange &range, uint32_t materialIndex) const;
+    /**
+     * @brief 在主相机下剔除实体的簇，存活区间写入mMeshletRanges，返回区间数
+     */
+    uint32_t CullMeshlets(entt::entity entity, const GeometryRange &range);
+    /**
+     * @brief 按世界包围球在主相机中的投影大小选择LOD
+     */
+    uint32_t SelectEntityLod(entt::entity entity, const GeometryRange &range);
+    void PollPipelines();
+    Pipeline *GetActivePipeline(PipelineType type) const;
+    std::shared_ptr<Mesh> ResolveMesh(const MeshComponent &meshComponent, UUID &meshID) const;
+    uint32_t GetMaterialIndex(const std::shared_ptr<Material> &material);
+    void BindStorage(GLuint binding, const StreamAllocation &allocation);
+    /**
+     * @brief 为本帧的渲染队列生成间接绘制命令和DrawData，前向和G-buffer通道共用
+     */
+    void BuildDrawCommands();
+    bool IsDeferredBatch(const DrawBatch &batch) const;
+    void BindSceneStorage();
+    /**
+     * @brief 前向管线和延迟光照管线共用的光源、簇和阴影参数
+     */
+    void SetLightingUniforms(const Pipeline &pipeline);
+    /**
+     * @brief gbuffer为true时只绘制写入G-buffer的批次，否则绘制其余批次
+     */
+    void DrawBatches(bool gbuffer);
+    void BeginGpuTimer();
+    void EndGpuTimer();
+    void CreateShadowMaps(uint32_t resolution);
+    void DeleteShadowMaps();
+    void SetShadowVariants(bool enabled);
+    /**
+     * @brief 收集与级联视锥相交的静态或动态投射体，返回数量
+     */
+    uint32_t CollectShadowCasters(const glm::mat4 &viewProjection, bool staticCasters);
+    void DrawShadowCasters(const glm::mat4 &viewProjection);
+    void OnStaticChanged(entt::registry &registry, entt::entity entity);
+    void OnTransformUpdate(entt::registry &registry, entt::entity entity);
+    /**
+     * @brief 网格或材质组件变化时，静态实体需要重新合批
+     */
+    void OnStaticSourceChanged(entt::registry &registry, entt::entity entity);
 };
-} // namespace MEngine
\ No newline at end of file
+} // namespace MEngine
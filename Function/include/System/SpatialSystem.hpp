@@ -0,0 +1,43 @@
+#pragma once
+#include "Component/BoundsComponent.hpp"
+#include "Spatial/DynamicBVH.hpp"
+#include "System/System.hpp"
+#include <entt/entt.hpp>
+#include <memory>
+#include <unordered_map>
+
+namespace MEngine
+{
+/**
+ * @brief 维护场景的动态BVH，世界包围体变化（BoundsComponent::dirty）时同步到树中
+ */
+class SpatialSystem final : public System
+{
+  private:
+    Core::DynamicBVH mTree;
+    std::unordered_map<entt::entity, int32_t> mProxies;
+
+  public:
+    SpatialSystem(std::shared_ptr<entt::registry> registry) : System(registry)
+    {
+    }
+    void Init() override;
+    void Update(float deltaTime) override;
+    void Shutdown() override;
+
+    inline const Core::DynamicBVH &GetTree() const
+    {
+        return mTree;
+    }
+    /**
+     * @brief 射线拾取，返回包围盒最近的实体
+     */
+    entt::entity RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance = 1000.0f) const;
+    void QueryFrustum(const Core::Frustum &frustum, std::vector<entt::entity> &result) const;
+    void QueryAABB(const Core::AABB &aabb, std::vector<entt::entity> &result) const;
+    void QueryKNearest(const glm::vec3 &point, size_t k, std::vector<entt::entity> &result) const;
+
+  private:
+    void OnBoundsDestroy(entt::registry &registry, entt::entity entity);
+};
+} // namespace MEngine
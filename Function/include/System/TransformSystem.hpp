@@ -1,4 +1,5 @@
 #pragma once
+#include "Component/BoundsComponent.hpp"
 #include "Component/MaterialComponent.hpp"
 #include "Component/MeshComponent.hpp"
 #include "Component/TransformComponent.hpp"
@@ -31,6 +32,9 @@ class TransformSystem final : public System
                                const glm::mat4 &parentMatrix = glm::mat4(1.0f));
 
   private:
-    void CalculateMatrix(entt::entity entity);
+    /**
+     * @brief 从根节点向下更新矩阵，只有自身或父节点变化时才重新分解矩阵并更新世界包围体
+     */
+    void CalculateMatrix(entt::entity entity, bool parentChanged = false);
 };
 } // namespace MEngine
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "ModelInstantiator.hpp"
+#include "Component/MaterialComponent.hpp"
+#include "Component/MeshComponent.hpp"
+#include "Component/TransformComponent.hpp"
+#include "Math.hpp"
+#include <iterator>
+#include <numeric>
+
+namespace MEngine
+{
+using Function::MaterialComponent;
+using Function::MeshComponent;
+using Function::TransformComponent;
+std::vector<entt::entity> ModelInstantiator::Instantiate(entt::registry &registry, const Core::Model &model,
+                                                         const Core::UUID &modelID, entt::entity parent)
+{
+    // 旧资源没有层级信息时，退化为挂着全部网格的单个根节点
+    const Core::ModelHierarchy *hierarchy = &model.Hierarchy;
+    Core::ModelHierarchy fallback;
+    if (hierarchy->IsEmpty() || !hierarchy->IsValid(model.Meshes.size()))
+    {
+        std::vector<uint32_t> meshes(model.Meshes.size());
+        std::iota(meshes.begin(), meshes.end(), 0u);
+        fallback.AddNode(model.Name, -1, glm::mat4(1.0f), meshes);
+        hierarchy = &fallback;
+    }
+    const auto nodeCount = hierarchy->GetNodeCount();
+    const auto meshCount = hierarchy->MeshIndices.size();
+    const auto total = nodeCount + meshCount;
+
+    // 预留容量，避免批量创建过程中存储反复扩容
+    auto &entityStorage = registry.storage<entt::entity>();
+    entityStorage.reserve(entityStorage.size() + total);
+    auto &transformStorage = registry.storage<TransformComponent>();
+    transformStorage.reserve(transformStorage.size() + total);
+    auto &meshStorage = registry.storage<MeshComponent>();
+    meshStorage.reserve(meshStorage.size() + meshCount);
+    auto &materialStorage = registry.storage<MaterialComponent>();
+    materialStorage.reserve(materialStorage.size() + meshCount);
+
+    std::vector<entt::entity> entities(total);
+    registry.create(entities.begin(), entities.end());
+    const auto meshEntities = entities.begin() + nodeCount;
+
+    glm::mat4 parentMatrix(1.0f);
+    if (parent != entt::null)
+    {
+        parentMatrix = registry.get<TransformComponent>(parent).modelMatrix;
+    }
+
+    std::vector<TransformComponent> transforms(total);
+    // 先统计子节点数量，children只分配一次
+    std::vector<uint32_t> childCounts(nodeCount);
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        childCounts[i] += hierarchy->MeshRanges[i].count;
+        if (hierarchy->Parents[i] >= 0)
+        {
+            childCounts[hierarchy->Parents[i]]++;
+        }
+    }
+    uint32_t rootCount = 0;
+    glm::vec3 skew;
+    glm::vec4 perspective;
+    for (size_t i = 0; i < nodeCount; i++)
+    {
+        auto &transform = transforms[i];
+        transform.name = hierarchy->Names[i];
+        transform.children.reserve(childCounts[i]);
+        const auto &localMatrix = hierarchy->LocalTransforms[i];
+        glm::decompose(localMatrix, transform.localScale, transform.localRotation, transform.localPosition, skew,
+                       perspective);
+        // 父节点下标更小，其矩阵已经计算完毕
+        auto parentIndex = hierarchy->Parents[i];
+        if (parentIndex < 0)
+        {
+            transform.parent = parent;
+            transform.modelMatrix = parentMatrix * localMatrix;
+            rootCount++;
+        }
+        else
+        {
+            auto &parentTransform = transforms[parentIndex];
+            transform.parent = entities[parentIndex];
+            transform.modelMatrix = parentTransform.modelMatrix * localMatrix;
+            parentTransform.children.push_back(entities[i]);
+        }
+        transform.dirty = true;
+        // 网格实体的局部变换为单位矩阵，直接继承节点矩阵
+        const auto &range = hierarchy->MeshRanges[i];
+        for (uint32_t j = range.offset; j < range.offset + range.count; j++)
+        {
+            auto &meshTransform = transforms[nodeCount + j];
+            meshTransform.name = transform.name;
+            meshTransform.parent = entities[i];
+            meshTransform.modelMatrix = transform.modelMatrix;
+            transform.children.push_back(meshEntities[j]);
+        }
+    }
+
+    registry.insert<TransformComponent>(entities.begin(), entities.end(),
+                                        std::make_move_iterator(transforms.begin()));
+    std::vector<MeshComponent> meshComponents(meshCount);
+    for (size_t j = 0; j < meshCount; j++)
+    {
+        meshComponents[j].modelID = modelID;
+        meshComponents[j].meshIndex = static_cast<int>(hierarchy->MeshIndices[j]);
+    }
+    registry.insert<MeshComponent>(meshEntities, entities.end(), meshComponents.begin());
+    registry.insert<MaterialComponent>(meshEntities, entities.end());
+
+    if (parent != entt::null)
+    {
+        auto &parentTransform = registry.get<TransformComponent>(parent);
+        parentTransform.children.reserve(parentTransform.children.size() + rootCount);
+        for (size_t i = 0; i < nodeCount; i++)
+        {
+            if (hierarchy->Parents[i] < 0)
+            {
+                parentTransform.children.push_back(entities[i]);
+            }
+        }
+    }
+    return entities;
+}
+} // namespace MEngine
@@ -0,0 +1,179 @@
+#include "Render/GLStateCache.hpp"
+
+namespace MEngine
+{
+namespace Function
+{
+GLStateCache::GLStateCache()
+{
+    Invalidate();
+}
+void GLStateCache::Invalidate()
+{
+    mProgram = Unknown;
+    mVertexArray = Unknown;
+    mDrawFramebuffer = Unknown;
+    mReadFramebuffer = Unknown;
+    mDrawIndirectBuffer = Unknown;
+    mTextures.fill(Unknown);
+    mSamplers.fill(Unknown);
+    mStorageBuffers.fill(BufferRange{});
+    mUniformBuffers.fill(BufferRange{});
+    mViewport.fill(-1);
+    mBlend = -1;
+    mDepthTest = -1;
+    mDepthWrite = -1;
+    mCullFace = -1;
+    mBlendSrc = Unknown;
+    mBlendDest = Unknown;
+    mDepthFunc = Unknown;
+    mCullMode = Unknown;
+}
+void GLStateCache::UseProgram(GLuint program)
+{
+    if (Change(mProgram, program))
+    {
+        glUseProgram(program);
+    }
+}
+void GLStateCache::BindVertexArray(GLuint vertexArray)
+{
+    if (Change(mVertexArray, vertexArray))
+    {
+        glBindVertexArray(vertexArray);
+    }
+}
+void GLStateCache::BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    if (target == GL_FRAMEBUFFER)
+    {
+        if (mDrawFramebuffer == framebuffer && mReadFramebuffer == framebuffer)
+        {
+            mStats.skipped++;
+            return;
+        }
+        mDrawFramebuffer = framebuffer;
+        mReadFramebuffer = framebuffer;
+        mStats.changes++;
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        return;
+    }
+    auto &current = target == GL_READ_FRAMEBUFFER ? mReadFramebuffer : mDrawFramebuffer;
+    if (Change(current, framebuffer))
+    {
+        glBindFramebuffer(target, framebuffer);
+    }
+}
+void GLStateCache::BindDrawIndirectBuffer(GLuint buffer)
+{
+    if (Change(mDrawIndirectBuffer, buffer))
+    {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer);
+    }
+}
+void GLStateCache::BindTexture(GLuint unit, GLuint texture)
+{
+    if (unit >= MaxTextureUnits)
+    {
+        glBindTextureUnit(unit, texture);
+        mStats.changes++;
+        return;
+    }
+    if (Change(mTextures[unit], texture))
+    {
+        glBindTextureUnit(unit, texture);
+    }
+}
+void GLStateCache::BindSampler(GLuint unit, GLuint sampler)
+{
+    if (unit >= MaxTextureUnits)
+    {
+        glBindSampler(unit, sampler);
+        mStats.changes++;
+        return;
+    }
+    if (Change(mSamplers[unit], sampler))
+    {
+        glBindSampler(unit, sampler);
+    }
+}
+void GLStateCache::BindBufferRange(GLenum target, GLuint binding, GLuint buffer, GLintptr offset, GLsizeiptr size)
+{
+    if (binding < MaxBufferBindings)
+    {
+        auto &current = target == GL_UNIFORM_BUFFER ? mUniformBuffers[binding] : mStorageBuffers[binding];
+        if (current.buffer == buffer && current.offset == offset && current.size == size)
+        {
+            mStats.skipped++;
+            return;
+        }
+        current = BufferRange{buffer, offset, size};
+    }
+    mStats.changes++;
+    glBindBufferRange(target, binding, buffer, offset, size);
+}
+void GLStateCache::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    if (Change(mViewport, std::array<GLint, 4>{x, y, width, height}))
+    {
+        glViewport(x, y, width, height);
+    }
+}
+void GLStateCache::SetBlend(bool enabled, GLenum src, GLenum dest)
+{
+    SetCapability(mBlend, GL_BLEND, enabled);
+    if (!enabled)
+    {
+        return;
+    }
+    if (mBlendSrc == src && mBlendDest == dest)
+    {
+        mStats.skipped++;
+        return;
+    }
+    mBlendSrc = src;
+    mBlendDest = dest;
+    mStats.changes++;
+    glBlendFunc(src, dest);
+}
+void GLStateCache::SetDepthTest(bool enabled, GLenum func)
+{
+    SetCapability(mDepthTest, GL_DEPTH_TEST, enabled);
+    if (enabled && Change(mDepthFunc, func))
+    {
+        glDepthFunc(func);
+    }
+}
+void GLStateCache::SetDepthWrite(bool enabled)
+{
+    if (Change(mDepthWrite, static_cast<int8_t>(enabled)))
+    {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+void GLStateCache::SetCullFace(bool enabled, GLenum mode)
+{
+    SetCapability(mCullFace, GL_CULL_FACE, enabled);
+    if (enabled && Change(mCullMode, mode))
+    {
+        glCullFace(mode);
+    }
+}
+bool GLStateCache::SetCapability(int8_t &current, GLenum capability, bool enabled)
+{
+    if (!Change(current, static_cast<int8_t>(enabled)))
+    {
+        return false;
+    }
+    if (enabled)
+    {
+        glEnable(capability);
+    }
+    else
+    {
+        glDisable(capability);
+    }
+    return true;
+}
+} // namespace Function
+} // namespace MEngine
@@ -0,0 +1,189 @@
+#include "Render/GeometryArena.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cstddef>
+
+namespace MEngine
+{
+namespace Function
+{
+GeometryArena::GeometryArena(Core::VertexFormat format, Core::IndexType indexType, uint32_t vertexCapacity,
+                             uint32_t indexCapacity)
+    : mFormat(format), mIndexType(indexType),
+      mVertexStride(format == Core::VertexFormat::Compact ? sizeof(Core::CompactVertex) : sizeof(Core::Vertex)),
+      mIndexSize(Core::GetIndexSize(indexType)), mVertexAllocator(vertexCapacity), mIndexAllocator(indexCapacity)
+{
+    glCreateBuffers(1, &mVBO);
+    glNamedBufferStorage(mVBO, static_cast<GLsizeiptr>(vertexCapacity) * mVertexStride, nullptr,
+                         GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &mEBO);
+    glNamedBufferStorage(mEBO, static_cast<GLsizeiptr>(indexCapacity) * mIndexSize, nullptr,
+                         GL_DYNAMIC_STORAGE_BIT);
+
+    glCreateVertexArrays(1, &mVAO);
+    if (mFormat == Core::VertexFormat::Compact)
+    {
+        SetupCompactAttributes();
+    }
+    else
+    {
+        SetupStandardAttributes();
+    }
+    BindBuffers();
+    LogInfo("Create geometry arena: {} vertices ({} bytes each), {} indices ({} bytes each)", vertexCapacity,
+            mVertexStride, indexCapacity, mIndexSize);
+}
+GeometryArena::~GeometryArena()
+{
+    glDeleteVertexArrays(1, &mVAO);
+    glDeleteBuffers(1, &mVBO);
+    glDeleteBuffers(1, &mEBO);
+}
+const GeometryRange *GeometryArena::Find(const Core::UUID &meshID) const
+{
+    if (auto it = mRanges.find(meshID); it != mRanges.end())
+    {
+        return &it->second;
+    }
+    return nullptr;
+}
+const GeometryRange &GeometryArena::Upload(const Core::UUID &meshID, const Core::Mesh &mesh)
+{
+    if (auto it = mRanges.find(meshID); it != mRanges.end())
+    {
+        return it->second;
+    }
+    auto vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+    if (mIndexType == Core::IndexType::UInt16 && vertexCount > Core::MaxUInt16IndexedVertices)
+    {
+        LogError("Mesh {} has {} vertices, too many for 16-bit indices", mesh.Name, vertexCount);
+    }
+    auto lodCount = static_cast<uint32_t>(std::min<size_t>(mesh.Lods.size() + 1, Core::MaxMeshLods));
+    auto indexCount = static_cast<uint32_t>(mesh.Indices.size());
+    for (uint32_t lod = 1; lod < lodCount; lod++)
+    {
+        indexCount += static_cast<uint32_t>(mesh.Lods[lod - 1].Indices.size());
+    }
+    auto baseVertex = mVertexAllocator.Allocate(vertexCount);
+    if (!baseVertex.has_value())
+    {
+        GrowBuffer(mVBO, mVertexAllocator, vertexCount, mVertexStride);
+        baseVertex = mVertexAllocator.Allocate(vertexCount);
+    }
+    auto firstIndex = mIndexAllocator.Allocate(indexCount);
+    if (!firstIndex.has_value())
+    {
+        GrowBuffer(mEBO, mIndexAllocator, indexCount, mIndexSize);
+        firstIndex = mIndexAllocator.Allocate(indexCount);
+    }
+    GeometryRange range{
+        .format = mFormat,
+        .indexType = mIndexType,
+        .baseVertex = baseVertex.value_or(0),
+        .vertexCount = vertexCount,
+        .firstIndex = firstIndex.value_or(0),
+        .indexCount = static_cast<uint32_t>(mesh.Indices.size()),
+        .lodCount = lodCount,
+        .meshlets = mesh.Meshlets,
+    };
+    auto vertexOffset = static_cast<GLintptr>(range.baseVertex) * static_cast<GLintptr>(mVertexStride);
+    auto vertexBytes = static_cast<GLsizeiptr>(vertexCount) * static_cast<GLsizeiptr>(mVertexStride);
+    if (mFormat == Core::VertexFormat::Compact)
+    {
+        range.quantization = Core::ComputePositionQuantization(mesh.Bounds);
+        auto compact = Core::EncodeCompactVertices(mesh.Vertices, range.quantization);
+        glNamedBufferSubData(mVBO, vertexOffset, vertexBytes, compact.data());
+    }
+    else
+    {
+        glNamedBufferSubData(mVBO, vertexOffset, vertexBytes, mesh.Vertices.data());
+    }
+    uint32_t offset = range.firstIndex;
+    for (uint32_t lod = 0; lod < lodCount; lod++)
+    {
+        const auto &indices = lod == 0 ? mesh.Indices : mesh.Lods[lod - 1].Indices;
+        range.lodFirstIndex[lod] = offset;
+        range.lodIndexCount[lod] = static_cast<uint32_t>(indices.size());
+        range.lodErrors[lod] = lod == 0 ? 0.0f : mesh.Lods[lod - 1].Error;
+        auto indexOffset = static_cast<GLintptr>(offset) * static_cast<GLintptr>(mIndexSize);
+        auto indexBytes = static_cast<GLsizeiptr>(indices.size()) * static_cast<GLsizeiptr>(mIndexSize);
+        if (mIndexType == Core::IndexType::UInt16)
+        {
+            // 索引相对网格自身的baseVertex，顶点数不超过65536时可以直接截断
+            std::vector<uint16_t> narrow(indices.begin(), indices.end());
+            glNamedBufferSubData(mEBO, indexOffset, indexBytes, narrow.data());
+        }
+        else
+        {
+            glNamedBufferSubData(mEBO, indexOffset, indexBytes, indices.data());
+        }
+        offset += range.lodIndexCount[lod];
+    }
+    return mRanges.emplace(meshID, range).first->second;
+}
+void GeometryArena::Release(const Core::UUID &meshID)
+{
+    if (auto it = mRanges.find(meshID); it != mRanges.end())
+    {
+        mVertexAllocator.Free(it->second.baseVertex, it->second.vertexCount);
+        mIndexAllocator.Free(it->second.firstIndex, it->second.GetAllocatedIndexCount());
+        mRanges.erase(it);
+    }
+}
+void GeometryArena::GrowBuffer(GLuint &buffer, Core::FreeListAllocator &allocator, uint32_t required, size_t stride)
+{
+    auto oldCapacity = allocator.GetCapacity();
+    auto newCapacity = std::max(oldCapacity * 2, oldCapacity + required);
+    GLuint newBuffer = 0;
+    glCreateBuffers(1, &newBuffer);
+    glNamedBufferStorage(newBuffer, static_cast<GLsizeiptr>(newCapacity) * stride, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    glCopyNamedBufferSubData(buffer, newBuffer, 0, 0, static_cast<GLsizeiptr>(oldCapacity) * stride);
+    glDeleteBuffers(1, &buffer);
+    buffer = newBuffer;
+    allocator.Grow(newCapacity);
+    BindBuffers();
+    LogInfo("Grow geometry arena buffer: {} -> {} elements", oldCapacity, newCapacity);
+}
+void GeometryArena::BindBuffers()
+{
+    glVertexArrayVertexBuffer(mVAO, 0, mVBO, 0, static_cast<GLsizei>(mVertexStride));
+    glVertexArrayElementBuffer(mVAO, mEBO);
+}
+void GeometryArena::SetupStandardAttributes()
+{
+    // position normal texCoord tangent bitangent
+    glEnableVertexArrayAttrib(mVAO, 0);
+    glVertexArrayAttribFormat(mVAO, 0, 3, GL_FLOAT, GL_FALSE, offsetof(Core::Vertex, position));
+    glVertexArrayAttribBinding(mVAO, 0, 0);
+    glEnableVertexArrayAttrib(mVAO, 1);
+    glVertexArrayAttribFormat(mVAO, 1, 3, GL_FLOAT, GL_FALSE, offsetof(Core::Vertex, normal));
+    glVertexArrayAttribBinding(mVAO, 1, 0);
+    glEnableVertexArrayAttrib(mVAO, 2);
+    glVertexArrayAttribFormat(mVAO, 2, 2, GL_FLOAT, GL_FALSE, offsetof(Core::Vertex, texCoord));
+    glVertexArrayAttribBinding(mVAO, 2, 0);
+    glEnableVertexArrayAttrib(mVAO, 3);
+    glVertexArrayAttribFormat(mVAO, 3, 3, GL_FLOAT, GL_FALSE, offsetof(Core::Vertex, tangent));
+    glVertexArrayAttribBinding(mVAO, 3, 0);
+    glEnableVertexArrayAttrib(mVAO, 4);
+    glVertexArrayAttribFormat(mVAO, 4, 3, GL_FLOAT, GL_FALSE, offsetof(Core::Vertex, bitangent));
+    glVertexArrayAttribBinding(mVAO, 4, 0);
+}
+void GeometryArena::SetupCompactAttributes()
+{
+    // 位置为[0,1]的unorm16，反量化由模型矩阵完成；法线为八面体编码，着色器按DrawData::vertexFormat解码
+    glEnableVertexArrayAttrib(mVAO, 0);
+    glVertexArrayAttribFormat(mVAO, 0, 3, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(Core::CompactVertex, position));
+    glVertexArrayAttribBinding(mVAO, 0, 0);
+    glEnableVertexArrayAttrib(mVAO, 1);
+    glVertexArrayAttribFormat(mVAO, 1, 2, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(Core::CompactVertex, normal));
+    glVertexArrayAttribBinding(mVAO, 1, 0);
+    glEnableVertexArrayAttrib(mVAO, 2);
+    glVertexArrayAttribFormat(mVAO, 2, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(Core::CompactVertex, texCoord));
+    glVertexArrayAttribBinding(mVAO, 2, 0);
+    // w为副切线符号，副切线不存储，location 4 保持关闭
+    glEnableVertexArrayAttrib(mVAO, 3);
+    glVertexArrayAttribFormat(mVAO, 3, 4, GL_BYTE, GL_TRUE, offsetof(Core::CompactVertex, tangent));
+    glVertexArrayAttribBinding(mVAO, 3, 0);
+}
+} // namespace Function
+} // namespace MEngine
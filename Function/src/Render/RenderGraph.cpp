@@ -0,0 +1,500 @@
+#include "Render/RenderGraph.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace MEngine
+{
+namespace Function
+{
+namespace
+{
+using Clock = std::chrono::high_resolution_clock;
+float ElapsedMs(Clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+}
+size_t GetFormatSize(GLenum format)
+{
+    switch (format)
+    {
+    case GL_R8:
+        return 1;
+    case GL_RG8:
+    case GL_R16F:
+    case GL_DEPTH_COMPONENT16:
+        return 2;
+    case GL_RGBA16F:
+    case GL_RG32F:
+    case GL_DEPTH32F_STENCIL8:
+        return 8;
+    case GL_RGBA32F:
+        return 16;
+    default:
+        // RGBA8、R11F_G11F_B10F、RGB10_A2、R32F、RG16、RG16F、DEPTH24_STENCIL8、DEPTH_COMPONENT32F 等
+        return 4;
+    }
+}
+bool HasStencil(GLenum format)
+{
+    return format == GL_DEPTH24_STENCIL8 || format == GL_DEPTH32F_STENCIL8;
+}
+} // namespace
+
+size_t RenderGraphTextureDesc::GetSize() const
+{
+    return static_cast<size_t>(width) * height * GetFormatSize(format);
+}
+
+RenderGraphTexture RenderGraphBuilder::CreateTexture(const std::string &name, const RenderGraphTextureDesc &desc)
+{
+    return mGraph.CreateTexture(name, desc);
+}
+void RenderGraphBuilder::Read(RenderGraphTexture texture)
+{
+    mGraph.mPasses[mPass].reads.push_back(texture);
+}
+void RenderGraphBuilder::Write(RenderGraphTexture texture)
+{
+    mGraph.mPasses[mPass].writes.push_back(texture);
+}
+void RenderGraphBuilder::WriteColor(RenderGraphTexture texture, AttachmentLoadOp loadOp, const glm::vec4 &clearColor)
+{
+    auto &attachments = mGraph.mPasses[mPass].colorAttachments;
+    if (attachments.size() >= RenderGraph::MaxColorAttachments)
+    {
+        LogError("Render pass {} has too many color attachments", mGraph.mPasses[mPass].name);
+        return;
+    }
+    attachments.push_back({texture, loadOp, clearColor});
+}
+void RenderGraphBuilder::WriteDepth(RenderGraphTexture texture, AttachmentLoadOp loadOp, float clearDepth)
+{
+    mGraph.mPasses[mPass].depthAttachment = {texture, loadOp, glm::vec4(clearDepth)};
+}
+void RenderGraphBuilder::SetSideEffect()
+{
+    mGraph.mPasses[mPass].sideEffect = true;
+}
+
+GLuint RenderPassContext::GetTexture(RenderGraphTexture texture) const
+{
+    const auto &virtualTexture = mGraph.mTextures[texture.index];
+    if (virtualTexture.imported != 0)
+    {
+        return virtualTexture.imported;
+    }
+    return virtualTexture.physical < mGraph.mPhysicalTextures.size() ? mGraph.mPhysicalTextures[virtualTexture.physical]
+                                                                     : 0;
+}
+const RenderGraphTextureDesc &RenderPassContext::GetDesc(RenderGraphTexture texture) const
+{
+    return mGraph.mTextures[texture.index].desc;
+}
+GLStateCache &RenderPassContext::GetStateCache() const
+{
+    return mGraph.mStateCache;
+}
+
+size_t RenderGraph::FramebufferKeyHash::operator()(const FramebufferKey &key) const
+{
+    size_t hash = key.depth;
+    for (uint32_t i = 0; i < key.colorCount; i++)
+    {
+        hash = hash * 1099511628211ull ^ key.colors[i];
+    }
+    return hash;
+}
+RenderGraph::RenderGraph(GLStateCache &stateCache) : mStateCache(stateCache)
+{
+}
+RenderGraph::~RenderGraph()
+{
+    for (auto &[key, framebuffer] : mFramebuffers)
+    {
+        glDeleteFramebuffers(1, &framebuffer);
+    }
+    for (auto &pooled : mPool)
+    {
+        glDeleteTextures(1, &pooled.texture);
+    }
+}
+void RenderGraph::Reset()
+{
+    mPasses.clear();
+    mTextures.clear();
+    mPhysicalDescs.clear();
+    mPhysicalTextures.clear();
+    mCompiled = false;
+}
+RenderGraphTexture RenderGraph::CreateTexture(const std::string &name, const RenderGraphTextureDesc &desc)
+{
+    mTextures.push_back(VirtualTexture{.name = name, .desc = desc});
+    return RenderGraphTexture{static_cast<uint32_t>(mTextures.size() - 1)};
+}
+RenderGraphTexture RenderGraph::ImportTexture(const std::string &name, GLuint texture,
+                                              const RenderGraphTextureDesc &desc)
+{
+    mTextures.push_back(VirtualTexture{.name = name, .desc = desc, .imported = texture});
+    return RenderGraphTexture{static_cast<uint32_t>(mTextures.size() - 1)};
+}
+uint32_t RenderGraph::AddPass(const std::string &name, const SetupFunction &setup, ExecuteFunction execute)
+{
+    auto index = static_cast<uint32_t>(mPasses.size());
+    mPasses.push_back(Pass{.name = name, .execute = std::move(execute)});
+    RenderGraphBuilder builder(*this, index);
+    setup(builder);
+    mCompiled = false;
+    return index;
+}
+void RenderGraph::Compile()
+{
+    auto start = Clock::now();
+    // 反向遍历：通道写入了后续需要的纹理才保留，用Clear/DontCare覆盖的纹理对更早的写入不再需要
+    std::vector<uint8_t> needed(mTextures.size(), 0);
+    for (size_t i = 0; i < mTextures.size(); i++)
+    {
+        needed[i] = mTextures[i].imported != 0;
+    }
+    for (auto pass = mPasses.rbegin(); pass != mPasses.rend(); ++pass)
+    {
+        bool live = pass->sideEffect;
+        auto visitAttachments = [&](auto &&visitor) {
+            for (auto &attachment : pass->colorAttachments)
+            {
+                visitor(attachment);
+            }
+            if (pass->depthAttachment.texture.IsValid())
+            {
+                visitor(pass->depthAttachment);
+            }
+        };
+        visitAttachments([&](const Attachment &attachment) { live |= needed[attachment.texture.index] != 0; });
+        for (auto write : pass->writes)
+        {
+            live |= needed[write.index] != 0;
+        }
+        pass->culled = !live;
+        if (!live)
+        {
+            continue;
+        }
+        visitAttachments([&](const Attachment &attachment) {
+            needed[attachment.texture.index] = attachment.loadOp == AttachmentLoadOp::Load;
+        });
+        for (auto read : pass->reads)
+        {
+            needed[read.index] = 1;
+        }
+        for (auto write : pass->writes)
+        {
+            needed[write.index] = 1;
+        }
+    }
+
+    // 生命周期：首次和最后一次使用该纹理的未剔除通道
+    for (auto &texture : mTextures)
+    {
+        texture.physical = RenderGraphTexture::Invalid;
+        texture.firstPass = RenderGraphTexture::Invalid;
+        texture.lastPass = 0;
+    }
+    auto use = [&](RenderGraphTexture texture, uint32_t pass) {
+        auto &virtualTexture = mTextures[texture.index];
+        virtualTexture.firstPass = std::min(virtualTexture.firstPass, pass);
+        virtualTexture.lastPass = std::max(virtualTexture.lastPass, pass);
+    };
+    for (uint32_t i = 0; i < mPasses.size(); i++)
+    {
+        auto &pass = mPasses[i];
+        if (pass.culled)
+        {
+            continue;
+        }
+        for (auto read : pass.reads)
+        {
+            use(read, i);
+        }
+        for (auto write : pass.writes)
+        {
+            use(write, i);
+        }
+        for (auto &attachment : pass.colorAttachments)
+        {
+            use(attachment.texture, i);
+        }
+        if (pass.depthAttachment.texture.IsValid())
+        {
+            use(pass.depthAttachment.texture, i);
+        }
+    }
+
+    // 按通道顺序分配物理纹理槽，纹理在最后一次使用后归还，供之后的同描述纹理复用
+    mPhysicalDescs.clear();
+    std::vector<uint32_t> freeSlots;
+    mStats = {};
+    for (uint32_t i = 0; i < mPasses.size(); i++)
+    {
+        if (mPasses[i].culled)
+        {
+            continue;
+        }
+        for (auto &texture : mTextures)
+        {
+            if (texture.imported != 0 || texture.firstPass != i)
+            {
+                continue;
+            }
+            auto slot = std::find_if(freeSlots.begin(), freeSlots.end(),
+                                     [&](uint32_t slot) { return mPhysicalDescs[slot] == texture.desc; });
+            if (slot != freeSlots.end())
+            {
+                texture.physical = *slot;
+                freeSlots.erase(slot);
+            }
+            else
+            {
+                texture.physical = static_cast<uint32_t>(mPhysicalDescs.size());
+                mPhysicalDescs.push_back(texture.desc);
+            }
+            mStats.unaliasedBytes += texture.desc.GetSize();
+        }
+        for (auto &texture : mTextures)
+        {
+            if (texture.physical != RenderGraphTexture::Invalid && texture.lastPass == i)
+            {
+                freeSlots.push_back(texture.physical);
+            }
+        }
+    }
+
+    mStats.passes = static_cast<uint32_t>(mPasses.size());
+    mStats.culledPasses =
+        static_cast<uint32_t>(std::count_if(mPasses.begin(), mPasses.end(), [](const Pass &pass) { return pass.culled; }));
+    mStats.transientTextures = static_cast<uint32_t>(
+        std::count_if(mTextures.begin(), mTextures.end(), [](const VirtualTexture &texture) { return texture.imported == 0; }));
+    mStats.physicalTextures = static_cast<uint32_t>(mPhysicalDescs.size());
+    for (auto &desc : mPhysicalDescs)
+    {
+        mStats.transientBytes += desc.GetSize();
+    }
+    mStats.setupTimeMs = ElapsedMs(start);
+    mCompiled = true;
+}
+void RenderGraph::Execute()
+{
+    if (!mCompiled)
+    {
+        Compile();
+    }
+    auto start = Clock::now();
+    mFrame++;
+    for (auto &pooled : mPool)
+    {
+        pooled.inUse = false;
+    }
+    mPhysicalTextures.clear();
+    for (auto &desc : mPhysicalDescs)
+    {
+        mPhysicalTextures.push_back(AcquireTexture(desc));
+    }
+    mStats.setupTimeMs += ElapsedMs(start);
+
+    RenderPassContext context(*this);
+    for (auto &pass : mPasses)
+    {
+        if (pass.culled)
+        {
+            continue;
+        }
+        auto passStart = Clock::now();
+        BeginPass(pass);
+        mStats.setupTimeMs += ElapsedMs(passStart);
+        if (pass.execute)
+        {
+            pass.execute(context);
+        }
+    }
+    ReleaseIdleTextures();
+    mStats.poolBytes = 0;
+    for (auto &pooled : mPool)
+    {
+        mStats.poolBytes += pooled.desc.GetSize();
+    }
+    mStats.framebuffers = static_cast<uint32_t>(mFramebuffers.size());
+}
+void RenderGraph::ReleaseTexture(GLuint texture)
+{
+    DeleteFramebuffers(texture);
+    // 删除已绑定的纹理会隐式解绑，新纹理可能复用该名字
+    mStateCache.Invalidate();
+}
+GLuint RenderGraph::AcquireTexture(const RenderGraphTextureDesc &desc)
+{
+    for (auto &pooled : mPool)
+    {
+        if (!pooled.inUse && pooled.desc == desc)
+        {
+            pooled.inUse = true;
+            pooled.lastUsedFrame = mFrame;
+            return pooled.texture;
+        }
+    }
+    GLuint texture = 0;
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, 1, desc.format, desc.width, desc.height);
+    glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    mPool.push_back(PooledTexture{texture, desc, mFrame, true});
+    return texture;
+}
+GLuint RenderGraph::GetFramebuffer(const Pass &pass)
+{
+    RenderPassContext context(*this);
+    FramebufferKey key;
+    key.colorCount = static_cast<uint32_t>(pass.colorAttachments.size());
+    for (uint32_t i = 0; i < key.colorCount; i++)
+    {
+        key.colors[i] = context.GetTexture(pass.colorAttachments[i].texture);
+    }
+    if (pass.depthAttachment.texture.IsValid())
+    {
+        key.depth = context.GetTexture(pass.depthAttachment.texture);
+    }
+    if (auto it = mFramebuffers.find(key); it != mFramebuffers.end())
+    {
+        return it->second;
+    }
+    GLuint framebuffer = 0;
+    glCreateFramebuffers(1, &framebuffer);
+    std::array<GLenum, MaxColorAttachments> drawBuffers{};
+    for (uint32_t i = 0; i < key.colorCount; i++)
+    {
+        glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0 + i, key.colors[i], 0);
+        drawBuffers[i] = GL_COLOR_ATTACHMENT0 + i;
+    }
+    if (key.colorCount > 0)
+    {
+        glNamedFramebufferDrawBuffers(framebuffer, static_cast<GLsizei>(key.colorCount), drawBuffers.data());
+    }
+    else
+    {
+        glNamedFramebufferDrawBuffer(framebuffer, GL_NONE);
+    }
+    if (key.depth != 0)
+    {
+        auto format = context.GetDesc(pass.depthAttachment.texture).format;
+        glNamedFramebufferTexture(framebuffer, HasStencil(format) ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT,
+                                  key.depth, 0);
+    }
+    if (glCheckNamedFramebufferStatus(framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        LogError("Framebuffer for render pass {} is not complete!", pass.name);
+    }
+    mFramebuffers.emplace(key, framebuffer);
+    return framebuffer;
+}
+void RenderGraph::BeginPass(const Pass &pass)
+{
+    if (pass.colorAttachments.empty() && !pass.depthAttachment.texture.IsValid())
+    {
+        return;
+    }
+    auto framebuffer = GetFramebuffer(pass);
+    mStateCache.BindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    const auto &first = pass.colorAttachments.empty() ? pass.depthAttachment : pass.colorAttachments.front();
+    const auto &desc = mTextures[first.texture.index].desc;
+    mStateCache.SetViewport(0, 0, static_cast<GLsizei>(desc.width), static_cast<GLsizei>(desc.height));
+
+    std::array<GLenum, MaxColorAttachments + 1> invalidate{};
+    GLsizei invalidateCount = 0;
+    for (uint32_t i = 0; i < pass.colorAttachments.size(); i++)
+    {
+        const auto &attachment = pass.colorAttachments[i];
+        if (attachment.loadOp == AttachmentLoadOp::Clear)
+        {
+            glClearNamedFramebufferfv(framebuffer, GL_COLOR, static_cast<GLint>(i),
+                                      glm::value_ptr(attachment.clearValue));
+        }
+        else if (attachment.loadOp == AttachmentLoadOp::DontCare)
+        {
+            invalidate[invalidateCount++] = GL_COLOR_ATTACHMENT0 + i;
+        }
+    }
+    const auto &depth = pass.depthAttachment;
+    if (depth.texture.IsValid())
+    {
+        bool stencil = HasStencil(mTextures[depth.texture.index].desc.format);
+        if (depth.loadOp == AttachmentLoadOp::Clear)
+        {
+            // 深度清除受深度写入掩码影响
+            mStateCache.SetDepthWrite(true);
+            if (stencil)
+            {
+                glClearNamedFramebufferfi(framebuffer, GL_DEPTH_STENCIL, 0, depth.clearValue.x, 0);
+            }
+            else
+            {
+                glClearNamedFramebufferfv(framebuffer, GL_DEPTH, 0, &depth.clearValue.x);
+            }
+        }
+        else if (depth.loadOp == AttachmentLoadOp::DontCare)
+        {
+            invalidate[invalidateCount++] = stencil ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+        }
+    }
+    if (invalidateCount > 0)
+    {
+        glInvalidateNamedFramebufferData(framebuffer, invalidateCount, invalidate.data());
+    }
+}
+void RenderGraph::ReleaseIdleTextures()
+{
+    bool released = false;
+    for (auto it = mPool.begin(); it != mPool.end();)
+    {
+        if (!it->inUse && mFrame - it->lastUsedFrame > MaxIdleFrames)
+        {
+            DeleteFramebuffers(it->texture);
+            glDeleteTextures(1, &it->texture);
+            it = mPool.erase(it);
+            released = true;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    if (released)
+    {
+        mStateCache.Invalidate();
+    }
+}
+void RenderGraph::DeleteFramebuffers(GLuint texture)
+{
+    for (auto it = mFramebuffers.begin(); it != mFramebuffers.end();)
+    {
+        const auto &key = it->first;
+        bool uses = key.depth == texture ||
+                    std::find(key.colors.begin(), key.colors.begin() + key.colorCount, texture) !=
+                        key.colors.begin() + key.colorCount;
+        if (uses)
+        {
+            if (mStateCache.GetDrawFramebuffer() == it->second)
+            {
+                mStateCache.BindFramebuffer(GL_FRAMEBUFFER, 0);
+            }
+            glDeleteFramebuffers(1, &it->second);
+            it = mFramebuffers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+} // namespace Function
+} // namespace MEngine
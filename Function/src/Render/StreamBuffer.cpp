@@ -0,0 +1,132 @@
+#include "Render/StreamBuffer.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace MEngine
+{
+namespace Function
+{
+namespace
+{
+constexpr GLbitfield StreamFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+// glBindBufferRange 不允许零长度
+constexpr size_t MinAllocationSize = 16;
+} // namespace
+StreamBuffer::StreamBuffer(size_t frameSize)
+{
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &mUniformAlignment);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &mStorageAlignment);
+    CreateBuffer(frameSize);
+}
+StreamBuffer::~StreamBuffer()
+{
+    for (auto &fence : mFences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+    for (auto &retired : mRetiredBuffers)
+    {
+        glDeleteBuffers(1, &retired.buffer);
+    }
+    // 删除缓冲区时会隐式解除映射
+    glDeleteBuffers(1, &mBuffer);
+}
+void StreamBuffer::CreateBuffer(size_t frameSize)
+{
+    mFrameSize = frameSize;
+    glCreateBuffers(1, &mBuffer);
+    auto totalSize = static_cast<GLsizeiptr>(mFrameSize * FrameCount);
+    glNamedBufferStorage(mBuffer, totalSize, nullptr, StreamFlags);
+    mMapped = static_cast<uint8_t *>(glMapNamedBufferRange(mBuffer, 0, totalSize, StreamFlags));
+    if (!mMapped)
+    {
+        LogError("Failed to map stream buffer of {} bytes", totalSize);
+    }
+    LogInfo("Create stream buffer: {} x {} bytes", FrameCount, mFrameSize);
+}
+bool StreamBuffer::WaitFence(GLsync &fence)
+{
+    if (!fence)
+    {
+        return false;
+    }
+    bool stalled = false;
+    GLbitfield flags = 0;
+    GLuint64 timeout = 0;
+    while (true)
+    {
+        auto result = glClientWaitSync(fence, flags, timeout);
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED)
+        {
+            break;
+        }
+        if (result == GL_WAIT_FAILED)
+        {
+            LogError("Stream buffer fence wait failed");
+            break;
+        }
+        // 第一次轮询未完成，说明CPU领先GPU超过FrameCount帧
+        stalled = true;
+        flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        timeout = 1'000'000;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+    return stalled;
+}
+void StreamBuffer::BeginFrame()
+{
+    mFrameNumber++;
+    mFrameIndex = static_cast<uint32_t>(mFrameNumber % FrameCount);
+    auto start = std::chrono::high_resolution_clock::now();
+    if (WaitFence(mFences[mFrameIndex]))
+    {
+        mStallCount++;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    mStallTimeMs = std::chrono::duration<float, std::milli>(end - start).count();
+    mOffset = 0;
+
+    // 等待过该段的栅栏后，FrameCount帧之前换下的缓冲区已不再被GPU使用
+    std::erase_if(mRetiredBuffers, [&](const RetiredBuffer &retired) {
+        if (retired.frame + FrameCount <= mFrameNumber)
+        {
+            glDeleteBuffers(1, &retired.buffer);
+            return true;
+        }
+        return false;
+    });
+}
+void StreamBuffer::EndFrame()
+{
+    mFences[mFrameIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+StreamAllocation StreamBuffer::Allocate(size_t size, size_t alignment)
+{
+    size = std::max(size, MinAllocationSize);
+    size_t offset = (mOffset + alignment - 1) / alignment * alignment;
+    if (offset + size > mFrameSize)
+    {
+        // 本帧已写入的数据仍在旧缓冲区中，保持映射，延迟到GPU用完后删除
+        auto newFrameSize = std::max(mFrameSize * 2, size * 2);
+        LogWarn("Stream buffer overflow, grow frame size from {} to {} bytes", mFrameSize, newFrameSize);
+        mRetiredBuffers.push_back({mBuffer, mFrameNumber});
+        CreateBuffer(newFrameSize);
+        mOffset = 0;
+        offset = 0;
+    }
+    mOffset = offset + size;
+    auto absoluteOffset = mFrameIndex * mFrameSize + offset;
+    return StreamAllocation{
+        .buffer = mBuffer,
+        .offset = static_cast<GLintptr>(absoluteOffset),
+        .size = static_cast<GLsizeiptr>(size),
+        .data = mMapped + absoluteOffset,
+    };
+}
+} // namespace Function
+} // namespace MEngine
@@ -1,69 +1,551 @@
 #include "System/RenderSystem.hpp"
 #include "Asset/Asset.hpp"
+#include "Asset/Model.hpp"
+#include "Asset/PBRMaterial.hpp"
 #include "Component/LightComponent.hpp"
+#include "Component/StaticComponent.hpp"
 #include "Component/TransformComponent.hpp"
 #include "Logger.hpp"
+#include "Shader/ProgramCache.hpp"
+#include "Shader/ShaderVariantCache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <glm/gtc/type_ptr.hpp>
 
 namespace MEngine
 {
-RenderSystem::RenderSystem(std::shared_ptr<entt::registry> registry) : System(registry)
+RenderSystem::RenderSystem(std::shared_ptr<entt::registry> registry, std::shared_ptr<IAssetManager> assetManager)
+    : System(registry, assetManager), mRenderGraph(mStateCache)
 {
 }
 RenderSystem::~RenderSystem()
 {
     glDeleteTextures(1, &ColorAttachment);
-    glDeleteTextures(1, &DepthAttachment);
-    glDeleteFramebuffers(1, &FBO);
-    glDeleteBuffers(1, &LightUBO);
+    DeleteShadowMaps();
+    glDeleteVertexArrays(1, &mEmptyVAO);
+    glDeleteQueries(static_cast<GLsizei>(mGpuTimerQueries.size()), mGpuTimerQueries.data());
 }
 void RenderSystem::Init()
 {
-    glCreateBuffers(1, &LightUBO);
-    glNamedBufferStorage(LightUBO, sizeof(Light) * 8, nullptr, GL_DYNAMIC_STORAGE_BIT);
     CreateFrameBuffer();
-    GLint maxUBOBindings;
-    glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &maxUBOBindings);
-    LogInfo("Max UBO Bindings Supported: {}", maxUBOBindings);
+    // 大多数网格使用16位索引，32位索引和紧凑格式的池初始容量小一些
+    for (auto format : {Core::VertexFormat::Standard, Core::VertexFormat::Compact})
+    {
+        for (auto indexType : {Core::IndexType::UInt16, Core::IndexType::UInt32})
+        {
+            bool common = format == Core::VertexFormat::Standard && indexType == Core::IndexType::UInt16;
+            mGeometryArenas[GetGeometryArenaIndex(format, indexType)] = std::make_unique<GeometryArena>(
+                format, indexType, common ? 1 << 20 : 1 << 18, common ? 1 << 22 : 1 << 20);
+        }
+    }
+    mStreamBuffer = std::make_unique<StreamBuffer>();
+    Core::ProgramCache::Get().SetDirectory(std::filesystem::current_path() / "Library" / "ShaderCache");
+    auto shaderDirectory = std::filesystem::current_path() / "Assets" / "Shaders";
+    // 创建变体缓存时安装支持 #include 的源码加载器
+    auto &variantCache = Editor::ShaderVariantCache::Get();
+    variantCache.GetPreprocessor().AddIncludeDirectory(shaderDirectory);
+    // 回退管线很小，同步编译，其他管线编译完成前用它绘制
+    mFallbackPipeline = std::make_shared<Pipeline>();
+    mFallbackPipeline->Name = "Fallback";
+    mFallbackPipeline->VertexShaderPath = shaderDirectory / "default.vert";
+    mFallbackPipeline->FragmentShaderPath = shaderDirectory / "default.frag";
+    mFallbackPipeline->Compile();
+    // 阴影管线只写深度，同样同步编译
+    mShadowPipeline = std::make_shared<Pipeline>();
+    mShadowPipeline->Name = "Shadow";
+    mShadowPipeline->VertexShaderPath = shaderDirectory / "Shadow.vert";
+    mShadowPipeline->FragmentShaderPath = shaderDirectory / "Shadow.frag";
+    mShadowPipeline->Compile();
+    auto forwardPBR = std::make_shared<Pipeline>();
+    forwardPBR->Name = "ForwardPBR";
+    forwardPBR->VertexShaderPath = shaderDirectory / "ForwardPBR.vert";
+    forwardPBR->FragmentShaderPath = shaderDirectory / "ForwardPBR.frag";
+    // 只声明着色器中实际有分支的关键字，否则会编译出相同的变体
+    forwardPBR->Keywords = {Editor::ShaderKeywords::Shadows};
+    mBasePipelines[PipelineType::ForwardOpaquePBR] = forwardPBR;
+    SetPipeline(PipelineType::ForwardOpaquePBR, variantCache.GetVariant(forwardPBR, 0));
+    // 延迟着色的G-buffer通道与前向共用顶点着色器
+    mGBufferBase = std::make_shared<Pipeline>();
+    mGBufferBase->Name = "GBuffer";
+    mGBufferBase->VertexShaderPath = shaderDirectory / "ForwardPBR.vert";
+    mGBufferBase->FragmentShaderPath = shaderDirectory / "GBuffer.frag";
+    mGBufferPipeline = variantCache.GetVariant(mGBufferBase, 0);
+    mGBufferPipeline->CompileAsync();
+    mDeferredLightingBase = std::make_shared<Pipeline>();
+    mDeferredLightingBase->Name = "DeferredLighting";
+    mDeferredLightingBase->VertexShaderPath = shaderDirectory / "FullscreenTriangle.vert";
+    mDeferredLightingBase->FragmentShaderPath = shaderDirectory / "DeferredLighting.frag";
+    mDeferredLightingBase->Keywords = {Editor::ShaderKeywords::Shadows};
+    mDeferredLightingPipeline = variantCache.GetVariant(mDeferredLightingBase, 0);
+    mDeferredLightingPipeline->CompileAsync();
+    glCreateVertexArrays(1, &mEmptyVAO);
+    glCreateQueries(GL_TIME_ELAPSED, static_cast<GLsizei>(mGpuTimerQueries.size()), mGpuTimerQueries.data());
+    // 静态投射体增删或移动时重绘阴影缓存层，同时重建所在的静态合批
+    mRegistry->on_construct<StaticComponent>().connect<&RenderSystem::OnStaticChanged>(this);
+    mRegistry->on_destroy<StaticComponent>().connect<&RenderSystem::OnStaticChanged>(this);
+    mRegistry->on_update<TransformComponent>().connect<&RenderSystem::OnTransformUpdate>(this);
+    mRegistry->on_construct<MeshComponent>().connect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_update<MeshComponent>().connect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_destroy<MeshComponent>().connect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_construct<MaterialComponent>().connect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_update<MaterialComponent>().connect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_destroy<MaterialComponent>().connect<&RenderSystem::OnStaticSourceChanged>(this);
+}
+void RenderSystem::ReloadShader(const std::filesystem::path &path)
+{
+    auto &variantCache = Editor::ShaderVariantCache::Get();
+    variantCache.OnSourceChanged(path);
+    // 回退管线和阴影管线不在变体缓存中，单独检查
+    auto dependents = variantCache.GetPreprocessor().GetDependents(path);
+    auto usesFile = [&](const std::filesystem::path &stagePath) {
+        return std::find(dependents.begin(), dependents.end(), stagePath.lexically_normal()) != dependents.end();
+    };
+    for (auto &pipeline : {mFallbackPipeline, mShadowPipeline})
+    {
+        if (usesFile(pipeline->VertexShaderPath) || usesFile(pipeline->FragmentShaderPath))
+        {
+            // 异步重编译，完成前继续使用旧program
+            pipeline->Recompile();
+        }
+    }
+}
+void RenderSystem::PollShaderChanges()
+{
+    for (const auto &path : Editor::ShaderVariantCache::Get().GetPreprocessor().PollModifiedFiles())
+    {
+        ReloadShader(path);
+    }
 }
 void RenderSystem::Update(float deltaTime)
 {
-    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
-    GLfloat clearColor[] = {0.2f, 0.3f, 0.3f, 1.0f};
-    GLfloat clearDepth[] = {1.0f};
-    glClearNamedFramebufferfv(FBO, GL_COLOR, 0, clearColor);
-    glClearNamedFramebufferfv(FBO, GL_DEPTH, 0, clearDepth);
-    glEnable(GL_DEPTH_TEST);
+    mFrameStats = {};
+    mStateCache.ResetStats();
+    mStreamBuffer->BeginFrame();
+    PollPipelines();
     GetMainCamera();
+    UpdateStaticBatches();
+    CullScene();
     RenderQueue();
+    BuildLightClusters();
+    UpdateShadows();
     UpdateSource();
-    RenderForwardPass();
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    BuildDrawCommands();
+    BuildRenderGraph();
+    BeginGpuTimer();
+    mRenderGraph.Execute();
+    EndGpuTimer();
+    mStreamBuffer->EndFrame();
+    mFrameStats.streamBytes = static_cast<uint32_t>(mStreamBuffer->GetUsed());
+    mFrameStats.streamStallMs = mStreamBuffer->GetStallTimeMs();
+    mStateCache.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    const auto &graphStats = mRenderGraph.GetStats();
+    mFrameStats.renderPasses = graphStats.passes - graphStats.culledPasses;
+    mFrameStats.culledRenderPasses = graphStats.culledPasses;
+    mFrameStats.renderTargetBytes = graphStats.transientBytes;
+    mFrameStats.renderTargetPoolBytes = graphStats.poolBytes;
+    mFrameStats.renderGraphSetupMs = graphStats.setupTimeMs;
+    const auto &stateStats = mStateCache.GetStats();
+    mFrameStats.stateChanges = stateStats.changes;
+    mFrameStats.redundantStateChanges = stateStats.skipped;
+    mFrameStats.deferred = mDeferredFrame;
+    for (const auto &arena : mGeometryArenas)
+    {
+        mFrameStats.geometryBytes += arena->GetUsedBytes();
+    }
+}
+void RenderSystem::BeginGpuTimer()
+{
+    glBeginQuery(GL_TIME_ELAPSED, mGpuTimerQueries[mGpuTimerFrame % mGpuTimerQueries.size()]);
+}
+void RenderSystem::EndGpuTimer()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+    mGpuTimerFrame++;
+    // 读取环中最早的查询，通常已经完成；未完成时沿用上一次的结果，不等待GPU
+    if (mGpuTimerFrame >= mGpuTimerQueries.size())
+    {
+        auto query = mGpuTimerQueries[mGpuTimerFrame % mGpuTimerQueries.size()];
+        GLint available = 0;
+        glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available)
+        {
+            GLuint64 elapsed = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+            mGpuTimeMs = static_cast<float>(elapsed) / 1e6f;
+        }
+    }
+    mFrameStats.gpuTimeMs = mGpuTimeMs;
 }
 void RenderSystem::Shutdown()
 {
+    mRegistry->on_construct<StaticComponent>().disconnect<&RenderSystem::OnStaticChanged>(this);
+    mRegistry->on_destroy<StaticComponent>().disconnect<&RenderSystem::OnStaticChanged>(this);
+    mRegistry->on_update<TransformComponent>().disconnect<&RenderSystem::OnTransformUpdate>(this);
+    mRegistry->on_construct<MeshComponent>().disconnect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_update<MeshComponent>().disconnect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_destroy<MeshComponent>().disconnect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_construct<MaterialComponent>().disconnect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_update<MaterialComponent>().disconnect<&RenderSystem::OnStaticSourceChanged>(this);
+    mRegistry->on_destroy<MaterialComponent>().disconnect<&RenderSystem::OnStaticSourceChanged>(this);
+}
+void RenderSystem::OnStaticChanged(entt::registry &registry, entt::entity entity)
+{
+    mShadowCascades.InvalidateStatic();
+    mDirtyStaticEntities.push_back(entity);
+}
+void RenderSystem::OnTransformUpdate(entt::registry &registry, entt::entity entity)
+{
+    if (registry.all_of<StaticComponent>(entity))
+    {
+        mShadowCascades.InvalidateStatic();
+        mDirtyStaticEntities.push_back(entity);
+    }
+}
+void RenderSystem::OnStaticSourceChanged(entt::registry &registry, entt::entity entity)
+{
+    if (registry.all_of<StaticComponent>(entity))
+    {
+        mDirtyStaticEntities.push_back(entity);
+    }
+}
+size_t RenderSystem::StaticBatchKeyHash::operator()(const StaticBatchKey &key) const
+{
+    size_t hash = std::hash<const Material *>()(key.material);
+    for (int i = 0; i < 3; i++)
+    {
+        hash = hash * 31 + std::hash<int>()(key.cell[i]);
+    }
+    return hash;
+}
+void RenderSystem::UpdateStaticBatches()
+{
+    if (mRebuildStaticBatches)
+    {
+        mRebuildStaticBatches = false;
+        for (const auto &[entity, key] : mStaticBatchKeys)
+        {
+            mDirtyStaticEntities.push_back(entity);
+        }
+        for (auto entity : mRegistry->view<StaticComponent>())
+        {
+            mDirtyStaticEntities.push_back(entity);
+        }
+    }
+    mDirtyStaticEntities.insert(mDirtyStaticEntities.end(), mPendingStaticEntities.begin(),
+                                mPendingStaticEntities.end());
+    mFrameStats.staticBatchedObjects = static_cast<uint32_t>(mStaticBatchKeys.size());
+    if (mDirtyStaticEntities.empty())
+    {
+        return;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    // 同一实体一帧内可能触发多个信号
+    std::sort(mDirtyStaticEntities.begin(), mDirtyStaticEntities.end());
+    mDirtyStaticEntities.erase(std::unique(mDirtyStaticEntities.begin(), mDirtyStaticEntities.end()),
+                               mDirtyStaticEntities.end());
+    for (auto entity : mDirtyStaticEntities)
+    {
+        RemoveFromStaticBatch(entity);
+        AddToStaticBatch(entity);
+    }
+    mDirtyStaticEntities.clear();
+    for (auto it = mStaticBatches.begin(); it != mStaticBatches.end();)
+    {
+        auto &batch = it->second;
+        if (!batch.dirty)
+        {
+            ++it;
+            continue;
+        }
+        for (const auto &part : batch.parts)
+        {
+            part.arena->Release(part.meshID);
+        }
+        batch.parts.clear();
+        if (batch.entities.empty())
+        {
+            it = mStaticBatches.erase(it);
+            continue;
+        }
+        RebuildStaticBatch(batch);
+        mFrameStats.staticBatchRebuilds++;
+        ++it;
+    }
+    mFrameStats.staticBatchedObjects = static_cast<uint32_t>(mStaticBatchKeys.size());
+    mFrameStats.staticBatchTimeMs =
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+bool RenderSystem::IsStaticBatched(entt::entity entity) const
+{
+    auto index = static_cast<size_t>(entt::to_entity(entity));
+    return index < mEntityStaticBatched.size() && mEntityStaticBatched[index] != 0;
+}
+void RenderSystem::AddToStaticBatch(entt::entity entity)
+{
+    mPendingStaticEntities.erase(entity);
+    if (!mStaticBatchSettings.enabled || !mRegistry->valid(entity) ||
+        !mRegistry->all_of<StaticComponent, TransformComponent, MeshComponent, MaterialComponent>(entity))
+    {
+        return;
+    }
+    auto material = mRegistry->get<MaterialComponent>(entity).materialHandle.Get();
+    UUID meshID;
+    auto mesh = ResolveMesh(mRegistry->get<MeshComponent>(entity), meshID);
+    if (!material || !mesh)
+    {
+        // 资源还在流式加载，之后的帧重试
+        mPendingStaticEntities.insert(entity);
+        return;
+    }
+    // 带簇的稠密网格和大网格保留逐实体的簇级剔除和LOD
+    if (mesh->Indices.empty() || !mesh->Meshlets.empty() ||
+        mesh->Vertices.size() > mStaticBatchSettings.maxSourceVertices)
+    {
+        return;
+    }
+    // 被合并的实体不进入渲染队列，包围体在这里同步，拾取和阴影仍然使用
+    UpdateEntityBounds(entity, *mesh);
+    const auto &worldBounds = mRegistry->get<BoundsComponent>(entity).worldBounds;
+    StaticBatchKey key{
+        .material = material.get(),
+        .cell = Core::StaticBatchBuilder::GetCell((worldBounds.min + worldBounds.max) * 0.5f,
+                                                  mStaticBatchSettings.cellSize),
+    };
+    auto &batch = mStaticBatches[key];
+    batch.material = material;
+    batch.entities.push_back(entity);
+    batch.dirty = true;
+    mStaticBatchKeys[entity] = key;
+    auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= mEntityStaticBatched.size())
+    {
+        mEntityStaticBatched.resize(index + 1, 0);
+    }
+    mEntityStaticBatched[index] = 1;
+}
+void RenderSystem::RemoveFromStaticBatch(entt::entity entity)
+{
+    auto it = mStaticBatchKeys.find(entity);
+    if (it == mStaticBatchKeys.end())
+    {
+        return;
+    }
+    if (auto batch = mStaticBatches.find(it->second); batch != mStaticBatches.end())
+    {
+        std::erase(batch->second.entities, entity);
+        batch->second.dirty = true;
+    }
+    mStaticBatchKeys.erase(it);
+    auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index < mEntityStaticBatched.size())
+    {
+        mEntityStaticBatched[index] = 0;
+    }
+}
+void RenderSystem::RebuildStaticBatch(StaticBatch &batch)
+{
+    std::vector<Core::StaticBatchSource> sources;
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    sources.reserve(batch.entities.size());
+    for (auto entity : batch.entities)
+    {
+        UUID meshID;
+        if (auto mesh = ResolveMesh(mRegistry->get<MeshComponent>(entity), meshID))
+        {
+            sources.push_back({mesh.get(), mRegistry->get<TransformComponent>(entity).modelMatrix});
+            meshes.push_back(std::move(mesh));
+        }
+    }
+    // 合并结果只在GPU上保留，每次重建使用新的ID
+    for (auto &merged : Core::StaticBatchBuilder::Merge(sources, mStaticBatchSettings.maxPositionError))
+    {
+        auto &arena = GetGeometryArena(merged);
+        auto meshID = mUUIDGenerator();
+        arena.Upload(meshID, merged);
+        batch.parts.push_back(StaticBatchPart{meshID, &arena, merged.Bounds});
+    }
+    batch.dirty = false;
+}
+void RenderSystem::UpdateEntityBounds(entt::entity entity, const Mesh &mesh)
+{
+    const auto &transform = mRegistry->get<TransformComponent>(entity);
+    auto &bounds = mRegistry->get_or_emplace<BoundsComponent>(entity);
+    bounds.localBounds = mesh.Bounds;
+    bounds.localSphere = mesh.Sphere;
+    bounds.worldBounds = Core::TransformAABB(mesh.Bounds, transform.modelMatrix);
+    bounds.worldSphere = Core::TransformBoundingSphere(mesh.Sphere, transform.modelMatrix);
+    bounds.dirty = true;
+    mRegistry->get<MeshComponent>(entity).dirty = false;
+}
+void RenderSystem::BuildRenderGraph()
+{
+    mRenderGraph.Reset();
+    auto width = static_cast<uint32_t>(mFrameBufferWidth);
+    auto height = static_cast<uint32_t>(mFrameBufferHeight);
+    auto sceneColor = mRenderGraph.ImportTexture("SceneColor", ColorAttachment, {width, height, GL_RGBA8});
+    RenderGraphTexture shadowMap;
+    if (mShadowLight.enabled)
+    {
+        // 阴影贴图各层由逐层帧缓冲写入，不作为通道附件
+        shadowMap = mRenderGraph.ImportTexture("ShadowMap", mShadowMap,
+                                               {mShadowMapResolution, mShadowMapResolution, GL_DEPTH_COMPONENT32F});
+        mRenderGraph.AddPass(
+            "Shadow", [&](RenderGraphBuilder &builder) { builder.Write(shadowMap); },
+            [this](RenderPassContext &) { RenderShadowPass(); });
+    }
+    const glm::vec4 clearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    mDeferredFrame = mMainCamera.renderPath == RenderPath::Deferred && mGBufferPipeline->IsReady() &&
+                     mDeferredLightingPipeline->IsReady();
+    if (!mDeferredFrame)
+    {
+        mRenderGraph.AddPass(
+            "Forward",
+            [&](RenderGraphBuilder &builder) {
+                if (shadowMap.IsValid())
+                {
+                    builder.Read(shadowMap);
+                }
+                auto sceneDepth = builder.CreateTexture("SceneDepth", {width, height, GL_DEPTH24_STENCIL8});
+                builder.WriteColor(sceneColor, AttachmentLoadOp::Clear, clearColor);
+                builder.WriteDepth(sceneDepth, AttachmentLoadOp::Clear);
+            },
+            [this](RenderPassContext &) {
+                mStateCache.SetDepthTest(true);
+                mStateCache.SetDepthWrite(true);
+                RenderForwardPass();
+            });
+        mRenderGraph.Compile();
+        return;
+    }
+
+    // G-buffer通道同时把环境光和自发光写入场景颜色，光照通道在其上叠加
+    RenderGraphTexture sceneDepth, albedo, normal, material;
+    mRenderGraph.AddPass(
+        "GBuffer",
+        [&](RenderGraphBuilder &builder) {
+            sceneDepth = builder.CreateTexture("SceneDepth", {width, height, GL_DEPTH24_STENCIL8});
+            albedo = builder.CreateTexture("GBufferAlbedo", {width, height, GL_RGBA8});
+            normal = builder.CreateTexture("GBufferNormal", {width, height, GL_RG16});
+            material = builder.CreateTexture("GBufferMaterial", {width, height, GL_RG8});
+            // 背景像素由深度判断后跳过，G-buffer无需清除
+            builder.WriteColor(sceneColor, AttachmentLoadOp::Clear, clearColor);
+            builder.WriteColor(albedo, AttachmentLoadOp::DontCare);
+            builder.WriteColor(normal, AttachmentLoadOp::DontCare);
+            builder.WriteColor(material, AttachmentLoadOp::DontCare);
+            builder.WriteDepth(sceneDepth, AttachmentLoadOp::Clear);
+        },
+        [this](RenderPassContext &) {
+            mStateCache.SetDepthTest(true);
+            mStateCache.SetDepthWrite(true);
+            RenderGBufferPass();
+        });
+    mRenderGraph.AddPass(
+        "DeferredLighting",
+        [&](RenderGraphBuilder &builder) {
+            for (auto texture : {sceneDepth, albedo, normal, material})
+            {
+                builder.Read(texture);
+            }
+            if (shadowMap.IsValid())
+            {
+                builder.Read(shadowMap);
+            }
+            builder.WriteColor(sceneColor);
+        },
+        [this, sceneDepth, albedo, normal, material](RenderPassContext &context) {
+            RenderDeferredLightingPass({context.GetTexture(sceneDepth), context.GetTexture(albedo),
+                                        context.GetTexture(normal), context.GetTexture(material)});
+        });
+    // 透明等不写入G-buffer的物体在光照之后前向绘制，复用G-buffer通道的深度
+    bool hasForwardBatches = std::any_of(mDrawBatches.begin(), mDrawBatches.end(),
+                                         [this](const DrawBatch &batch) { return !IsDeferredBatch(batch); });
+    if (hasForwardBatches)
+    {
+        mRenderGraph.AddPass(
+            "Forward",
+            [&](RenderGraphBuilder &builder) {
+                if (shadowMap.IsValid())
+                {
+                    builder.Read(shadowMap);
+                }
+                builder.WriteColor(sceneColor);
+                builder.WriteDepth(sceneDepth);
+            },
+            [this](RenderPassContext &) {
+                mStateCache.SetDepthTest(true);
+                mStateCache.SetDepthWrite(true);
+                RenderForwardPass();
+            });
+    }
+    mRenderGraph.Compile();
+}
+void RenderSystem::SetPipeline(PipelineType type, std::shared_ptr<Pipeline> pipeline)
+{
+    if (pipeline->GetCompileStatus() == PipelineCompileStatus::NotCompiled)
+    {
+        pipeline->CompileAsync();
+    }
+    mPipelines[type] = pipeline;
+}
+void RenderSystem::PollPipelines()
+{
+    // 不支持并行编译时每帧只完成一个管线，把阻塞分摊到多帧
+    bool parallel = Pipeline::SupportsParallelCompile();
+    bool finished = false;
+    auto poll = [&](Pipeline &pipeline) {
+        if (pipeline.GetCompileStatus() != PipelineCompileStatus::Compiling)
+        {
+            return;
+        }
+        if ((parallel || !finished) && pipeline.IsCompileComplete())
+        {
+            pipeline.FinishCompile();
+            finished = true;
+        }
+        else
+        {
+            mFrameStats.compilingPipelines++;
+        }
+    };
+    for (auto &[type, pipeline] : mPipelines)
+    {
+        poll(*pipeline);
+    }
+    // 延迟着色、回退和阴影管线不属于任何材质管线类型，单独检查
+    poll(*mGBufferPipeline);
+    poll(*mDeferredLightingPipeline);
+    poll(*mFallbackPipeline);
+    poll(*mShadowPipeline);
+}
+Pipeline *RenderSystem::GetActivePipeline(PipelineType type) const
+{
+    if (auto it = mPipelines.find(type); it != mPipelines.end() && it->second->IsReady())
+    {
+        return it->second.get();
+    }
+    if (mFallbackPipeline && mFallbackPipeline->IsReady())
+    {
+        return mFallbackPipeline.get();
+    }
+    return nullptr;
 }
 void RenderSystem::CreateFrameBuffer(int width, int height)
 {
-    if (FBO != 0)
+    if (ColorAttachment != 0)
     {
+        if (width == mFrameBufferWidth && height == mFrameBufferHeight)
+        {
+            return;
+        }
+        mRenderGraph.ReleaseTexture(ColorAttachment);
         glDeleteTextures(1, &ColorAttachment);
-        glDeleteTextures(1, &DepthAttachment);
-        glDeleteFramebuffers(1, &FBO);
-        FBO = 0;
+        ColorAttachment = 0;
     }
-    glCreateFramebuffers(1, &FBO);
+    mFrameBufferWidth = width;
+    mFrameBufferHeight = height;
     glCreateTextures(GL_TEXTURE_2D, 1, &ColorAttachment);
     glTextureStorage2D(ColorAttachment, 1, GL_RGBA8, width, height);
-    glCreateTextures(GL_TEXTURE_2D, 1, &DepthAttachment);
-    glTextureStorage2D(DepthAttachment, 1, GL_DEPTH24_STENCIL8, width, height);
-
-    glNamedFramebufferTexture(FBO, GL_COLOR_ATTACHMENT0, ColorAttachment, 0);
-    glNamedFramebufferTexture(FBO, GL_DEPTH_STENCIL_ATTACHMENT, DepthAttachment, 0);
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-    {
-        LogError("Framebuffer is not complete!");
-    }
-    glViewport(0, 0, width, height);
     LogInfo("Create framebuffer: {}x{}", width, height);
 }
 void RenderSystem::GetMainCamera()
@@ -88,6 +570,96 @@ void RenderSystem::GetMainCamera()
         }
     }
 }
+void RenderSystem::CullScene()
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    auto view = mRegistry->view<BoundsComponent, MeshComponent>();
+    mCullEntities.clear();
+    mFrustumCuller.Clear();
+    mFrustumCuller.Reserve(view.size_hint());
+    for (auto entity : view)
+    {
+        if (IsStaticBatched(entity))
+        {
+            continue;
+        }
+        mCullEntities.push_back(entity);
+        mFrustumCuller.Add(view.get<BoundsComponent>(entity).worldBounds);
+    }
+    auto viewProjection = mMainCamera.projectionMatrix * mMainCamera.viewMatrix;
+    auto frustum = Core::Frustum::FromMatrix(viewProjection);
+    mFrustumCuller.Cull(frustum);
+
+    std::fill(mEntityVisibility.begin(), mEntityVisibility.end(), 1);
+    for (size_t i = 0; i < mCullEntities.size(); i++)
+    {
+        auto index = static_cast<size_t>(entt::to_entity(mCullEntities[i]));
+        if (index >= mEntityVisibility.size())
+        {
+            mEntityVisibility.resize(index + 1, 1);
+        }
+        mEntityVisibility[index] = mFrustumCuller.IsVisible(i) ? 1 : 0;
+    }
+    mFrameStats.visibleObjects = static_cast<uint32_t>(mFrustumCuller.GetVisibleCount());
+    mFrameStats.culledObjects = static_cast<uint32_t>(mFrustumCuller.GetCulledCount());
+    mFrameStats.cullTimeMs =
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    CullOccluded(viewProjection);
+}
+void RenderSystem::CullOccluded(const glm::mat4 &viewProjection)
+{
+    auto occluders = mRegistry->view<OccluderComponent, TransformComponent, MeshComponent>();
+    if (occluders.begin() == occluders.end())
+    {
+        return;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    mOcclusionCuller.BeginFrame(viewProjection);
+    for (auto entity : occluders)
+    {
+        if (!IsEntityVisible(entity))
+        {
+            continue;
+        }
+        UUID meshID;
+        if (auto mesh = ResolveMesh(occluders.get<MeshComponent>(entity), meshID))
+        {
+            mOcclusionCuller.AddOccluder(mesh->Vertices, mesh->Indices,
+                                         occluders.get<TransformComponent>(entity).modelMatrix);
+        }
+    }
+    mOcclusionCuller.Rasterize();
+
+    // 只测试通过视锥剔除的非遮挡体
+    mOccludeeBounds.clear();
+    mOccludeeVisibility.clear();
+    for (size_t i = 0; i < mCullEntities.size(); i++)
+    {
+        auto entity = mCullEntities[i];
+        bool candidate = mFrustumCuller.IsVisible(i) && !mRegistry->all_of<OccluderComponent>(entity);
+        mOccludeeBounds.push_back(mRegistry->get<BoundsComponent>(entity).worldBounds);
+        mOccludeeVisibility.push_back(candidate ? 1 : 0);
+    }
+    mOcclusionCuller.Cull(mOccludeeBounds, mOccludeeVisibility);
+    for (size_t i = 0; i < mCullEntities.size(); i++)
+    {
+        if (mFrustumCuller.IsVisible(i) && !mOccludeeVisibility[i] &&
+            !mRegistry->all_of<OccluderComponent>(mCullEntities[i]))
+        {
+            mEntityVisibility[static_cast<size_t>(entt::to_entity(mCullEntities[i]))] = 0;
+            mFrameStats.occludedObjects++;
+        }
+    }
+    mFrameStats.visibleObjects -= mFrameStats.occludedObjects;
+    mFrameStats.occluderTriangles = mOcclusionCuller.GetTriangleCount();
+    mFrameStats.occlusionTimeMs =
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+bool RenderSystem::IsEntityVisible(entt::entity entity) const
+{
+    auto index = static_cast<size_t>(entt::to_entity(entity));
+    return index >= mEntityVisibility.size() || mEntityVisibility[index] != 0;
+}
 void RenderSystem::UpdateSource()
 {
     // auto materialView = mRegistry->view<MaterialComponent>();
@@ -113,93 +685,716 @@ void RenderSystem::UpdateSource()
 
 void RenderSystem::RenderQueue()
 {
-    // mRenderQueue.clear();
-    // auto entities = mRegistry->view<TransformComponent, MeshComponent, MaterialComponent>();
-    // for (auto entity : entities)
-    // {
-    //     auto &materialComponent = mRegistry->get<MaterialComponent>(entity);
-    //     auto materialID = materialComponent.materialID;
-    //     std::shared_ptr<Material> material;
-    //     switch (materialComponent.type)
-    //     {
-    //     case MaterialType::Standard:
-    //         material = mResourceManager->GetAsset<StandardMaterial>(materialID);
-    //         break;
-    //     case MaterialType::PBR:
-    //         material = mResourceManager->GetAsset<PBRMaterial>(materialID);
-    //         break;
-    //     case MaterialType::Phong:
-    //         break;
-    //     }
-    //     mRenderQueue[material->PipelineID].push_back(entity);
-    // }
+    for (auto &[pipelineType, items] : mRenderQueue)
+    {
+        items.clear();
+    }
+    mMaterialData.clear();
+    mMaterialIndices.clear();
+    auto entities = mRegistry->view<TransformComponent, MeshComponent, MaterialComponent>();
+    for (auto entity : entities)
+    {
+        if (IsStaticBatched(entity) || !IsEntityVisible(entity))
+        {
+            continue;
+        }
+        auto &meshComponent = entities.get<MeshComponent>(entity);
+        auto &materialComponent = entities.get<MaterialComponent>(entity);
+        std::shared_ptr<Material> material = materialComponent.materialHandle.Get();
+        if (!material)
+        {
+            material = mDefaultMaterial;
+        }
+        if (!material)
+        {
+            continue;
+        }
+        UUID meshID;
+        auto mesh = ResolveMesh(meshComponent, meshID);
+        if (!mesh || mesh->Indices.empty())
+        {
+            continue;
+        }
+        // 网格变化时同步模型空间包围体，世界包围体随后只在变换改变时更新
+        if (meshComponent.dirty)
+        {
+            UpdateEntityBounds(entity, *mesh);
+            if (mRegistry->all_of<StaticComponent>(entity))
+            {
+                mShadowCascades.InvalidateStatic();
+            }
+        }
+        // 首次出现的网格上传到共享几何池
+        auto &arena = GetGeometryArena(*mesh);
+        const auto &range = arena.Upload(meshID, *mesh);
+        mRenderQueue[material->PipelineType].push_back(DrawItem{
+            .entity = entity,
+            .meshID = meshID,
+            .arena = &arena,
+            .materialIndex = GetMaterialIndex(material),
+            .lod = SelectEntityLod(entity, range),
+        });
+    }
+    // 静态合批按合并网格的世界包围盒剔除
+    auto frustum = Core::Frustum::FromMatrix(mMainCamera.projectionMatrix * mMainCamera.viewMatrix);
+    for (const auto &[key, batch] : mStaticBatches)
+    {
+        for (const auto &part : batch.parts)
+        {
+            if (!frustum.Intersects(part.bounds))
+            {
+                mFrameStats.culledStaticBatches++;
+                continue;
+            }
+            mRenderQueue[batch.material->PipelineType].push_back(DrawItem{
+                .entity = entt::null,
+                .meshID = part.meshID,
+                .arena = part.arena,
+                .materialIndex = GetMaterialIndex(batch.material),
+                .lod = 0,
+            });
+            mFrameStats.staticBatches++;
+        }
+    }
 }
-void RenderSystem::RenderDeferredPass()
+uint32_t RenderSystem::SelectEntityLod(entt::entity entity, const GeometryRange &range)
 {
+    auto index = static_cast<size_t>(entt::to_entity(entity));
+    if (index >= mEntityLods.size())
+    {
+        mEntityLods.resize(index + 1, 0);
+    }
+    uint32_t lod = 0;
+    if (range.lodCount > 1)
+    {
+        // 误差相对于包围球半径，物体缩放后不需要换算
+        const auto &sphere = mRegistry->get<BoundsComponent>(entity).worldSphere;
+        auto viewPosition = glm::vec3(mMainCamera.viewMatrix * glm::vec4(sphere.center, 1.0f));
+        float size = Core::ProjectSphereSize(viewPosition, sphere.radius, mMainCamera.projectionMatrix,
+                                             static_cast<float>(mFrameBufferHeight));
+        lod = Core::SelectLod(range.GetLodErrors(), size, mEntityLods[index], mLodSettings);
+    }
+    if (lod > 0)
+    {
+        mFrameStats.lodObjects++;
+    }
+    mEntityLods[index] = static_cast<uint8_t>(lod);
+    return lod;
 }
-void RenderSystem::RenderForwardPass()
+std::shared_ptr<Mesh> RenderSystem::ResolveMesh(const MeshComponent &meshComponent, UUID &meshID) const
+{
+    auto model = std::dynamic_pointer_cast<Model>(mAssetManager->GetAssetByID(meshComponent.modelID));
+    if (!model || meshComponent.meshIndex < 0 || meshComponent.meshIndex >= static_cast<int>(model->Meshes.size()))
+    {
+        return nullptr;
+    }
+    meshID = model->Meshes[meshComponent.meshIndex];
+    return std::dynamic_pointer_cast<Mesh>(mAssetManager->GetAssetByID(meshID));
+}
+uint32_t RenderSystem::GetMaterialIndex(const std::shared_ptr<Material> &material)
+{
+    if (auto it = mMaterialIndices.find(material.get()); it != mMaterialIndices.end())
+    {
+        return it->second;
+    }
+    MaterialData data;
+    if (auto pbr = std::dynamic_pointer_cast<PBRMaterial>(material))
+    {
+        auto &parameters = pbr->Parameters;
+        data.albedo = glm::vec4(parameters.albedo, 1.0f);
+        data.emissive = glm::vec4(parameters.emissive, 1.0f);
+        data.parameters =
+            glm::vec4(parameters.metallic, parameters.roughness, parameters.ao, parameters.emissiveIntensity);
+    }
+    auto index = static_cast<uint32_t>(mMaterialData.size());
+    mMaterialData.push_back(data);
+    mMaterialIndices[material.get()] = index;
+    return index;
+}
+void RenderSystem::BuildLightClusters()
 {
+    auto start = std::chrono::high_resolution_clock::now();
+    mPackedLights.clear();
+    mShadowLight = {};
+    uint32_t directionalCount = 0;
     auto lightView = mRegistry->view<LightComponent, TransformComponent>();
-    int count = 0;
-    std::vector<Light> lights;
     for (auto entity : lightView)
     {
-        Light light;
-        if (count > 8)
-            return;
         auto &lightComponent = lightView.get<LightComponent>(entity);
-        auto &lightTransformComponent = lightView.get<TransformComponent>(entity);
-        light.color = lightComponent.Color;
-        light.position = lightTransformComponent.worldPosition;
+        auto &transformComponent = lightView.get<TransformComponent>(entity);
+        Core::PackedLight light;
+        light.positionRange = glm::vec4(transformComponent.worldPosition, lightComponent.Radius);
+        light.colorIntensity = glm::vec4(lightComponent.Color, lightComponent.Intensity);
+        auto direction = transformComponent.worldRotation * glm::vec3(0, 0, -1);
         switch (lightComponent.LightType)
         {
-        case LightType::Directional: {
-            light.type = 0;
-            light.direction = lightTransformComponent.worldRotation * glm::vec3(0, 0, -1);
+        case LightType::Directional:
+            light.directionType = glm::vec4(direction, static_cast<float>(Core::PackedLightType::Directional));
+            // 光源网格按输入顺序排列方向光，计数即该光源在方向光部分中的索引
+            if (lightComponent.CastShadows && !mShadowLight.enabled)
+            {
+                mShadowLight = ShadowLight{
+                    .enabled = true,
+                    .directionalIndex = directionalCount,
+                    .direction = direction,
+                    .bias = lightComponent.ShadowBias,
+                    .normalBias = lightComponent.ShadowNormalBias,
+                    .distance = lightComponent.ShadowDistance,
+                };
+            }
+            directionalCount++;
             break;
-        }
-        case LightType::Point: {
-            light.type = 1;
-            light.radius = 10;
+        case LightType::Point:
+            light.directionType = glm::vec4(direction, static_cast<float>(Core::PackedLightType::Point));
             break;
-        }
-        case LightType::Spot: {
+        case LightType::Spot:
+            light.directionType = glm::vec4(direction, static_cast<float>(Core::PackedLightType::Spot));
+            light.spotAngles = glm::vec4(std::cos(glm::radians(lightComponent.InnerAngle)),
+                                         std::cos(glm::radians(lightComponent.OuterAngle)), 0.0f, 0.0f);
             break;
         }
-        }
-        count++;
-        lights.push_back(light);
+        mPackedLights.push_back(light);
     }
-    // for (auto [pipelineID, entities] : mRenderQueue)
-    // {
-    //     auto pipeline = mResourceManager->GetAsset<Pipeline>(pipelineID);
-    //     auto program = pipeline->programID;
-    //     glUseProgram(program);
-    //     glProgramUniformMatrix4fv(program, 0, 1, GL_FALSE,
-    //                               glm::value_ptr(mMainCamera.viewMatrix)); // layout(location = 1)
-    //     glProgramUniformMatrix4fv(program, 1, 1, GL_FALSE,
-    //                               glm::value_ptr(mMainCamera.projectionMatrix)); // layout(location = 2)
-
-    //     // glProgramUniform3f(program,3,1,GL_FALSE,glm::value_ptr(lights[0].color));
+    mLightGrid.Build(mPackedLights, mMainCamera.viewMatrix, mMainCamera.projectionMatrix, mMainCamera.nearPlane,
+                     mMainCamera.farPlane);
+    const auto &lights = mLightGrid.GetLights();
+    const auto &clusters = mLightGrid.GetClusters();
+    const auto &indices = mLightGrid.GetLightIndices();
+    mLightAllocation = mStreamBuffer->WriteStorage(lights);
+    mClusterAllocation = mStreamBuffer->WriteStorage(clusters);
+    mLightIndexAllocation = mStreamBuffer->WriteStorage(indices);
+    auto end = std::chrono::high_resolution_clock::now();
+    mFrameStats.lights = static_cast<uint32_t>(lights.size());
+    mFrameStats.maxLightsPerCluster = mLightGrid.GetMaxLightsPerCluster();
+    mFrameStats.lightAssignTimeMs = std::chrono::duration<float, std::milli>(end - start).count();
+}
+void RenderSystem::UpdateShadows()
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    SetShadowVariants(mShadowLight.enabled);
+    mShadowCasters.clear();
+    if (!mShadowLight.enabled)
+    {
+        return;
+    }
+    auto config = mShadowCascades.GetConfig();
+    if (config.shadowDistance != mShadowLight.distance)
+    {
+        config.shadowDistance = mShadowLight.distance;
+        mShadowCascades.SetConfig(config);
+    }
+    if (mShadowMapResolution != mShadowCascades.GetConfig().resolution)
+    {
+        CreateShadowMaps(mShadowCascades.GetConfig().resolution);
+    }
+    mShadowCascades.Update(mMainCamera.viewMatrix, mMainCamera.projectionMatrix, mMainCamera.nearPlane,
+                           mMainCamera.farPlane, mShadowLight.direction);
 
-    //     for (auto entity : entities)
-    //     {
-    //         auto &transformComponent = mRegistry->get<TransformComponent>(entity);
-    //         auto &meshComponent = mRegistry->get<MeshComponent>(entity);
-    //         auto &materialComponent = mRegistry->get<MaterialComponent>(entity);
-    //         auto materialID = materialComponent.materialID;
-    //         auto modelID = meshComponent.modelID;
-    //         auto meshIndex = meshComponent.meshIndex;
-    //         auto model = mResourceManager->GetAsset<Model>(modelID);
-    //         auto mesh = model->Meshes[meshIndex];
-    //         glm::mat4 modelMatrix = transformComponent.modelMatrix;
-    //         glProgramUniformMatrix4fv(program, 2, 1, GL_FALSE, glm::value_ptr(modelMatrix)); // layout(location =
-    //         glBindVertexArray(mesh->VAO);
-    //         glDrawElements(GL_TRIANGLES, mesh->Indices.size(), GL_UNSIGNED_INT, nullptr);
-    //     }
-    // }
+    // 相机之外的物体也可能投射阴影，不使用相机的剔除结果
+    auto casters = mRegistry->view<TransformComponent, MeshComponent, MaterialComponent, BoundsComponent>();
+    for (auto entity : casters)
+    {
+        UUID meshID;
+        auto mesh = ResolveMesh(casters.get<MeshComponent>(entity), meshID);
+        if (!mesh || mesh->Indices.empty())
+        {
+            continue;
+        }
+        auto &arena = GetGeometryArena(*mesh);
+        mShadowCasters.push_back(ShadowCaster{
+            .arena = &arena,
+            .range = &arena.Upload(meshID, *mesh),
+            .entity = entity,
+            .bounds = casters.get<BoundsComponent>(entity).worldBounds,
+            .isStatic = mRegistry->all_of<StaticComponent>(entity),
+        });
+    }
+    // 同一几何池、同一网格相邻，绘制时合并为一条实例化命令
+    std::sort(mShadowCasters.begin(), mShadowCasters.end(), [](const ShadowCaster &a, const ShadowCaster &b) {
+        if (a.arena != b.arena)
+        {
+            return a.arena < b.arena;
+        }
+        return a.range->firstIndex < b.range->firstIndex;
+    });
+    mFrameStats.shadowTimeMs +=
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+void RenderSystem::SetShadowVariants(bool enabled)
+{
+    if (enabled == mShadowVariantsEnabled)
+    {
+        return;
+    }
+    mShadowVariantsEnabled = enabled;
+    auto &variantCache = Editor::ShaderVariantCache::Get();
+    for (auto &[type, base] : mBasePipelines)
+    {
+        uint32_t mask = enabled ? Editor::ShaderVariantCache::GetKeywordMask(*base, {Editor::ShaderKeywords::Shadows})
+                                : 0;
+        SetPipeline(type, variantCache.GetVariant(base, mask));
+    }
+    uint32_t lightingMask =
+        enabled ? Editor::ShaderVariantCache::GetKeywordMask(*mDeferredLightingBase, {Editor::ShaderKeywords::Shadows})
+                : 0;
+    mDeferredLightingPipeline = variantCache.GetVariant(mDeferredLightingBase, lightingMask);
+    if (mDeferredLightingPipeline->GetCompileStatus() == PipelineCompileStatus::NotCompiled)
+    {
+        mDeferredLightingPipeline->CompileAsync();
+    }
+}
+void RenderSystem::CreateShadowMaps(uint32_t resolution)
+{
+    DeleteShadowMaps();
+    mShadowMapResolution = resolution;
+    auto size = static_cast<GLsizei>(resolution);
+    auto layers = static_cast<GLsizei>(Core::CascadedShadowMap::MaxCascades);
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &mStaticShadowMap);
+    glTextureStorage3D(mStaticShadowMap, 1, GL_DEPTH_COMPONENT32F, size, size, layers);
+    glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &mShadowMap);
+    glTextureStorage3D(mShadowMap, 1, GL_DEPTH_COMPONENT32F, size, size, layers);
+    // 硬件比较加线性过滤，每次采样即是2x2 PCF
+    glTextureParameteri(mShadowMap, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(mShadowMap, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTextureParameteri(mShadowMap, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(mShadowMap, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTextureParameteri(mShadowMap, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTextureParameteri(mShadowMap, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    for (GLint layer = 0; layer < layers; layer++)
+    {
+        glCreateFramebuffers(1, &mStaticShadowFramebuffers[layer]);
+        glNamedFramebufferTextureLayer(mStaticShadowFramebuffers[layer], GL_DEPTH_ATTACHMENT, mStaticShadowMap, 0,
+                                       layer);
+        glNamedFramebufferDrawBuffer(mStaticShadowFramebuffers[layer], GL_NONE);
+        glCreateFramebuffers(1, &mShadowFramebuffers[layer]);
+        glNamedFramebufferTextureLayer(mShadowFramebuffers[layer], GL_DEPTH_ATTACHMENT, mShadowMap, 0, layer);
+        glNamedFramebufferDrawBuffer(mShadowFramebuffers[layer], GL_NONE);
+    }
+    mShadowLayerMatchesStatic.fill(false);
+    mShadowCascades.InvalidateStatic();
+    LogInfo("Create shadow maps: {}x{}x{}", resolution, resolution, layers);
+}
+void RenderSystem::DeleteShadowMaps()
+{
+    if (mShadowMap == 0)
+    {
+        return;
+    }
+    // 删除前解绑，避免状态缓存记着已删除的名字
+    mStateCache.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    mStateCache.BindTexture(8, 0);
+    glDeleteFramebuffers(static_cast<GLsizei>(mShadowFramebuffers.size()), mShadowFramebuffers.data());
+    glDeleteFramebuffers(static_cast<GLsizei>(mStaticShadowFramebuffers.size()), mStaticShadowFramebuffers.data());
+    glDeleteTextures(1, &mShadowMap);
+    glDeleteTextures(1, &mStaticShadowMap);
+    mShadowFramebuffers.fill(0);
+    mStaticShadowFramebuffers.fill(0);
+    mShadowMap = 0;
+    mStaticShadowMap = 0;
+    mShadowMapResolution = 0;
+}
+void RenderSystem::RenderShadowPass()
+{
+    if (!mShadowPipeline->IsReady())
+    {
+        return;
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    auto size = static_cast<GLsizei>(mShadowMapResolution);
+    mStateCache.UseProgram(mShadowPipeline->GetProgram());
+    mStateCache.SetBlend(false);
+    mStateCache.SetDepthTest(true);
+    mStateCache.SetDepthWrite(true);
+    mStateCache.SetViewport(0, 0, size, size);
+    const float clearDepth = 1.0f;
+    for (uint32_t cascade = 0; cascade < mShadowCascades.GetCascadeCount(); cascade++)
+    {
+        const auto &viewProjection = mShadowCascades.GetCascade(cascade).viewProjection;
+        // 静态层只在级联矩阵（按texel取整后）变化或静态投射体变化时重绘
+        if (mShadowCascades.NeedsStaticUpdate(cascade))
+        {
+            mStateCache.BindFramebuffer(GL_FRAMEBUFFER, mStaticShadowFramebuffers[cascade]);
+            glClearNamedFramebufferfv(mStaticShadowFramebuffers[cascade], GL_DEPTH, 0, &clearDepth);
+            CollectShadowCasters(viewProjection, true);
+            DrawShadowCasters(viewProjection);
+            mShadowCascades.MarkStaticUpdated(cascade);
+            mShadowLayerMatchesStatic[cascade] = false;
+            mFrameStats.staticShadowUpdates++;
+        }
+        // 没有动态投射体且最终层已是静态层的副本时，整层都不用动
+        bool hasDynamic = CollectShadowCasters(viewProjection, false) > 0;
+        if (!hasDynamic && mShadowLayerMatchesStatic[cascade])
+        {
+            continue;
+        }
+        glCopyImageSubData(mStaticShadowMap, GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(cascade), mShadowMap,
+                           GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(cascade), size, size, 1);
+        mShadowLayerMatchesStatic[cascade] = !hasDynamic;
+        if (hasDynamic)
+        {
+            mStateCache.BindFramebuffer(GL_FRAMEBUFFER, mShadowFramebuffers[cascade]);
+            DrawShadowCasters(viewProjection);
+        }
+    }
+    mFrameStats.shadowTimeMs +=
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+uint32_t RenderSystem::CollectShadowCasters(const glm::mat4 &viewProjection, bool staticCasters)
+{
+    // 级联的近平面已向光源方向延伸，视锥外的物体不会投射到级联内
+    auto frustum = Core::Frustum::FromMatrix(viewProjection);
+    mCascadeCasters.clear();
+    for (const auto &caster : mShadowCasters)
+    {
+        if (caster.isStatic == staticCasters && frustum.Intersects(caster.bounds))
+        {
+            mCascadeCasters.push_back(&caster);
+        }
+    }
+    return static_cast<uint32_t>(mCascadeCasters.size());
+}
+void RenderSystem::DrawShadowCasters(const glm::mat4 &viewProjection)
+{
+    if (mCascadeCasters.empty())
+    {
+        return;
+    }
+    auto commandAllocation = mStreamBuffer->Allocate(mCascadeCasters.size() * sizeof(DrawElementsIndirectCommand),
+                                                     alignof(DrawElementsIndirectCommand));
+    auto drawDataAllocation = mStreamBuffer->AllocateStorage(mCascadeCasters.size() * sizeof(DrawData));
+    auto *commands = static_cast<DrawElementsIndirectCommand *>(commandAllocation.data);
+    auto *drawData = static_cast<DrawData *>(drawDataAllocation.data);
+    uint32_t commandCount = 0;
+    uint32_t instanceCount = 0;
+    mStateCache.BindDrawIndirectBuffer(commandAllocation.buffer);
+    BindStorage(0, drawDataAllocation);
+    glProgramUniformMatrix4fv(mShadowPipeline->GetProgram(), 0, 1, GL_FALSE, glm::value_ptr(viewProjection));
+    // 投射体已按几何池排序，每个池一次多重绘制
+    uint32_t firstCommand = 0;
+    for (size_t i = 0; i < mCascadeCasters.size(); i++)
+    {
+        const auto &caster = *mCascadeCasters[i];
+        if (i == 0 || caster.range != mCascadeCasters[i - 1]->range)
+        {
+            commands[commandCount++] = DrawElementsIndirectCommand{
+                .count = caster.range->indexCount,
+                .instanceCount = 0,
+                .firstIndex = caster.range->firstIndex,
+                .baseVertex = static_cast<int32_t>(caster.range->baseVertex),
+                .baseInstance = instanceCount,
+            };
+        }
+        commands[commandCount - 1].instanceCount++;
+        drawData[instanceCount++] = MakeDrawData(caster.entity, *caster.range, 0);
+        if (i + 1 == mCascadeCasters.size() || mCascadeCasters[i + 1]->arena != caster.arena)
+        {
+            mStateCache.BindVertexArray(caster.arena->GetVAO());
+            glMultiDrawElementsIndirect(
+                GL_TRIANGLES, caster.arena->GetGLIndexType(),
+                reinterpret_cast<const void *>(commandAllocation.offset +
+                                               firstCommand * sizeof(DrawElementsIndirectCommand)),
+                static_cast<GLsizei>(commandCount - firstCommand), 0);
+            mFrameStats.drawCalls++;
+            firstCommand = commandCount;
+        }
+    }
+    mFrameStats.drawCommands += commandCount;
+    mFrameStats.shadowCasters += instanceCount;
+}
+uint32_t RenderSystem::CullMeshlets(entt::entity entity, const GeometryRange &range)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    const auto &modelMatrix = mRegistry->get<TransformComponent>(entity).modelMatrix;
+    auto frustum = Core::Frustum::FromMatrix(mMainCamera.projectionMatrix * mMainCamera.viewMatrix * modelMatrix);
+    auto camera =
+        Core::MeshletCuller::GetModelSpaceCamera(mMainCamera.viewMatrix, mMainCamera.projectionMatrix, modelMatrix);
+    mMeshletRanges.clear();
+    auto stats =
+        Core::MeshletCuller::Cull(range.meshlets, frustum, camera, mMeshletSettings.coneCulling, mMeshletRanges);
+    mFrameStats.meshlets += static_cast<uint32_t>(range.meshlets.size());
+    mFrameStats.culledMeshlets += stats.frustumCulled + stats.backfaceCulled;
+    mFrameStats.triangles += stats.visibleTriangles;
+    mFrameStats.meshletCullTimeMs +=
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return static_cast<uint32_t>(mMeshletRanges.size());
+}
+GeometryArena &RenderSystem::GetGeometryArena(const Mesh &mesh) const
+{
+    auto indexType =
+        mesh.Vertices.size() > Core::MaxUInt16IndexedVertices ? Core::IndexType::UInt32 : mesh.IndexFormat;
+    return *mGeometryArenas[GetGeometryArenaIndex(mesh.Format, indexType)];
+}
+const glm::mat4 &RenderSystem::GetModelMatrix(entt::entity entity) const
+{
+    static const glm::mat4 identity(1.0f);
+    return entity == entt::null ? identity : mRegistry->get<TransformComponent>(entity).modelMatrix;
+}
+DrawData RenderSystem::MakeDrawData(entt::entity entity, const GeometryRange &range, uint32_t materialIndex) const
+{
+    const auto &modelMatrix = GetModelMatrix(entity);
+    return DrawData{
+        .modelMatrix = range.format == Core::VertexFormat::Compact ? modelMatrix * range.quantization.GetMatrix()
+                                                                    : modelMatrix,
+        .materialIndex = materialIndex,
+        .vertexFormat = static_cast<uint32_t>(range.format),
+    };
+}
+void RenderSystem::BuildDrawCommands()
+{
+    // 按管线构建间接绘制命令，同一网格的实例合并为一条命令，每个实例对应一个 DrawData，
+    // 着色器通过 gl_BaseInstance + gl_InstanceID 取数据，材质索引逐实例存放
+    // 命令和 DrawData 直接写入流式缓冲区的映射内存，按队列总数预留
+    // 有簇的网格在LOD0时逐实例剔除簇，存活的连续区间各生成一条命令，不与其他实例合并
+    mDrawBatches.clear();
+    auto useMeshlets = [this](const GeometryRange &range, uint32_t lod) {
+        return mMeshletSettings.enabled && lod == 0 && !range.meshlets.empty();
+    };
+    size_t maxInstances = 0;
+    size_t maxCommands = 0;
+    for (auto &[pipelineType, items] : mRenderQueue)
+    {
+        maxInstances += items.size();
+        for (auto &item : items)
+        {
+            auto range = item.arena->Find(item.meshID);
+            maxCommands += range && useMeshlets(*range, item.lod) ? range->meshlets.size() : 1;
+        }
+    }
+    if (maxInstances == 0)
+    {
+        return;
+    }
+    mCommandAllocation = mStreamBuffer->Allocate(maxCommands * sizeof(DrawElementsIndirectCommand),
+                                                 alignof(DrawElementsIndirectCommand));
+    auto drawDataAllocation = mStreamBuffer->AllocateStorage(maxInstances * sizeof(DrawData));
+    auto *commands = static_cast<DrawElementsIndirectCommand *>(mCommandAllocation.data);
+    auto *drawData = static_cast<DrawData *>(drawDataAllocation.data);
+    uint32_t commandCount = 0;
+    uint32_t instanceCount = 0;
+    for (auto &[pipelineType, items] : mRenderQueue)
+    {
+        if (items.empty() || !mPipelines.contains(pipelineType))
+        {
+            continue;
+        }
+        mInstanceItems.clear();
+        for (auto &item : items)
+        {
+            if (auto range = item.arena->Find(item.meshID))
+            {
+                mInstanceItems.push_back(InstanceItem{item.arena, range, item.entity, item.materialIndex, item.lod});
+            }
+        }
+        // 先按几何池分组，再按网格LOD在池中的位置排序，同一网格的同一级别内再按材质排序
+        std::sort(mInstanceItems.begin(), mInstanceItems.end(), [](const InstanceItem &a, const InstanceItem &b) {
+            if (a.arena != b.arena)
+            {
+                return a.arena < b.arena;
+            }
+            auto firstA = a.range->lodFirstIndex[a.lod];
+            auto firstB = b.range->lodFirstIndex[b.lod];
+            if (firstA != firstB)
+            {
+                return firstA < firstB;
+            }
+            return a.materialIndex < b.materialIndex;
+        });
+        DrawBatch batch{
+            .pipelineType = pipelineType,
+            .arena = nullptr,
+            .firstCommand = commandCount,
+            .commandCount = 0,
+        };
+        for (size_t i = 0; i < mInstanceItems.size(); i++)
+        {
+            const auto &item = mInstanceItems[i];
+            // 几何池变化时VAO和索引类型不同，需要新的批次
+            if (item.arena != batch.arena)
+            {
+                if (batch.commandCount > 0)
+                {
+                    mDrawBatches.push_back(batch);
+                }
+                batch.arena = item.arena;
+                batch.firstCommand = commandCount;
+                batch.commandCount = 0;
+            }
+            if (useMeshlets(*item.range, item.lod))
+            {
+                auto visibleRanges = CullMeshlets(item.entity, *item.range);
+                if (visibleRanges == 0)
+                {
+                    continue;
+                }
+                for (uint32_t r = 0; r < visibleRanges; r++)
+                {
+                    const auto &meshletRange = mMeshletRanges[r];
+                    commands[commandCount++] = DrawElementsIndirectCommand{
+                        .count = meshletRange.indexCount,
+                        .instanceCount = 1,
+                        .firstIndex = item.range->firstIndex + meshletRange.firstIndex,
+                        .baseVertex = static_cast<int32_t>(item.range->baseVertex),
+                        .baseInstance = instanceCount,
+                    };
+                    batch.commandCount++;
+                }
+                drawData[instanceCount++] = MakeDrawData(item.entity, *item.range, item.materialIndex);
+                if (item.range->format == Core::VertexFormat::Compact)
+                {
+                    mFrameStats.compactInstances++;
+                }
+                continue;
+            }
+            if (batch.commandCount == 0 || item.range != mInstanceItems[i - 1].range ||
+                item.lod != mInstanceItems[i - 1].lod)
+            {
+                commands[commandCount++] = DrawElementsIndirectCommand{
+                    .count = item.range->lodIndexCount[item.lod],
+                    .instanceCount = 0,
+                    .firstIndex = item.range->lodFirstIndex[item.lod],
+                    .baseVertex = static_cast<int32_t>(item.range->baseVertex),
+                    .baseInstance = instanceCount,
+                };
+                batch.commandCount++;
+            }
+            commands[commandCount - 1].instanceCount++;
+            drawData[instanceCount++] = MakeDrawData(item.entity, *item.range, item.materialIndex);
+            mFrameStats.triangles += item.range->lodIndexCount[item.lod] / 3;
+            if (item.range->format == Core::VertexFormat::Compact)
+            {
+                mFrameStats.compactInstances++;
+            }
+        }
+        if (batch.commandCount > 0)
+        {
+            mDrawBatches.push_back(batch);
+        }
+    }
+    mFrameStats.instances = instanceCount;
+    mDrawDataAllocation = drawDataAllocation;
+    mMaterialAllocation = mStreamBuffer->WriteStorage(mMaterialData);
+}
+bool RenderSystem::IsDeferredBatch(const DrawBatch &batch) const
+{
+    // 只有不透明的PBR物体写入G-buffer，其余仍走前向
+    return mDeferredFrame && batch.pipelineType == PipelineType::ForwardOpaquePBR;
+}
+void RenderSystem::BindSceneStorage()
+{
+    mStateCache.BindDrawIndirectBuffer(mCommandAllocation.buffer);
+    BindStorage(0, mDrawDataAllocation);
+    BindStorage(1, mMaterialAllocation);
+    BindStorage(2, mLightAllocation);
+    BindStorage(3, mClusterAllocation);
+    BindStorage(4, mLightIndexAllocation);
+}
+void RenderSystem::SetLightingUniforms(const Pipeline &pipeline)
+{
+    auto program = pipeline.GetProgram();
+    const auto &gridConfig = mLightGrid.GetConfig();
+    auto sliceScaleBias = mLightGrid.GetSliceScaleBias();
+    glProgramUniformMatrix4fv(program, 0, 1, GL_FALSE, glm::value_ptr(mMainCamera.viewMatrix));
+    glProgramUniform4ui(program, 3, gridConfig.tilesX, gridConfig.tilesY, gridConfig.slices,
+                        mLightGrid.GetDirectionalCount());
+    glProgramUniform4f(program, 4, sliceScaleBias.x, sliceScaleBias.y, static_cast<float>(mFrameBufferWidth),
+                       static_cast<float>(mFrameBufferHeight));
+    // 阴影参数只设置给带SHADOWS关键字的变体，回退管线没有这些uniform
+    if (!mShadowLight.enabled || std::find(pipeline.Defines.begin(), pipeline.Defines.end(),
+                                           Editor::ShaderKeywords::Shadows) == pipeline.Defines.end())
+    {
+        return;
+    }
+    std::array<glm::mat4, Core::CascadedShadowMap::MaxCascades> shadowMatrices{};
+    glm::vec4 shadowTexelSizes(0.0f);
+    auto cascadeCount = mShadowCascades.GetCascadeCount();
+    for (uint32_t i = 0; i < cascadeCount; i++)
+    {
+        shadowMatrices[i] = mShadowCascades.GetCascade(i).viewProjection;
+        shadowTexelSizes[i] = mShadowCascades.GetCascade(i).texelSize;
+    }
+    glProgramUniformMatrix4fv(program, 5, static_cast<GLsizei>(cascadeCount), GL_FALSE,
+                              glm::value_ptr(shadowMatrices[0]));
+    glProgramUniform4fv(program, 9, 1, glm::value_ptr(mShadowCascades.GetSplitDistances()));
+    glProgramUniform4f(program, 10, mShadowLight.bias, mShadowLight.normalBias, static_cast<float>(cascadeCount),
+                       static_cast<float>(mShadowLight.directionalIndex));
+    glProgramUniform4fv(program, 11, 1, glm::value_ptr(shadowTexelSizes));
+    mStateCache.BindTexture(8, mShadowMap);
+}
+void RenderSystem::DrawBatches(bool gbuffer)
+{
+    if (mDrawBatches.empty())
+    {
+        return;
+    }
+    BindSceneStorage();
+    for (auto &batch : mDrawBatches)
+    {
+        if (IsDeferredBatch(batch) != gbuffer)
+        {
+            continue;
+        }
+        auto pipeline = gbuffer ? mGBufferPipeline.get() : GetActivePipeline(batch.pipelineType);
+        if (!pipeline)
+        {
+            continue;
+        }
+        auto program = pipeline->GetProgram();
+        mStateCache.UseProgram(program);
+        mStateCache.BindVertexArray(batch.arena->GetVAO());
+        if (gbuffer)
+        {
+            mStateCache.SetBlend(false);
+            glProgramUniformMatrix4fv(program, 0, 1, GL_FALSE, glm::value_ptr(mMainCamera.viewMatrix));
+        }
+        else
+        {
+            mStateCache.SetBlend(pipeline->blendingEnabled, pipeline->blendSrc, pipeline->blendDest);
+            SetLightingUniforms(*pipeline);
+        }
+        glProgramUniformMatrix4fv(program, 1, 1, GL_FALSE, glm::value_ptr(mMainCamera.projectionMatrix));
+        glMultiDrawElementsIndirect(
+            GL_TRIANGLES, batch.arena->GetGLIndexType(),
+            reinterpret_cast<const void *>(mCommandAllocation.offset +
+                                           batch.firstCommand * sizeof(DrawElementsIndirectCommand)),
+            static_cast<GLsizei>(batch.commandCount), 0);
+        mFrameStats.drawCalls++;
+        mFrameStats.drawCommands += batch.commandCount;
+    }
+}
+void RenderSystem::RenderForwardPass()
+{
+    DrawBatches(false);
+}
+void RenderSystem::RenderGBufferPass()
+{
+    DrawBatches(true);
+}
+void RenderSystem::RenderDeferredLightingPass(const std::array<GLuint, 4> &gbuffer)
+{
+    // 全屏三角形逐像素重建位置并遍历所在簇的光源，结果叠加到G-buffer通道写入的环境光和自发光上
+    auto pipeline = mDeferredLightingPipeline.get();
+    auto program = pipeline->GetProgram();
+    mStateCache.UseProgram(program);
+    mStateCache.SetBlend(true, GL_ONE, GL_ONE);
+    mStateCache.SetDepthTest(false);
+    mStateCache.SetDepthWrite(false);
+    for (GLuint i = 0; i < gbuffer.size(); i++)
+    {
+        mStateCache.BindTexture(GBufferTextureUnit + i, gbuffer[i]);
+    }
+    BindStorage(2, mLightAllocation);
+    BindStorage(3, mClusterAllocation);
+    BindStorage(4, mLightIndexAllocation);
+    SetLightingUniforms(*pipeline);
+    auto inverseViewProjection = glm::inverse(mMainCamera.projectionMatrix * mMainCamera.viewMatrix);
+    glProgramUniformMatrix4fv(program, 2, 1, GL_FALSE, glm::value_ptr(inverseViewProjection));
+    mStateCache.BindVertexArray(mEmptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    mFrameStats.drawCalls++;
 }
-void RenderSystem::RenderPostProcessPass()
+void RenderSystem::BindStorage(GLuint binding, const StreamAllocation &allocation)
 {
+    mStateCache.BindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, allocation.buffer, allocation.offset,
+                                allocation.size);
 }
 } // namespace MEngine
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "System/SpatialSystem.hpp"
+
+namespace MEngine
+{
+void SpatialSystem::Init()
+{
+    mRegistry->on_destroy<BoundsComponent>().connect<&SpatialSystem::OnBoundsDestroy>(this);
+}
+void SpatialSystem::Update(float deltaTime)
+{
+    auto view = mRegistry->view<BoundsComponent>();
+    for (auto entity : view)
+    {
+        auto &bounds = view.get<BoundsComponent>(entity);
+        if (!bounds.dirty || !bounds.worldBounds.IsValid())
+        {
+            continue;
+        }
+        if (auto it = mProxies.find(entity); it != mProxies.end())
+        {
+            mTree.MoveProxy(it->second, bounds.worldBounds);
+        }
+        else
+        {
+            mProxies[entity] = mTree.CreateProxy(bounds.worldBounds, entt::to_integral(entity));
+        }
+        bounds.dirty = false;
+    }
+}
+void SpatialSystem::Shutdown()
+{
+    mRegistry->on_destroy<BoundsComponent>().disconnect<&SpatialSystem::OnBoundsDestroy>(this);
+    mTree.Clear();
+    mProxies.clear();
+}
+void SpatialSystem::OnBoundsDestroy(entt::registry &registry, entt::entity entity)
+{
+    if (auto it = mProxies.find(entity); it != mProxies.end())
+    {
+        mTree.DestroyProxy(it->second);
+        mProxies.erase(it);
+    }
+}
+entt::entity SpatialSystem::RayCast(const glm::vec3 &origin, const glm::vec3 &direction, float maxDistance) const
+{
+    entt::entity closest = entt::null;
+    mTree.RayCast(origin, direction, maxDistance, [&](uint32_t id, float distance) {
+        if (distance < maxDistance)
+        {
+            maxDistance = distance;
+            closest = static_cast<entt::entity>(id);
+        }
+        return maxDistance;
+    });
+    return closest;
+}
+void SpatialSystem::QueryFrustum(const Core::Frustum &frustum, std::vector<entt::entity> &result) const
+{
+    result.clear();
+    mTree.QueryFrustum(frustum, [&](uint32_t id) {
+        result.push_back(static_cast<entt::entity>(id));
+        return true;
+    });
+}
+void SpatialSystem::QueryAABB(const Core::AABB &aabb, std::vector<entt::entity> &result) const
+{
+    result.clear();
+    mTree.QueryAABB(aabb, [&](uint32_t id) {
+        result.push_back(static_cast<entt::entity>(id));
+        return true;
+    });
+}
+void SpatialSystem::QueryKNearest(const glm::vec3 &point, size_t k, std::vector<entt::entity> &result) const
+{
+    std::vector<uint32_t> ids;
+    mTree.QueryKNearest(point, k, ids);
+    result.resize(ids.size());
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+        result[i] = static_cast<entt::entity>(ids[i]);
+    }
+}
+} // namespace MEngine
@@ -12,13 +12,17 @@ void TransformSystem::Update(float deltaTime)
     for (auto entity : view)
     {
         auto &transformComponent = view.get<TransformComponent>(entity);
-        CalculateMatrix(entity);
+        // 子节点由父节点递归更新
+        if (transformComponent.parent == entt::null)
+        {
+            CalculateMatrix(entity);
+        }
     }
 }
 void TransformSystem::Shutdown()
 {
 }
-void TransformSystem::CalculateMatrix(entt::entity entity)
+void TransformSystem::CalculateMatrix(entt::entity entity, bool parentChanged)
 {
     // 获取实体的TransformComponent
     auto &transformComponent = mRegistry->get<TransformComponent>(entity);
@@ -26,26 +30,38 @@ void TransformSystem::CalculateMatrix(entt::entity entity)
     glm::mat4 localMatrix = glm::translate(glm::mat4(1.0f), transformComponent.localPosition) *
                             glm::mat4_cast(transformComponent.localRotation) *
                             glm::scale(glm::mat4(1.0f), transformComponent.localScale);
+    glm::mat4 modelMatrix = localMatrix;
     if (transformComponent.parent != entt::null)
     {
         auto &parentTransform = mRegistry->get<TransformComponent>(transformComponent.parent);
-        transformComponent.modelMatrix = parentTransform.modelMatrix * localMatrix;
+        modelMatrix = parentTransform.modelMatrix * localMatrix;
     }
-    else
+    // 编辑器可能直接修改local属性而不标记dirty，因此同时比较矩阵
+    bool changed = parentChanged || transformComponent.dirty || modelMatrix != transformComponent.modelMatrix;
+    if (changed)
     {
-        transformComponent.modelMatrix = localMatrix;
-    }
+        transformComponent.modelMatrix = modelMatrix;
+        transformComponent.dirty = false;
 
-    glm::vec3 skew;
-    glm::vec4 perspective;
+        glm::vec3 skew;
+        glm::vec4 perspective;
+        glm::decompose(transformComponent.modelMatrix, transformComponent.worldScale,
+                       transformComponent.worldRotation, transformComponent.worldPosition, skew, perspective);
 
-    glm::decompose(transformComponent.modelMatrix, transformComponent.worldScale, transformComponent.worldRotation,
-                   transformComponent.worldPosition, skew, perspective);
+        if (auto bounds = mRegistry->try_get<BoundsComponent>(entity))
+        {
+            bounds->worldBounds = Core::TransformAABB(bounds->localBounds, transformComponent.modelMatrix);
+            bounds->worldSphere = Core::TransformBoundingSphere(bounds->localSphere, transformComponent.modelMatrix);
+            bounds->dirty = true;
+        }
+        // 通知监听变换的系统（例如静态阴影缓存）
+        mRegistry->patch<TransformComponent>(entity);
+    }
 
     // 递归更新所有子节点
     for (auto child : transformComponent.children)
     {
-        CalculateMatrix(child);
+        CalculateMatrix(child, changed);
     }
 }
 void TransformSystem::Translate(TransformComponent &transform, const glm::vec3 &delta)
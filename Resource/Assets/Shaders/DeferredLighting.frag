@@ -0,0 +1,40 @@
+#version 460 core
+layout(location = 0) out vec4 OutColor;
+layout(location = 0) uniform mat4 viewMatrix;
+layout(location = 2) uniform mat4 inverseViewProjection;
+layout(location = 3) uniform uvec4 clusterGrid; // tilesX, tilesY, slices, directionalCount
+layout(location = 4) uniform vec4 clusterParams; // sliceScale, sliceBias, viewportWidth, viewportHeight
+layout(binding = 9) uniform sampler2D gbufferDepth;
+layout(binding = 10) uniform sampler2D gbufferAlbedo;
+layout(binding = 11) uniform sampler2D gbufferNormal;
+layout(binding = 12) uniform sampler2D gbufferMaterial;
+#include "Include/GBuffer.glsl"
+#include "Include/Lighting.glsl"
+#include "Include/Shadow.glsl"
+#include "Include/ClusteredLighting.glsl"
+
+void main()
+{
+  ivec2 pixel = ivec2(gl_FragCoord.xy);
+  float depth = texelFetch(gbufferDepth, pixel, 0).r;
+  // 背景，保留G-buffer通道的清除色
+  if (depth >= 1.0)
+  {
+    discard;
+  }
+  vec2 uv = gl_FragCoord.xy / clusterParams.zw;
+  vec4 clip = vec4(uv * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+  vec4 world = inverseViewProjection * clip;
+  vec3 worldPosition = world.xyz / world.w;
+  float viewDepth = -(viewMatrix * vec4(worldPosition, 1.0)).z;
+
+  vec3 albedo = texelFetch(gbufferAlbedo, pixel, 0).rgb;
+  vec3 N = DecodeOctahedral(texelFetch(gbufferNormal, pixel, 0).rg);
+  vec2 roughnessMetallic = texelFetch(gbufferMaterial, pixel, 0).rg;
+  vec3 cameraPosition = -transpose(mat3(viewMatrix)) * viewMatrix[3].xyz;
+  vec3 V = normalize(cameraPosition - worldPosition);
+
+  vec3 color = ShadeClusteredLights(worldPosition, viewDepth, gl_FragCoord.xy, N, V, albedo, roughnessMetallic.y,
+                                    roughnessMetallic.x);
+  OutColor = vec4(color, 0.0);
+}
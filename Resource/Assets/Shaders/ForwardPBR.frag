@@ -1,19 +1,32 @@
 #version 460 core
 layout(location = 0) out vec4 OutColor;
+layout(location = 0) in vec3 fragWorldPosition; // Location 0
+layout(location = 1) in float fragViewDepth; // Location 1
 layout(location = 2) in vec3 fragNormal; // Location 2
 layout(location = 3) in vec2 fragTexCoord; // Location 3
-layout(location = 3) uniform light
-{
-  vec3 position[8];
-  vec3 direction[8];
-  vec3 color[8];
-  float intensity[8];
-  float radius[8];
-  int type[8];
-};
+layout(location = 4) flat in uint fragMaterialIndex; // Location 4
+layout(location = 0) uniform mat4 viewMatrix;
+layout(location = 3) uniform uvec4 clusterGrid; // tilesX, tilesY, slices, directionalCount
+layout(location = 4) uniform vec4 clusterParams; // sliceScale, sliceBias, viewportWidth, viewportHeight
+#include "Include/Material.glsl"
+#include "Include/Lighting.glsl"
+#include "Include/Shadow.glsl"
+#include "Include/ClusteredLighting.glsl"
+
 void main()
 {
- OutColor = vec4(color[0], 1.0); // Set the output color to black
-}
-
+  MaterialData material = materials[fragMaterialIndex];
+  vec3 albedo = material.albedo.rgb;
+  float metallic = material.parameters.x;
+  float roughness = clamp(material.parameters.y, 0.04, 1.0);
+  float ao = material.parameters.z;
+  vec3 N = normalize(fragNormal);
+  vec3 cameraPosition = -transpose(mat3(viewMatrix)) * viewMatrix[3].xyz;
+  vec3 V = normalize(cameraPosition - fragWorldPosition);
 
+  vec3 color = ShadeClusteredLights(fragWorldPosition, fragViewDepth, gl_FragCoord.xy, N, V, albedo, metallic,
+                                    roughness);
+  vec3 ambient = vec3(0.03) * albedo * ao;
+  vec3 emissive = material.emissive.rgb * material.parameters.w;
+  OutColor = vec4(ambient + color + emissive, material.albedo.a);
+}
@@ -6,16 +6,27 @@ layout(location = 2) in vec2 inTexCoords; // Location 2
 
 layout(location = 0) uniform mat4 viewMatrix; 
 layout(location = 1) uniform mat4 projectionMatrix;       
-layout(location = 2) uniform mat4 modelMatrix;    
 
+#include "Include/DrawData.glsl"
+
+layout(location = 0) out vec3 fragWorldPosition; // Location 0
+layout(location = 1) out float fragViewDepth; // Location 1，视图空间距离，用于查找深度切片
 layout(location = 2) out vec3 fragNormal; // Location 2
 layout(location = 3) out vec2 fragTexCoords; // Location 3
+layout(location = 4) flat out uint fragMaterialIndex; // Location 4
 
 void main()
 {
-    gl_Position = projectionMatrix * viewMatrix * modelMatrix * vec4(inPosition, 1.0);
-    fragNormal = mat3(modelMatrix) * inNormal; // 变换法线
+    // 间接命令的 baseInstance 指向该网格第一个实例的DrawData
+    DrawData draw = draws[gl_BaseInstance + gl_InstanceID];
+    vec4 worldPosition = draw.modelMatrix * vec4(inPosition, 1.0);
+    vec4 viewPosition = viewMatrix * worldPosition;
+    gl_Position = projectionMatrix * viewPosition;
+    fragWorldPosition = worldPosition.xyz;
+    fragViewDepth = -viewPosition.z;
+    fragNormal = mat3(draw.modelMatrix) * DecodeVertexNormal(draw, inNormal); // 变换法线
     fragTexCoords = inTexCoords; // 传递纹理坐标
+    fragMaterialIndex = draw.materialIndex;
 }
 
 
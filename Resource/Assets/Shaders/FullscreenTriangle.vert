@@ -0,0 +1,7 @@
+#version 460 core
+// 顶点由 gl_VertexID 生成，一个三角形覆盖整个屏幕
+void main()
+{
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
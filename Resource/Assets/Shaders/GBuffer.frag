@@ -0,0 +1,29 @@
+#version 460 core
+layout(location = 0) out vec4 OutColor;
+layout(location = 1) out vec4 OutAlbedo;
+layout(location = 2) out vec2 OutNormal;
+layout(location = 3) out vec2 OutMaterial;
+layout(location = 0) in vec3 fragWorldPosition; // Location 0
+layout(location = 1) in float fragViewDepth; // Location 1
+layout(location = 2) in vec3 fragNormal; // Location 2
+layout(location = 3) in vec2 fragTexCoord; // Location 3
+layout(location = 4) flat in uint fragMaterialIndex; // Location 4
+#include "Include/Material.glsl"
+#include "Include/GBuffer.glsl"
+
+void main()
+{
+  MaterialData material = materials[fragMaterialIndex];
+  vec3 albedo = material.albedo.rgb;
+  // 与ARM贴图相同的通道含义：AO随反照率存放，粗糙度和金属度单独一张
+  float ao = material.parameters.z;
+  float roughness = clamp(material.parameters.y, 0.04, 1.0);
+  float metallic = material.parameters.x;
+  // 与方向无关的项在这里算完，光照通道只累加直接光
+  vec3 ambient = vec3(0.03) * albedo * ao;
+  vec3 emissive = material.emissive.rgb * material.parameters.w;
+  OutColor = vec4(ambient + emissive, 1.0);
+  OutAlbedo = vec4(albedo, ao);
+  OutNormal = EncodeOctahedral(normalize(fragNormal));
+  OutMaterial = vec2(roughness, metallic);
+}
@@ -0,0 +1,43 @@
+#pragma once
+// 方向光加所在簇内光源的直接光照，前向和延迟光照共用
+// 包含前需声明 clusterGrid、clusterParams，并包含 Lighting.glsl 和 Shadow.glsl
+vec3 ShadeClusteredLights(vec3 worldPosition, float viewDepth, vec2 fragCoord, vec3 N, vec3 V, vec3 albedo,
+                          float metallic, float roughness)
+{
+  vec3 color = vec3(0.0);
+  for (uint i = 0; i < clusterGrid.w; i++)
+  {
+    LightData light = lights[i];
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a;
+#ifdef SHADOWS
+    if (i == uint(shadowParams.w))
+    {
+      radiance *= SampleShadow(worldPosition, N, viewDepth);
+    }
+#endif
+    color += EvaluateLight(normalize(-light.directionType.xyz), radiance, N, V, albedo, metallic, roughness);
+  }
+
+  // 只遍历当前簇内的光源
+  uvec2 tile = min(uvec2(fragCoord / clusterParams.zw * vec2(clusterGrid.xy)), clusterGrid.xy - 1u);
+  uint slice = uint(clamp(log(viewDepth) * clusterParams.x + clusterParams.y, 0.0, float(clusterGrid.z - 1u)));
+  ClusterRange cluster = clusters[(slice * clusterGrid.y + tile.y) * clusterGrid.x + tile.x];
+  for (uint i = 0; i < cluster.count; i++)
+  {
+    LightData light = lights[lightIndices[cluster.offset + i]];
+    vec3 toLight = light.positionRange.xyz - worldPosition;
+    float distance = length(toLight);
+    vec3 L = toLight / max(distance, 1e-4);
+    // 平滑衰减到半径处为0
+    float falloff = clamp(1.0 - pow(distance / light.positionRange.w, 4.0), 0.0, 1.0);
+    float attenuation = falloff * falloff / (distance * distance + 1.0);
+    if (uint(light.directionType.w) == 2u)
+    {
+      float cosAngle = dot(-L, normalize(light.directionType.xyz));
+      attenuation *= smoothstep(light.spotAngles.y, light.spotAngles.x, cosAngle);
+    }
+    vec3 radiance = light.colorIntensity.rgb * light.colorIntensity.a * attenuation;
+    color += EvaluateLight(L, radiance, N, V, albedo, metallic, roughness);
+  }
+  return color;
+}
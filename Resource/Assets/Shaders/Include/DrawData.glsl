@@ -0,0 +1,22 @@
+#pragma once
+#include "Octahedral.glsl"
+// 与 Function::DrawData 一致，通过 gl_BaseInstance + gl_InstanceID 索引
+struct DrawData
+{
+    mat4 modelMatrix; // 紧凑顶点的位置反量化已合并进来
+    uint materialIndex;
+    uint vertexFormat; // Core::VertexFormat
+    uint padding0;
+    uint padding1;
+};
+layout(std430, binding = 0) readonly buffer DrawDataBuffer
+{
+    DrawData draws[];
+};
+const uint VertexFormatStandard = 0u;
+const uint VertexFormatCompact = 1u;
+// 紧凑顶点的法线是八面体编码的两个unorm16分量，只占用xy
+vec3 DecodeVertexNormal(DrawData draw, vec3 normal)
+{
+    return draw.vertexFormat == VertexFormatCompact ? DecodeOctahedral(normal.xy) : normal;
+}
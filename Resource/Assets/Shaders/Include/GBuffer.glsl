@@ -0,0 +1,5 @@
+#pragma once
+// G-buffer 布局，与 RenderSystem::BuildRenderGraph 一致
+// 0 场景颜色（环境光+自发光） 1 反照率+AO (RGBA8) 2 八面体法线 (RG16) 3 粗糙度+金属度 (RG8)
+
+#include "Octahedral.glsl"
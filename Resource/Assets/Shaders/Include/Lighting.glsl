@@ -0,0 +1,48 @@
+#pragma once
+// 与 Core::PackedLight 一致
+struct LightData
+{
+  vec4 positionRange;  // xyz 位置，w 半径
+  vec4 colorIntensity; // rgb 颜色，a 强度
+  vec4 directionType;  // xyz 方向，w 类型 0方向光 1点光 2聚光
+  vec4 spotAngles;     // x cos(内角) y cos(外角)
+};
+layout(std430, binding = 2) readonly buffer LightBuffer
+{
+  LightData lights[];
+};
+struct ClusterRange
+{
+  uint offset;
+  uint count;
+};
+layout(std430, binding = 3) readonly buffer ClusterBuffer
+{
+  ClusterRange clusters[];
+};
+layout(std430, binding = 4) readonly buffer LightIndexBuffer
+{
+  uint lightIndices[];
+};
+
+const float PI = 3.14159265359;
+
+vec3 EvaluateLight(vec3 lightDir, vec3 radiance, vec3 N, vec3 V, vec3 albedo, float metallic, float roughness)
+{
+  vec3 H = normalize(lightDir + V);
+  float NdotL = max(dot(N, lightDir), 0.0);
+  float NdotV = max(dot(N, V), 1e-4);
+  float NdotH = max(dot(N, H), 0.0);
+  // GGX + Schlick-GGX + Schlick
+  float a = roughness * roughness;
+  float a2 = a * a;
+  float denom = NdotH * NdotH * (a2 - 1.0) + 1.0;
+  float D = a2 / (PI * denom * denom);
+  float k = (roughness + 1.0) * (roughness + 1.0) / 8.0;
+  float G = NdotV / (NdotV * (1.0 - k) + k) * NdotL / (NdotL * (1.0 - k) + k);
+  vec3 F0 = mix(vec3(0.04), albedo, metallic);
+  vec3 F = F0 + (1.0 - F0) * pow(1.0 - max(dot(H, V), 0.0), 5.0);
+  vec3 specular = D * G * F / max(4.0 * NdotV * NdotL, 1e-4);
+  vec3 diffuse = (1.0 - F) * (1.0 - metallic) * albedo / PI;
+  return (diffuse + specular) * radiance * NdotL;
+}
@@ -0,0 +1,12 @@
+#pragma once
+// 与 Function::MaterialData 一致
+struct MaterialData
+{
+  vec4 albedo;
+  vec4 emissive;
+  vec4 parameters; // metallic, roughness, ao, emissiveIntensity
+};
+layout(std430, binding = 1) readonly buffer MaterialBuffer
+{
+  MaterialData materials[];
+};
@@ -0,0 +1,22 @@
+#pragma once
+// 与 Core::EncodeOctahedral / DecodeOctahedral 一致，G-buffer法线和紧凑顶点法线共用
+
+// 八面体映射把单位向量压到两个分量，误差在各方向上均匀，输出范围[0,1]
+vec2 EncodeOctahedral(vec3 n)
+{
+  n /= abs(n.x) + abs(n.y) + abs(n.z);
+  vec2 e = n.xy;
+  if (n.z < 0.0)
+  {
+    e = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+  }
+  return e * 0.5 + 0.5;
+}
+vec3 DecodeOctahedral(vec2 e)
+{
+  e = e * 2.0 - 1.0;
+  vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+  float t = clamp(-n.z, 0.0, 1.0);
+  n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+  return normalize(n);
+}
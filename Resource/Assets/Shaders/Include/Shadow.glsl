@@ -0,0 +1,39 @@
+#pragma once
+// 方向光级联阴影，与 RenderSystem::RenderShadowPass 一致
+#ifdef SHADOWS
+layout(location = 5) uniform mat4 shadowMatrices[4]; // Location 5-8
+layout(location = 9) uniform vec4 shadowSplits; // 各级联的视图空间远端距离
+layout(location = 10) uniform vec4 shadowParams; // depthBias, normalBias(texel), cascadeCount, lightIndex
+layout(location = 11) uniform vec4 shadowTexelSizes; // 各级联每texel的世界尺寸
+layout(binding = 8) uniform sampler2DArrayShadow shadowMap;
+
+float SampleShadow(vec3 worldPosition, vec3 N, float viewDepth)
+{
+  uint cascadeCount = uint(shadowParams.z);
+  uint cascade = 0;
+  while (cascade < cascadeCount && viewDepth > shadowSplits[cascade])
+  {
+    cascade++;
+  }
+  if (cascade >= cascadeCount)
+  {
+    return 1.0;
+  }
+  // 沿法线偏移，偏移量随级联texel大小缩放
+  vec3 position = worldPosition + N * shadowParams.y * shadowTexelSizes[cascade];
+  vec4 clip = shadowMatrices[cascade] * vec4(position, 1.0);
+  vec3 coord = clip.xyz / clip.w * 0.5 + 0.5;
+  float depth = coord.z - shadowParams.x;
+  vec2 texelSize = 1.0 / vec2(textureSize(shadowMap, 0).xy);
+  // 3x3 PCF，比较采样本身再做双线性过滤
+  float visibility = 0.0;
+  for (int y = -1; y <= 1; y++)
+  {
+    for (int x = -1; x <= 1; x++)
+    {
+      visibility += texture(shadowMap, vec4(coord.xy + vec2(x, y) * texelSize, float(cascade), depth));
+    }
+  }
+  return visibility / 9.0;
+}
+#endif
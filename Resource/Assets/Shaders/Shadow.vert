@@ -0,0 +1,12 @@
+#version 460 core
+layout(location = 0) in vec3 inPosition; // Location 0
+
+layout(location = 0) uniform mat4 lightViewProjection;
+
+#include "Include/DrawData.glsl"
+
+void main()
+{
+    DrawData draw = draws[gl_BaseInstance + gl_InstanceID];
+    gl_Position = lightViewProjection * draw.modelMatrix * vec4(inPosition, 1.0);
+}
@@ -3,6 +3,8 @@
 #include "Asset/CustomMaterial.hpp"
 #include "Asset/Folder.hpp"
 #include "Asset/Material.hpp"
+#include "Asset/Mesh.hpp"
+#include "Asset/Model.hpp"
 #include "Asset/PBRMaterial.hpp"
 #include "Asset/PhongMaterial.hpp"
 #include "Asset/Pipeline.hpp"
@@ -11,7 +13,10 @@
 #include "Asset/Texture2D.hpp"
 #include "Importer/AssetImporter.hpp"
 #include "Importer/AudioImporter.hpp"
+#include "Importer/FBXImporter.hpp"
+#include "Importer/GLTFImporter.hpp"
 #include "Importer/NativeFormatImporter.hpp"
+#include "Importer/OBJImporter.hpp"
 #include "Importer/PrefabImporter.hpp"
 #include "Importer/ShaderImporter.hpp"
 #include "Importer/TextureImporter.hpp"
@@ -44,6 +49,8 @@ class AssetDatabase
     static std::unordered_map<std::filesystem::path, UUID> Path2UUID;
     static std::unordered_map<std::type_index, std::string> Asset2Extension;
     static std::vector<std::filesystem::path> AssetPaths;
+    // 模型导入时产生的子资源（网格），按ID索引
+    static std::unordered_map<UUID, std::shared_ptr<Asset>> SubAssets;
 
   public:
     static AssetType DetermineAssetType(const std::string &extension);
@@ -112,6 +119,18 @@ class AssetDatabase
     static void Refresh();
     static std::filesystem::path GenerateUniqueAssetPath(std::filesystem::path path);
     static std::shared_ptr<AssetMeta> GetAssetMeta(const std::filesystem::path &path);
+    static std::shared_ptr<AssetMeta> GetAssetMeta(const UUID &id);
+    /**
+     * @brief 获取已加载模型的子资源，例如网格
+     */
+    template <std::derived_from<Asset> TAsset> static std::shared_ptr<TAsset> GetSubAsset(const UUID &id)
+    {
+        if (auto it = SubAssets.find(id); it != SubAssets.end())
+        {
+            return std::dynamic_pointer_cast<TAsset>(it->second);
+        }
+        return nullptr;
+    }
     /**
      * @brief 加载资源，如果资源已经加载过，则直接返回。注意：请仅在需要时加载资源，例如在编辑器中预览资源或在层级中时。
      *
@@ -154,6 +173,20 @@ class AssetDatabase
                 auto prefab = std::make_shared<Prefab>();
                 return prefab;
             }
+            else if constexpr (std::is_same_v<TAsset, Model>)
+            {
+                auto importer = std::dynamic_pointer_cast<ModelImporter>(meta->importer);
+                if (!importer)
+                {
+                    throw std::runtime_error("Model importer not found: " + path.string());
+                }
+                auto result = importer->Import();
+                for (size_t i = 0; i < result.Meshes.size(); i++)
+                {
+                    SubAssets[importer->meshIDs[i]] = result.Meshes[i];
+                }
+                return result.Model;
+            }
             else
             {
                 throw std::runtime_error("Unsupported asset type");
@@ -199,6 +232,18 @@ template <> struct adl_serializer<MEngine::Editor::AssetMeta>
             {
                 j["PrefabImporter"] = *shaderImporter;
             }
+            else if (auto objImporter = std::dynamic_pointer_cast<MEngine::Editor::OBJImporter>(importer))
+            {
+                j["OBJImporter"] = *objImporter;
+            }
+            else if (auto gltfImporter = std::dynamic_pointer_cast<MEngine::Editor::GLTFImporter>(importer))
+            {
+                j["GLTFImporter"] = *gltfImporter;
+            }
+            else if (auto fbxImporter = std::dynamic_pointer_cast<MEngine::Editor::FBXImporter>(importer))
+            {
+                j["FBXImporter"] = *fbxImporter;
+            }
             else
             {
                 j["DefaultImporter"] = *importer;
@@ -243,6 +288,21 @@ template <> struct adl_serializer<MEngine::Editor::AssetMeta>
             auto prefabImporter = j.at("PrefabImporter").get<MEngine::Editor::PrefabImporter>();
             meta.importer = std::make_shared<MEngine::Editor::PrefabImporter>(prefabImporter);
         }
+        else if (j.contains("OBJImporter"))
+        {
+            auto objImporter = j.at("OBJImporter").get<MEngine::Editor::OBJImporter>();
+            meta.importer = std::make_shared<MEngine::Editor::OBJImporter>(objImporter);
+        }
+        else if (j.contains("GLTFImporter"))
+        {
+            auto gltfImporter = j.at("GLTFImporter").get<MEngine::Editor::GLTFImporter>();
+            meta.importer = std::make_shared<MEngine::Editor::GLTFImporter>(gltfImporter);
+        }
+        else if (j.contains("FBXImporter"))
+        {
+            auto fbxImporter = j.at("FBXImporter").get<MEngine::Editor::FBXImporter>();
+            meta.importer = std::make_shared<MEngine::Editor::FBXImporter>(fbxImporter);
+        }
         else
         {
             throw std::runtime_error("Invalid asset meta importer");
@@ -1,16 +1,25 @@
-
 #pragma once
-#include "Importer/AssetImporter.hpp"
+#include "Importer/ModelImporter.hpp"
 namespace MEngine
 {
 namespace Editor
 {
-
-class FBXImporter final : public AssetImporter
+class FBXImporter final : public ModelImporter
 {
+  public:
+    bool generateTangents = true;
+    bool flipUVs = false;
+
   public:
     FBXImporter();
     ~FBXImporter() override = default;
+    /**
+     * @brief 通过assimp导入模型，同时计算每个网格的包围盒与包围球，优化索引顺序，
+     * 按lodRatios生成LOD并选择顶点格式和索引类型
+     *
+     * 顶点数超出16位索引范围的网格按splitLargeMeshes切分，Meshes可能多于文件中的网格
+     */
+    ModelImportResult Import() override;
 };
 } // namespace Editor
 } // namespace MEngine
@@ -20,11 +29,15 @@ template <> struct adl_serializer<MEngine::Editor::FBXImporter>
 {
     static void to_json(json &j, const MEngine::Editor::FBXImporter &importer)
     {
-        j = static_cast<MEngine::Editor::AssetImporter>(importer);
+        adl_serializer<MEngine::Editor::ModelImporter>::to_json(j, importer);
+        j["generateTangents"] = importer.generateTangents;
+        j["flipUVs"] = importer.flipUVs;
     }
     static void from_json(const json &j, MEngine::Editor::FBXImporter &importer)
     {
-        static_cast<MEngine::Editor::AssetImporter &>(importer) = j;
+        adl_serializer<MEngine::Editor::ModelImporter>::from_json(j, importer);
+        importer.generateTangents = j.value("generateTangents", true);
+        importer.flipUVs = j.value("flipUVs", false);
     }
 };
-} // namespace nlohmann
\ No newline at end of file
+} // namespace nlohmann
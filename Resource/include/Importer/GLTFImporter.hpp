@@ -0,0 +1,42 @@
+#pragma once
+#include "Importer/ModelImporter.hpp"
+namespace MEngine
+{
+namespace Editor
+{
+/**
+ * @brief 原生glTF 2.0导入器，支持.glb和引用外部.bin或data URI的.gltf
+ *
+ * 文件和外部缓冲区通过内存映射读取，访问器直接指向映射内存；
+ * 布局与引擎格式一致的访问器（float3位置、uint32索引等）整段复制，其余逐元素转换。
+ * 每个图元（primitive）导入为一个网格，只支持三角形图元。
+ */
+class GLTFImporter final : public ModelImporter
+{
+  public:
+    // 文件没有切线时由纹理坐标计算
+    bool generateTangents = true;
+
+  public:
+    GLTFImporter();
+    ~GLTFImporter() override = default;
+    ModelImportResult Import() override;
+};
+} // namespace Editor
+} // namespace MEngine
+namespace nlohmann
+{
+template <> struct adl_serializer<MEngine::Editor::GLTFImporter>
+{
+    static void to_json(json &j, const MEngine::Editor::GLTFImporter &importer)
+    {
+        adl_serializer<MEngine::Editor::ModelImporter>::to_json(j, importer);
+        j["generateTangents"] = importer.generateTangents;
+    }
+    static void from_json(const json &j, MEngine::Editor::GLTFImporter &importer)
+    {
+        adl_serializer<MEngine::Editor::ModelImporter>::from_json(j, importer);
+        importer.generateTangents = j.value("generateTangents", true);
+    }
+};
+} // namespace nlohmann
@@ -0,0 +1,94 @@
+#pragma once
+#include "Asset/Mesh.hpp"
+#include "Asset/Model.hpp"
+#include "Importer/AssetImporter.hpp"
+#include <memory>
+#include <vector>
+namespace MEngine
+{
+namespace Editor
+{
+/**
+ * @brief 模型导入结果，Meshes的顺序与Model::Meshes一一对应
+ */
+struct ModelImportResult
+{
+    std::shared_ptr<Core::Model> Model;
+    std::vector<std::shared_ptr<Core::Mesh>> Meshes;
+};
+/**
+ * @brief 各格式模型导入器的基类，读入网格后统一做优化、切分、簇、LOD和顶点格式选择
+ */
+class ModelImporter : public AssetImporter
+{
+  public:
+    float globalScale = 1.0f;
+    // 顶点去重、缓存与过度绘制优化、顶点读取重排
+    bool optimizeMesh = true;
+    // 各级LOD相对原网格的目标三角形比例，为空则不生成LOD
+    std::vector<float> lodRatios{0.5f, 0.25f, 0.125f};
+    // 以紧凑顶点格式上传，位置误差超过maxPositionError（缩放后的单位）的网格仍使用标准格式
+    bool compactVertices = false;
+    float maxPositionError = 0.0005f;
+    // 三角形数不少于meshletMinTriangles的稠密网格切分成簇，绘制前逐簇剔除
+    bool generateMeshlets = true;
+    uint32_t meshletMinTriangles = 4096;
+    // 顶点数超出16位索引范围的网格切分成多个子网格，否则整体使用32位索引
+    bool splitLargeMeshes = true;
+    // 子网格ID，重新导入时复用，保证场景中的MeshComponent引用不失效
+    std::vector<Core::UUID> meshIDs;
+
+  public:
+    ~ModelImporter() override = default;
+    virtual ModelImportResult Import() = 0;
+
+  protected:
+    /**
+     * @brief 处理读入的网格并生成模型，网格已按globalScale缩放并计算好包围体
+     *
+     * 顶点数超出16位索引范围的网格按splitLargeMeshes切分，结果可能多于输入。
+     * hierarchy中的网格下标指向输入网格，切分后映射到对应的全部子网格；为空时生成挂载所有网格的单个根节点
+     */
+    ModelImportResult ProcessMeshes(std::vector<std::shared_ptr<Core::Mesh>> meshes,
+                                    Core::ModelHierarchy hierarchy = {});
+};
+} // namespace Editor
+} // namespace MEngine
+namespace nlohmann
+{
+template <> struct adl_serializer<MEngine::Editor::ModelImporter>
+{
+    static void to_json(json &j, const MEngine::Editor::ModelImporter &importer)
+    {
+        j = static_cast<MEngine::Editor::AssetImporter>(importer);
+        j["globalScale"] = importer.globalScale;
+        j["optimizeMesh"] = importer.optimizeMesh;
+        j["lodRatios"] = importer.lodRatios;
+        j["compactVertices"] = importer.compactVertices;
+        j["maxPositionError"] = importer.maxPositionError;
+        j["splitLargeMeshes"] = importer.splitLargeMeshes;
+        j["generateMeshlets"] = importer.generateMeshlets;
+        j["meshletMinTriangles"] = importer.meshletMinTriangles;
+        j["meshIDs"] = importer.meshIDs;
+    }
+    static void from_json(const json &j, MEngine::Editor::ModelImporter &importer)
+    {
+        static_cast<MEngine::Editor::AssetImporter &>(importer) = j;
+        importer.globalScale = j.value("globalScale", 1.0f);
+        importer.optimizeMesh = j.value("optimizeMesh", true);
+        if (j.contains("lodRatios"))
+        {
+            importer.lodRatios = j.at("lodRatios").get<std::vector<float>>();
+        }
+        importer.compactVertices = j.value("compactVertices", false);
+        importer.maxPositionError = j.value("maxPositionError", 0.0005f);
+        importer.splitLargeMeshes = j.value("splitLargeMeshes", true);
+        importer.generateMeshlets = j.value("generateMeshlets", true);
+        importer.meshletMinTriangles = j.value("meshletMinTriangles", 4096u);
+        if (j.contains("meshIDs"))
+        {
+            importer.meshIDs = j.at("meshIDs").get<std::vector<MEngine::Core::UUID>>();
+        }
+    }
+};
+} // namespace nlohmann
@@ -0,0 +1,42 @@
+#pragma once
+#include "Importer/ModelImporter.hpp"
+namespace MEngine
+{
+namespace Editor
+{
+/**
+ * @brief 面向大型扫描模型的OBJ导入器
+ *
+ * 文件内存映射后按窗口分段处理：每个窗口切成按行对齐的块并行解析，再按文件顺序合并并对
+ * (位置, 纹理坐标, 法线)组合去重，结果与线程数无关。解析完的窗口立即归还物理页，
+ * 常驻内存只随输出增长。每个o/g分组导入为一个网格，多边形按扇形三角化。
+ */
+class OBJImporter final : public ModelImporter
+{
+  public:
+    // 文件没有切线信息，有纹理坐标时由其计算
+    bool generateTangents = true;
+
+  public:
+    OBJImporter();
+    ~OBJImporter() override = default;
+    ModelImportResult Import() override;
+};
+} // namespace Editor
+} // namespace MEngine
+namespace nlohmann
+{
+template <> struct adl_serializer<MEngine::Editor::OBJImporter>
+{
+    static void to_json(json &j, const MEngine::Editor::OBJImporter &importer)
+    {
+        adl_serializer<MEngine::Editor::ModelImporter>::to_json(j, importer);
+        j["generateTangents"] = importer.generateTangents;
+    }
+    static void from_json(const json &j, MEngine::Editor::OBJImporter &importer)
+    {
+        adl_serializer<MEngine::Editor::ModelImporter>::from_json(j, importer);
+        importer.generateTangents = j.value("generateTangents", true);
+    }
+};
+} // namespace nlohmann
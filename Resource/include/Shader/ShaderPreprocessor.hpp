@@ -0,0 +1,75 @@
+#pragma once
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace MEngine
+{
+namespace Editor
+{
+/**
+ * @brief 预处理结果，dependencies 包含入口文件自身和所有被包含的文件
+ */
+struct PreprocessedShader
+{
+    std::string source;
+    std::vector<std::filesystem::path> dependencies;
+    bool success = false;
+};
+/**
+ * @brief GLSL预处理器
+ *
+ * 展开 #include "..." / #include <...>，支持 #pragma once，检测循环包含，
+ * 在 #version 之后插入宏定义，并用 #line 保持编译错误的行号对应原文件。
+ * 文件内容按修改时间缓存，记录每个入口文件依赖的包含文件以便增量重编译。
+ */
+class ShaderPreprocessor final
+{
+  private:
+    struct CachedFile
+    {
+        std::string content;
+        std::filesystem::file_time_type writeTime;
+    };
+    std::vector<std::filesystem::path> mIncludeDirectories;
+    std::unordered_map<std::filesystem::path, CachedFile> mFiles;
+    // 入口文件 -> 预处理时用到的所有文件
+    std::unordered_map<std::filesystem::path, std::vector<std::filesystem::path>> mDependencies;
+    // 预处理用到过的文件及上次检查时的修改时间，用于热重载
+    std::unordered_map<std::filesystem::path, std::filesystem::file_time_type> mWatchedFiles;
+
+  public:
+    /**
+     * @brief 添加包含搜索目录，相对于当前文件的路径优先
+     */
+    void AddIncludeDirectory(const std::filesystem::path &directory);
+    PreprocessedShader Process(const std::filesystem::path &path, const std::vector<std::string> &defines = {});
+    /**
+     * @brief 依赖该文件的入口文件（包括文件自身为入口的情况）
+     */
+    std::vector<std::filesystem::path> GetDependents(const std::filesystem::path &path) const;
+    /**
+     * @brief 丢弃文件缓存，下次预处理时重新读取
+     */
+    void Invalidate(const std::filesystem::path &path);
+    /**
+     * @brief 检查预处理用到过的文件，返回上次检查后被修改的文件，每次修改只报告一次
+     */
+    std::vector<std::filesystem::path> PollModifiedFiles();
+
+  private:
+    struct Context
+    {
+        std::vector<std::filesystem::path> stack; // 当前包含链，用于检测循环
+        std::unordered_set<std::filesystem::path> onceFiles;
+        std::vector<std::filesystem::path> dependencies;
+        const std::vector<std::string> *defines;
+    };
+    bool Expand(const std::filesystem::path &path, std::string &output, Context &context);
+    const std::string *ReadFile(const std::filesystem::path &path);
+    std::filesystem::path ResolveInclude(const std::string &name, const std::filesystem::path &currentDirectory) const;
+};
+} // namespace Editor
+} // namespace MEngine
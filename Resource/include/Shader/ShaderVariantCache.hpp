@@ -0,0 +1,61 @@
+#pragma once
+#include "Asset/Pipeline.hpp"
+#include "Shader/ShaderPreprocessor.hpp"
+#include <memory>
+#include <unordered_map>
+
+namespace MEngine
+{
+namespace Editor
+{
+// 引擎内置的关键字，管线在 Keywords 中声明自己支持哪些
+namespace ShaderKeywords
+{
+constexpr const char *NormalMap = "NORMAL_MAP";
+constexpr const char *Shadows = "SHADOWS";
+constexpr const char *Skinning = "SKINNING";
+} // namespace ShaderKeywords
+/**
+ * @brief 着色器变体缓存
+ *
+ * 以基础管线和关键字位掩码为键保存变体，变体在第一次请求时创建，交给渲染器使用时才编译。
+ * 同时把 Pipeline 的源码加载替换为 ShaderPreprocessor，修改包含文件时只重编译依赖它的变体。
+ */
+class ShaderVariantCache final
+{
+  private:
+    ShaderPreprocessor mPreprocessor;
+    std::unordered_map<const Core::Pipeline *, std::unordered_map<uint32_t, std::shared_ptr<Core::Pipeline>>>
+        mVariants;
+
+    ShaderVariantCache();
+
+  public:
+    static ShaderVariantCache &Get();
+    ~ShaderVariantCache();
+    ShaderVariantCache(const ShaderVariantCache &) = delete;
+    ShaderVariantCache &operator=(const ShaderVariantCache &) = delete;
+
+    inline ShaderPreprocessor &GetPreprocessor()
+    {
+        return mPreprocessor;
+    }
+    /**
+     * @brief 由关键字名计算位掩码，基础管线未声明的关键字被忽略
+     */
+    static uint32_t GetKeywordMask(const Core::Pipeline &base, const std::vector<std::string> &keywords);
+    /**
+     * @brief 获取变体，首次请求时创建但不编译；掩码为0时同样返回独立的变体
+     */
+    std::shared_ptr<Core::Pipeline> GetVariant(const std::shared_ptr<Core::Pipeline> &base, uint32_t keywordMask);
+    /**
+     * @brief 源文件修改后调用，重新提交所有依赖它的变体
+     *
+     * @return 受影响的变体数量，未编译过的变体只计数不编译
+     */
+    size_t OnSourceChanged(const std::filesystem::path &path);
+    void Remove(const Core::Pipeline *base);
+    size_t GetVariantCount() const;
+};
+} // namespace Editor
+} // namespace MEngine
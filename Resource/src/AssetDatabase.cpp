@@ -18,6 +18,7 @@ namespace Editor
 std::unordered_map<UUID, std::shared_ptr<AssetMeta>> AssetDatabase::UUID2Meta{};
 std::unordered_map<std::filesystem::path, UUID> AssetDatabase::Path2UUID{};
 std::vector<std::filesystem::path> AssetDatabase::AssetPaths{};
+std::unordered_map<UUID, std::shared_ptr<Asset>> AssetDatabase::SubAssets{};
 std::unordered_map<std::type_index, std::string> AssetDatabase::Asset2Extension{
     {typeid(Asset), ".asset"},     {typeid(Pipeline), ".shader"},   {typeid(Material), ".mat"},
     {typeid(PBRMaterial), ".mat"}, {typeid(PhongMaterial), ".mat"}, {typeid(CustomMaterial), ".mat"},
@@ -88,6 +89,18 @@ void AssetDatabase::ImportAsset(const std::filesystem::path &path)
         // 构建默认importer
         meta->importer = std::make_shared<TextureImporter>();
     }
+    else if (extension == ".fbx")
+    {
+        meta->importer = std::make_shared<FBXImporter>();
+    }
+    else if (extension == ".obj")
+    {
+        meta->importer = std::make_shared<OBJImporter>();
+    }
+    else if (extension == ".gltf" || extension == ".glb")
+    {
+        meta->importer = std::make_shared<GLTFImporter>();
+    }
     // for native asset
     else if (extension == ".mat" || extension == ".shader" || extension == ".prefab")
     {
@@ -175,6 +188,14 @@ std::shared_ptr<AssetMeta> AssetDatabase::GetAssetMeta(const std::filesystem::pa
         return nullptr;
     }
 }
+std::shared_ptr<AssetMeta> AssetDatabase::GetAssetMeta(const UUID &id)
+{
+    if (auto it = UUID2Meta.find(id); it != UUID2Meta.end())
+    {
+        return it->second;
+    }
+    return nullptr;
+}
 AssetType AssetDatabase::DetermineAssetType(const std::string &extension)
 {
     if (extension.empty())
@@ -198,7 +219,7 @@ AssetType AssetDatabase::DetermineAssetType(const std::string &extension)
     {
         return AssetType::Prefab;
     }
-    if (extension == ".fbx" || extension == ".obj")
+    if (extension == ".fbx" || extension == ".obj" || extension == ".gltf" || extension == ".glb")
     {
         return AssetType::Model;
     }
@@ -1,12 +1,102 @@
-
 #include "Importer/FBXImporter.hpp"
+#include "Logger.hpp"
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
 
 namespace MEngine
 {
 namespace Editor
 {
+namespace
+{
+std::shared_ptr<Core::Mesh> ConvertMesh(const aiMesh *aiMesh, float scale)
+{
+    auto mesh = std::make_shared<Core::Mesh>();
+    mesh->Name = aiMesh->mName.C_Str();
+    mesh->Vertices.resize(aiMesh->mNumVertices);
+    for (unsigned int i = 0; i < aiMesh->mNumVertices; i++)
+    {
+        auto &vertex = mesh->Vertices[i];
+        const auto &position = aiMesh->mVertices[i];
+        vertex.position = glm::vec3(position.x, position.y, position.z) * scale;
+        if (aiMesh->HasNormals())
+        {
+            const auto &normal = aiMesh->mNormals[i];
+            vertex.normal = glm::vec3(normal.x, normal.y, normal.z);
+        }
+        if (aiMesh->HasTextureCoords(0))
+        {
+            const auto &texCoord = aiMesh->mTextureCoords[0][i];
+            vertex.texCoord = glm::vec2(texCoord.x, texCoord.y);
+        }
+        if (aiMesh->HasTangentsAndBitangents())
+        {
+            const auto &tangent = aiMesh->mTangents[i];
+            const auto &bitangent = aiMesh->mBitangents[i];
+            vertex.tangent = glm::vec3(tangent.x, tangent.y, tangent.z);
+            vertex.bitangent = glm::vec3(bitangent.x, bitangent.y, bitangent.z);
+        }
+    }
+    mesh->Indices.reserve(static_cast<size_t>(aiMesh->mNumFaces) * 3);
+    for (unsigned int i = 0; i < aiMesh->mNumFaces; i++)
+    {
+        const auto &face = aiMesh->mFaces[i];
+        mesh->Indices.insert(mesh->Indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+    }
+    mesh->RecalculateBounds();
+    return mesh;
+}
+/**
+ * @brief assimp矩阵为行主序；顶点已按scale缩放，平移也要同样缩放才能保持相对位置
+ */
+glm::mat4 ConvertTransform(const aiMatrix4x4 &m, float scale)
+{
+    return glm::mat4(glm::vec4(m.a1, m.b1, m.c1, m.d1), glm::vec4(m.a2, m.b2, m.c2, m.d2),
+                     glm::vec4(m.a3, m.b3, m.c3, m.d3), glm::vec4(m.a4 * scale, m.b4 * scale, m.c4 * scale, m.d4));
+}
+void AddNode(const aiNode *node, int32_t parent, float scale, Core::ModelHierarchy &hierarchy)
+{
+    auto index = hierarchy.AddNode(node->mName.C_Str(), parent, ConvertTransform(node->mTransformation, scale),
+                                   std::span<const uint32_t>(node->mMeshes, node->mNumMeshes));
+    for (unsigned int i = 0; i < node->mNumChildren; i++)
+    {
+        AddNode(node->mChildren[i], index, scale, hierarchy);
+    }
+}
+} // namespace
 FBXImporter::FBXImporter()
 {
+    supportedExtensions = {".fbx"};
+}
+ModelImportResult FBXImporter::Import()
+{
+    ModelImportResult result;
+    unsigned int flags = aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenNormals;
+    if (generateTangents)
+    {
+        flags |= aiProcess_CalcTangentSpace;
+    }
+    if (flipUVs)
+    {
+        flags |= aiProcess_FlipUVs;
+    }
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(assetPath.string(), flags);
+    if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode)
+    {
+        LogError("Failed to import model {}: {}", assetPath.string(), importer.GetErrorString());
+        return result;
+    }
+    std::vector<std::shared_ptr<Core::Mesh>> meshes;
+    meshes.reserve(scene->mNumMeshes);
+    for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+    {
+        meshes.push_back(ConvertMesh(scene->mMeshes[i], globalScale));
+    }
+    Core::ModelHierarchy hierarchy;
+    AddNode(scene->mRootNode, -1, globalScale, hierarchy);
+    return ProcessMeshes(std::move(meshes), std::move(hierarchy));
 }
 } // namespace Editor
 } // namespace MEngine
@@ -0,0 +1,667 @@
+#include "Importer/GLTFImporter.hpp"
+#include "Geometry/VertexAttributes.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include <charconv>
+#include <cstring>
+#include <functional>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <span>
+
+namespace MEngine
+{
+namespace Editor
+{
+namespace
+{
+constexpr uint32_t GLBMagic = 0x46546C67; // "glTF"
+constexpr uint32_t GLBChunkJSON = 0x4E4F534A;
+constexpr uint32_t GLBChunkBIN = 0x004E4942;
+constexpr uint32_t ComponentByte = 5120;
+constexpr uint32_t ComponentUnsignedByte = 5121;
+constexpr uint32_t ComponentShort = 5122;
+constexpr uint32_t ComponentUnsignedShort = 5123;
+constexpr uint32_t ComponentUnsignedInt = 5125;
+constexpr uint32_t ComponentFloat = 5126;
+constexpr uint32_t ModeTriangles = 4;
+
+size_t GetComponentSize(uint32_t componentType)
+{
+    switch (componentType)
+    {
+    case ComponentByte:
+    case ComponentUnsignedByte:
+        return 1;
+    case ComponentShort:
+    case ComponentUnsignedShort:
+        return 2;
+    case ComponentUnsignedInt:
+    case ComponentFloat:
+        return 4;
+    default:
+        return 0;
+    }
+}
+uint32_t GetComponentCount(const std::string &type)
+{
+    if (type == "SCALAR")
+        return 1;
+    if (type == "VEC2")
+        return 2;
+    if (type == "VEC3")
+        return 3;
+    if (type == "VEC4")
+        return 4;
+    if (type == "MAT4")
+        return 16;
+    return 0;
+}
+/**
+ * @brief 访问器在文件映射上的视图，不复制数据
+ */
+struct AccessorView
+{
+    const uint8_t *data = nullptr;
+    size_t count = 0;
+    size_t stride = 0;
+    uint32_t componentType = ComponentFloat;
+    uint32_t components = 0;
+    bool normalized = false;
+
+    inline bool IsValid() const
+    {
+        return data != nullptr;
+    }
+    /**
+     * @brief 元素类型相同且紧密排列，可以整段复制
+     */
+    inline bool IsPacked(uint32_t type, uint32_t count) const
+    {
+        return componentType == type && components == count && stride == GetComponentSize(type) * count;
+    }
+    /**
+     * @brief 读取第index个元素的前n个分量，归一化整数转换到[0,1]或[-1,1]
+     */
+    void Read(size_t index, float *out, uint32_t n) const
+    {
+        const uint8_t *element = data + index * stride;
+        auto componentSize = GetComponentSize(componentType);
+        for (uint32_t c = 0; c < n && c < components; c++)
+        {
+            const uint8_t *p = element + c * componentSize;
+            switch (componentType)
+            {
+            case ComponentFloat:
+                std::memcpy(&out[c], p, sizeof(float));
+                break;
+            case ComponentUnsignedByte:
+                out[c] = normalized ? *p / 255.0f : static_cast<float>(*p);
+                break;
+            case ComponentByte: {
+                auto value = static_cast<int8_t>(*p);
+                out[c] = normalized ? std::max(value / 127.0f, -1.0f) : static_cast<float>(value);
+                break;
+            }
+            case ComponentUnsignedShort: {
+                uint16_t value;
+                std::memcpy(&value, p, sizeof(value));
+                out[c] = normalized ? value / 65535.0f : static_cast<float>(value);
+                break;
+            }
+            case ComponentShort: {
+                int16_t value;
+                std::memcpy(&value, p, sizeof(value));
+                out[c] = normalized ? std::max(value / 32767.0f, -1.0f) : static_cast<float>(value);
+                break;
+            }
+            case ComponentUnsignedInt: {
+                uint32_t value;
+                std::memcpy(&value, p, sizeof(value));
+                out[c] = static_cast<float>(value);
+                break;
+            }
+            }
+        }
+    }
+    uint32_t ReadIndex(size_t index) const
+    {
+        const uint8_t *p = data + index * stride;
+        switch (componentType)
+        {
+        case ComponentUnsignedByte:
+            return *p;
+        case ComponentUnsignedShort: {
+            uint16_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+        default: {
+            uint32_t value;
+            std::memcpy(&value, p, sizeof(value));
+            return value;
+        }
+        }
+    }
+};
+/**
+ * @brief 文件中的缓冲区，GLB的BIN块和外部.bin都直接引用映射内存，只有data URI需要解码
+ */
+class BufferSet
+{
+  private:
+    std::vector<Core::MappedFile> mFiles;
+    std::vector<std::vector<uint8_t>> mDecoded;
+    std::vector<std::span<const uint8_t>> mBuffers;
+
+  public:
+    bool Load(const nlohmann::json &document, std::span<const uint8_t> binChunk, const std::filesystem::path &directory)
+    {
+        if (!document.contains("buffers"))
+        {
+            return true;
+        }
+        for (const auto &buffer : document.at("buffers"))
+        {
+            auto byteLength = buffer.value("byteLength", size_t(0));
+            std::span<const uint8_t> data;
+            if (!buffer.contains("uri"))
+            {
+                data = binChunk;
+            }
+            else
+            {
+                auto uri = buffer.at("uri").get<std::string>();
+                if (uri.starts_with("data:"))
+                {
+                    auto comma = uri.find(',');
+                    if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos)
+                    {
+                        LogError("Unsupported glTF data URI");
+                        return false;
+                    }
+                    mDecoded.push_back(DecodeBase64(std::string_view(uri).substr(comma + 1)));
+                    data = mDecoded.back();
+                }
+                else
+                {
+                    Core::MappedFile file(directory / DecodeURI(uri));
+                    if (!file.IsOpen())
+                    {
+                        LogError("Failed to open glTF buffer {}", (directory / uri).string());
+                        return false;
+                    }
+                    // 映射地址不随MappedFile移动而改变
+                    data = file.GetSpan();
+                    mFiles.push_back(std::move(file));
+                }
+            }
+            if (data.size() < byteLength)
+            {
+                LogError("glTF buffer is shorter than its byteLength: {} < {}", data.size(), byteLength);
+                return false;
+            }
+            mBuffers.push_back(data.first(byteLength));
+        }
+        return true;
+    }
+    /**
+     * @brief 解析访问器，越界或不支持的访问器返回无效视图
+     */
+    AccessorView GetAccessor(const nlohmann::json &document, size_t index) const
+    {
+        AccessorView view;
+        const auto &accessors = document.at("accessors");
+        if (index >= accessors.size())
+        {
+            return view;
+        }
+        const auto &accessor = accessors.at(index);
+        if (!accessor.contains("bufferView") || accessor.contains("sparse"))
+        {
+            LogWarn("glTF accessor {} without buffer view or with sparse storage is not supported", index);
+            return view;
+        }
+        const auto &bufferView = document.at("bufferViews").at(accessor.at("bufferView").get<size_t>());
+        auto bufferIndex = bufferView.at("buffer").get<size_t>();
+        if (bufferIndex >= mBuffers.size())
+        {
+            return view;
+        }
+        view.count = accessor.at("count").get<size_t>();
+        view.componentType = accessor.at("componentType").get<uint32_t>();
+        view.components = GetComponentCount(accessor.at("type").get<std::string>());
+        view.normalized = accessor.value("normalized", false);
+        auto elementSize = GetComponentSize(view.componentType) * view.components;
+        view.stride = bufferView.value("byteStride", elementSize);
+        auto viewOffset = bufferView.value("byteOffset", size_t(0));
+        auto viewLength = bufferView.at("byteLength").get<size_t>();
+        auto offset = accessor.value("byteOffset", size_t(0));
+        const auto &buffer = mBuffers[bufferIndex];
+        if (elementSize == 0 || viewOffset + viewLength > buffer.size() ||
+            (view.count > 0 && offset + (view.count - 1) * view.stride + elementSize > viewLength))
+        {
+            LogError("glTF accessor {} is out of range", index);
+            return AccessorView{};
+        }
+        view.data = buffer.data() + viewOffset + offset;
+        return view;
+    }
+
+  private:
+    static std::vector<uint8_t> DecodeBase64(std::string_view text)
+    {
+        auto value = [](char c) -> int {
+            if (c >= 'A' && c <= 'Z')
+                return c - 'A';
+            if (c >= 'a' && c <= 'z')
+                return c - 'a' + 26;
+            if (c >= '0' && c <= '9')
+                return c - '0' + 52;
+            if (c == '+' || c == '-')
+                return 62;
+            if (c == '/' || c == '_')
+                return 63;
+            return -1;
+        };
+        std::vector<uint8_t> result;
+        result.reserve(text.size() / 4 * 3);
+        uint32_t bits = 0;
+        int bitCount = 0;
+        for (char c : text)
+        {
+            int v = value(c);
+            if (v < 0)
+            {
+                continue;
+            }
+            bits = (bits << 6) | static_cast<uint32_t>(v);
+            bitCount += 6;
+            if (bitCount >= 8)
+            {
+                bitCount -= 8;
+                result.push_back(static_cast<uint8_t>(bits >> bitCount));
+            }
+        }
+        return result;
+    }
+    static std::string DecodeURI(const std::string &uri)
+    {
+        std::string result;
+        for (size_t i = 0; i < uri.size(); i++)
+        {
+            if (uri[i] == '%' && i + 2 < uri.size())
+            {
+                // 非法的%XX原样保留
+                uint32_t value = 0;
+                const char *first = uri.data() + i + 1;
+                auto [last, error] = std::from_chars(first, first + 2, value, 16);
+                if (error == std::errc() && last == first + 2)
+                {
+                    result.push_back(static_cast<char>(value));
+                    i += 2;
+                }
+                else
+                {
+                    result.push_back(uri[i]);
+                }
+            }
+            else
+            {
+                result.push_back(uri[i]);
+            }
+        }
+        return result;
+    }
+};
+std::shared_ptr<Core::Mesh> ConvertPrimitive(const nlohmann::json &document, const nlohmann::json &primitive,
+                                             const BufferSet &buffers, float scale, bool generateTangents)
+{
+    const auto &attributes = primitive.at("attributes");
+    auto accessor = [&](const char *name) {
+        return attributes.contains(name) ? buffers.GetAccessor(document, attributes.at(name).get<size_t>())
+                                         : AccessorView{};
+    };
+    auto positions = accessor("POSITION");
+    if (!positions.IsValid() || positions.components != 3)
+    {
+        return nullptr;
+    }
+    auto mesh = std::make_shared<Core::Mesh>();
+    auto vertexCount = positions.count;
+    mesh->Vertices.resize(vertexCount);
+    auto &vertices = mesh->Vertices;
+    // float3位置和法线是最常见的布局，逐元素直接复制，不经过分量转换
+    if (positions.IsPacked(ComponentFloat, 3))
+    {
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            std::memcpy(&vertices[i].position, positions.data + i * positions.stride, sizeof(glm::vec3));
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            positions.Read(i, &vertices[i].position.x, 3);
+        }
+    }
+    if (scale != 1.0f)
+    {
+        for (auto &vertex : vertices)
+        {
+            vertex.position *= scale;
+        }
+    }
+    auto normals = accessor("NORMAL");
+    bool hasNormals = normals.IsValid() && normals.count == vertexCount && normals.components == 3;
+    if (hasNormals)
+    {
+        bool packed = normals.IsPacked(ComponentFloat, 3);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            if (packed)
+            {
+                std::memcpy(&vertices[i].normal, normals.data + i * normals.stride, sizeof(glm::vec3));
+            }
+            else
+            {
+                normals.Read(i, &vertices[i].normal.x, 3);
+            }
+        }
+    }
+    auto texCoords = accessor("TEXCOORD_0");
+    bool hasTexCoords = texCoords.IsValid() && texCoords.count == vertexCount && texCoords.components == 2;
+    if (hasTexCoords)
+    {
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            texCoords.Read(i, &vertices[i].texCoord.x, 2);
+            // glTF的纹理原点在左上角，纹理加载时已上下翻转
+            vertices[i].texCoord.y = 1.0f - vertices[i].texCoord.y;
+        }
+    }
+
+    auto indices = primitive.contains("indices")
+                       ? buffers.GetAccessor(document, primitive.at("indices").get<size_t>())
+                       : AccessorView{};
+    if (indices.IsValid())
+    {
+        mesh->Indices.resize(indices.count);
+        if (indices.IsPacked(ComponentUnsignedInt, 1))
+        {
+            std::memcpy(mesh->Indices.data(), indices.data, indices.count * sizeof(uint32_t));
+        }
+        else
+        {
+            for (size_t i = 0; i < indices.count; i++)
+            {
+                mesh->Indices[i] = indices.ReadIndex(i);
+            }
+        }
+        for (auto index : mesh->Indices)
+        {
+            if (index >= vertexCount)
+            {
+                LogError("glTF index {} out of range of {} vertices", index, vertexCount);
+                return nullptr;
+            }
+        }
+    }
+    else if (primitive.contains("indices"))
+    {
+        return nullptr;
+    }
+    else
+    {
+        mesh->Indices.resize(vertexCount);
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            mesh->Indices[i] = static_cast<uint32_t>(i);
+        }
+    }
+    mesh->Indices.resize(mesh->Indices.size() / 3 * 3);
+
+    if (!hasNormals)
+    {
+        Core::ComputeNormals(vertices, mesh->Indices);
+    }
+    // glTF的切线w为副切线方向的符号，副切线按MikkTSpace约定指向V向上，与翻转后的纹理坐标一致
+    auto tangents = accessor("TANGENT");
+    if (tangents.IsValid() && tangents.count == vertexCount && tangents.components == 4)
+    {
+        for (size_t i = 0; i < vertexCount; i++)
+        {
+            float tangent[4] = {1.0f, 0.0f, 0.0f, 1.0f};
+            tangents.Read(i, tangent, 4);
+            vertices[i].tangent = glm::vec3(tangent[0], tangent[1], tangent[2]);
+            vertices[i].bitangent = glm::cross(vertices[i].normal, vertices[i].tangent) * tangent[3];
+        }
+    }
+    else if (generateTangents && hasTexCoords)
+    {
+        Core::ComputeTangents(vertices, mesh->Indices);
+    }
+    mesh->RecalculateBounds();
+    return mesh;
+}
+/**
+ * @brief 节点的局部变换，matrix与TRS二选一，平移按scale缩放以匹配已缩放的顶点
+ */
+glm::mat4 GetLocalTransform(const nlohmann::json &node, float scale)
+{
+    glm::mat4 transform(1.0f);
+    if (node.contains("matrix"))
+    {
+        auto matrix = node.at("matrix").get<std::vector<float>>();
+        if (matrix.size() == 16)
+        {
+            // glTF矩阵按列主序存储
+            for (int column = 0; column < 4; column++)
+            {
+                for (int row = 0; row < 4; row++)
+                {
+                    transform[column][row] = matrix[column * 4 + row];
+                }
+            }
+        }
+    }
+    else
+    {
+        auto translation = node.value("translation", std::vector<float>{0.0f, 0.0f, 0.0f});
+        auto rotation = node.value("rotation", std::vector<float>{0.0f, 0.0f, 0.0f, 1.0f});
+        auto nodeScale = node.value("scale", std::vector<float>{1.0f, 1.0f, 1.0f});
+        if (translation.size() == 3 && rotation.size() == 4 && nodeScale.size() == 3)
+        {
+            // rotation按(x, y, z, w)存储
+            transform = glm::translate(glm::mat4(1.0f), glm::vec3(translation[0], translation[1], translation[2])) *
+                        glm::mat4_cast(glm::quat(rotation[3], rotation[0], rotation[1], rotation[2])) *
+                        glm::scale(glm::mat4(1.0f), glm::vec3(nodeScale[0], nodeScale[1], nodeScale[2]));
+        }
+    }
+    transform[3] = glm::vec4(glm::vec3(transform[3]) * scale, transform[3][3]);
+    return transform;
+}
+/**
+ * @brief 从默认场景的根节点开始按深度优先先序展开节点，没有场景时以所有未被引用的节点为根
+ */
+Core::ModelHierarchy BuildHierarchy(const nlohmann::json &document,
+                                    const std::vector<std::vector<uint32_t>> &primitiveMeshes, float scale)
+{
+    Core::ModelHierarchy hierarchy;
+    if (!document.contains("nodes"))
+    {
+        return hierarchy;
+    }
+    const auto &nodes = document.at("nodes");
+    std::vector<size_t> roots;
+    if (document.contains("scenes") && !document.at("scenes").empty())
+    {
+        auto scene = document.value("scene", size_t(0));
+        const auto &scenes = document.at("scenes");
+        const auto &sceneNodes = scenes.at(scene < scenes.size() ? scene : 0).value("nodes", nlohmann::json::array());
+        for (const auto &node : sceneNodes)
+        {
+            roots.push_back(node.get<size_t>());
+        }
+    }
+    else
+    {
+        std::vector<bool> isChild(nodes.size(), false);
+        for (const auto &node : nodes)
+        {
+            for (const auto &child : node.value("children", nlohmann::json::array()))
+            {
+                auto index = child.get<size_t>();
+                if (index < isChild.size())
+                {
+                    isChild[index] = true;
+                }
+            }
+        }
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            if (!isChild[i])
+            {
+                roots.push_back(i);
+            }
+        }
+    }
+    // 按规范节点构成森林，visited防止错误文件中的环导致无限递归
+    std::vector<bool> visited(nodes.size(), false);
+    std::function<void(size_t, int32_t)> addNode = [&](size_t index, int32_t parent) {
+        if (index >= nodes.size() || visited[index])
+        {
+            return;
+        }
+        visited[index] = true;
+        const auto &node = nodes.at(index);
+        std::span<const uint32_t> meshes;
+        if (node.contains("mesh"))
+        {
+            auto mesh = node.at("mesh").get<size_t>();
+            if (mesh < primitiveMeshes.size())
+            {
+                meshes = primitiveMeshes[mesh];
+            }
+        }
+        auto current = hierarchy.AddNode(node.value("name", "node_" + std::to_string(index)), parent,
+                                         GetLocalTransform(node, scale), meshes);
+        for (const auto &child : node.value("children", nlohmann::json::array()))
+        {
+            addNode(child.get<size_t>(), current);
+        }
+    };
+    for (auto root : roots)
+    {
+        addNode(root, -1);
+    }
+    return hierarchy;
+}
+} // namespace
+GLTFImporter::GLTFImporter()
+{
+    supportedExtensions = {".gltf", ".glb"};
+}
+ModelImportResult GLTFImporter::Import()
+{
+    Core::MappedFile file(assetPath);
+    if (!file.IsOpen())
+    {
+        LogError("Failed to open model {}", assetPath.string());
+        return {};
+    }
+    auto bytes = file.GetSpan();
+    std::span<const uint8_t> jsonChunk = bytes;
+    std::span<const uint8_t> binChunk;
+    uint32_t magic = 0;
+    if (bytes.size() >= 12)
+    {
+        std::memcpy(&magic, bytes.data(), sizeof(magic));
+    }
+    if (magic == GLBMagic)
+    {
+        // 12字节文件头后依次是JSON块和可选的BIN块，每块以长度和类型开头
+        jsonChunk = {};
+        size_t offset = 12;
+        while (offset + 8 <= bytes.size())
+        {
+            uint32_t chunkLength = 0, chunkType = 0;
+            std::memcpy(&chunkLength, bytes.data() + offset, sizeof(chunkLength));
+            std::memcpy(&chunkType, bytes.data() + offset + 4, sizeof(chunkType));
+            offset += 8;
+            if (offset + chunkLength > bytes.size())
+            {
+                break;
+            }
+            auto chunk = bytes.subspan(offset, chunkLength);
+            if (chunkType == GLBChunkJSON && jsonChunk.empty())
+            {
+                jsonChunk = chunk;
+            }
+            else if (chunkType == GLBChunkBIN && binChunk.empty())
+            {
+                binChunk = chunk;
+            }
+            offset += chunkLength;
+        }
+    }
+    auto document = nlohmann::json::parse(jsonChunk.begin(), jsonChunk.end(), nullptr, false);
+    if (document.is_discarded() || !document.is_object())
+    {
+        LogError("Failed to parse glTF {}", assetPath.string());
+        return {};
+    }
+    std::vector<std::shared_ptr<Core::Mesh>> meshes;
+    Core::ModelHierarchy hierarchy;
+    // 描述中缺少字段或类型不符时nlohmann::json抛出异常，按导入失败处理
+    try
+    {
+        BufferSet buffers;
+        if (!buffers.Load(document, binChunk, assetPath.parent_path()))
+        {
+            LogError("Failed to load buffers of glTF {}", assetPath.string());
+            return {};
+        }
+        // glTF网格的每个图元导入为一个网格，节点通过这里找到对应的全部网格
+        std::vector<std::vector<uint32_t>> primitiveMeshes;
+        if (document.contains("meshes"))
+        {
+            const auto &documentMeshes = document.at("meshes");
+            primitiveMeshes.resize(documentMeshes.size());
+            for (size_t m = 0; m < documentMeshes.size(); m++)
+            {
+                const auto &gltfMesh = documentMeshes.at(m);
+                auto meshName = gltfMesh.value("name", "mesh_" + std::to_string(m));
+                const auto &primitives = gltfMesh.at("primitives");
+                for (size_t p = 0; p < primitives.size(); p++)
+                {
+                    const auto &primitive = primitives.at(p);
+                    if (primitive.value("mode", ModeTriangles) != ModeTriangles)
+                    {
+                        LogWarn("Skip non-triangle primitive {} of glTF mesh {}", p, meshName);
+                        continue;
+                    }
+                    auto mesh = ConvertPrimitive(document, primitive, buffers, globalScale, generateTangents);
+                    if (!mesh)
+                    {
+                        LogError("Failed to convert primitive {} of glTF mesh {}", p, meshName);
+                        continue;
+                    }
+                    mesh->Name = primitives.size() > 1 ? meshName + "_" + std::to_string(p) : meshName;
+                    primitiveMeshes[m].push_back(static_cast<uint32_t>(meshes.size()));
+                    meshes.push_back(std::move(mesh));
+                }
+            }
+        }
+        hierarchy = BuildHierarchy(document, primitiveMeshes, globalScale);
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        LogError("Invalid glTF {}: {}", assetPath.string(), e.what());
+        return {};
+    }
+    return ProcessMeshes(std::move(meshes), std::move(hierarchy));
+}
+} // namespace Editor
+} // namespace MEngine
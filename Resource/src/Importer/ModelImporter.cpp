@@ -0,0 +1,200 @@
+#include "Importer/ModelImporter.hpp"
+#include "Geometry/MeshLod.hpp"
+#include "Geometry/MeshOptimizer.hpp"
+#include "Geometry/MeshSimplifier.hpp"
+#include "Geometry/MeshletBuilder.hpp"
+#include "Geometry/VertexQuantization.hpp"
+#include "Logger.hpp"
+#include <cfloat>
+
+namespace MEngine
+{
+namespace Editor
+{
+namespace
+{
+void OptimizeMesh(Core::Mesh &mesh)
+{
+    auto vertexCount = mesh.Vertices.size();
+    auto before = Core::MeshOptimizer::AnalyzeVertexCache(mesh.Indices, mesh.Vertices.size());
+    Core::MeshOptimizer::Optimize(mesh.Vertices, mesh.Indices);
+    auto after = Core::MeshOptimizer::AnalyzeVertexCache(mesh.Indices, mesh.Vertices.size());
+    LogInfo("Optimize mesh {}: vertices {} -> {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}", mesh.Name,
+            vertexCount, mesh.Vertices.size(), before.acmr, after.acmr, before.atvr, after.atvr);
+}
+/**
+ * @brief 顶点数超出16位索引范围的网格按三角形顺序切成多个子网格，每段都能使用16位索引
+ */
+std::vector<std::shared_ptr<Core::Mesh>> SplitMesh(std::shared_ptr<Core::Mesh> mesh)
+{
+    if (mesh->Vertices.size() <= Core::MaxUInt16IndexedVertices)
+    {
+        return {std::move(mesh)};
+    }
+    auto offsets =
+        Core::MeshOptimizer::SplitByVertexLimit(mesh->Indices, mesh->Vertices.size(), Core::MaxUInt16IndexedVertices);
+    std::vector<std::shared_ptr<Core::Mesh>> parts;
+    for (size_t i = 0; i + 1 < offsets.size(); i++)
+    {
+        auto part = std::make_shared<Core::Mesh>();
+        part->Name = mesh->Name + "_" + std::to_string(i);
+        Core::MeshOptimizer::ExtractRange(mesh->Vertices, mesh->Indices, offsets[i], offsets[i + 1], part->Vertices,
+                                          part->Indices);
+        part->RecalculateBounds();
+        parts.push_back(std::move(part));
+    }
+    LogInfo("Split mesh {} with {} vertices into {} parts for 16-bit indices", mesh->Name, mesh->Vertices.size(),
+            parts.size());
+    return parts;
+}
+void GenerateLods(Core::Mesh &mesh, const std::vector<float> &ratios, bool optimize)
+{
+    mesh.Lods.clear();
+    size_t previousCount = mesh.Indices.size();
+    for (float ratio : ratios)
+    {
+        if (mesh.Lods.size() + 1 >= Core::MaxMeshLods)
+        {
+            break;
+        }
+        auto target = static_cast<size_t>(static_cast<float>(mesh.Indices.size()) * ratio) / 3 * 3;
+        float error = 0.0f;
+        // 每级都从原网格简化，误差直接相对原网格
+        auto indices = Core::MeshSimplifier::Simplify(mesh.Vertices, mesh.Indices, target, FLT_MAX, &error);
+        // 接缝和边界锁定后可能简化不动，减少不到一成的级别没有意义
+        if (indices.empty() || indices.size() * 10 > previousCount * 9)
+        {
+            break;
+        }
+        previousCount = indices.size();
+        // LOD共用已按LOD0排好的顶点，只重排自己的三角形
+        if (optimize)
+        {
+            Core::MeshOptimizer::OptimizeVertexCache(indices, mesh.Vertices.size());
+        }
+        mesh.Lods.push_back(Core::MeshLod{
+            .Indices = std::move(indices),
+            .Error = mesh.Sphere.radius > 0.0f ? error / mesh.Sphere.radius : 0.0f,
+        });
+    }
+}
+/**
+ * @brief 把节点引用的输入网格替换为切分后的全部子网格
+ */
+Core::ModelHierarchy RemapHierarchy(Core::ModelHierarchy hierarchy, const std::vector<Core::MeshRange> &outputRanges,
+                                    const std::string &rootName)
+{
+    Core::ModelHierarchy result;
+    if (hierarchy.IsEmpty())
+    {
+        std::vector<uint32_t> meshes;
+        for (const auto &range : outputRanges)
+        {
+            for (uint32_t i = 0; i < range.count; i++)
+            {
+                meshes.push_back(range.offset + i);
+            }
+        }
+        result.AddNode(rootName, -1, glm::mat4(1.0f), meshes);
+        return result;
+    }
+    result.Reserve(hierarchy.GetNodeCount(), hierarchy.MeshIndices.size());
+    std::vector<uint32_t> meshes;
+    for (size_t node = 0; node < hierarchy.GetNodeCount(); node++)
+    {
+        meshes.clear();
+        for (auto input : hierarchy.GetMeshes(node))
+        {
+            if (input >= outputRanges.size())
+            {
+                // 越界的下标标记为无效，由调用方校验后整体替换
+                meshes.push_back(UINT32_MAX);
+                continue;
+            }
+            for (uint32_t i = 0; i < outputRanges[input].count; i++)
+            {
+                meshes.push_back(outputRanges[input].offset + i);
+            }
+        }
+        result.AddNode(std::move(hierarchy.Names[node]), hierarchy.Parents[node], hierarchy.LocalTransforms[node],
+                       meshes);
+    }
+    return result;
+}
+} // namespace
+ModelImportResult ModelImporter::ProcessMeshes(std::vector<std::shared_ptr<Core::Mesh>> meshes,
+                                               Core::ModelHierarchy hierarchy)
+{
+    ModelImportResult result;
+    result.Model = std::make_shared<Core::Model>();
+    result.Model->Name = name;
+    result.Meshes.reserve(meshes.size());
+    size_t lodCount = 0;
+    size_t compactCount = 0;
+    size_t uint16Count = 0;
+    size_t meshletCount = 0;
+    // 每个输入网格对应的输出子网格区间
+    std::vector<Core::MeshRange> outputRanges;
+    outputRanges.reserve(meshes.size());
+    for (auto &mesh : meshes)
+    {
+        if (optimizeMesh)
+        {
+            OptimizeMesh(*mesh);
+        }
+        auto parts = splitLargeMeshes ? SplitMesh(std::move(mesh)) : std::vector<std::shared_ptr<Core::Mesh>>{mesh};
+        outputRanges.push_back(
+            Core::MeshRange{static_cast<uint32_t>(result.Meshes.size()), static_cast<uint32_t>(parts.size())});
+        for (auto &part : parts)
+        {
+            part->ChooseIndexFormat();
+            // 簇按缓存优化后的顺序生长，重排LOD0的三角形；LOD只在远处使用，不再切分
+            if (generateMeshlets && part->Indices.size() / 3 >= meshletMinTriangles)
+            {
+                part->Meshlets = Core::MeshletBuilder::Build(part->Vertices, part->Indices);
+                meshletCount += part->Meshlets.size();
+            }
+            if (part->IndexFormat == Core::IndexType::UInt16)
+            {
+                uint16Count++;
+            }
+            GenerateLods(*part, lodRatios, optimizeMesh);
+            lodCount += part->Lods.size();
+            if (compactVertices)
+            {
+                part->Format = Core::ChooseVertexFormat(*part, maxPositionError);
+                if (part->Format == Core::VertexFormat::Compact)
+                {
+                    compactCount++;
+                }
+                else
+                {
+                    LogInfo("Mesh {} keeps standard vertices: position error or texture coordinates out of range",
+                            part->Name);
+                }
+            }
+            result.Meshes.push_back(std::move(part));
+        }
+    }
+    // 子网格按输出顺序编号，重新导入同一文件时切分结果不变
+    meshIDs.resize(result.Meshes.size());
+    for (auto &meshID : meshIDs)
+    {
+        if (meshID == Core::UUID())
+        {
+            meshID = Core::UUIDGenerator()();
+        }
+    }
+    result.Model->Meshes = meshIDs;
+    result.Model->Hierarchy = RemapHierarchy(std::move(hierarchy), outputRanges, name);
+    if (!result.Model->Hierarchy.IsValid(result.Meshes.size()))
+    {
+        LogError("Invalid node hierarchy in model {}, replaced by a single root node", assetPath.string());
+        result.Model->Hierarchy = RemapHierarchy({}, outputRanges, name);
+    }
+    LogInfo("Import model {}: {} meshes ({} compact, {} with 16-bit indices), {} lods, {} meshlets",
+            assetPath.string(), result.Meshes.size(), compactCount, uint16Count, lodCount, meshletCount);
+    return result;
+}
+} // namespace Editor
+} // namespace MEngine
@@ -0,0 +1,574 @@
+#include "Importer/OBJImporter.hpp"
+#include "Geometry/VertexAttributes.hpp"
+#include "Logger.hpp"
+#include "MappedFile.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <string_view>
+#include <thread>
+
+namespace MEngine
+{
+namespace Editor
+{
+namespace
+{
+// 每块约8MB，一个窗口包含的块数随线程数增长，窗口解析完即归还映射页
+constexpr size_t ChunkSize = 8ull << 20;
+constexpr size_t ChunksPerThread = 2;
+constexpr int32_t MissingIndex = INT32_MIN;
+constexpr uint32_t MissingKey = UINT32_MAX;
+constexpr uint32_t RelativePosition = 1u << 0;
+constexpr uint32_t RelativeTexCoord = 1u << 1;
+constexpr uint32_t RelativeNormal = 1u << 2;
+
+/**
+ * @brief 面的一个角，负数索引相对于所在块之前的顶点数，合并时才能换算成全局索引
+ */
+struct Corner
+{
+    int32_t position = 0;
+    int32_t texCoord = MissingIndex;
+    int32_t normal = MissingIndex;
+    uint32_t relative = 0;
+};
+struct GroupMarker
+{
+    size_t corner;
+    std::string name;
+};
+/**
+ * @brief 一个块的解析结果，顶点数组和三角化后的面角都按文件顺序排列
+ */
+struct Chunk
+{
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<Corner> corners;
+    std::vector<GroupMarker> groups;
+    size_t skippedLines = 0;
+};
+struct VertexKey
+{
+    uint32_t position;
+    uint32_t texCoord;
+    uint32_t normal;
+    inline bool operator==(const VertexKey &other) const = default;
+};
+/**
+ * @brief 按首次出现的顺序为顶点组合分配索引，开放寻址，表中只存索引
+ */
+class VertexDeduplicator
+{
+  private:
+    std::vector<uint32_t> mTable;
+    size_t mMask = 0;
+
+  public:
+    std::vector<VertexKey> Keys;
+
+  public:
+    uint32_t Insert(const VertexKey &key)
+    {
+        if ((Keys.size() + 1) * 2 > mTable.size())
+        {
+            Rehash(std::max<size_t>(mTable.size() * 2, 1024));
+        }
+        size_t slot = Hash(key) & mMask;
+        while (mTable[slot] != MissingKey)
+        {
+            if (Keys[mTable[slot]] == key)
+            {
+                return mTable[slot];
+            }
+            slot = (slot + 1) & mMask;
+        }
+        auto index = static_cast<uint32_t>(Keys.size());
+        mTable[slot] = index;
+        Keys.push_back(key);
+        return index;
+    }
+    void Release()
+    {
+        mTable = {};
+        mMask = 0;
+    }
+
+  private:
+    static size_t Hash(const VertexKey &key)
+    {
+        uint64_t h = key.position * 0x9E3779B97F4A7C15ull;
+        h ^= (key.texCoord + 0x632BE59BD9B4E019ull + (h << 6) + (h >> 2)) * 0xBF58476D1CE4E5B9ull;
+        h ^= (key.normal + 0x94D049BB133111EBull + (h << 6) + (h >> 2)) * 0x94D049BB133111EBull;
+        return static_cast<size_t>(h ^ (h >> 31));
+    }
+    void Rehash(size_t capacity)
+    {
+        mTable.assign(capacity, MissingKey);
+        mMask = capacity - 1;
+        for (uint32_t i = 0; i < Keys.size(); i++)
+        {
+            size_t slot = Hash(Keys[i]) & mMask;
+            while (mTable[slot] != MissingKey)
+            {
+                slot = (slot + 1) & mMask;
+            }
+            mTable[slot] = i;
+        }
+    }
+};
+struct GroupBuilder
+{
+    std::string name;
+    VertexDeduplicator vertices;
+    std::vector<uint32_t> indices;
+    bool invalid = false;
+};
+
+inline bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t';
+}
+inline bool IsLineEnd(char c)
+{
+    return c == '\n' || c == '\r';
+}
+inline void SkipSpaces(const char *&p, const char *end)
+{
+    while (p < end && IsSpace(*p))
+    {
+        p++;
+    }
+}
+/**
+ * @brief 与区域设置无关的浮点解析，std::from_chars不接受前导'+'
+ */
+bool ParseFloat(const char *&p, const char *end, float &value)
+{
+    SkipSpaces(p, end);
+    if (p < end && *p == '+')
+    {
+        p++;
+    }
+    auto [next, error] = std::from_chars(p, end, value);
+    if (error != std::errc())
+    {
+        return false;
+    }
+    p = next;
+    return true;
+}
+bool ParseInt(const char *&p, const char *end, int32_t &value)
+{
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = *p == '-';
+        p++;
+    }
+    if (p >= end || *p < '0' || *p > '9')
+    {
+        return false;
+    }
+    int64_t result = 0;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        result = result * 10 + (*p - '0');
+        if (result > INT32_MAX)
+        {
+            return false;
+        }
+        p++;
+    }
+    value = static_cast<int32_t>(negative ? -result : result);
+    return true;
+}
+/**
+ * @brief 将OBJ中从1开始的索引转换为从0开始，负数索引转换为相对块起点的偏移
+ */
+bool ResolveIndex(int32_t index, size_t localCount, uint32_t flag, int32_t &result, uint32_t &relative)
+{
+    if (index > 0)
+    {
+        result = index - 1;
+        return true;
+    }
+    if (index < 0)
+    {
+        result = static_cast<int32_t>(static_cast<int64_t>(localCount) + index);
+        relative |= flag;
+        return true;
+    }
+    return false;
+}
+bool ParseFace(const char *p, const char *end, Chunk &chunk, std::vector<Corner> &polygon)
+{
+    polygon.clear();
+    while (true)
+    {
+        SkipSpaces(p, end);
+        if (p >= end || IsLineEnd(*p) || *p == '#')
+        {
+            break;
+        }
+        Corner corner;
+        int32_t index = 0;
+        if (!ParseInt(p, end, index) ||
+            !ResolveIndex(index, chunk.positions.size(), RelativePosition, corner.position, corner.relative))
+        {
+            return false;
+        }
+        if (p < end && *p == '/')
+        {
+            p++;
+            if (p < end && *p != '/')
+            {
+                if (!ParseInt(p, end, index) ||
+                    !ResolveIndex(index, chunk.texCoords.size(), RelativeTexCoord, corner.texCoord, corner.relative))
+                {
+                    return false;
+                }
+            }
+            if (p < end && *p == '/')
+            {
+                p++;
+                if (!ParseInt(p, end, index) ||
+                    !ResolveIndex(index, chunk.normals.size(), RelativeNormal, corner.normal, corner.relative))
+                {
+                    return false;
+                }
+            }
+        }
+        if (p < end && !IsSpace(*p) && !IsLineEnd(*p))
+        {
+            return false;
+        }
+        polygon.push_back(corner);
+    }
+    if (polygon.size() < 3)
+    {
+        return false;
+    }
+    // 按扇形三角化，凸多边形结果正确，扫描数据基本都是三角形
+    for (size_t i = 1; i + 1 < polygon.size(); i++)
+    {
+        chunk.corners.push_back(polygon[0]);
+        chunk.corners.push_back(polygon[i]);
+        chunk.corners.push_back(polygon[i + 1]);
+    }
+    return true;
+}
+std::string_view ReadName(const char *p, const char *end)
+{
+    SkipSpaces(p, end);
+    auto nameEnd = p;
+    while (nameEnd < end && !IsLineEnd(*nameEnd))
+    {
+        nameEnd++;
+    }
+    while (nameEnd > p && IsSpace(nameEnd[-1]))
+    {
+        nameEnd--;
+    }
+    return std::string_view(p, nameEnd - p);
+}
+/**
+ * @brief 解析[begin, end)内的完整行，只处理v/vt/vn/f/o/g，其余语句忽略
+ */
+void ParseChunk(const char *begin, const char *end, Chunk &chunk)
+{
+    // 估计每行约30字节，避免解析时反复扩容
+    chunk.positions.reserve((end - begin) / 32);
+    chunk.corners.reserve((end - begin) / 16);
+    std::vector<Corner> polygon;
+    const char *line = begin;
+    while (line < end)
+    {
+        auto lineEnd = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        lineEnd = lineEnd ? lineEnd : end;
+        const char *p = line;
+        line = lineEnd + 1;
+        SkipSpaces(p, lineEnd);
+        if (p + 1 >= lineEnd)
+        {
+            continue;
+        }
+        bool valid = true;
+        if (p[0] == 'v' && IsSpace(p[1]))
+        {
+            p += 2;
+            glm::vec3 position;
+            valid = ParseFloat(p, lineEnd, position.x) && ParseFloat(p, lineEnd, position.y) &&
+                    ParseFloat(p, lineEnd, position.z);
+            // 解析失败也占位，保证后续索引不错位
+            chunk.positions.push_back(valid ? position : glm::vec3(0.0f));
+        }
+        else if (p[0] == 'v' && p[1] == 't' && p + 2 < lineEnd && IsSpace(p[2]))
+        {
+            p += 3;
+            glm::vec2 texCoord(0.0f);
+            valid = ParseFloat(p, lineEnd, texCoord.x);
+            // v分量可省略
+            ParseFloat(p, lineEnd, texCoord.y);
+            chunk.texCoords.push_back(texCoord);
+        }
+        else if (p[0] == 'v' && p[1] == 'n' && p + 2 < lineEnd && IsSpace(p[2]))
+        {
+            p += 3;
+            glm::vec3 normal;
+            valid = ParseFloat(p, lineEnd, normal.x) && ParseFloat(p, lineEnd, normal.y) &&
+                    ParseFloat(p, lineEnd, normal.z);
+            chunk.normals.push_back(valid ? normal : glm::vec3(0.0f, 1.0f, 0.0f));
+        }
+        else if (p[0] == 'f' && IsSpace(p[1]))
+        {
+            valid = ParseFace(p + 2, lineEnd, chunk, polygon);
+        }
+        else if ((p[0] == 'o' || p[0] == 'g') && IsSpace(p[1]))
+        {
+            chunk.groups.push_back(GroupMarker{chunk.corners.size(), std::string(ReadName(p + 2, lineEnd))});
+        }
+        if (!valid)
+        {
+            chunk.skippedLines++;
+        }
+    }
+}
+inline const uint8_t *NextLine(const uint8_t *p, const uint8_t *end)
+{
+    auto newline = static_cast<const uint8_t *>(std::memchr(p, '\n', end - p));
+    return newline ? newline + 1 : end;
+}
+uint32_t ToGlobal(int32_t index, uint32_t relative, uint32_t flag, size_t base, bool &invalid)
+{
+    if (index == MissingIndex)
+    {
+        return MissingKey;
+    }
+    auto global = (relative & flag) ? static_cast<int64_t>(base) + index : static_cast<int64_t>(index);
+    if (global < 0 || global >= MissingKey)
+    {
+        invalid = true;
+        return 0;
+    }
+    return static_cast<uint32_t>(global);
+}
+struct ExpandedMesh
+{
+    std::shared_ptr<Core::Mesh> mesh;
+    bool missingNormals = false;
+    bool hasTexCoords = false;
+};
+/**
+ * @brief 按去重后的顶点组合展开顶点，引用了不存在的顶点时返回空网格
+ */
+ExpandedMesh ExpandVertices(GroupBuilder &group, const std::vector<glm::vec3> &positions,
+                            const std::vector<glm::vec2> &texCoords, const std::vector<glm::vec3> &normals, float scale)
+{
+    const auto &keys = group.vertices.Keys;
+    auto mesh = std::make_shared<Core::Mesh>();
+    mesh->Vertices.resize(keys.size());
+    std::atomic<bool> invalid = group.invalid;
+    std::atomic<bool> missingNormals = false;
+    std::atomic<bool> hasTexCoords = false;
+    Core::ThreadPool::Get().ParallelFor(keys.size(), 1 << 16, [&](size_t begin, size_t end) {
+        bool localInvalid = false, localMissingNormals = false, localTexCoords = false;
+        for (size_t i = begin; i < end; i++)
+        {
+            const auto &key = keys[i];
+            auto &vertex = mesh->Vertices[i];
+            if (key.position >= positions.size())
+            {
+                localInvalid = true;
+                continue;
+            }
+            vertex.position = positions[key.position] * scale;
+            if (key.texCoord != MissingKey)
+            {
+                localInvalid |= key.texCoord >= texCoords.size();
+                vertex.texCoord = key.texCoord < texCoords.size() ? texCoords[key.texCoord] : glm::vec2(0.0f);
+                localTexCoords = true;
+            }
+            if (key.normal != MissingKey && key.normal < normals.size())
+            {
+                vertex.normal = normals[key.normal];
+            }
+            else
+            {
+                localInvalid |= key.normal != MissingKey;
+                localMissingNormals = true;
+            }
+        }
+        if (localInvalid)
+            invalid = true;
+        if (localMissingNormals)
+            missingNormals = true;
+        if (localTexCoords)
+            hasTexCoords = true;
+    });
+    if (invalid)
+    {
+        return {};
+    }
+    group.vertices = {};
+    mesh->Indices = std::move(group.indices);
+    return ExpandedMesh{std::move(mesh), missingNormals, hasTexCoords};
+}
+} // namespace
+OBJImporter::OBJImporter()
+{
+    supportedExtensions = {".obj"};
+}
+ModelImportResult OBJImporter::Import()
+{
+    auto start = std::chrono::steady_clock::now();
+    Core::MappedFile file(assetPath);
+    if (!file.IsOpen())
+    {
+        LogError("Failed to open model {}", assetPath.string());
+        return {};
+    }
+    file.AdviseSequential();
+    auto &threadPool = Core::ThreadPool::Get();
+    auto windowSize = ChunkSize * ChunksPerThread * (threadPool.GetThreadCount() + 1);
+    const uint8_t *data = file.GetData();
+    const uint8_t *fileEnd = data + file.GetSize();
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<GroupBuilder> groups(1);
+    groups.back().name = assetPath.stem().string();
+    size_t skippedLines = 0, triangles = 0;
+    // 按块的顺序合并，顶点编号只取决于文件内容
+    auto merge = [&](std::vector<Chunk> &chunks) {
+        for (auto &chunk : chunks)
+        {
+            auto positionBase = positions.size();
+            auto texCoordBase = texCoords.size();
+            auto normalBase = normals.size();
+            positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+            texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+            normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+            size_t marker = 0;
+            for (size_t i = 0; i <= chunk.corners.size(); i++)
+            {
+                for (; marker < chunk.groups.size() && chunk.groups[marker].corner == i; marker++)
+                {
+                    // 还没有面的分组只更新名字
+                    if (!groups.back().indices.empty())
+                    {
+                        groups.back().vertices.Release();
+                        groups.emplace_back();
+                    }
+                    groups.back().name = std::move(chunk.groups[marker].name);
+                }
+                if (i == chunk.corners.size())
+                {
+                    break;
+                }
+                const auto &corner = chunk.corners[i];
+                auto &group = groups.back();
+                VertexKey key{
+                    ToGlobal(corner.position, corner.relative, RelativePosition, positionBase, group.invalid),
+                    ToGlobal(corner.texCoord, corner.relative, RelativeTexCoord, texCoordBase, group.invalid),
+                    ToGlobal(corner.normal, corner.relative, RelativeNormal, normalBase, group.invalid)};
+                group.indices.push_back(group.vertices.Insert(key));
+            }
+            skippedLines += chunk.skippedLines;
+            triangles += chunk.corners.size() / 3;
+            chunk = Chunk{};
+        }
+    };
+    // 合并是串行的，放在单独线程上与下一个窗口的解析重叠
+    std::vector<Chunk> chunks[2];
+    std::jthread merger;
+    std::vector<const uint8_t *> boundaries;
+    const uint8_t *window = data;
+    for (size_t windowIndex = 0; window < fileEnd; windowIndex++)
+    {
+        auto windowEnd = NextLine(window + std::min<size_t>(windowSize, fileEnd - window) - 1, fileEnd);
+        boundaries.assign(1, window);
+        while (boundaries.back() < windowEnd)
+        {
+            auto next = boundaries.back() + std::min<size_t>(ChunkSize, windowEnd - boundaries.back());
+            boundaries.push_back(next < windowEnd ? NextLine(next - 1, windowEnd) : windowEnd);
+        }
+        auto &windowChunks = chunks[windowIndex % 2];
+        windowChunks.assign(boundaries.size() - 1, Chunk{});
+        threadPool.ParallelFor(windowChunks.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+            {
+                ParseChunk(reinterpret_cast<const char *>(boundaries[i]),
+                           reinterpret_cast<const char *>(boundaries[i + 1]), windowChunks[i]);
+            }
+        });
+        // 解析结果不再引用映射内存
+        file.Discard(window - data, windowEnd - window);
+        window = windowEnd;
+        if (merger.joinable())
+        {
+            merger.join();
+        }
+        merger = std::jthread([&merge, &windowChunks]() { merge(windowChunks); });
+    }
+    if (merger.joinable())
+    {
+        merger.join();
+    }
+    file.Close();
+    if (skippedLines > 0)
+    {
+        LogWarn("Skipped {} malformed lines in {}", skippedLines, assetPath.string());
+    }
+
+    std::vector<ExpandedMesh> expanded;
+    for (auto &group : groups)
+    {
+        if (group.indices.empty())
+        {
+            continue;
+        }
+        auto name = group.name;
+        auto result = ExpandVertices(group, positions, texCoords, normals, globalScale);
+        if (!result.mesh)
+        {
+            LogError("Group {} of {} references missing vertices", name, assetPath.string());
+            continue;
+        }
+        result.mesh->Name = std::move(name);
+        expanded.push_back(std::move(result));
+    }
+    groups = {};
+    auto parseTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LogDebug("Parse OBJ {}: {} positions, {} triangles, {} groups in {:.1f} ms", assetPath.string(), positions.size(),
+             triangles, expanded.size(), parseTime);
+    // 顶点已展开到网格中，计算法线和切线的临时数组分配前先释放原始数组
+    positions = {};
+    texCoords = {};
+    normals = {};
+
+    std::vector<std::shared_ptr<Core::Mesh>> meshes;
+    for (auto &[mesh, missingNormals, hasTexCoords] : expanded)
+    {
+        // 只要有顶点缺少法线就整体重新计算，避免同一网格混用两种法线
+        if (missingNormals)
+        {
+            Core::ComputeNormals(mesh->Vertices, mesh->Indices);
+        }
+        if (generateTangents && hasTexCoords)
+        {
+            Core::ComputeTangents(mesh->Vertices, mesh->Indices);
+        }
+        mesh->RecalculateBounds();
+        meshes.push_back(std::move(mesh));
+    }
+    return ProcessMeshes(std::move(meshes));
+}
+} // namespace Editor
+} // namespace MEngine
@@ -0,0 +1,258 @@
+#include "Shader/ShaderPreprocessor.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace MEngine
+{
+namespace Editor
+{
+namespace
+{
+std::string_view TrimLeft(std::string_view line)
+{
+    auto start = line.find_first_not_of(" \t");
+    return start == std::string_view::npos ? std::string_view() : line.substr(start);
+}
+/**
+ * @brief 解析预处理指令名，例如 "#  include" 返回 "include"，非指令返回空
+ */
+std::string_view GetDirective(std::string_view line, std::string_view &rest)
+{
+    line = TrimLeft(line);
+    if (line.empty() || line.front() != '#')
+    {
+        return {};
+    }
+    line = TrimLeft(line.substr(1));
+    auto end = line.find_first_of(" \t");
+    auto directive = line.substr(0, end);
+    rest = end == std::string_view::npos ? std::string_view() : TrimLeft(line.substr(end));
+    return directive;
+}
+std::string FormatDefine(const std::string &define)
+{
+    auto separator = define.find('=');
+    if (separator == std::string::npos)
+    {
+        return "#define " + define + "\n";
+    }
+    return "#define " + define.substr(0, separator) + " " + define.substr(separator + 1) + "\n";
+}
+} // namespace
+void ShaderPreprocessor::AddIncludeDirectory(const std::filesystem::path &directory)
+{
+    auto normalized = directory.lexically_normal();
+    if (std::find(mIncludeDirectories.begin(), mIncludeDirectories.end(), normalized) == mIncludeDirectories.end())
+    {
+        mIncludeDirectories.push_back(normalized);
+    }
+}
+PreprocessedShader ShaderPreprocessor::Process(const std::filesystem::path &path, const std::vector<std::string> &defines)
+{
+    PreprocessedShader result;
+    Context context;
+    context.defines = &defines;
+    auto root = path.lexically_normal();
+    result.success = Expand(root, result.source, context);
+    result.dependencies = std::move(context.dependencies);
+    if (result.success)
+    {
+        mDependencies[root] = result.dependencies;
+        // 已在监视的文件保留旧的时间，避免检查前被重新读取的修改漏报给其他依赖者
+        for (const auto &dependency : result.dependencies)
+        {
+            if (auto it = mFiles.find(dependency); it != mFiles.end())
+            {
+                mWatchedFiles.try_emplace(dependency, it->second.writeTime);
+            }
+        }
+    }
+    else
+    {
+        result.source.clear();
+    }
+    return result;
+}
+std::vector<std::filesystem::path> ShaderPreprocessor::GetDependents(const std::filesystem::path &path) const
+{
+    auto normalized = path.lexically_normal();
+    std::vector<std::filesystem::path> dependents;
+    for (const auto &[root, dependencies] : mDependencies)
+    {
+        if (std::find(dependencies.begin(), dependencies.end(), normalized) != dependencies.end())
+        {
+            dependents.push_back(root);
+        }
+    }
+    return dependents;
+}
+void ShaderPreprocessor::Invalidate(const std::filesystem::path &path)
+{
+    mFiles.erase(path.lexically_normal());
+}
+std::vector<std::filesystem::path> ShaderPreprocessor::PollModifiedFiles()
+{
+    std::vector<std::filesystem::path> modified;
+    for (auto &[path, writeTime] : mWatchedFiles)
+    {
+        std::error_code error;
+        auto current = std::filesystem::last_write_time(path, error);
+        // 编辑器保存时可能短暂删除文件，下次检查再处理
+        if (error || current == writeTime)
+        {
+            continue;
+        }
+        writeTime = current;
+        modified.push_back(path);
+    }
+    return modified;
+}
+const std::string *ShaderPreprocessor::ReadFile(const std::filesystem::path &path)
+{
+    std::error_code error;
+    auto writeTime = std::filesystem::last_write_time(path, error);
+    if (error)
+    {
+        return nullptr;
+    }
+    if (auto it = mFiles.find(path); it != mFiles.end() && it->second.writeTime == writeTime)
+    {
+        return &it->second.content;
+    }
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return nullptr;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    auto &cached = mFiles[path];
+    cached.content = buffer.str();
+    cached.writeTime = writeTime;
+    return &cached.content;
+}
+std::filesystem::path ShaderPreprocessor::ResolveInclude(const std::string &name,
+                                                         const std::filesystem::path &currentDirectory) const
+{
+    auto candidate = (currentDirectory / name).lexically_normal();
+    if (std::filesystem::exists(candidate))
+    {
+        return candidate;
+    }
+    for (const auto &directory : mIncludeDirectories)
+    {
+        candidate = (directory / name).lexically_normal();
+        if (std::filesystem::exists(candidate))
+        {
+            return candidate;
+        }
+    }
+    return {};
+}
+bool ShaderPreprocessor::Expand(const std::filesystem::path &path, std::string &output, Context &context)
+{
+    if (std::find(context.stack.begin(), context.stack.end(), path) != context.stack.end())
+    {
+        LogError("Circular shader include: {}", path.string());
+        return false;
+    }
+    if (context.onceFiles.contains(path))
+    {
+        return true;
+    }
+    const auto *content = ReadFile(path);
+    if (!content)
+    {
+        LogError("Failed to open shader file: {}", path.string());
+        return false;
+    }
+    if (std::find(context.dependencies.begin(), context.dependencies.end(), path) == context.dependencies.end())
+    {
+        context.dependencies.push_back(path);
+    }
+    // #line 的源字符串编号使用文件在依赖列表中的序号
+    auto fileIndex = std::find(context.dependencies.begin(), context.dependencies.end(), path) -
+                     context.dependencies.begin();
+    bool isRoot = context.stack.empty();
+    context.stack.push_back(path);
+    std::istringstream stream(*content);
+    std::string line;
+    size_t lineNumber = 0;
+    bool definesInserted = false;
+    bool success = true;
+    while (std::getline(stream, line))
+    {
+        lineNumber++;
+        std::string_view rest;
+        auto directive = GetDirective(line, rest);
+        if (directive == "version")
+        {
+            if (!isRoot)
+            {
+                // 被包含文件中的 #version 忽略，保留空行维持行号
+                output += "\n";
+                continue;
+            }
+            output += line + "\n";
+            for (const auto &define : *context.defines)
+            {
+                output += FormatDefine(define);
+            }
+            output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+            definesInserted = true;
+            continue;
+        }
+        if (directive == "pragma" && rest.starts_with("once"))
+        {
+            context.onceFiles.insert(path);
+            output += "\n";
+            continue;
+        }
+        if (directive == "include")
+        {
+            if (rest.size() < 2 || !((rest.front() == '"' && rest.find('"', 1) != std::string_view::npos) ||
+                                     (rest.front() == '<' && rest.find('>', 1) != std::string_view::npos)))
+            {
+                LogError("Invalid #include in {}:{}", path.string(), lineNumber);
+                success = false;
+                break;
+            }
+            auto close = rest.front() == '"' ? rest.find('"', 1) : rest.find('>', 1);
+            auto name = std::string(rest.substr(1, close - 1));
+            auto includePath = ResolveInclude(name, path.parent_path());
+            if (includePath.empty())
+            {
+                LogError("Shader include not found: {} ({}:{})", name, path.string(), lineNumber);
+                success = false;
+                break;
+            }
+            auto includeIndex = std::find(context.dependencies.begin(), context.dependencies.end(), includePath) -
+                                context.dependencies.begin();
+            output += "#line 1 " + std::to_string(includeIndex) + "\n";
+            if (!Expand(includePath, output, context))
+            {
+                success = false;
+                break;
+            }
+            output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+            continue;
+        }
+        output += line + "\n";
+    }
+    context.stack.pop_back();
+    if (success && isRoot && !definesInserted && !context.defines->empty())
+    {
+        // 没有 #version 时宏放在最前面
+        std::string defineBlock;
+        for (const auto &define : *context.defines)
+        {
+            defineBlock += FormatDefine(define);
+        }
+        output.insert(0, defineBlock + "#line 1 0\n");
+    }
+    return success;
+}
+} // namespace Editor
+} // namespace MEngine
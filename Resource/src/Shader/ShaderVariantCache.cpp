@@ -0,0 +1,108 @@
+#include "Shader/ShaderVariantCache.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+
+namespace MEngine
+{
+namespace Editor
+{
+ShaderVariantCache::ShaderVariantCache()
+{
+    Core::Pipeline::SetSourceLoader([this](const std::filesystem::path &path, const std::vector<std::string> &defines) {
+        return mPreprocessor.Process(path, defines).source;
+    });
+}
+ShaderVariantCache::~ShaderVariantCache()
+{
+    Core::Pipeline::SetSourceLoader(nullptr);
+}
+ShaderVariantCache &ShaderVariantCache::Get()
+{
+    static ShaderVariantCache cache;
+    return cache;
+}
+uint32_t ShaderVariantCache::GetKeywordMask(const Core::Pipeline &base, const std::vector<std::string> &keywords)
+{
+    uint32_t mask = 0;
+    for (const auto &keyword : keywords)
+    {
+        auto it = std::find(base.Keywords.begin(), base.Keywords.end(), keyword);
+        if (it != base.Keywords.end() && it - base.Keywords.begin() < 32)
+        {
+            mask |= 1u << (it - base.Keywords.begin());
+        }
+    }
+    return mask;
+}
+std::shared_ptr<Core::Pipeline> ShaderVariantCache::GetVariant(const std::shared_ptr<Core::Pipeline> &base,
+                                                               uint32_t keywordMask)
+{
+    auto &variants = mVariants[base.get()];
+    if (auto it = variants.find(keywordMask); it != variants.end())
+    {
+        return it->second;
+    }
+    auto variant = std::make_shared<Core::Pipeline>();
+    variant->Name = base->Name;
+    variant->VertexShaderPath = base->VertexShaderPath;
+    variant->FragmentShaderPath = base->FragmentShaderPath;
+    variant->GeometryShaderPath = base->GeometryShaderPath;
+    variant->blendingEnabled = base->blendingEnabled;
+    variant->blendSrc = base->blendSrc;
+    variant->blendDest = base->blendDest;
+    variant->Keywords = base->Keywords;
+    variant->Defines = base->Defines;
+    for (size_t i = 0; i < base->Keywords.size() && i < 32; i++)
+    {
+        if (keywordMask & (1u << i))
+        {
+            variant->Defines.push_back(base->Keywords[i]);
+            variant->Name += "_" + base->Keywords[i];
+        }
+    }
+    variants.emplace(keywordMask, variant);
+    return variant;
+}
+size_t ShaderVariantCache::OnSourceChanged(const std::filesystem::path &path)
+{
+    mPreprocessor.Invalidate(path);
+    auto dependents = mPreprocessor.GetDependents(path);
+    size_t count = 0;
+    for (auto &[base, variants] : mVariants)
+    {
+        for (auto &[mask, variant] : variants)
+        {
+            auto usesFile = [&](const std::filesystem::path &stagePath) {
+                return !stagePath.empty() && std::find(dependents.begin(), dependents.end(),
+                                                       stagePath.lexically_normal()) != dependents.end();
+            };
+            if (usesFile(variant->VertexShaderPath) || usesFile(variant->FragmentShaderPath) ||
+                usesFile(variant->GeometryShaderPath))
+            {
+                // 还没被使用过的变体等到首次使用时再编译；正在编译的变体在完成后重新提交
+                if (variant->GetCompileStatus() != Core::PipelineCompileStatus::NotCompiled)
+                {
+                    variant->Recompile();
+                }
+                count++;
+            }
+        }
+    }
+    LogInfo("Shader source changed: {}, recompile {} variants", path.string(), count);
+    return count;
+}
+void ShaderVariantCache::Remove(const Core::Pipeline *base)
+{
+    mVariants.erase(base);
+}
+size_t ShaderVariantCache::GetVariantCount() const
+{
+    size_t count = 0;
+    for (const auto &[base, variants] : mVariants)
+    {
+        count += variants.size();
+    }
+    return count;
+}
+} // namespace Editor
+} // namespace MEngine
@@ -0,0 +1,78 @@
+#include "Asset/Mesh.hpp"
+#include "Bounds.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+using namespace MEngine::Core;
+
+namespace
+{
+Mesh CreateBox(const glm::vec3 &extents)
+{
+    Mesh mesh;
+    for (int i = 0; i < 8; i++)
+    {
+        Vertex vertex{};
+        vertex.position = glm::vec3(i & 1 ? extents.x : -extents.x, i & 2 ? extents.y : -extents.y,
+                                    i & 4 ? extents.z : -extents.z);
+        mesh.Vertices.push_back(vertex);
+    }
+    mesh.RecalculateBounds();
+    return mesh;
+}
+} // namespace
+
+TEST(BoundsTest, EmptyAABBIsInvalid)
+{
+    AABB aabb;
+    EXPECT_FALSE(aabb.IsValid());
+    aabb.Expand(glm::vec3(1.0f));
+    EXPECT_TRUE(aabb.IsValid());
+}
+
+TEST(BoundsTest, MeshBoundsEncloseVertices)
+{
+    auto mesh = CreateBox(glm::vec3(1.0f, 2.0f, 3.0f));
+    EXPECT_EQ(mesh.Bounds.min, glm::vec3(-1.0f, -2.0f, -3.0f));
+    EXPECT_EQ(mesh.Bounds.max, glm::vec3(1.0f, 2.0f, 3.0f));
+    for (const auto &vertex : mesh.Vertices)
+    {
+        EXPECT_LE(glm::length(vertex.position - mesh.Sphere.center), mesh.Sphere.radius + 1e-4f);
+    }
+}
+
+TEST(BoundsTest, TransformAABBTranslateAndRotate)
+{
+    AABB aabb{glm::vec3(-1.0f, -2.0f, -3.0f), glm::vec3(1.0f, 2.0f, 3.0f)};
+    auto translated = TransformAABB(aabb, glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f)));
+    EXPECT_FLOAT_EQ(translated.min.x, 9.0f);
+    EXPECT_FLOAT_EQ(translated.max.x, 11.0f);
+
+    auto rotated = TransformAABB(aabb, glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0, 0, 1)));
+    EXPECT_NEAR(rotated.max.x, 2.0f, 1e-5f);
+    EXPECT_NEAR(rotated.max.y, 1.0f, 1e-5f);
+    EXPECT_NEAR(rotated.max.z, 3.0f, 1e-5f);
+}
+
+TEST(BoundsTest, TransformSphereUsesMaxScale)
+{
+    BoundingSphere sphere{glm::vec3(0.0f), 1.0f};
+    auto scaled = TransformBoundingSphere(sphere, glm::scale(glm::mat4(1.0f), glm::vec3(1.0f, 4.0f, 2.0f)));
+    EXPECT_FLOAT_EQ(scaled.radius, 4.0f);
+}
+
+TEST(BoundsTest, MeshSerializeKeepsBounds)
+{
+    auto mesh = CreateBox(glm::vec3(1.0f));
+    json j = mesh;
+    ASSERT_TRUE(j.contains("Bounds"));
+    Mesh loaded = j.get<Mesh>();
+    EXPECT_EQ(loaded.Bounds.min, mesh.Bounds.min);
+    EXPECT_EQ(loaded.Bounds.max, mesh.Bounds.max);
+    EXPECT_FLOAT_EQ(loaded.Sphere.radius, mesh.Sphere.radius);
+
+    // 旧资源没有包围体字段时重新计算
+    j.erase("Bounds");
+    loaded = j.get<Mesh>();
+    EXPECT_EQ(loaded.Bounds.max, mesh.Bounds.max);
+}
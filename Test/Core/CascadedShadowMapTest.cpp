@@ -0,0 +1,143 @@
+#include "Shadow/CascadedShadowMap.hpp"
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+using namespace MEngine::Core;
+
+class CascadedShadowMapTest : public ::testing::Test
+{
+  protected:
+    CascadedShadowMap mShadows;
+    glm::mat4 mProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+    glm::vec3 mLightDirection = glm::normalize(glm::vec3(-0.3f, -1.0f, -0.5f));
+
+    glm::mat4 View(const glm::vec3 &position, float yaw) const
+    {
+        auto forward = glm::vec3(std::sin(yaw), 0.0f, -std::cos(yaw));
+        return glm::lookAt(position, position + forward, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+    /**
+     * @brief 世界原点在级联中的texel坐标
+     */
+    glm::vec2 OriginTexel(uint32_t cascade) const
+    {
+        auto clip = mShadows.GetCascade(cascade).viewProjection * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        float resolution = static_cast<float>(mShadows.GetConfig().resolution);
+        return glm::vec2((clip.x * 0.5f + 0.5f) * resolution, (clip.y * 0.5f + 0.5f) * resolution);
+    }
+};
+
+TEST_F(CascadedShadowMapTest, SplitsAreIncreasingAndClampedToShadowDistance)
+{
+    mShadows.Update(View(glm::vec3(0.0f), 0.0f), mProjection, 0.1f, 1000.0f, mLightDirection);
+    ASSERT_EQ(mShadows.GetCascadeCount(), 4u);
+    float previous = 0.1f;
+    for (uint32_t i = 0; i < mShadows.GetCascadeCount(); i++)
+    {
+        EXPECT_GT(mShadows.GetCascade(i).splitDistance, previous);
+        previous = mShadows.GetCascade(i).splitDistance;
+    }
+    EXPECT_FLOAT_EQ(previous, mShadows.GetConfig().shadowDistance);
+    // 越远的级联覆盖越大，texel越粗
+    EXPECT_LT(mShadows.GetCascade(0).texelSize, mShadows.GetCascade(3).texelSize);
+}
+
+TEST_F(CascadedShadowMapTest, CascadeContainsFrustumSlice)
+{
+    glm::vec3 position(12.3f, 4.5f, -7.8f);
+    float yaw = 0.7f;
+    auto view = View(position, yaw);
+    mShadows.Update(view, mProjection, 0.1f, 1000.0f, mLightDirection);
+    auto inverseViewProjection = glm::inverse(mProjection * view);
+    float sliceNear = 0.1f;
+    for (uint32_t cascade = 0; cascade < mShadows.GetCascadeCount(); cascade++)
+    {
+        float sliceFar = mShadows.GetCascade(cascade).splitDistance;
+        for (float x : {-1.0f, 1.0f})
+        {
+            for (float y : {-1.0f, 1.0f})
+            {
+                // 近平面角点沿相机射线推到切片两端
+                auto corner = inverseViewProjection * glm::vec4(x, y, -1.0f, 1.0f);
+                auto nearCorner = glm::vec3(corner) / corner.w;
+                auto ray = nearCorner - position;
+                float scale = 1.0f / glm::dot(ray, glm::normalize(glm::vec3(std::sin(yaw), 0.0f, -std::cos(yaw))));
+                for (float distance : {sliceNear, sliceFar})
+                {
+                    auto point = position + ray * scale * distance;
+                    auto clip = mShadows.GetCascade(cascade).viewProjection * glm::vec4(point, 1.0f);
+                    EXPECT_LE(std::abs(clip.x), 1.0f + 1e-4f);
+                    EXPECT_LE(std::abs(clip.y), 1.0f + 1e-4f);
+                    EXPECT_LE(std::abs(clip.z), 1.0f + 1e-4f);
+                }
+            }
+        }
+        sliceNear = sliceFar;
+    }
+}
+
+TEST_F(CascadedShadowMapTest, RotationKeepsCascadeSize)
+{
+    mShadows.Update(View(glm::vec3(0.0f), 0.0f), mProjection, 0.1f, 1000.0f, mLightDirection);
+    std::array<float, CascadedShadowMap::MaxCascades> texelSizes;
+    for (uint32_t i = 0; i < mShadows.GetCascadeCount(); i++)
+    {
+        texelSizes[i] = mShadows.GetCascade(i).texelSize;
+    }
+    for (float yaw : {0.3f, 1.2f, 2.5f, 4.0f})
+    {
+        mShadows.Update(View(glm::vec3(5.0f, 1.0f, 3.0f), yaw), mProjection, 0.1f, 1000.0f, mLightDirection);
+        for (uint32_t i = 0; i < mShadows.GetCascadeCount(); i++)
+        {
+            EXPECT_FLOAT_EQ(mShadows.GetCascade(i).texelSize, texelSizes[i]);
+        }
+    }
+}
+
+TEST_F(CascadedShadowMapTest, TranslationSnapsToWholeTexels)
+{
+    mShadows.Update(View(glm::vec3(0.0f), 0.0f), mProjection, 0.1f, 1000.0f, mLightDirection);
+    auto first = OriginTexel(0);
+    for (int frame = 1; frame < 50; frame++)
+    {
+        mShadows.Update(View(glm::vec3(0.137f * frame, 0.0f, -0.071f * frame), 0.0f), mProjection, 0.1f, 1000.0f,
+                        mLightDirection);
+        auto offset = OriginTexel(0) - first;
+        // 投影只以整数个取整步长平移，世界中固定点的texel坐标不会出现小数变化
+        float snap = static_cast<float>(mShadows.GetConfig().snapTexels);
+        EXPECT_NEAR(offset.x / snap, std::round(offset.x / snap), 1e-2f);
+        EXPECT_NEAR(offset.y / snap, std::round(offset.y / snap), 1e-2f);
+    }
+}
+
+TEST_F(CascadedShadowMapTest, StaticCacheSurvivesSmallMovement)
+{
+    mShadows.Update(View(glm::vec3(0.0f), 0.0f), mProjection, 0.1f, 1000.0f, mLightDirection);
+    for (uint32_t i = 0; i < mShadows.GetCascadeCount(); i++)
+    {
+        EXPECT_TRUE(mShadows.NeedsStaticUpdate(i));
+        mShadows.MarkStaticUpdated(i);
+    }
+    // 远级联的取整步长有数米，小幅移动只在跨过取整网格时失效，每个轴最多一次
+    uint32_t last = mShadows.GetCascadeCount() - 1;
+    int invalidations = 0;
+    for (int frame = 1; frame <= 100; frame++)
+    {
+        mShadows.Update(View(glm::vec3(0.01f * frame, 0.0f, 0.0f), 0.0f), mProjection, 0.1f, 1000.0f,
+                        mLightDirection);
+        if (mShadows.NeedsStaticUpdate(last))
+        {
+            invalidations++;
+            mShadows.MarkStaticUpdated(last);
+        }
+    }
+    EXPECT_LE(invalidations, 3);
+
+    mShadows.Update(View(glm::vec3(1.0f, 0.0f, 0.0f), 1.0f), mProjection, 0.1f, 1000.0f,
+                    glm::normalize(glm::vec3(0.3f, -1.0f, -0.5f)));
+    EXPECT_TRUE(mShadows.NeedsStaticUpdate(last));
+    mShadows.MarkStaticUpdated(last);
+    mShadows.InvalidateStatic();
+    EXPECT_TRUE(mShadows.NeedsStaticUpdate(last));
+}
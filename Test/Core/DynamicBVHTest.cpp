@@ -0,0 +1,246 @@
+#include "Spatial/DynamicBVH.hpp"
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace MEngine::Core;
+
+namespace
+{
+std::vector<AABB> CreateRandomBoxes(size_t count, float worldSize, uint32_t seed = 7)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-worldSize, worldSize);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+    std::vector<AABB> boxes(count);
+    for (auto &box : boxes)
+    {
+        glm::vec3 center(position(rng), position(rng), position(rng));
+        glm::vec3 extents(size(rng), size(rng), size(rng));
+        box = AABB{center - extents, center + extents};
+    }
+    return boxes;
+}
+Frustum CreateFrustum()
+{
+    auto projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 200.0f);
+    auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.2f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum::FromMatrix(projection * view);
+}
+std::vector<uint32_t> Sorted(std::vector<uint32_t> values)
+{
+    std::sort(values.begin(), values.end());
+    return values;
+}
+} // namespace
+
+TEST(DynamicBVHTest, CreateDestroyKeepsTreeValid)
+{
+    DynamicBVH tree;
+    auto boxes = CreateRandomBoxes(2000, 100.0f);
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < boxes.size(); i++)
+    {
+        proxies.push_back(tree.CreateProxy(boxes[i], i));
+    }
+    EXPECT_TRUE(tree.Validate());
+    EXPECT_EQ(tree.GetProxyCount(), boxes.size());
+    for (size_t i = 0; i < proxies.size(); i += 2)
+    {
+        tree.DestroyProxy(proxies[i]);
+    }
+    EXPECT_TRUE(tree.Validate());
+    EXPECT_EQ(tree.GetProxyCount(), boxes.size() / 2);
+    // 高度应远小于线性链
+    EXPECT_LT(tree.GetHeight(), 40);
+}
+
+TEST(DynamicBVHTest, MoveProxyUsesFatBounds)
+{
+    DynamicBVH tree(0.5f);
+    auto proxy = tree.CreateProxy(AABB{glm::vec3(0.0f), glm::vec3(1.0f)}, 0);
+    tree.CreateProxy(AABB{glm::vec3(5.0f), glm::vec3(6.0f)}, 1);
+    EXPECT_FALSE(tree.MoveProxy(proxy, AABB{glm::vec3(0.2f), glm::vec3(1.2f)}));
+    EXPECT_TRUE(tree.MoveProxy(proxy, AABB{glm::vec3(10.0f), glm::vec3(11.0f)}));
+    EXPECT_TRUE(tree.Validate());
+    EXPECT_EQ(tree.GetAABB(proxy).min, glm::vec3(10.0f));
+}
+
+TEST(DynamicBVHTest, QueriesMatchBruteForce)
+{
+    DynamicBVH tree;
+    auto boxes = CreateRandomBoxes(5000, 100.0f);
+    std::vector<int32_t> proxies;
+    for (uint32_t i = 0; i < boxes.size(); i++)
+    {
+        proxies.push_back(tree.CreateProxy(boxes[i], i));
+    }
+    // 移动一部分物体
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+    for (size_t i = 0; i < boxes.size(); i += 3)
+    {
+        glm::vec3 delta(offset(rng), offset(rng), offset(rng));
+        boxes[i] = AABB{boxes[i].min + delta, boxes[i].max + delta};
+        tree.MoveProxy(proxies[i], boxes[i]);
+    }
+    ASSERT_TRUE(tree.Validate());
+
+    AABB queryBox{glm::vec3(-20.0f), glm::vec3(30.0f)};
+    std::vector<uint32_t> expected, actual;
+    for (uint32_t i = 0; i < boxes.size(); i++)
+    {
+        if (boxes[i].Overlaps(queryBox))
+        {
+            expected.push_back(i);
+        }
+    }
+    tree.QueryAABB(queryBox, [&](uint32_t id) {
+        actual.push_back(id);
+        return true;
+    });
+    EXPECT_EQ(Sorted(actual), expected);
+
+    auto frustum = CreateFrustum();
+    expected.clear();
+    actual.clear();
+    for (uint32_t i = 0; i < boxes.size(); i++)
+    {
+        if (frustum.Intersects(boxes[i]))
+        {
+            expected.push_back(i);
+        }
+    }
+    tree.QueryFrustum(frustum, [&](uint32_t id) {
+        actual.push_back(id);
+        return true;
+    });
+    EXPECT_EQ(Sorted(actual), expected);
+
+    glm::vec3 point(10.0f, -5.0f, 20.0f);
+    auto distance = [&](const AABB &aabb) {
+        auto d = glm::max(glm::max(aabb.min - point, point - aabb.max), glm::vec3(0.0f));
+        return glm::dot(d, d);
+    };
+    std::vector<uint32_t> order(boxes.size());
+    for (uint32_t i = 0; i < order.size(); i++)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return distance(boxes[a]) < distance(boxes[b]); });
+    tree.QueryKNearest(point, 8, actual);
+    ASSERT_EQ(actual.size(), 8u);
+    for (size_t i = 0; i < actual.size(); i++)
+    {
+        EXPECT_FLOAT_EQ(distance(boxes[actual[i]]), distance(boxes[order[i]]));
+    }
+}
+
+TEST(DynamicBVHTest, RayCastFindsClosest)
+{
+    DynamicBVH tree;
+    tree.CreateProxy(AABB{glm::vec3(-1.0f, -1.0f, 9.0f), glm::vec3(1.0f, 1.0f, 11.0f)}, 0);
+    tree.CreateProxy(AABB{glm::vec3(-1.0f, -1.0f, 4.0f), glm::vec3(1.0f, 1.0f, 6.0f)}, 1);
+    tree.CreateProxy(AABB{glm::vec3(5.0f, -1.0f, 4.0f), glm::vec3(7.0f, 1.0f, 6.0f)}, 2);
+    uint32_t closest = UINT32_MAX;
+    float closestDistance = 100.0f;
+    tree.RayCast(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), closestDistance, [&](uint32_t id, float distance) {
+        if (distance < closestDistance)
+        {
+            closestDistance = distance;
+            closest = id;
+        }
+        return closestDistance;
+    });
+    EXPECT_EQ(closest, 1u);
+    EXPECT_FLOAT_EQ(closestDistance, 4.0f);
+}
+
+TEST(DynamicBVHTest, RayCastAlongBoxFace)
+{
+    DynamicBVH tree;
+    tree.CreateProxy(AABB{glm::vec3(0.0f, 0.0f, 4.0f), glm::vec3(2.0f, 2.0f, 6.0f)}, 0);
+    tree.CreateProxy(AABB{glm::vec3(0.5f, 0.0f, 8.0f), glm::vec3(2.0f, 2.0f, 9.0f)}, 1);
+    // 射线平行于x、y轴，起点正好落在盒子0的x=min和y=max平面上
+    std::vector<std::pair<uint32_t, float>> hits;
+    tree.RayCast(glm::vec3(0.0f, 2.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), 100.0f, [&](uint32_t id, float distance) {
+        hits.emplace_back(id, distance);
+        return 100.0f;
+    });
+    ASSERT_EQ(hits.size(), 1u);
+    EXPECT_EQ(hits[0].first, 0u);
+    EXPECT_FLOAT_EQ(hits[0].second, 4.0f);
+}
+
+// 性能对比，默认不运行：--gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+class DynamicBVHBenchmark : public testing::TestWithParam<size_t>
+{
+};
+TEST_P(DynamicBVHBenchmark, DISABLED_QueryVersusBruteForce)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto count = GetParam();
+    // 保持物体密度不变
+    float worldSize = 50.0f * std::cbrt(static_cast<float>(count) / 10000.0f);
+    auto boxes = CreateRandomBoxes(count, worldSize);
+
+    auto start = Clock::now();
+    DynamicBVH tree;
+    std::vector<int32_t> proxies(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        proxies[i] = tree.CreateProxy(boxes[i], i);
+    }
+    auto buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    auto frustum = CreateFrustum();
+    AABB queryBox{glm::vec3(-10.0f), glm::vec3(10.0f)};
+    size_t bruteFrustum = 0, bruteBox = 0, treeFrustum = 0, treeBox = 0;
+    start = Clock::now();
+    for (const auto &box : boxes)
+    {
+        bruteFrustum += frustum.Intersects(box);
+    }
+    auto bruteFrustumMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    start = Clock::now();
+    for (const auto &box : boxes)
+    {
+        bruteBox += box.Overlaps(queryBox);
+    }
+    auto bruteBoxMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    start = Clock::now();
+    tree.QueryFrustum(frustum, [&](uint32_t) { return ++treeFrustum, true; });
+    auto treeFrustumMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    start = Clock::now();
+    tree.QueryAABB(queryBox, [&](uint32_t) { return ++treeBox, true; });
+    auto treeBoxMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    start = Clock::now();
+    std::vector<uint32_t> nearest;
+    tree.QueryKNearest(glm::vec3(0.0f), 16, nearest);
+    auto knnMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // 10%物体每帧移动
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> offset(-0.5f, 0.5f);
+    start = Clock::now();
+    for (size_t i = 0; i < count; i += 10)
+    {
+        glm::vec3 delta(offset(rng), offset(rng), offset(rng));
+        boxes[i] = AABB{boxes[i].min + delta, boxes[i].max + delta};
+        tree.MoveProxy(proxies[i], boxes[i]);
+    }
+    auto updateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    EXPECT_EQ(bruteFrustum, treeFrustum);
+    EXPECT_EQ(bruteBox, treeBox);
+    GTEST_LOG_(INFO) << count << " objects: build " << buildMs << " ms, height " << tree.GetHeight()
+                     << ", SAH ratio " << tree.GetAreaRatio();
+    GTEST_LOG_(INFO) << "frustum brute " << bruteFrustumMs << " ms / bvh " << treeFrustumMs << " ms (" << treeFrustum
+                     << " hits)";
+    GTEST_LOG_(INFO) << "aabb brute " << bruteBoxMs << " ms / bvh " << treeBoxMs << " ms (" << treeBox << " hits)";
+    GTEST_LOG_(INFO) << "knn(16) " << knnMs << " ms, update 10% " << updateMs << " ms";
+}
+INSTANTIATE_TEST_SUITE_P(ObjectCount, DynamicBVHBenchmark, testing::Values(10000, 100000, 1000000));
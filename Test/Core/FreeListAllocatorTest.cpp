@@ -0,0 +1,56 @@
+#include "FreeListAllocator.hpp"
+#include <gtest/gtest.h>
+
+using namespace MEngine::Core;
+
+TEST(FreeListAllocatorTest, AllocateSequential)
+{
+    FreeListAllocator allocator(100);
+    auto a = allocator.Allocate(10);
+    auto b = allocator.Allocate(20);
+    ASSERT_TRUE(a.has_value());
+    ASSERT_TRUE(b.has_value());
+    EXPECT_EQ(a.value(), 0);
+    EXPECT_EQ(b.value(), 10);
+    EXPECT_EQ(allocator.GetUsed(), 30);
+}
+TEST(FreeListAllocatorTest, AllocateOutOfSpace)
+{
+    FreeListAllocator allocator(16);
+    EXPECT_TRUE(allocator.Allocate(16).has_value());
+    EXPECT_FALSE(allocator.Allocate(1).has_value());
+}
+TEST(FreeListAllocatorTest, FreeCoalesce)
+{
+    FreeListAllocator allocator(30);
+    auto a = allocator.Allocate(10).value();
+    auto b = allocator.Allocate(10).value();
+    auto c = allocator.Allocate(10).value();
+    allocator.Free(a, 10);
+    allocator.Free(c, 10);
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 2);
+    allocator.Free(b, 10);
+    EXPECT_EQ(allocator.GetFreeBlockCount(), 1);
+    EXPECT_EQ(allocator.GetUsed(), 0);
+    EXPECT_EQ(allocator.Allocate(30).value(), 0);
+}
+TEST(FreeListAllocatorTest, BestFitReuse)
+{
+    FreeListAllocator allocator(100);
+    auto a = allocator.Allocate(40).value();
+    allocator.Allocate(10);
+    auto c = allocator.Allocate(8).value();
+    allocator.Allocate(10);
+    allocator.Free(a, 40);
+    allocator.Free(c, 8);
+    EXPECT_EQ(allocator.Allocate(8).value(), c);
+}
+TEST(FreeListAllocatorTest, Grow)
+{
+    FreeListAllocator allocator(10);
+    allocator.Allocate(10);
+    EXPECT_FALSE(allocator.Allocate(5).has_value());
+    allocator.Grow(20);
+    EXPECT_EQ(allocator.GetCapacity(), 20);
+    EXPECT_EQ(allocator.Allocate(10).value(), 10);
+}
@@ -0,0 +1,80 @@
+#include "Culling/FrustumCuller.hpp"
+#include "Frustum.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace MEngine::Core;
+
+namespace
+{
+Frustum CreateFrustum()
+{
+    auto projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum::FromMatrix(projection * view);
+}
+AABB CreateBox(const glm::vec3 &center, float halfSize)
+{
+    return AABB{center - glm::vec3(halfSize), center + glm::vec3(halfSize)};
+}
+} // namespace
+
+TEST(FrustumCullerTest, FrustumIntersects)
+{
+    auto frustum = CreateFrustum();
+    EXPECT_TRUE(frustum.Intersects(CreateBox(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f)));
+    EXPECT_FALSE(frustum.Intersects(CreateBox(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f)));
+    EXPECT_FALSE(frustum.Intersects(CreateBox(glm::vec3(0.0f, 0.0f, -200.0f), 1.0f)));
+    EXPECT_FALSE(frustum.Intersects(CreateBox(glm::vec3(100.0f, 0.0f, -10.0f), 1.0f)));
+    // 跨越侧平面的包围盒保留
+    EXPECT_TRUE(frustum.Intersects(CreateBox(glm::vec3(0.0f, 6.0f, -10.0f), 1.0f)));
+    EXPECT_TRUE(frustum.Intersects(BoundingSphere{glm::vec3(0.0f, 0.0f, -10.0f), 1.0f}));
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere{glm::vec3(0.0f, 0.0f, 10.0f), 1.0f}));
+    // 无效包围盒与FrustumCuller一样视为可见
+    EXPECT_TRUE(frustum.Intersects(AABB{}));
+}
+
+TEST(FrustumCullerTest, CullCountsVisible)
+{
+    FrustumCuller culler;
+    culler.Add(CreateBox(glm::vec3(0.0f, 0.0f, -10.0f), 1.0f));
+    culler.Add(CreateBox(glm::vec3(0.0f, 0.0f, 10.0f), 1.0f));
+    culler.Add(AABB{});
+    EXPECT_EQ(culler.Cull(CreateFrustum()), 2u);
+    EXPECT_TRUE(culler.IsVisible(0));
+    EXPECT_FALSE(culler.IsVisible(1));
+    // 无效包围盒始终可见
+    EXPECT_TRUE(culler.IsVisible(2));
+    EXPECT_EQ(culler.GetCulledCount(), 1u);
+}
+
+TEST(FrustumCullerTest, SimdMatchesScalar)
+{
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-120.0f, 120.0f);
+    std::uniform_real_distribution<float> size(0.1f, 5.0f);
+    FrustumCuller culler;
+    // 非8的倍数，覆盖尾部标量路径
+    const size_t count = 20003;
+    culler.Reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        culler.Add(CreateBox(glm::vec3(position(rng), position(rng), position(rng)), size(rng)));
+    }
+    auto frustum = CreateFrustum();
+    culler.Cull(frustum, FrustumCuller::SimdLevel::Scalar, false);
+    auto expected = culler.GetVisibility();
+    auto expectedCount = culler.GetVisibleCount();
+    EXPECT_GT(expectedCount, 0u);
+    EXPECT_LT(expectedCount, count);
+
+    for (auto level : {FrustumCuller::SimdLevel::SSE, FrustumCuller::SimdLevel::AVX2})
+    {
+        for (bool parallel : {false, true})
+        {
+            EXPECT_EQ(culler.Cull(frustum, level, parallel), expectedCount);
+            EXPECT_EQ(culler.GetVisibility(), expected);
+        }
+    }
+}
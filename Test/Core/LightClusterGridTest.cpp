@@ -0,0 +1,183 @@
+#include "Culling/LightClusterGrid.hpp"
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace MEngine::Core;
+
+namespace
+{
+constexpr float Near = 0.1f;
+constexpr float Far = 200.0f;
+glm::mat4 CreateProjection()
+{
+    return glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, Near, Far);
+}
+glm::mat4 CreateView()
+{
+    return glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+}
+PackedLight CreatePointLight(const glm::vec3 &position, float range)
+{
+    PackedLight light;
+    light.positionRange = glm::vec4(position, range);
+    light.directionType.w = static_cast<float>(PackedLightType::Point);
+    return light;
+}
+std::vector<PackedLight> CreateRandomLights(size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> xy(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> z(-150.0f, 5.0f);
+    std::uniform_real_distribution<float> range(0.5f, 6.0f);
+    std::vector<PackedLight> lights;
+    lights.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        lights.push_back(CreatePointLight(glm::vec3(xy(rng), xy(rng) * 0.5f, z(rng)), range(rng)));
+    }
+    return lights;
+}
+// 视图空间点所在的簇，与着色器中的计算方式一致
+uint32_t FindCluster(const LightClusterGrid &grid, const glm::mat4 &projection, const glm::vec3 &viewPosition)
+{
+    auto clip = projection * glm::vec4(viewPosition, 1.0f);
+    auto ndc = glm::vec2(clip.x, clip.y) / clip.w;
+    const auto &config = grid.GetConfig();
+    auto x = std::min(static_cast<uint32_t>((ndc.x * 0.5f + 0.5f) * config.tilesX), config.tilesX - 1);
+    auto y = std::min(static_cast<uint32_t>((ndc.y * 0.5f + 0.5f) * config.tilesY), config.tilesY - 1);
+    return grid.GetClusterIndex(x, y, grid.GetSlice(-viewPosition.z));
+}
+bool ClusterContains(const LightClusterGrid &grid, uint32_t clusterIndex, uint32_t lightIndex)
+{
+    const auto &cluster = grid.GetClusters()[clusterIndex];
+    const auto &indices = grid.GetLightIndices();
+    return std::find(indices.begin() + cluster.offset, indices.begin() + cluster.offset + cluster.count,
+                     lightIndex) != indices.begin() + cluster.offset + cluster.count;
+}
+} // namespace
+
+TEST(LightClusterGridTest, DirectionalLightsGoFirst)
+{
+    LightClusterGrid grid;
+    PackedLight sun;
+    sun.directionType = glm::vec4(0.0f, -1.0f, 0.0f, static_cast<float>(PackedLightType::Directional));
+    std::vector<PackedLight> lights{CreatePointLight(glm::vec3(0.0f, 0.0f, -10.0f), 2.0f), sun};
+    grid.Build(lights, CreateView(), CreateProjection(), Near, Far);
+    ASSERT_EQ(grid.GetLights().size(), 2u);
+    EXPECT_EQ(grid.GetDirectionalCount(), 1u);
+    EXPECT_EQ(static_cast<PackedLightType>(grid.GetLights()[0].directionType.w), PackedLightType::Directional);
+    // 方向光不进入任何簇
+    for (auto index : grid.GetLightIndices())
+    {
+        EXPECT_EQ(index, 1u);
+    }
+}
+
+TEST(LightClusterGridTest, LightBehindCameraIsDropped)
+{
+    LightClusterGrid grid;
+    std::vector<PackedLight> lights{CreatePointLight(glm::vec3(0.0f, 0.0f, 20.0f), 2.0f)};
+    grid.Build(lights, CreateView(), CreateProjection(), Near, Far);
+    EXPECT_TRUE(grid.GetLights().empty());
+    EXPECT_TRUE(grid.GetLightIndices().empty());
+    EXPECT_EQ(grid.GetMaxLightsPerCluster(), 0u);
+}
+
+TEST(LightClusterGridTest, SliceMatchesClusterBounds)
+{
+    LightClusterGrid grid;
+    grid.Build({}, CreateView(), CreateProjection(), Near, Far);
+    const auto &config = grid.GetConfig();
+    EXPECT_EQ(grid.GetSlice(Near * 0.5f), 0u);
+    EXPECT_EQ(grid.GetSlice(Far * 2.0f), config.slices - 1);
+    for (uint32_t slice = 0; slice < config.slices; slice++)
+    {
+        const auto &bounds = grid.GetClusterBounds(grid.GetClusterIndex(config.tilesX / 2, config.tilesY / 2, slice));
+        float depth = -(bounds.min.z + bounds.max.z) * 0.5f;
+        EXPECT_EQ(grid.GetSlice(depth), slice);
+    }
+}
+
+TEST(LightClusterGridTest, MatchesBruteForce)
+{
+    auto view = CreateView();
+    auto projection = CreateProjection();
+    auto lights = CreateRandomLights(2000, 7);
+
+    LightClusterGrid grid;
+    grid.Build(lights, view, projection, Near, Far, true);
+    LightClusterGrid serialGrid;
+    serialGrid.Build(lights, view, projection, Near, Far, false);
+    EXPECT_EQ(grid.GetLightIndices(), serialGrid.GetLightIndices());
+
+    const auto &packed = grid.GetLights();
+    // 簇中每个光源都必须与簇包围盒相交
+    for (uint32_t clusterIndex = 0; clusterIndex < grid.GetClusterCount(); clusterIndex++)
+    {
+        const auto &cluster = grid.GetClusters()[clusterIndex];
+        const auto &bounds = grid.GetClusterBounds(clusterIndex);
+        for (uint32_t i = 0; i < cluster.count; i++)
+        {
+            const auto &light = packed[grid.GetLightIndices()[cluster.offset + i]];
+            auto center = glm::vec3(view * glm::vec4(glm::vec3(light.positionRange), 1.0f));
+            auto d = glm::clamp(center, bounds.min, bounds.max) - center;
+            EXPECT_LE(glm::dot(d, d), light.positionRange.w * light.positionRange.w + 1e-3f);
+        }
+    }
+    // 光源范围内的可见点所在的簇必须包含该光源
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    size_t checked = 0;
+    for (uint32_t lightIndex = 0; lightIndex < packed.size(); lightIndex++)
+    {
+        auto center = glm::vec3(view * glm::vec4(glm::vec3(packed[lightIndex].positionRange), 1.0f));
+        float radius = packed[lightIndex].positionRange.w;
+        for (int sample = 0; sample < 16; sample++)
+        {
+            glm::vec3 offset(unit(rng), unit(rng), unit(rng));
+            if (glm::dot(offset, offset) > 1.0f)
+            {
+                continue;
+            }
+            auto point = center + offset * radius;
+            auto clip = projection * glm::vec4(point, 1.0f);
+            if (clip.w <= 0.0f || -point.z < Near || -point.z > Far || std::abs(clip.x) > clip.w ||
+                std::abs(clip.y) > clip.w)
+            {
+                continue;
+            }
+            EXPECT_TRUE(ClusterContains(grid, FindCluster(grid, projection, point), lightIndex));
+            checked++;
+        }
+    }
+    EXPECT_GT(checked, 1000u);
+}
+
+TEST(LightClusterGridTest, DISABLED_Benchmark)
+{
+    auto view = CreateView();
+    auto projection = CreateProjection();
+    for (size_t count : {256, 1024, 4096, 16384})
+    {
+        auto lights = CreateRandomLights(count, 3);
+        LightClusterGrid grid;
+        grid.Build(lights, view, projection, Near, Far);
+        for (bool parallel : {false, true})
+        {
+            constexpr int iterations = 20;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < iterations; i++)
+            {
+                grid.Build(lights, view, projection, Near, Far, parallel);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+            GTEST_LOG_(INFO) << count << " lights (" << (parallel ? "parallel" : "serial") << "): " << ms
+                             << " ms, indices " << grid.GetLightIndices().size() << ", max per cluster "
+                             << grid.GetMaxLightsPerCluster();
+        }
+    }
+}
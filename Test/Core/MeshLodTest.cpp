@@ -0,0 +1,62 @@
+#include "Geometry/MeshLod.hpp"
+#include <array>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+using namespace MEngine::Core;
+
+class MeshLodTest : public ::testing::Test
+{
+  protected:
+    // 相对误差，第0级为原网格
+    std::array<float, 4> mErrors{0.0f, 0.01f, 0.04f, 0.16f};
+    MeshLodSettings mSettings;
+};
+
+TEST_F(MeshLodTest, ProjectedSizeShrinksWithDistance)
+{
+    auto projection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 1000.0f);
+    // fov 90度时，距离d处半径r的球投影半径约为 r / d 个半屏
+    float size = ProjectSphereSize(glm::vec3(0.0f, 0.0f, -100.0f), 1.0f, projection, 1000.0f);
+    EXPECT_NEAR(size, 10.0f, 0.01f);
+    EXPECT_NEAR(ProjectSphereSize(glm::vec3(0.0f, 0.0f, -200.0f), 1.0f, projection, 1000.0f), size / 2.0f, 0.01f);
+    EXPECT_TRUE(std::isinf(ProjectSphereSize(glm::vec3(0.0f, 0.0f, -0.5f), 1.0f, projection, 1000.0f)));
+
+    auto ortho = glm::ortho(-10.0f, 10.0f, -10.0f, 10.0f, 0.1f, 100.0f);
+    EXPECT_FLOAT_EQ(ProjectSphereSize(glm::vec3(0.0f, 0.0f, -5.0f), 1.0f, ortho, 1000.0f),
+                    ProjectSphereSize(glm::vec3(0.0f, 0.0f, -50.0f), 1.0f, ortho, 1000.0f));
+}
+
+TEST_F(MeshLodTest, SelectsCoarsestLodWithinPixelError)
+{
+    // 误差像素 = 相对误差 * 投影直径 / 2
+    EXPECT_EQ(SelectLod(mErrors, 1000.0f, 0, mSettings), 0u);
+    EXPECT_EQ(SelectLod(mErrors, 150.0f, 0, mSettings), 1u);
+    EXPECT_EQ(SelectLod(mErrors, 30.0f, 0, mSettings), 2u);
+    EXPECT_EQ(SelectLod(mErrors, 5.0f, 0, mSettings), 3u);
+    EXPECT_EQ(SelectLod(mErrors, 5.0f, 3, mSettings), 3u);
+    EXPECT_EQ(SelectLod(mErrors, 1000.0f, 3, mSettings), 0u);
+    EXPECT_EQ(SelectLod({}, 5.0f, 2, mSettings), 0u);
+}
+
+TEST_F(MeshLodTest, HysteresisPreventsFlicker)
+{
+    // LOD1在投影直径200像素时恰好误差1像素
+    float threshold = 2.0f * mSettings.pixelError / mErrors[1];
+    uint32_t lod = SelectLod(mErrors, threshold * 1.05f, 0, mSettings);
+    EXPECT_EQ(lod, 0u);
+    // 缩小到阈值以下但仍在余量内，保持原网格
+    lod = SelectLod(mErrors, threshold * 0.95f, lod, mSettings);
+    EXPECT_EQ(lod, 0u);
+    lod = SelectLod(mErrors, threshold * 0.7f, lod, mSettings);
+    EXPECT_EQ(lod, 1u);
+    // 在阈值附近来回变化不会切回去
+    for (float scale : {0.8f, 0.95f, 0.8f, 0.99f})
+    {
+        lod = SelectLod(mErrors, threshold * scale, lod, mSettings);
+        EXPECT_EQ(lod, 1u);
+    }
+    // 超过阈值立即切到更精细的级别
+    lod = SelectLod(mErrors, threshold * 1.01f, lod, mSettings);
+    EXPECT_EQ(lod, 0u);
+}
@@ -0,0 +1,247 @@
+#include "Geometry/MeshOptimizer.hpp"
+#include <algorithm>
+#include <array>
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+#include <random>
+#include <tuple>
+
+using namespace MEngine::Core;
+
+namespace
+{
+struct TestVertex
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+};
+using Triangle = std::array<glm::vec3, 3>;
+
+/**
+ * @brief 高度场网格，三角形顺序打乱以模拟DCC工具导出的无序索引
+ */
+void MakeShuffledGrid(uint32_t size, std::vector<TestVertex> &vertices, std::vector<uint32_t> &indices)
+{
+    for (uint32_t z = 0; z <= size; z++)
+    {
+        for (uint32_t x = 0; x <= size; x++)
+        {
+            float fx = static_cast<float>(x), fz = static_cast<float>(z);
+            vertices.push_back({glm::vec3(fx, std::sin(fx * 0.3f) * std::cos(fz * 0.2f), fz),
+                                glm::vec3(0.0f, 1.0f, 0.0f), glm::vec2(fx, fz)});
+        }
+    }
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t z = 0; z < size; z++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t a = z * (size + 1) + x, b = a + 1, c = a + size + 1, d = c + 1;
+            triangles.push_back({a, c, b});
+            triangles.push_back({b, c, d});
+        }
+    }
+    std::mt19937 random(42);
+    std::shuffle(triangles.begin(), triangles.end(), random);
+    for (const auto &triangle : triangles)
+    {
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+}
+/**
+ * @brief 按位置展开的三角形集合，旋转到最小顶点开头以忽略起始顶点，保留绕序
+ */
+std::vector<Triangle> CollectTriangles(const std::vector<TestVertex> &vertices, const std::vector<uint32_t> &indices)
+{
+    auto less = [](const glm::vec3 &a, const glm::vec3 &b) {
+        return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+    };
+    std::vector<Triangle> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        Triangle triangle{vertices[indices[i]].position, vertices[indices[i + 1]].position,
+                          vertices[indices[i + 2]].position};
+        auto first = std::min_element(triangle.begin(), triangle.end(), less);
+        std::rotate(triangle.begin(), first, triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end(), [&](const Triangle &a, const Triangle &b) {
+        for (int k = 0; k < 3; k++)
+        {
+            if (less(a[k], b[k]))
+            {
+                return true;
+            }
+            if (less(b[k], a[k]))
+            {
+                return false;
+            }
+        }
+        return false;
+    });
+    return triangles;
+}
+} // namespace
+
+TEST(MeshOptimizerTest, AnalyzeVertexCache)
+{
+    std::vector<uint32_t> indices{0, 1, 2, 2, 1, 3};
+    auto stats = MeshOptimizer::AnalyzeVertexCache(indices, 4);
+    EXPECT_EQ(stats.misses, 4u);
+    EXPECT_FLOAT_EQ(stats.acmr, 2.0f);
+    EXPECT_FLOAT_EQ(stats.atvr, 1.0f);
+    // 缓存只有3个顶点时0被挤出
+    indices.insert(indices.end(), {3, 1, 0});
+    EXPECT_EQ(MeshOptimizer::AnalyzeVertexCache(indices, 4, 3).misses, 5u);
+}
+
+TEST(MeshOptimizerTest, DeduplicatesWholeVertices)
+{
+    // 展开成三角形列表，每个角一个独立顶点
+    std::vector<TestVertex> grid;
+    std::vector<uint32_t> gridIndices;
+    MakeShuffledGrid(8, grid, gridIndices);
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    for (auto index : gridIndices)
+    {
+        indices.push_back(static_cast<uint32_t>(vertices.size()));
+        vertices.push_back(grid[index]);
+    }
+    // 位置相同但UV不同的顶点不能合并
+    vertices[0].texCoord.x += 100.0f;
+    auto expected = CollectTriangles(vertices, indices);
+
+    std::vector<uint32_t> remap;
+    auto uniqueCount = MeshOptimizer::GenerateVertexRemap(remap, reinterpret_cast<const uint8_t *>(vertices.data()),
+                                                          sizeof(TestVertex), vertices.size());
+    EXPECT_EQ(uniqueCount, grid.size() + 1);
+    MeshOptimizer::RemapVertices(vertices, indices, remap, uniqueCount);
+    EXPECT_EQ(vertices.size(), grid.size() + 1);
+    EXPECT_EQ(CollectTriangles(vertices, indices), expected);
+}
+
+TEST(MeshOptimizerTest, VertexCacheOptimizationImprovesAcmr)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(64, vertices, indices);
+    auto expected = CollectTriangles(vertices, indices);
+    auto before = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+
+    MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+    auto after = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+    EXPECT_EQ(CollectTriangles(vertices, indices), expected);
+    EXPECT_GT(before.acmr, 2.0f);
+    // 规则网格上Tipsify的ACMR约0.7，理论下限0.5
+    EXPECT_LT(after.acmr, 0.8f);
+    EXPECT_LT(after.atvr, 1.6f);
+
+    // 每个子簇从冷缓存开始的ACMR不超过原来的1.05倍，但簇首之后的三角形原本可能命中上一簇的顶点，留一些余量
+    MeshOptimizer::OptimizeOverdraw(indices, reinterpret_cast<const uint8_t *>(&vertices.front().position),
+                                    sizeof(TestVertex), vertices.size());
+    EXPECT_EQ(CollectTriangles(vertices, indices), expected);
+    EXPECT_LE(MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).acmr, after.acmr * 1.1f);
+}
+
+TEST(MeshOptimizerTest, OverdrawDrawsOutwardClustersFirst)
+{
+    // 两块平行的面片，外侧的一块（沿法线方向离中心更远）应先画
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    for (float y : {-1.0f, 1.0f})
+    {
+        auto base = static_cast<uint32_t>(vertices.size());
+        for (int i = 0; i < 4; i++)
+        {
+            vertices.push_back({glm::vec3(float(i & 1), y, float(i >> 1)), glm::vec3(0.0f), glm::vec2(0.0f)});
+        }
+        // 两块都朝+Y，上面一块在外侧
+        indices.insert(indices.end(), {base, base + 2, base + 1, base + 1, base + 2, base + 3});
+    }
+    MeshOptimizer::OptimizeOverdraw(indices, reinterpret_cast<const uint8_t *>(&vertices.front().position),
+                                    sizeof(TestVertex), vertices.size());
+    EXPECT_FLOAT_EQ(vertices[indices[0]].position.y, 1.0f);
+    EXPECT_FLOAT_EQ(vertices[indices.back()].position.y, -1.0f);
+}
+
+TEST(MeshOptimizerTest, FetchRemapFollowsFirstUse)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(16, vertices, indices);
+    // 额外一个未被引用的顶点
+    vertices.push_back({glm::vec3(100.0f), glm::vec3(0.0f), glm::vec2(0.0f)});
+    auto expected = CollectTriangles(vertices, indices);
+
+    std::vector<uint32_t> remap;
+    auto usedCount = MeshOptimizer::GenerateFetchRemap(remap, indices, vertices.size());
+    EXPECT_EQ(usedCount, vertices.size() - 1);
+    EXPECT_EQ(remap.back(), ~0u);
+    MeshOptimizer::RemapVertices(vertices, indices, remap, usedCount);
+    EXPECT_EQ(CollectTriangles(vertices, indices), expected);
+    uint32_t next = 0;
+    for (auto index : indices)
+    {
+        EXPECT_LE(index, next);
+        next = std::max(next, index + 1);
+    }
+}
+
+TEST(MeshOptimizerTest, OptimizeKeepsTriangles)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(32, vertices, indices);
+    auto expected = CollectTriangles(vertices, indices);
+    auto before = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+    MeshOptimizer::Optimize(vertices, indices);
+    auto after = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+    EXPECT_EQ(CollectTriangles(vertices, indices), expected);
+    EXPECT_LT(after.acmr, before.acmr * 0.5f);
+}
+
+TEST(MeshOptimizerTest, SplitByVertexLimit)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeShuffledGrid(32, vertices, indices);
+    MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+    auto expected = CollectTriangles(vertices, indices);
+
+    // 不需要切分时只有一段
+    EXPECT_EQ(MeshOptimizer::SplitByVertexLimit(indices, vertices.size(), vertices.size()),
+              (std::vector<size_t>{0, indices.size()}));
+
+    const size_t limit = 200;
+    auto offsets = MeshOptimizer::SplitByVertexLimit(indices, vertices.size(), limit);
+    ASSERT_GT(offsets.size(), 2u);
+    EXPECT_EQ(offsets.front(), 0u);
+    EXPECT_EQ(offsets.back(), indices.size());
+    std::vector<TestVertex> merged;
+    std::vector<uint32_t> mergedIndices;
+    size_t totalVertices = 0;
+    for (size_t part = 0; part + 1 < offsets.size(); part++)
+    {
+        EXPECT_EQ(offsets[part] % 3, 0u);
+        std::vector<TestVertex> partVertices;
+        std::vector<uint32_t> partIndices;
+        MeshOptimizer::ExtractRange(vertices, indices, offsets[part], offsets[part + 1], partVertices, partIndices);
+        EXPECT_LE(partVertices.size(), limit);
+        // 除最后一段外每段都应接近上限，避免切得过碎
+        if (part + 2 < offsets.size())
+        {
+            EXPECT_GT(partVertices.size(), limit - 3);
+        }
+        totalVertices += partVertices.size();
+        for (auto index : partIndices)
+        {
+            mergedIndices.push_back(index + static_cast<uint32_t>(merged.size()));
+        }
+        merged.insert(merged.end(), partVertices.begin(), partVertices.end());
+    }
+    EXPECT_EQ(CollectTriangles(merged, mergedIndices), expected);
+    // 缓存优化后的顺序局部性好，段边界上复制的顶点不多
+    EXPECT_LT(totalVertices, vertices.size() * 5 / 4);
+}
@@ -0,0 +1,247 @@
+#include "Geometry/MeshSimplifier.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <gtest/gtest.h>
+
+using namespace MEngine::Core;
+
+namespace
+{
+struct TestVertex
+{
+    glm::vec3 position;
+    glm::vec2 texCoord;
+};
+struct TestMesh
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+};
+/**
+ * @brief 闭合的经纬球，两极共用一个顶点，没有接缝
+ */
+TestMesh MakeSphere(uint32_t rings, uint32_t segments, float radius)
+{
+    TestMesh mesh;
+    mesh.vertices.push_back({glm::vec3(0.0f, radius, 0.0f), glm::vec2(0.0f)});
+    for (uint32_t ring = 1; ring < rings; ring++)
+    {
+        float theta = glm::pi<float>() * ring / rings;
+        for (uint32_t segment = 0; segment < segments; segment++)
+        {
+            float phi = 2.0f * glm::pi<float>() * segment / segments;
+            mesh.vertices.push_back({radius * glm::vec3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                                        -std::sin(theta) * std::sin(phi)),
+                                     glm::vec2(0.0f)});
+        }
+    }
+    uint32_t south = static_cast<uint32_t>(mesh.vertices.size());
+    mesh.vertices.push_back({glm::vec3(0.0f, -radius, 0.0f), glm::vec2(0.0f)});
+    auto ringVertex = [&](uint32_t ring, uint32_t segment) { return 1 + (ring - 1) * segments + segment % segments; };
+    for (uint32_t segment = 0; segment < segments; segment++)
+    {
+        mesh.indices.insert(mesh.indices.end(), {0, ringVertex(1, segment), ringVertex(1, segment + 1)});
+        mesh.indices.insert(mesh.indices.end(),
+                            {south, ringVertex(rings - 1, segment + 1), ringVertex(rings - 1, segment)});
+    }
+    for (uint32_t ring = 1; ring + 1 < rings; ring++)
+    {
+        for (uint32_t segment = 0; segment < segments; segment++)
+        {
+            auto a = ringVertex(ring, segment), b = ringVertex(ring, segment + 1);
+            auto c = ringVertex(ring + 1, segment), d = ringVertex(ring + 1, segment + 1);
+            mesh.indices.insert(mesh.indices.end(), {a, c, d, a, d, b});
+        }
+    }
+    return mesh;
+}
+/**
+ * @brief XZ平面上的开放网格
+ */
+TestMesh MakeGrid(uint32_t size, float (*height)(float, float))
+{
+    TestMesh mesh;
+    for (uint32_t z = 0; z <= size; z++)
+    {
+        for (uint32_t x = 0; x <= size; x++)
+        {
+            float fx = static_cast<float>(x), fz = static_cast<float>(z);
+            mesh.vertices.push_back({glm::vec3(fx, height(fx, fz), fz), glm::vec2(fx, fz) / float(size)});
+        }
+    }
+    for (uint32_t z = 0; z < size; z++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            uint32_t a = z * (size + 1) + x, b = a + 1, c = a + size + 1, d = c + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    return mesh;
+}
+float PointTriangleDistance(const glm::vec3 &p, const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+{
+    auto ab = b - a, ac = c - a, ap = p - a;
+    auto normal = glm::cross(ab, ac);
+    float area = glm::dot(normal, normal);
+    if (area > 0.0f)
+    {
+        // 投影点在三角形内部时取到平面的距离
+        auto projected = p - normal * (glm::dot(ap, normal) / area);
+        float u = glm::dot(glm::cross(b - projected, c - projected), normal);
+        float v = glm::dot(glm::cross(c - projected, a - projected), normal);
+        float w = glm::dot(glm::cross(a - projected, b - projected), normal);
+        if (u >= 0.0f && v >= 0.0f && w >= 0.0f)
+        {
+            return glm::length(p - projected);
+        }
+    }
+    auto segment = [&](const glm::vec3 &s0, const glm::vec3 &s1) {
+        auto d = s1 - s0;
+        float t = std::clamp(glm::dot(p - s0, d) / std::max(glm::dot(d, d), FLT_MIN), 0.0f, 1.0f);
+        return glm::length(p - (s0 + d * t));
+    };
+    return std::min({segment(a, b), segment(b, c), segment(c, a)});
+}
+/**
+ * @brief 原网格顶点到简化网格表面的最大距离
+ */
+float MaxDeviation(const TestMesh &mesh, const std::vector<uint32_t> &simplified)
+{
+    float maxDistance = 0.0f;
+    for (const auto &vertex : mesh.vertices)
+    {
+        float distance = FLT_MAX;
+        for (size_t i = 0; i < simplified.size(); i += 3)
+        {
+            distance = std::min(distance, PointTriangleDistance(vertex.position,
+                                                                mesh.vertices[simplified[i]].position,
+                                                                mesh.vertices[simplified[i + 1]].position,
+                                                                mesh.vertices[simplified[i + 2]].position));
+        }
+        maxDistance = std::max(maxDistance, distance);
+    }
+    return maxDistance;
+}
+} // namespace
+
+TEST(MeshSimplifierTest, ReachesTargetTriangleCount)
+{
+    auto sphere = MakeSphere(32, 64, 1.0f);
+    for (float ratio : {0.5f, 0.25f, 0.1f})
+    {
+        auto target = static_cast<size_t>(sphere.indices.size() * ratio) / 3 * 3;
+        float error = 0.0f;
+        auto result = MeshSimplifier::Simplify(sphere.vertices, sphere.indices, target, FLT_MAX, &error);
+        // 每次折叠删除两个三角形
+        EXPECT_LE(result.size(), target);
+        EXPECT_GE(result.size() + 6, target);
+        EXPECT_GT(error, 0.0f);
+    }
+}
+
+TEST(MeshSimplifierTest, ErrorBoundsSurfaceDeviation)
+{
+    auto sphere = MakeSphere(16, 32, 1.0f);
+    float previousError = 0.0f;
+    for (float ratio : {0.5f, 0.25f, 0.1f})
+    {
+        float error = 0.0f;
+        auto result = MeshSimplifier::Simplify(sphere.vertices, sphere.indices,
+                                               static_cast<size_t>(sphere.indices.size() * ratio), FLT_MAX, &error);
+        EXPECT_LE(MaxDeviation(sphere, result), error + 1e-4f);
+        EXPECT_GE(error, previousError);
+        previousError = error;
+    }
+    // 误差上限优先于目标数量
+    float maxError = 0.01f;
+    float error = 0.0f;
+    auto result = MeshSimplifier::Simplify(sphere.vertices, sphere.indices, 0, maxError, &error);
+    EXPECT_LE(error, maxError);
+    EXPECT_LT(result.size(), sphere.indices.size());
+    EXPECT_LE(MaxDeviation(sphere, result), maxError + 1e-4f);
+}
+
+TEST(MeshSimplifierTest, KeepsOrientationOfClosedMesh)
+{
+    auto sphere = MakeSphere(16, 32, 2.0f);
+    auto result = MeshSimplifier::Simplify(sphere.vertices, sphere.indices, sphere.indices.size() / 10, FLT_MAX);
+    ASSERT_FALSE(result.empty());
+    for (size_t i = 0; i < result.size(); i += 3)
+    {
+        const auto &a = sphere.vertices[result[i]].position;
+        const auto &b = sphere.vertices[result[i + 1]].position;
+        const auto &c = sphere.vertices[result[i + 2]].position;
+        EXPECT_GT(glm::dot(glm::cross(b - a, c - a), a + b + c), 0.0f);
+    }
+}
+
+TEST(MeshSimplifierTest, FlatRegionsCollapseWithoutError)
+{
+    auto grid = MakeGrid(20, [](float x, float z) {
+        // 中心一个凸起，其余为平面
+        float dx = x - 10.0f, dz = z - 10.0f;
+        return dx * dx + dz * dz < 4.0f ? 1.0f : 0.0f;
+    });
+    float error = 1.0f;
+    auto result = MeshSimplifier::Simplify(grid.vertices, grid.indices, 0, 1e-4f, &error);
+    EXPECT_LE(error, 1e-4f);
+    EXPECT_LT(result.size(), grid.indices.size() / 2);
+    EXPECT_LE(MaxDeviation(grid, result), 1e-4f);
+    // 边界顶点锁定，开放网格的轮廓不变
+    std::vector<uint8_t> used(grid.vertices.size(), 0);
+    for (auto index : result)
+    {
+        used[index] = 1;
+    }
+    for (uint32_t i = 0; i <= 20; i++)
+    {
+        EXPECT_TRUE(used[i]);
+        EXPECT_TRUE(used[20 * 21 + i]);
+        EXPECT_TRUE(used[i * 21]);
+        EXPECT_TRUE(used[i * 21 + 20]);
+    }
+}
+
+TEST(MeshSimplifierTest, SeamVerticesAreLocked)
+{
+    // 第10列顶点复制一份作为UV接缝，右半边引用复制的顶点
+    auto grid = MakeGrid(20, [](float, float) { return 0.0f; });
+    std::vector<uint32_t> seam(grid.vertices.size(), ~0u);
+    for (uint32_t z = 0; z <= 20; z++)
+    {
+        uint32_t index = z * 21 + 10;
+        seam[index] = static_cast<uint32_t>(grid.vertices.size());
+        auto copy = grid.vertices[index];
+        copy.texCoord.x += 1.0f;
+        grid.vertices.push_back(copy);
+    }
+    for (size_t i = 0; i < grid.indices.size(); i += 3)
+    {
+        float centerX = 0.0f;
+        for (int k = 0; k < 3; k++)
+        {
+            centerX += grid.vertices[grid.indices[i + k]].position.x / 3.0f;
+        }
+        for (int k = 0; k < 3 && centerX > 10.0f; k++)
+        {
+            if (seam[grid.indices[i + k]] != ~0u)
+            {
+                grid.indices[i + k] = seam[grid.indices[i + k]];
+            }
+        }
+    }
+    auto result = MeshSimplifier::Simplify(grid.vertices, grid.indices, 0, 1e-4f);
+    std::vector<uint8_t> used(grid.vertices.size(), 0);
+    for (auto index : result)
+    {
+        used[index] = 1;
+    }
+    for (uint32_t z = 0; z <= 20; z++)
+    {
+        EXPECT_TRUE(used[z * 21 + 10]);
+        EXPECT_TRUE(used[seam[z * 21 + 10]]);
+    }
+}
@@ -0,0 +1,222 @@
+#include "Culling/MeshletCuller.hpp"
+#include "Geometry/MeshOptimizer.hpp"
+#include "Geometry/MeshletBuilder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <unordered_set>
+
+using namespace MEngine::Core;
+
+namespace
+{
+struct TestVertex
+{
+    glm::vec3 position;
+};
+/**
+ * @brief 以原点为中心的经纬球，三角形朝外
+ */
+void MakeSphere(uint32_t segments, std::vector<TestVertex> &vertices, std::vector<uint32_t> &indices)
+{
+    const float pi = glm::pi<float>();
+    for (uint32_t y = 0; y <= segments; y++)
+    {
+        for (uint32_t x = 0; x <= segments * 2; x++)
+        {
+            float u = float(x) / float(segments * 2) * 2.0f * pi, v = float(y) / float(segments) * pi;
+            vertices.push_back({glm::vec3(std::sin(v) * std::cos(u), std::cos(v), std::sin(v) * std::sin(u))});
+        }
+    }
+    uint32_t row = segments * 2 + 1;
+    for (uint32_t y = 0; y < segments; y++)
+    {
+        for (uint32_t x = 0; x < segments * 2; x++)
+        {
+            uint32_t a = y * row + x, b = a + 1, c = a + row, d = c + 1;
+            indices.insert(indices.end(), {a, b, c, b, d, c});
+        }
+    }
+}
+std::vector<Meshlet> BuildSphere(uint32_t segments, std::vector<TestVertex> &vertices, std::vector<uint32_t> &indices)
+{
+    MakeSphere(segments, vertices, indices);
+    MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+    return MeshletBuilder::Build(vertices, indices);
+}
+glm::vec3 TriangleNormal(const std::vector<TestVertex> &vertices, const uint32_t *triangle)
+{
+    auto a = vertices[triangle[0]].position, b = vertices[triangle[1]].position, c = vertices[triangle[2]].position;
+    return glm::cross(b - a, c - a);
+}
+} // namespace
+
+TEST(MeshletTest, BuildRespectsLimits)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    MakeSphere(32, vertices, indices);
+    auto original = indices;
+    MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+    auto meshlets = MeshletBuilder::Build(vertices, indices);
+    ASSERT_FALSE(meshlets.empty());
+    EXPECT_EQ(indices.size(), original.size());
+
+    uint32_t next = 0;
+    size_t totalTriangles = 0;
+    for (const auto &meshlet : meshlets)
+    {
+        // 连续且覆盖整个索引缓冲区
+        EXPECT_EQ(meshlet.firstIndex, next);
+        next += meshlet.triangleCount * 3;
+        totalTriangles += meshlet.triangleCount;
+        EXPECT_LE(meshlet.triangleCount, MeshletBuilder::MaxTriangles);
+        std::unordered_set<uint32_t> unique(indices.begin() + meshlet.firstIndex,
+                                            indices.begin() + meshlet.firstIndex + meshlet.triangleCount * 3);
+        EXPECT_EQ(unique.size(), meshlet.vertexCount);
+        EXPECT_LE(meshlet.vertexCount, MeshletBuilder::MaxVertices);
+        for (auto index : unique)
+        {
+            EXPECT_LE(glm::length(vertices[index].position - meshlet.sphere.center), meshlet.sphere.radius * 1.0001f);
+        }
+    }
+    EXPECT_EQ(totalTriangles, original.size() / 3);
+    // 贪心生长的簇应接近上限，平均每簇顶点数远大于三角形列表的下限
+    float averageTriangles = float(totalTriangles) / float(meshlets.size());
+    EXPECT_GT(averageTriangles, 80.0f);
+
+    // 三角形集合和绕序不变
+    auto canonical = [](std::vector<uint32_t> list) {
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (size_t i = 0; i < list.size(); i += 3)
+        {
+            std::array<uint32_t, 3> triangle{list[i], list[i + 1], list[i + 2]};
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    };
+    EXPECT_EQ(canonical(indices), canonical(original));
+}
+
+TEST(MeshletTest, ConeCullingIsConservative)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    auto meshlets = BuildSphere(48, vertices, indices);
+    // 远处正交视线下，约一半的簇背对相机
+    for (auto camera : {glm::vec4(0.0f, 0.0f, 5.0f, 1.0f), glm::vec4(3.0f, -2.0f, 1.2f, 1.0f),
+                        glm::vec4(0.0f, 0.0f, -1.0f, 0.0f), glm::vec4(0.3f, 0.9f, 0.1f, 0.0f)})
+    {
+        uint32_t culled = 0;
+        for (const auto &meshlet : meshlets)
+        {
+            if (!MeshletCuller::IsBackfacing(meshlet, camera))
+            {
+                continue;
+            }
+            culled++;
+            for (uint32_t t = 0; t < meshlet.triangleCount; t++)
+            {
+                const auto *triangle = &indices[meshlet.firstIndex + t * 3];
+                auto normal = TriangleNormal(vertices, triangle);
+                for (int k = 0; k < 3; k++)
+                {
+                    auto view = camera.w == 0.0f ? glm::vec3(camera)
+                                                 : vertices[triangle[k]].position - glm::vec3(camera);
+                    EXPECT_GE(glm::dot(view, normal), -1e-6f);
+                }
+            }
+        }
+        EXPECT_GT(culled, meshlets.size() / 5);
+        EXPECT_LT(culled, meshlets.size() / 2);
+    }
+}
+
+TEST(MeshletTest, CullMergesRanges)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    auto meshlets = BuildSphere(32, vertices, indices);
+    auto view = glm::lookAt(glm::vec3(0.0f, 0.0f, 6.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    auto projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f);
+    auto model = glm::mat4(1.0f);
+    auto frustum = Frustum::FromMatrix(projection * view * model);
+    auto camera = MeshletCuller::GetModelSpaceCamera(view, projection, model);
+    EXPECT_NEAR(glm::length(glm::vec3(camera) - glm::vec3(0.0f, 0.0f, 6.0f)), 0.0f, 1e-4f);
+
+    // 不做背面剔除时整个球都在视锥内，合并成一个区间
+    std::vector<MeshletRange> ranges;
+    auto stats = MeshletCuller::Cull(meshlets, frustum, camera, false, ranges);
+    EXPECT_EQ(stats.visible, meshlets.size());
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0].firstIndex, 0u);
+    EXPECT_EQ(ranges[0].indexCount, indices.size());
+
+    ranges.clear();
+    stats = MeshletCuller::Cull(meshlets, frustum, camera, true, ranges);
+    EXPECT_GT(stats.backfaceCulled, 0u);
+    uint32_t rangeIndices = 0;
+    for (const auto &range : ranges)
+    {
+        rangeIndices += range.indexCount;
+    }
+    EXPECT_EQ(rangeIndices, stats.visibleTriangles * 3);
+
+    // 物体移到相机左侧视锥之外，缩放不影响结果
+    model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(-20.0f, 0.0f, 0.0f)), glm::vec3(2.0f, 0.5f, 1.0f));
+    ranges.clear();
+    stats = MeshletCuller::Cull(meshlets, Frustum::FromMatrix(projection * view * model),
+                                MeshletCuller::GetModelSpaceCamera(view, projection, model), true, ranges);
+    EXPECT_EQ(stats.visible, 0u);
+    EXPECT_TRUE(ranges.empty());
+
+    // 部分在视锥内
+    model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(-3.3f, 0.0f, 0.0f)), glm::vec3(2.0f));
+    ranges.clear();
+    stats = MeshletCuller::Cull(meshlets, Frustum::FromMatrix(projection * view * model),
+                                MeshletCuller::GetModelSpaceCamera(view, projection, model), false, ranges);
+    EXPECT_GT(stats.frustumCulled, 0u);
+    EXPECT_GT(stats.visible, 0u);
+}
+
+TEST(MeshletTest, DISABLED_Benchmark)
+{
+    std::vector<TestVertex> vertices;
+    std::vector<uint32_t> indices;
+    auto start = std::chrono::high_resolution_clock::now();
+    auto meshlets = BuildSphere(512, vertices, indices);
+    float buildMs =
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << indices.size() / 3 << " triangles, " << meshlets.size() << " meshlets, build " << buildMs << " ms"
+              << std::endl;
+
+    auto view = glm::lookAt(glm::vec3(0.0f, 0.0f, 1.8f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    auto projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+    std::vector<MeshletRange> ranges;
+    for (bool coneCulling : {false, true})
+    {
+        constexpr int iterations = 200;
+        MeshletCullStats stats;
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            auto model = glm::rotate(glm::mat4(1.0f), float(i) * 0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+            ranges.clear();
+            stats = MeshletCuller::Cull(meshlets, Frustum::FromMatrix(projection * view * model),
+                                        MeshletCuller::GetModelSpaceCamera(view, projection, model), coneCulling,
+                                        ranges);
+        }
+        float cullMs =
+            std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() /
+            iterations;
+        std::cout << "cone " << coneCulling << ": " << cullMs << " ms per mesh, "
+                  << cullMs * 1e6f / float(meshlets.size()) << " ns per meshlet, visible " << stats.visible
+                  << " (frustum culled " << stats.frustumCulled << ", backface culled " << stats.backfaceCulled
+                  << "), " << ranges.size() << " ranges" << std::endl;
+    }
+}
@@ -0,0 +1,77 @@
+#include "Asset/Model.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+using namespace MEngine::Core;
+namespace
+{
+/**
+ * @brief root -> (arm -> hand), leg；arm和hand各平移一段
+ */
+ModelHierarchy CreateHierarchy()
+{
+    ModelHierarchy hierarchy;
+    auto root = hierarchy.AddNode("root", -1, glm::mat4(1.0f));
+    std::vector<uint32_t> armMeshes{0, 1};
+    auto arm =
+        hierarchy.AddNode("arm", root, glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)), armMeshes);
+    std::vector<uint32_t> handMeshes{2};
+    hierarchy.AddNode("hand", arm, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.0f, 0.0f)), handMeshes);
+    hierarchy.AddNode("leg", root, glm::mat4(1.0f));
+    return hierarchy;
+}
+} // namespace
+TEST(ModelHierarchyTest, AddNode_StoresDepthFirstArrays)
+{
+    auto hierarchy = CreateHierarchy();
+    ASSERT_EQ(hierarchy.GetNodeCount(), 4u);
+    EXPECT_EQ(hierarchy.Names, (std::vector<std::string>{"root", "arm", "hand", "leg"}));
+    EXPECT_EQ(hierarchy.Parents, (std::vector<int32_t>{-1, 0, 1, 0}));
+    EXPECT_EQ(hierarchy.MeshIndices, (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_TRUE(hierarchy.GetMeshes(0).empty());
+    ASSERT_EQ(hierarchy.GetMeshes(1).size(), 2u);
+    EXPECT_EQ(hierarchy.GetMeshes(1)[1], 1u);
+    EXPECT_EQ(hierarchy.GetMeshes(2)[0], 2u);
+    EXPECT_TRUE(hierarchy.IsValid(3));
+    EXPECT_FALSE(hierarchy.IsValid(2));
+}
+TEST(ModelHierarchyTest, IsValid_RejectsChildBeforeParent)
+{
+    auto hierarchy = CreateHierarchy();
+    hierarchy.Parents[1] = 2;
+    EXPECT_FALSE(hierarchy.IsValid(3));
+    hierarchy = CreateHierarchy();
+    hierarchy.LocalTransforms.pop_back();
+    EXPECT_FALSE(hierarchy.IsValid(3));
+}
+TEST(ModelHierarchyTest, ComputeGlobalTransforms_AccumulatesParents)
+{
+    auto transforms = CreateHierarchy().ComputeGlobalTransforms();
+    ASSERT_EQ(transforms.size(), 4u);
+    EXPECT_FLOAT_EQ(transforms[2][3][0], 1.0f);
+    EXPECT_FLOAT_EQ(transforms[2][3][1], 2.0f);
+    EXPECT_FLOAT_EQ(transforms[3][3][0], 0.0f);
+}
+TEST(ModelHierarchyTest, Serialize_RoundTrip)
+{
+    Model model;
+    model.Meshes = {UUIDGenerator()(), UUIDGenerator()(), UUIDGenerator()()};
+    model.Hierarchy = CreateHierarchy();
+    nlohmann::json j = model;
+    auto loaded = j.get<Model>();
+    EXPECT_EQ(loaded.Hierarchy.Names, model.Hierarchy.Names);
+    EXPECT_EQ(loaded.Hierarchy.Parents, model.Hierarchy.Parents);
+    EXPECT_EQ(loaded.Hierarchy.MeshIndices, model.Hierarchy.MeshIndices);
+    ASSERT_EQ(loaded.Hierarchy.MeshRanges.size(), 4u);
+    EXPECT_EQ(loaded.Hierarchy.MeshRanges[1].offset, 0u);
+    EXPECT_EQ(loaded.Hierarchy.MeshRanges[1].count, 2u);
+    EXPECT_EQ(loaded.Hierarchy.MeshRanges[2].offset, 2u);
+    EXPECT_FLOAT_EQ(loaded.Hierarchy.LocalTransforms[2][3][1], 2.0f);
+    EXPECT_TRUE(loaded.Hierarchy.IsValid(loaded.Meshes.size()));
+}
+TEST(ModelHierarchyTest, Deserialize_WithoutHierarchy)
+{
+    nlohmann::json j = Model();
+    j.erase("Hierarchy");
+    auto loaded = j.get<Model>();
+    EXPECT_TRUE(loaded.Hierarchy.IsEmpty());
+}
@@ -0,0 +1,140 @@
+#include "Culling/OcclusionCuller.hpp"
+#include <chrono>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace MEngine::Core;
+
+namespace
+{
+glm::mat4 CreateViewProjection()
+{
+    auto projection = glm::perspective(glm::radians(60.0f), 2.0f, 0.1f, 500.0f);
+    auto view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    return projection * view;
+}
+AABB CreateBox(const glm::vec3 &center, const glm::vec3 &extents)
+{
+    return AABB{center - extents, center + extents};
+}
+} // namespace
+
+TEST(OcclusionCullerTest, EmptyBufferKeepsEverything)
+{
+    OcclusionCuller culler;
+    culler.BeginFrame(CreateViewProjection());
+    culler.Rasterize();
+    EXPECT_TRUE(culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -50.0f), glm::vec3(1.0f))));
+}
+
+TEST(OcclusionCullerTest, WallOccludesBoxBehind)
+{
+    OcclusionCuller culler;
+    culler.BeginFrame(CreateViewProjection());
+    // 在z=-10处放一面覆盖视野中心的墙
+    culler.AddOccluder(CreateBox(glm::vec3(0.0f, 0.0f, -10.0f), glm::vec3(8.0f, 4.0f, 0.5f)));
+    culler.Rasterize();
+    EXPECT_EQ(culler.GetTriangleCount(), 12u);
+    EXPECT_LT(culler.GetDepth(OcclusionCuller::Width / 2, OcclusionCuller::Height / 2), 1.0f);
+
+    EXPECT_FALSE(culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -30.0f), glm::vec3(1.0f))));
+    // 墙前方
+    EXPECT_TRUE(culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -5.0f), glm::vec3(1.0f))));
+    // 从墙的边缘露出
+    EXPECT_TRUE(culler.IsVisible(CreateBox(glm::vec3(28.0f, 0.0f, -30.0f), glm::vec3(1.0f))));
+    // 跨越近平面
+    EXPECT_TRUE(culler.IsVisible(CreateBox(glm::vec3(0.0f), glm::vec3(1.0f))));
+}
+
+TEST(OcclusionCullerTest, MeshOccluderMatchesBoxOccluder)
+{
+    struct Vertex
+    {
+        glm::vec3 position;
+        glm::vec2 texCoord;
+    };
+    // 两个三角形组成的四边形墙面
+    std::vector<Vertex> vertices = {{{-8.0f, -4.0f, 0.0f}, {}},
+                                    {{8.0f, -4.0f, 0.0f}, {}},
+                                    {{8.0f, 4.0f, 0.0f}, {}},
+                                    {{-8.0f, 4.0f, 0.0f}, {}}};
+    std::vector<uint32_t> indices = {0, 1, 2, 0, 2, 3};
+    OcclusionCuller culler;
+    culler.BeginFrame(CreateViewProjection());
+    culler.AddOccluder(vertices, indices, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f)));
+    culler.Rasterize(false);
+    EXPECT_FALSE(culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -30.0f), glm::vec3(1.0f))));
+    EXPECT_TRUE(culler.IsVisible(CreateBox(glm::vec3(0.0f, 6.0f, -12.0f), glm::vec3(1.0f))));
+}
+
+TEST(OcclusionCullerTest, ParallelMatchesSerial)
+{
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> position(-40.0f, 40.0f);
+    std::uniform_real_distribution<float> depth(-200.0f, -5.0f);
+    std::vector<AABB> occluders(64), occludees(20000);
+    for (auto &occluder : occluders)
+    {
+        occluder = CreateBox(glm::vec3(position(rng), position(rng) * 0.5f, depth(rng)), glm::vec3(6.0f, 3.0f, 0.5f));
+    }
+    for (auto &occludee : occludees)
+    {
+        occludee = CreateBox(glm::vec3(position(rng), position(rng) * 0.5f, depth(rng)), glm::vec3(0.5f));
+    }
+    std::vector<uint8_t> serial, parallel;
+    OcclusionCuller culler;
+    for (bool useThreads : {false, true})
+    {
+        culler.BeginFrame(CreateViewProjection());
+        for (const auto &occluder : occluders)
+        {
+            culler.AddOccluder(occluder);
+        }
+        culler.Rasterize(useThreads);
+        auto &visibility = useThreads ? parallel : serial;
+        visibility.assign(occludees.size(), 1);
+        culler.Cull(occludees, visibility, useThreads);
+    }
+    EXPECT_EQ(serial, parallel);
+    auto visibleCount = std::count(serial.begin(), serial.end(), 1);
+    EXPECT_GT(visibleCount, 0);
+    EXPECT_LT(visibleCount, static_cast<long>(occludees.size()));
+}
+
+// 性能测试，默认不运行：--gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST(OcclusionCullerTest, DISABLED_Benchmark)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> depth(-300.0f, -5.0f);
+    std::vector<AABB> occluders(256), occludees(100000);
+    for (auto &occluder : occluders)
+    {
+        occluder = CreateBox(glm::vec3(position(rng), position(rng) * 0.5f, depth(rng)), glm::vec3(8.0f, 4.0f, 0.5f));
+    }
+    for (auto &occludee : occludees)
+    {
+        occludee = CreateBox(glm::vec3(position(rng), position(rng) * 0.5f, depth(rng)), glm::vec3(0.5f));
+    }
+    OcclusionCuller culler;
+    for (bool parallel : {false, true})
+    {
+        auto start = Clock::now();
+        culler.BeginFrame(CreateViewProjection());
+        for (const auto &occluder : occluders)
+        {
+            culler.AddOccluder(occluder);
+        }
+        culler.Rasterize(parallel);
+        auto rasterMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::vector<uint8_t> visibility(occludees.size(), 1);
+        start = Clock::now();
+        auto visible = culler.Cull(occludees, visibility, parallel);
+        auto testMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        GTEST_LOG_(INFO) << (parallel ? "parallel" : "serial") << ": raster " << culler.GetTriangleCount()
+                         << " triangles " << rasterMs << " ms, test " << occludees.size() << " boxes " << testMs
+                         << " ms, visible " << visible;
+    }
+}
@@ -0,0 +1,247 @@
+#include "Asset/Pipeline.hpp"
+#include "Shader/ProgramCache.hpp"
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <glad/glad.h>
+#include <gtest/gtest.h>
+
+using namespace MEngine::Core;
+
+namespace
+{
+constexpr const char *VertexSource = R"(#version 460 core
+layout(location = 0) in vec3 inPosition;
+layout(location = 0) uniform mat4 mvp;
+void main()
+{
+    gl_Position = mvp * vec4(inPosition, 1.0);
+}
+)";
+constexpr const char *FragmentSource = R"(#version 460 core
+layout(location = 0) out vec4 OutColor;
+void main()
+{
+#ifdef RED
+    OutColor = vec4(1.0, 0.0, 0.0, 1.0);
+#else
+    OutColor = vec4(1.0);
+#endif
+}
+)";
+} // namespace
+
+TEST(ProgramCacheKeyTest, KeyDependsOnAllInputs)
+{
+    auto base = ProgramCache::Hash({"a", "b"}, {}, "driver");
+    EXPECT_EQ(base, ProgramCache::Hash({"a", "b"}, {}, "driver"));
+    EXPECT_NE(base, ProgramCache::Hash({"a", "c"}, {}, "driver"));
+    EXPECT_NE(base, ProgramCache::Hash({"a", "b"}, {"RED"}, "driver"));
+    EXPECT_NE(base, ProgramCache::Hash({"a", "b"}, {}, "other driver"));
+    // 拼接边界不同的源码不能得到同一个键
+    EXPECT_NE(ProgramCache::Hash({"ab", "c"}, {}, ""), ProgramCache::Hash({"a", "bc"}, {}, ""));
+}
+
+/**
+ * @brief 需要GL上下文，无窗口环境下跳过；可设置 LIBGL_ALWAYS_SOFTWARE=1 在 llvmpipe 上运行
+ */
+class ProgramCacheTest : public ::testing::Test
+{
+  protected:
+    std::filesystem::path mTestPath = std::filesystem::current_path() / "Test" / "ProgramCache";
+    GLFWwindow *mWindow = nullptr;
+    void SetUp() override
+    {
+        if (!glfwInit())
+        {
+            GTEST_SKIP() << "GLFW init failed";
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        mWindow = glfwCreateWindow(64, 64, "", nullptr, nullptr);
+        if (!mWindow)
+        {
+            glfwTerminate();
+            GTEST_SKIP() << "OpenGL 4.6 context unavailable";
+        }
+        glfwMakeContextCurrent(mWindow);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+        {
+            GTEST_SKIP() << "Failed to load OpenGL functions";
+        }
+        std::filesystem::remove_all(mTestPath);
+        std::filesystem::create_directories(mTestPath);
+        std::ofstream(mTestPath / "Test.vert") << VertexSource;
+        std::ofstream(mTestPath / "Test.frag") << FragmentSource;
+        ProgramCache::Get().SetDirectory(mTestPath / "Cache");
+    }
+    void TearDown() override
+    {
+        if (mWindow)
+        {
+            glfwDestroyWindow(mWindow);
+            glfwTerminate();
+        }
+    }
+    std::shared_ptr<Pipeline> CreatePipeline(std::vector<std::string> defines = {})
+    {
+        auto pipeline = std::make_shared<Pipeline>();
+        pipeline->Name = "Test";
+        pipeline->VertexShaderPath = mTestPath / "Test.vert";
+        pipeline->FragmentShaderPath = mTestPath / "Test.frag";
+        pipeline->Defines = std::move(defines);
+        return pipeline;
+    }
+};
+
+TEST_F(ProgramCacheTest, SecondCompileHitsCache)
+{
+    auto &cache = ProgramCache::Get();
+    if (!cache.IsEnabled())
+    {
+        GTEST_SKIP() << "Driver has no program binary formats";
+    }
+    auto before = cache.GetStats();
+    ASSERT_TRUE(CreatePipeline()->Compile());
+    EXPECT_EQ(cache.GetStats().misses, before.misses + 1);
+    EXPECT_EQ(cache.GetStats().stores, before.stores + 1);
+
+    auto pipeline = CreatePipeline();
+    ASSERT_TRUE(pipeline->Compile());
+    EXPECT_EQ(cache.GetStats().hits, before.hits + 1);
+    EXPECT_NE(pipeline->GetProgram(), 0u);
+
+    // 宏不同则是另一个变体
+    ASSERT_TRUE(CreatePipeline({"RED"})->Compile());
+    EXPECT_EQ(cache.GetStats().misses, before.misses + 2);
+}
+
+TEST_F(ProgramCacheTest, CorruptBinaryFallsBackToCompile)
+{
+    auto &cache = ProgramCache::Get();
+    if (!cache.IsEnabled())
+    {
+        GTEST_SKIP() << "Driver has no program binary formats";
+    }
+    ASSERT_TRUE(CreatePipeline()->Compile());
+    for (auto &entry : std::filesystem::directory_iterator(cache.GetDirectory()))
+    {
+        std::ofstream(entry.path(), std::ios::binary | std::ios::trunc) << "garbage";
+    }
+    auto before = cache.GetStats();
+    auto pipeline = CreatePipeline();
+    ASSERT_TRUE(pipeline->Compile());
+    EXPECT_NE(pipeline->GetProgram(), 0u);
+    EXPECT_EQ(cache.GetStats().hits, before.hits);
+    EXPECT_EQ(cache.GetStats().stores, before.stores + 1);
+}
+
+TEST_F(ProgramCacheTest, CorruptLengthIsDiscarded)
+{
+    auto &cache = ProgramCache::Get();
+    if (!cache.IsEnabled())
+    {
+        GTEST_SKIP() << "Driver has no program binary formats";
+    }
+    ASSERT_TRUE(CreatePipeline()->Compile());
+    // 把文件头中的length（偏移20）改成远大于文件的值
+    for (auto &entry : std::filesystem::directory_iterator(cache.GetDirectory()))
+    {
+        std::fstream file(entry.path(), std::ios::binary | std::ios::in | std::ios::out);
+        uint32_t length = 0xFFFFFFF0u;
+        file.seekp(20);
+        file.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    }
+    auto before = cache.GetStats();
+    auto pipeline = CreatePipeline();
+    ASSERT_TRUE(pipeline->Compile());
+    EXPECT_NE(pipeline->GetProgram(), 0u);
+    EXPECT_EQ(cache.GetStats().hits, before.hits);
+    EXPECT_EQ(cache.GetStats().misses, before.misses + 1);
+    EXPECT_EQ(cache.GetStats().stores, before.stores + 1);
+}
+
+TEST_F(ProgramCacheTest, AsyncCompileKeepsOldProgramUntilReady)
+{
+    ProgramCache::Get().Clear();
+    auto pipeline = CreatePipeline();
+    ASSERT_TRUE(pipeline->Compile());
+    auto oldProgram = pipeline->GetProgram();
+
+    pipeline->Defines = {"RED"};
+    ASSERT_TRUE(pipeline->CompileAsync());
+    // 编译期间仍可用旧program绘制
+    EXPECT_TRUE(pipeline->IsReady());
+    if (pipeline->GetCompileStatus() == PipelineCompileStatus::Compiling)
+    {
+        EXPECT_EQ(pipeline->GetProgram(), oldProgram);
+        while (!pipeline->IsCompileComplete())
+        {
+        }
+        ASSERT_TRUE(pipeline->FinishCompile());
+    }
+    EXPECT_EQ(pipeline->GetCompileStatus(), PipelineCompileStatus::Ready);
+    EXPECT_NE(pipeline->GetProgram(), 0u);
+}
+
+TEST_F(ProgramCacheTest, RecompileDuringCompileIsDeferred)
+{
+    ProgramCache::Get().Clear();
+    auto pipeline = CreatePipeline();
+    ASSERT_TRUE(pipeline->CompileAsync());
+    ASSERT_EQ(pipeline->GetCompileStatus(), PipelineCompileStatus::Compiling);
+    // 编译期间源码被修改，不能丢掉这次修改
+    pipeline->Defines = {"RED"};
+    pipeline->Recompile();
+    EXPECT_TRUE(pipeline->IsRecompilePending());
+    ASSERT_TRUE(pipeline->FinishCompile());
+    EXPECT_FALSE(pipeline->IsRecompilePending());
+    EXPECT_EQ(pipeline->GetCompileStatus(), PipelineCompileStatus::Compiling);
+    ASSERT_TRUE(pipeline->FinishCompile());
+    EXPECT_EQ(pipeline->GetCompileStatus(), PipelineCompileStatus::Ready);
+    // 再次编译同样的宏应命中缓存，说明延迟的编译用的是新宏
+    auto before = ProgramCache::Get().GetStats();
+    if (ProgramCache::Get().IsEnabled())
+    {
+        ASSERT_TRUE(CreatePipeline({"RED"})->Compile());
+        EXPECT_EQ(ProgramCache::Get().GetStats().hits, before.hits + 1);
+    }
+}
+
+TEST_F(ProgramCacheTest, AsyncCompileReportsFailure)
+{
+    std::ofstream(mTestPath / "Broken.frag") << "#version 460 core\nvoid main() { undefined(); }\n";
+    auto pipeline = CreatePipeline();
+    pipeline->FragmentShaderPath = mTestPath / "Broken.frag";
+    ASSERT_TRUE(pipeline->CompileAsync());
+    EXPECT_FALSE(pipeline->FinishCompile());
+    EXPECT_EQ(pipeline->GetCompileStatus(), PipelineCompileStatus::Failed);
+    EXPECT_FALSE(pipeline->IsReady());
+}
+
+TEST_F(ProgramCacheTest, DISABLED_ColdWarmBenchmark)
+{
+    auto &cache = ProgramCache::Get();
+    if (!cache.IsEnabled())
+    {
+        GTEST_SKIP() << "Driver has no program binary formats";
+    }
+    constexpr int variants = 32;
+    auto compileAll = [&]() {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < variants; i++)
+        {
+            CreatePipeline({"VARIANT=" + std::to_string(i)})->Compile();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+    cache.Clear();
+    double cold = compileAll();
+    double warm = compileAll();
+    GTEST_LOG_(INFO) << reinterpret_cast<const char *>(glGetString(GL_RENDERER)) << ": " << variants
+                     << " programs cold " << cold << " ms, warm " << warm << " ms";
+}
@@ -0,0 +1,101 @@
+#include "Geometry/StaticBatchBuilder.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+using namespace MEngine::Core;
+
+namespace
+{
+/**
+ * @brief z=0平面上的单位正方形，法线朝+z，三角形逆时针
+ */
+Mesh MakeQuad()
+{
+    Mesh mesh;
+    for (auto position : {glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(1, 1, 0), glm::vec3(0, 1, 0)})
+    {
+        Vertex vertex{};
+        vertex.position = position;
+        vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+        vertex.tangent = glm::vec3(1.0f, 0.0f, 0.0f);
+        vertex.bitangent = glm::vec3(0.0f, 1.0f, 0.0f);
+        mesh.Vertices.push_back(vertex);
+    }
+    mesh.Indices = {0, 1, 2, 0, 2, 3};
+    mesh.RecalculateBounds();
+    return mesh;
+}
+glm::vec3 FaceNormal(const Mesh &mesh, size_t triangle)
+{
+    auto a = mesh.Vertices[mesh.Indices[triangle * 3]].position;
+    auto b = mesh.Vertices[mesh.Indices[triangle * 3 + 1]].position;
+    auto c = mesh.Vertices[mesh.Indices[triangle * 3 + 2]].position;
+    return glm::normalize(glm::cross(b - a, c - a));
+}
+} // namespace
+
+TEST(StaticBatchTest, GetCellFloorsNegative)
+{
+    EXPECT_EQ(StaticBatchBuilder::GetCell(glm::vec3(1.0f, 31.9f, 32.0f), 32.0f), glm::ivec3(0, 0, 1));
+    EXPECT_EQ(StaticBatchBuilder::GetCell(glm::vec3(-0.1f, -32.0f, -32.1f), 32.0f), glm::ivec3(-1, -1, -2));
+}
+
+TEST(StaticBatchTest, MergeTransformsToWorldSpace)
+{
+    auto quad = MakeQuad();
+    std::vector<StaticBatchSource> sources{
+        {&quad, glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f))},
+        {&quad, glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f))},
+    };
+    auto meshes = StaticBatchBuilder::Merge(sources);
+    ASSERT_EQ(meshes.size(), 1u);
+    const auto &merged = meshes[0];
+    ASSERT_EQ(merged.Vertices.size(), 8u);
+    ASSERT_EQ(merged.Indices.size(), 12u);
+    EXPECT_EQ(merged.IndexFormat, IndexType::UInt16);
+    EXPECT_EQ(merged.Format, VertexFormat::Standard);
+    EXPECT_NEAR(glm::length(merged.Vertices[2].position - glm::vec3(11.0f, 1.0f, 0.0f)), 0.0f, 1e-5f);
+    // 第二个正方形的索引偏移到其顶点
+    EXPECT_EQ(merged.Indices[6], 4u);
+    // 绕x轴旋转90度后法线朝-y
+    EXPECT_NEAR(glm::length(merged.Vertices[4].normal - glm::vec3(0.0f, -1.0f, 0.0f)), 0.0f, 1e-5f);
+    EXPECT_NEAR(glm::length(FaceNormal(merged, 2) - glm::vec3(0.0f, -1.0f, 0.0f)), 0.0f, 1e-5f);
+    EXPECT_NEAR(merged.Bounds.min.x, 0.0f, 1e-5f);
+    EXPECT_NEAR(merged.Bounds.max.x, 11.0f, 1e-5f);
+}
+
+TEST(StaticBatchTest, MirroredTransformKeepsFrontFace)
+{
+    auto quad = MakeQuad();
+    // 非均匀缩放加镜像，法线需用逆转置矩阵变换
+    std::vector<StaticBatchSource> sources{{&quad, glm::scale(glm::mat4(1.0f), glm::vec3(2.0f, 1.0f, -3.0f))}};
+    auto meshes = StaticBatchBuilder::Merge(sources);
+    ASSERT_EQ(meshes.size(), 1u);
+    for (size_t triangle = 0; triangle < 2; triangle++)
+    {
+        EXPECT_NEAR(glm::length(FaceNormal(meshes[0], triangle) - glm::vec3(0.0f, 0.0f, -1.0f)), 0.0f, 1e-5f);
+    }
+    EXPECT_NEAR(glm::length(meshes[0].Vertices[0].normal - glm::vec3(0.0f, 0.0f, -1.0f)), 0.0f, 1e-5f);
+}
+
+TEST(StaticBatchTest, MergeSplitsAtVertexLimit)
+{
+    auto quad = MakeQuad();
+    std::vector<StaticBatchSource> sources(5, StaticBatchSource{&quad, glm::mat4(1.0f)});
+    auto meshes = StaticBatchBuilder::Merge(sources, 0.0005f, 8);
+    ASSERT_EQ(meshes.size(), 3u);
+    EXPECT_EQ(meshes[0].Vertices.size(), 8u);
+    EXPECT_EQ(meshes[2].Vertices.size(), 4u);
+    for (const auto &mesh : meshes)
+    {
+        for (auto index : mesh.Indices)
+        {
+            EXPECT_LT(index, mesh.Vertices.size());
+        }
+    }
+    // 紧凑格式的来源合并后仍按误差选择紧凑格式
+    quad.Format = VertexFormat::Compact;
+    meshes = StaticBatchBuilder::Merge(sources);
+    ASSERT_EQ(meshes.size(), 1u);
+    EXPECT_EQ(meshes[0].Format, VertexFormat::Compact);
+}
@@ -0,0 +1,31 @@
+#include "ThreadPool.hpp"
+#include <gtest/gtest.h>
+#include <numeric>
+
+using namespace MEngine::Core;
+
+TEST(ThreadPoolTest, ParallelForCoversRange)
+{
+    ThreadPool pool(4);
+    std::vector<int> values(100000, 0);
+    pool.ParallelFor(values.size(), 1000, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            values[i]++;
+        }
+    });
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 100000);
+}
+
+TEST(ThreadPoolTest, NestedParallelFor)
+{
+    ThreadPool pool(2);
+    std::atomic<int> total = 0;
+    pool.ParallelFor(8, 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            pool.ParallelFor(1000, 10, [&](size_t b, size_t e) { total += static_cast<int>(e - b); });
+        }
+    });
+    EXPECT_EQ(total, 8000);
+}
@@ -0,0 +1,118 @@
+#include "Geometry/VertexQuantization.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace MEngine::Core;
+
+TEST(VertexQuantizationTest, HalfFloatRoundTrip)
+{
+    // 半精度可以精确表示的值，包括最大值、最小规格化数和最小非规格化数
+    for (float value : {0.0f, -0.0f, 1.0f, -2.5f, 65504.0f, 6.1035156e-5f, 5.9604645e-8f})
+    {
+        EXPECT_EQ(HalfToFloat(FloatToHalf(value)), value);
+    }
+    EXPECT_NEAR(HalfToFloat(FloatToHalf(0.333f)), 0.333f, 0.333f / 1024.0f);
+    EXPECT_TRUE(std::isinf(HalfToFloat(FloatToHalf(1e6f))));
+    EXPECT_TRUE(std::isnan(HalfToFloat(FloatToHalf(std::nanf("")))));
+    // 半精度相对误差不超过2^-11
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> distribution(-16.0f, 16.0f);
+    for (int i = 0; i < 1000; i++)
+    {
+        float value = distribution(random);
+        EXPECT_NEAR(HalfToFloat(FloatToHalf(value)), value, std::abs(value) / 2048.0f + 1e-7f);
+    }
+}
+
+TEST(VertexQuantizationTest, OctahedralRoundTrip)
+{
+    std::mt19937 random(11);
+    std::normal_distribution<float> distribution;
+    float maxAngle = 0.0f;
+    for (int i = 0; i < 2000; i++)
+    {
+        auto normal = glm::normalize(glm::vec3(distribution(random), distribution(random), distribution(random)));
+        auto encoded = EncodeOctahedral(normal);
+        EXPECT_GE(encoded.x, 0.0f);
+        EXPECT_LE(encoded.x, 1.0f);
+        // 按16位量化后解码
+        auto quantized = glm::vec2(std::round(encoded.x * 65535.0f), std::round(encoded.y * 65535.0f)) / 65535.0f;
+        auto decoded = DecodeOctahedral(quantized);
+        // 小角度下acos精度不够，用叉积长度
+        EXPECT_GT(glm::dot(normal, decoded), 0.0f);
+        maxAngle = std::max(maxAngle, std::asin(std::min(glm::length(glm::cross(normal, decoded)), 1.0f)));
+    }
+    // 16位八面体编码的最大角误差约0.005度
+    EXPECT_LT(maxAngle, glm::radians(0.01f));
+    for (auto axis : {glm::vec3(0, 0, 1), glm::vec3(0, 0, -1), glm::vec3(1, 0, 0), glm::vec3(0, -1, 0)})
+    {
+        EXPECT_NEAR(glm::dot(DecodeOctahedral(EncodeOctahedral(axis)), axis), 1.0f, 1e-6f);
+    }
+}
+
+TEST(VertexQuantizationTest, CompactVertexRoundTrip)
+{
+    AABB bounds{glm::vec3(-3.0f, 0.0f, -1.0f), glm::vec3(5.0f, 2.0f, 1.0f)};
+    auto quantization = ComputePositionQuantization(bounds);
+    EXPECT_FLOAT_EQ(quantization.scale, 8.0f);
+
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> gaussian;
+    for (int i = 0; i < 500; i++)
+    {
+        Vertex vertex{};
+        vertex.position = bounds.min + (bounds.max - bounds.min) * glm::vec3(unit(random), unit(random), unit(random));
+        vertex.normal = glm::normalize(glm::vec3(gaussian(random), gaussian(random), gaussian(random)));
+        // 与法线正交的切线，副切线按随机符号镜像
+        auto tangent = glm::cross(vertex.normal, glm::normalize(glm::vec3(gaussian(random), gaussian(random), 1.0f)));
+        vertex.tangent = glm::normalize(tangent);
+        float sign = i % 2 ? -1.0f : 1.0f;
+        vertex.bitangent = glm::cross(vertex.normal, vertex.tangent) * sign;
+        vertex.texCoord = glm::vec2(unit(random) * 4.0f, unit(random));
+
+        auto decoded = DecodeCompactVertex(EncodeCompactVertex(vertex, quantization), quantization);
+        auto positionError = glm::abs(decoded.position - vertex.position);
+        float maxError = quantization.GetStep() * 0.5f + 1e-6f;
+        EXPECT_LE(std::max({positionError.x, positionError.y, positionError.z}), maxError);
+        EXPECT_GT(glm::dot(decoded.normal, vertex.normal), 0.99999f);
+        EXPECT_GT(glm::dot(glm::normalize(decoded.tangent), vertex.tangent), 0.999f);
+        // 重建的副切线方向正确
+        EXPECT_GT(glm::dot(glm::normalize(decoded.bitangent), vertex.bitangent), 0.99f);
+        EXPECT_NEAR(decoded.texCoord.x, vertex.texCoord.x, 4.0f / 2048.0f);
+        EXPECT_NEAR(decoded.texCoord.y, vertex.texCoord.y, 1.0f / 2048.0f);
+    }
+}
+
+TEST(VertexQuantizationTest, MatrixMatchesDecode)
+{
+    AABB bounds{glm::vec3(10.0f, -4.0f, 2.0f), glm::vec3(12.0f, -3.0f, 2.5f)};
+    auto quantization = ComputePositionQuantization(bounds);
+    Vertex vertex{};
+    vertex.position = glm::vec3(11.3f, -3.2f, 2.1f);
+    vertex.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    auto compact = EncodeCompactVertex(vertex, quantization);
+    // 着色器读到的unorm值经模型矩阵中的反量化变换还原位置
+    auto unorm = glm::vec4(compact.position[0], compact.position[1], compact.position[2], 65535.0f) / 65535.0f;
+    auto position = glm::vec3(quantization.GetMatrix() * unorm);
+    EXPECT_NEAR(glm::length(position - DecodeCompactVertex(compact, quantization).position), 0.0f, 1e-5f);
+}
+
+TEST(VertexQuantizationTest, ChooseVertexFormat)
+{
+    Mesh mesh;
+    Vertex vertex{};
+    vertex.position = glm::vec3(-1.0f);
+    mesh.Vertices.push_back(vertex);
+    vertex.position = glm::vec3(1.0f);
+    vertex.texCoord = glm::vec2(1.0f, 2.0f);
+    mesh.Vertices.push_back(vertex);
+    mesh.RecalculateBounds();
+    // 2米的网格步长约0.03毫米
+    EXPECT_EQ(ChooseVertexFormat(mesh, 0.0005f), VertexFormat::Compact);
+    EXPECT_EQ(ChooseVertexFormat(mesh, 0.00001f), VertexFormat::Standard);
+    // 平铺UV超出半精度的精确范围
+    mesh.Vertices.back().texCoord.x = 10.0f;
+    EXPECT_EQ(ChooseVertexFormat(mesh, 0.0005f), VertexFormat::Standard);
+}
@@ -0,0 +1,256 @@
+#include "Asset/Mesh.hpp"
+#include "Asset/Model.hpp"
+#include "Asset/PBRMaterial.hpp"
+#include "Component/CameraComponent.hpp"
+#include "Component/LightComponent.hpp"
+#include "Component/MaterialComponent.hpp"
+#include "Component/MeshComponent.hpp"
+#include "Component/TransformComponent.hpp"
+#include "System/RenderSystem.hpp"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <filesystem>
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+using namespace MEngine;
+using namespace MEngine::Function;
+
+namespace
+{
+/**
+ * @brief 只从内存中返回测试场景的网格和模型
+ */
+class TestAssetManager final : public IAssetManager
+{
+  public:
+    std::unordered_map<Core::UUID, std::shared_ptr<Core::Asset>> Assets;
+    std::shared_ptr<Core::Asset> GetAssetByID(const Core::UUID &id) override
+    {
+        auto it = Assets.find(id);
+        return it != Assets.end() ? it->second : nullptr;
+    }
+};
+} // namespace
+
+/**
+ * @brief 用 RenderSystem 分别以前向和延迟路径渲染同一场景，比较输出
+ *
+ * 场景是若干层从远到近叠放的全屏四边形（最坏情况的过度绘制）和随机分布的点光源。
+ * RenderSystem 从工作目录的 Assets/Shaders 加载着色器，测试在临时目录中放一份拷贝。
+ * 需要GL上下文，无窗口环境下跳过；可设置 LIBGL_ALWAYS_SOFTWARE=1 在 llvmpipe 上运行
+ */
+class DeferredShadingTest : public ::testing::Test
+{
+  protected:
+    static constexpr uint32_t Width = 640;
+    static constexpr uint32_t Height = 360;
+    GLFWwindow *mWindow = nullptr;
+    std::filesystem::path mPreviousPath;
+    std::filesystem::path mWorkPath;
+    std::shared_ptr<entt::registry> mRegistry;
+    std::shared_ptr<TestAssetManager> mAssetManager;
+    std::unique_ptr<RenderSystem> mRenderSystem;
+    entt::entity mCamera = entt::null;
+    Core::UUID mModelID;
+
+    void SetUp() override
+    {
+        if (!glfwInit())
+        {
+            GTEST_SKIP() << "GLFW init failed";
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        mWindow = glfwCreateWindow(64, 64, "", nullptr, nullptr);
+        if (!mWindow)
+        {
+            glfwTerminate();
+            GTEST_SKIP() << "OpenGL 4.6 context unavailable";
+        }
+        glfwMakeContextCurrent(mWindow);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+        {
+            GTEST_SKIP() << "Failed to load OpenGL functions";
+        }
+        mPreviousPath = std::filesystem::current_path();
+        mWorkPath = std::filesystem::temp_directory_path() / "MEngineDeferredShadingTest";
+        std::filesystem::remove_all(mWorkPath);
+        std::filesystem::create_directories(mWorkPath / "Assets");
+        std::filesystem::copy(MENGINE_SHADER_DIRECTORY, mWorkPath / "Assets" / "Shaders",
+                              std::filesystem::copy_options::recursive);
+        std::filesystem::current_path(mWorkPath);
+
+        mRegistry = std::make_shared<entt::registry>();
+        mAssetManager = std::make_shared<TestAssetManager>();
+        mRenderSystem = std::make_unique<RenderSystem>(mRegistry, mAssetManager);
+        mRenderSystem->Init();
+        mRenderSystem->CreateFrameBuffer(Width, Height);
+        // 场景实体不设置材质句柄，统一使用默认材质
+        auto material = std::make_shared<Core::PBRMaterial>();
+        material->PipelineType = Core::PipelineType::ForwardOpaquePBR;
+        material->Parameters.albedo = glm::vec3(0.8f, 0.7f, 0.6f);
+        material->Parameters.metallic = 0.1f;
+        material->Parameters.roughness = 0.6f;
+        material->Parameters.ao = 1.0f;
+        mRenderSystem->SetDefaultMaterial(material);
+
+        auto quad = std::make_shared<Core::Mesh>();
+        const glm::vec2 corners[] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+        for (auto corner : corners)
+        {
+            Core::Vertex vertex{};
+            vertex.position = glm::vec3(corner, 0.0f);
+            vertex.normal = glm::vec3(0.0f, 0.0f, 1.0f);
+            quad->Vertices.push_back(vertex);
+        }
+        quad->Indices = {0, 1, 2, 0, 2, 3};
+        quad->RecalculateBounds();
+        quad->ChooseIndexFormat();
+        auto model = std::make_shared<Core::Model>();
+        auto meshID = Core::UUIDGenerator()();
+        model->Meshes = {meshID};
+        mModelID = Core::UUIDGenerator()();
+        mAssetManager->Assets[meshID] = quad;
+        mAssetManager->Assets[mModelID] = model;
+    }
+    void TearDown() override
+    {
+        if (!mWindow)
+        {
+            return;
+        }
+        // RenderSystem 析构时删除GL对象，必须在销毁上下文之前
+        if (mRenderSystem)
+        {
+            mRenderSystem->Shutdown();
+            mRenderSystem.reset();
+        }
+        glfwDestroyWindow(mWindow);
+        glfwTerminate();
+        std::filesystem::current_path(mPreviousPath);
+        std::error_code error;
+        std::filesystem::remove_all(mWorkPath, error);
+    }
+    void BuildScene(uint32_t layers, uint32_t lightCount)
+    {
+        mRegistry->clear();
+        mCamera = mRegistry->create();
+        mRegistry->emplace<TransformComponent>(mCamera);
+        auto &camera = mRegistry->emplace<CameraComponent>(mCamera);
+        camera.isMainCamera = true;
+        camera.nearPlane = 0.1f;
+        camera.farPlane = 100.0f;
+        camera.aspectRatio = float(Width) / float(Height);
+        camera.viewMatrix = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        camera.projectionMatrix = glm::perspective(glm::radians(60.0f), camera.aspectRatio, 0.1f, 100.0f);
+        // 从远到近，每层都覆盖整个视口
+        for (uint32_t i = 0; i < layers; i++)
+        {
+            auto entity = mRegistry->create();
+            float depth = 30.0f - 28.0f * float(i) / float(std::max(layers, 1u));
+            auto &transform = mRegistry->emplace<TransformComponent>(entity);
+            transform.modelMatrix = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -depth)),
+                                               glm::vec3(depth * 1.5f, depth, 1.0f));
+            auto &mesh = mRegistry->emplace<MeshComponent>(entity);
+            mesh.modelID = mModelID;
+            mesh.meshIndex = 0;
+            mRegistry->emplace<MaterialComponent>(entity);
+        }
+        std::mt19937 random(7);
+        std::uniform_real_distribution<float> xy(-12.0f, 12.0f);
+        std::uniform_real_distribution<float> z(-30.0f, -2.0f);
+        for (uint32_t i = 0; i < lightCount; i++)
+        {
+            auto entity = mRegistry->create();
+            auto &transform = mRegistry->emplace<TransformComponent>(entity);
+            transform.worldPosition = glm::vec3(xy(random), xy(random) * 0.6f, z(random));
+            auto &light = mRegistry->emplace<LightComponent>(entity);
+            light.LightType = LightType::Point;
+            light.Color = glm::vec3(1.0f, 0.9f, 0.8f);
+            light.Intensity = 4.0f;
+            light.Radius = 6.0f;
+        }
+    }
+    /**
+     * @brief 切换相机的渲染路径并渲染，直到管线编译完成且实际走了该路径
+     */
+    void Render(bool deferred)
+    {
+        mRegistry->get<CameraComponent>(mCamera).renderPath = deferred ? RenderPath::Deferred : RenderPath::Forward;
+        for (int frame = 0; frame < 1000; frame++)
+        {
+            mRenderSystem->Update(0.0f);
+            const auto &stats = mRenderSystem->GetFrameStats();
+            if (stats.compilingPipelines == 0 && stats.deferred == deferred)
+            {
+                return;
+            }
+            glFinish();
+        }
+        FAIL() << "Pipelines did not finish compiling";
+    }
+    std::vector<uint8_t> ReadOutput()
+    {
+        std::vector<uint8_t> pixels(Width * Height * 4);
+        glGetTextureImage(mRenderSystem->ColorAttachment, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                          static_cast<GLsizei>(pixels.size()), pixels.data());
+        return pixels;
+    }
+};
+
+TEST_F(DeferredShadingTest, MatchesForward)
+{
+    BuildScene(4, 64);
+    Render(false);
+    EXPECT_FALSE(mRenderSystem->GetFrameStats().deferred);
+    auto forward = ReadOutput();
+    Render(true);
+    ASSERT_TRUE(mRenderSystem->GetFrameStats().deferred);
+    auto deferred = ReadOutput();
+    // 场景确实被绘制，而不是两边都只有清屏颜色
+    EXPECT_GT(mRenderSystem->GetFrameStats().visibleObjects, 0u);
+    // 法线和材质经过量化，允许少量舍入差异
+    int maxDifference = 0;
+    for (size_t i = 0; i < forward.size(); i++)
+    {
+        maxDifference = std::max(maxDifference, std::abs(int(forward[i]) - int(deferred[i])));
+    }
+    EXPECT_LE(maxDifference, 3);
+}
+
+TEST_F(DeferredShadingTest, DISABLED_Benchmark)
+{
+    for (uint32_t lights : {16u, 256u, 1024u})
+    {
+        for (uint32_t layers : {1u, 4u, 8u})
+        {
+            BuildScene(layers, lights);
+            // 预热，让纹理池和程序就绪
+            Render(false);
+            Render(true);
+            // GPU耗时延迟几帧读回，取多帧平均
+            constexpr int frames = 20;
+            auto measure = [&](bool deferred) {
+                Render(deferred);
+                float total = 0.0f;
+                for (int i = 0; i < frames; i++)
+                {
+                    mRenderSystem->Update(0.0f);
+                    total += mRenderSystem->GetFrameStats().gpuTimeMs;
+                }
+                return total / frames;
+            };
+            float forwardMs = measure(false);
+            float deferredMs = measure(true);
+            GTEST_LOG_(INFO) << "lights " << lights << ", overdraw " << layers << "x: forward " << forwardMs
+                             << " ms, deferred " << deferredMs << " ms";
+        }
+    }
+}
@@ -0,0 +1,142 @@
+#include "Component/MaterialComponent.hpp"
+#include "Component/MeshComponent.hpp"
+#include "Component/TransformComponent.hpp"
+#include "ModelInstantiator.hpp"
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+using namespace MEngine;
+using namespace MEngine::Function;
+namespace
+{
+/**
+ * @brief root -> (arm -> hand), leg；arm挂两个网格，hand挂一个网格
+ */
+Core::Model CreateModel()
+{
+    Core::Model model;
+    model.Meshes = {Core::UUIDGenerator()(), Core::UUIDGenerator()(), Core::UUIDGenerator()()};
+    auto &hierarchy = model.Hierarchy;
+    auto root = hierarchy.AddNode("root", -1, glm::mat4(1.0f));
+    std::vector<uint32_t> armMeshes{0, 1};
+    auto arm =
+        hierarchy.AddNode("arm", root, glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)), armMeshes);
+    std::vector<uint32_t> handMeshes{2};
+    hierarchy.AddNode("hand", arm, glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 2.0f, 0.0f)), handMeshes);
+    hierarchy.AddNode("leg", root, glm::scale(glm::mat4(1.0f), glm::vec3(2.0f)));
+    return model;
+}
+/**
+ * @brief 每个节点挂一个网格，节点i的父节点为(i-1)/4，构成约7层的四叉树
+ */
+Core::Model CreateLargeModel(uint32_t nodeCount)
+{
+    Core::Model model;
+    model.Meshes.resize(16);
+    auto &hierarchy = model.Hierarchy;
+    hierarchy.Reserve(nodeCount, nodeCount);
+    for (uint32_t i = 0; i < nodeCount; i++)
+    {
+        uint32_t mesh = i % 16;
+        hierarchy.AddNode("node" + std::to_string(i), i == 0 ? -1 : static_cast<int32_t>((i - 1) / 4),
+                          glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)),
+                          std::span<const uint32_t>(&mesh, 1));
+    }
+    return model;
+}
+} // namespace
+TEST(ModelInstantiatorTest, Instantiate_CreatesNodeAndMeshEntities)
+{
+    entt::registry registry;
+    auto model = CreateModel();
+    auto modelID = Core::UUIDGenerator()();
+    auto entities = ModelInstantiator::Instantiate(registry, model, modelID);
+    ASSERT_EQ(entities.size(), 7u);
+    for (auto entity : entities)
+    {
+        EXPECT_TRUE(registry.valid(entity));
+        EXPECT_TRUE(registry.all_of<TransformComponent>(entity));
+    }
+    // 节点实体
+    auto &root = registry.get<TransformComponent>(entities[0]);
+    EXPECT_EQ(root.name, "root");
+    EXPECT_EQ(root.parent, entt::null);
+    EXPECT_EQ(root.children, (std::vector<entt::entity>{entities[1], entities[3]}));
+    auto &arm = registry.get<TransformComponent>(entities[1]);
+    EXPECT_EQ(arm.parent, entities[0]);
+    EXPECT_EQ(arm.children, (std::vector<entt::entity>{entities[4], entities[5], entities[2]}));
+    EXPECT_FLOAT_EQ(arm.localPosition.x, 1.0f);
+    auto &hand = registry.get<TransformComponent>(entities[2]);
+    EXPECT_EQ(hand.parent, entities[1]);
+    EXPECT_FLOAT_EQ(hand.modelMatrix[3][0], 1.0f);
+    EXPECT_FLOAT_EQ(hand.modelMatrix[3][1], 2.0f);
+    auto &leg = registry.get<TransformComponent>(entities[3]);
+    EXPECT_NEAR(leg.localScale.x, 2.0f, 1e-5f);
+    EXPECT_TRUE(leg.children.empty());
+    EXPECT_FALSE(registry.all_of<MeshComponent>(entities[0]));
+    // 网格实体按MeshIndices顺序排列
+    std::vector<int> meshIndices{0, 1, 2};
+    std::vector<entt::entity> meshParents{entities[1], entities[1], entities[2]};
+    for (size_t i = 0; i < 3; i++)
+    {
+        auto entity = entities[4 + i];
+        ASSERT_TRUE((registry.all_of<MeshComponent, MaterialComponent>(entity)));
+        EXPECT_EQ(registry.get<MeshComponent>(entity).modelID, modelID);
+        EXPECT_EQ(registry.get<MeshComponent>(entity).meshIndex, meshIndices[i]);
+        EXPECT_EQ(registry.get<TransformComponent>(entity).parent, meshParents[i]);
+    }
+    EXPECT_FLOAT_EQ(registry.get<TransformComponent>(entities[6]).modelMatrix[3][1], 2.0f);
+}
+TEST(ModelInstantiatorTest, Instantiate_AttachesRootsToParent)
+{
+    entt::registry registry;
+    auto parent = registry.create();
+    auto &parentTransform = registry.emplace<TransformComponent>(parent);
+    parentTransform.modelMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 5.0f));
+    auto entities = ModelInstantiator::Instantiate(registry, CreateModel(), Core::UUIDGenerator()(), parent);
+    auto &root = registry.get<TransformComponent>(entities[0]);
+    EXPECT_EQ(root.parent, parent);
+    EXPECT_EQ(registry.get<TransformComponent>(parent).children, (std::vector<entt::entity>{entities[0]}));
+    EXPECT_FLOAT_EQ(registry.get<TransformComponent>(entities[2]).modelMatrix[3][2], 5.0f);
+}
+TEST(ModelInstantiatorTest, InstantiateWithoutHierarchy_CreatesSingleRoot)
+{
+    entt::registry registry;
+    Core::Model model;
+    model.Meshes = {Core::UUIDGenerator()(), Core::UUIDGenerator()()};
+    auto entities = ModelInstantiator::Instantiate(registry, model, Core::UUIDGenerator()());
+    ASSERT_EQ(entities.size(), 3u);
+    EXPECT_EQ(registry.get<TransformComponent>(entities[0]).children.size(), 2u);
+    EXPECT_EQ(registry.get<MeshComponent>(entities[2]).meshIndex, 1);
+}
+TEST(ModelInstantiatorTest, InstantiateLargeModel_LinksHierarchy)
+{
+    constexpr uint32_t nodeCount = 20000;
+    entt::registry registry;
+    auto model = CreateLargeModel(nodeCount);
+    auto entities = ModelInstantiator::Instantiate(registry, model, Core::UUIDGenerator()());
+    ASSERT_EQ(entities.size(), nodeCount * 2);
+    EXPECT_EQ(registry.storage<TransformComponent>().size(), nodeCount * 2);
+    EXPECT_EQ(registry.storage<MeshComponent>().size(), nodeCount);
+    // 节点i有4个子节点和1个网格
+    EXPECT_EQ(registry.get<TransformComponent>(entities[1]).children.size(), 5u);
+    EXPECT_EQ(registry.get<TransformComponent>(entities[nodeCount - 1]).parent, entities[(nodeCount - 2) / 4]);
+    EXPECT_EQ(registry.get<MeshComponent>(entities[nodeCount + 17]).meshIndex, 1);
+    // 节点4999深度为7，累加7次平移
+    EXPECT_FLOAT_EQ(registry.get<TransformComponent>(entities[4999]).modelMatrix[3][0], 7.0f);
+}
+TEST(ModelInstantiatorTest, InstantiateTwice_AppendsToRegistry)
+{
+    constexpr uint32_t nodeCount = 20000;
+    entt::registry registry;
+    auto model = CreateLargeModel(nodeCount);
+    auto first = ModelInstantiator::Instantiate(registry, model, Core::UUIDGenerator()());
+    auto second = ModelInstantiator::Instantiate(registry, model, Core::UUIDGenerator()());
+    ASSERT_EQ(second.size(), nodeCount * 2);
+    EXPECT_EQ(registry.storage<TransformComponent>().size(), nodeCount * 4);
+    EXPECT_EQ(registry.storage<MeshComponent>().size(), nodeCount * 2);
+    // 第二次实例化的层级只引用自己的实体
+    EXPECT_NE(first[0], second[0]);
+    EXPECT_EQ(registry.get<TransformComponent>(second[1]).parent, second[0]);
+    EXPECT_EQ(registry.get<TransformComponent>(second[nodeCount]).parent, second[0]);
+    EXPECT_EQ(registry.get<TransformComponent>(first[1]).children.size(), 5u);
+}
@@ -0,0 +1,156 @@
+#include "Render/RenderGraph.hpp"
+#include <gtest/gtest.h>
+
+using namespace MEngine::Function;
+
+// 只测试Compile，不需要GL上下文
+class RenderGraphTest : public ::testing::Test
+{
+  protected:
+    GLStateCache mStateCache;
+    RenderGraph mGraph{mStateCache};
+    RenderGraphTextureDesc mColorDesc{1280, 720, GL_RGBA16F};
+    RenderGraphTexture mOutput;
+
+    void SetUp() override
+    {
+        mOutput = mGraph.ImportTexture("Output", 1, {1280, 720, GL_RGBA8});
+    }
+};
+
+TEST_F(RenderGraphTest, CullsPassesWithoutConsumers)
+{
+    RenderGraphTexture unused;
+    auto debugPass = mGraph.AddPass(
+        "Debug",
+        [&](RenderGraphBuilder &builder) {
+            unused = builder.CreateTexture("Unused", mColorDesc);
+            builder.WriteColor(unused, AttachmentLoadOp::Clear);
+        },
+        nullptr);
+    auto mainPass = mGraph.AddPass(
+        "Main", [&](RenderGraphBuilder &builder) { builder.WriteColor(mOutput, AttachmentLoadOp::Clear); }, nullptr);
+    auto computePass = mGraph.AddPass("Compute", [](RenderGraphBuilder &builder) { builder.SetSideEffect(); }, nullptr);
+    mGraph.Compile();
+    EXPECT_TRUE(mGraph.IsPassCulled(debugPass));
+    EXPECT_FALSE(mGraph.IsPassCulled(mainPass));
+    EXPECT_FALSE(mGraph.IsPassCulled(computePass));
+    EXPECT_EQ(mGraph.GetPhysicalIndex(unused), RenderGraphTexture::Invalid);
+    EXPECT_EQ(mGraph.GetStats().culledPasses, 1u);
+    EXPECT_EQ(mGraph.GetStats().physicalTextures, 0u);
+}
+
+TEST_F(RenderGraphTest, KeepsProducersOfConsumedTextures)
+{
+    RenderGraphTexture gbuffer;
+    auto geometryPass = mGraph.AddPass(
+        "Geometry",
+        [&](RenderGraphBuilder &builder) {
+            gbuffer = builder.CreateTexture("GBuffer", mColorDesc);
+            builder.WriteColor(gbuffer, AttachmentLoadOp::Clear);
+        },
+        nullptr);
+    auto lightingPass = mGraph.AddPass(
+        "Lighting",
+        [&](RenderGraphBuilder &builder) {
+            builder.Read(gbuffer);
+            builder.WriteColor(mOutput, AttachmentLoadOp::DontCare);
+        },
+        nullptr);
+    mGraph.Compile();
+    EXPECT_FALSE(mGraph.IsPassCulled(geometryPass));
+    EXPECT_FALSE(mGraph.IsPassCulled(lightingPass));
+}
+
+TEST_F(RenderGraphTest, NonAttachmentWritesKeepProducer)
+{
+    auto shadowMap = mGraph.ImportTexture("ShadowMap", 2, {2048, 2048, GL_DEPTH_COMPONENT32F});
+    RenderGraphTexture unused;
+    auto shadowPass =
+        mGraph.AddPass("Shadow", [&](RenderGraphBuilder &builder) { builder.Write(shadowMap); }, nullptr);
+    auto probePass = mGraph.AddPass(
+        "Probe",
+        [&](RenderGraphBuilder &builder) {
+            unused = builder.CreateTexture("Probe", mColorDesc);
+            builder.Write(unused);
+        },
+        nullptr);
+    mGraph.Compile();
+    EXPECT_FALSE(mGraph.IsPassCulled(shadowPass));
+    EXPECT_TRUE(mGraph.IsPassCulled(probePass));
+}
+
+TEST_F(RenderGraphTest, ClearOverwritesEarlierWrites)
+{
+    auto firstPass = mGraph.AddPass(
+        "First", [&](RenderGraphBuilder &builder) { builder.WriteColor(mOutput, AttachmentLoadOp::Clear); }, nullptr);
+    auto secondPass = mGraph.AddPass(
+        "Second", [&](RenderGraphBuilder &builder) { builder.WriteColor(mOutput, AttachmentLoadOp::Clear); }, nullptr);
+    auto overlayPass = mGraph.AddPass(
+        "Overlay", [&](RenderGraphBuilder &builder) { builder.WriteColor(mOutput, AttachmentLoadOp::Load); }, nullptr);
+    mGraph.Compile();
+    EXPECT_TRUE(mGraph.IsPassCulled(firstPass));
+    EXPECT_FALSE(mGraph.IsPassCulled(secondPass));
+    EXPECT_FALSE(mGraph.IsPassCulled(overlayPass));
+}
+
+TEST_F(RenderGraphTest, AliasesTexturesWithDisjointLifetimes)
+{
+    // A -> t0 -> B -> t1 -> C -> t2 -> D -> Output，t0 与 t2 生命周期不重叠
+    RenderGraphTexture t0, t1, t2, depth;
+    mGraph.AddPass(
+        "A",
+        [&](RenderGraphBuilder &builder) {
+            t0 = builder.CreateTexture("t0", mColorDesc);
+            builder.WriteColor(t0, AttachmentLoadOp::Clear);
+        },
+        nullptr);
+    mGraph.AddPass(
+        "B",
+        [&](RenderGraphBuilder &builder) {
+            t1 = builder.CreateTexture("t1", mColorDesc);
+            builder.Read(t0);
+            builder.WriteColor(t1, AttachmentLoadOp::DontCare);
+        },
+        nullptr);
+    mGraph.AddPass(
+        "C",
+        [&](RenderGraphBuilder &builder) {
+            t2 = builder.CreateTexture("t2", mColorDesc);
+            depth = builder.CreateTexture("Depth", {1280, 720, GL_DEPTH24_STENCIL8});
+            builder.Read(t1);
+            builder.WriteColor(t2, AttachmentLoadOp::DontCare);
+            builder.WriteDepth(depth, AttachmentLoadOp::Clear);
+        },
+        nullptr);
+    mGraph.AddPass(
+        "D",
+        [&](RenderGraphBuilder &builder) {
+            builder.Read(t2);
+            builder.WriteColor(mOutput, AttachmentLoadOp::DontCare);
+        },
+        nullptr);
+    mGraph.Compile();
+    EXPECT_EQ(mGraph.GetPhysicalIndex(t0), mGraph.GetPhysicalIndex(t2));
+    EXPECT_NE(mGraph.GetPhysicalIndex(t0), mGraph.GetPhysicalIndex(t1));
+    // 描述不同的纹理不共用
+    EXPECT_NE(mGraph.GetPhysicalIndex(depth), mGraph.GetPhysicalIndex(t0));
+    EXPECT_NE(mGraph.GetPhysicalIndex(depth), mGraph.GetPhysicalIndex(t1));
+
+    const auto &stats = mGraph.GetStats();
+    EXPECT_EQ(stats.transientTextures, 4u);
+    EXPECT_EQ(stats.physicalTextures, 3u);
+    EXPECT_EQ(stats.transientBytes, mColorDesc.GetSize() * 2 + 1280 * 720 * 4);
+    EXPECT_EQ(stats.unaliasedBytes, stats.transientBytes + mColorDesc.GetSize());
+}
+
+TEST_F(RenderGraphTest, ResetClearsPasses)
+{
+    mGraph.AddPass(
+        "Main", [&](RenderGraphBuilder &builder) { builder.WriteColor(mOutput, AttachmentLoadOp::Clear); }, nullptr);
+    mGraph.Compile();
+    EXPECT_EQ(mGraph.GetStats().passes, 1u);
+    mGraph.Reset();
+    mGraph.Compile();
+    EXPECT_EQ(mGraph.GetStats().passes, 0u);
+}
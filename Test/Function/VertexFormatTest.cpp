@@ -0,0 +1,286 @@
+#include "Asset/Mesh.hpp"
+#include "Asset/Pipeline.hpp"
+#include "Culling/LightClusterGrid.hpp"
+#include "Render/DrawCommand.hpp"
+#include "Render/GLStateCache.hpp"
+#include "Render/GeometryArena.hpp"
+#include "Render/StreamBuffer.hpp"
+#include "Shader/ShaderVariantCache.hpp"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <glad/glad.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <memory>
+
+using namespace MEngine::Function;
+using MEngine::Core::LightClusterGrid;
+using MEngine::Core::PackedLight;
+using MEngine::Core::PackedLightType;
+using MEngine::Core::Pipeline;
+using MEngine::Core::VertexFormat;
+
+/**
+ * @brief 同一网格分别以标准格式和紧凑格式上传，用前向PBR着色器绘制一排实例
+ *
+ * 需要GL上下文，无窗口环境下跳过；可设置 LIBGL_ALWAYS_SOFTWARE=1 在 llvmpipe 上运行
+ */
+class VertexFormatTest : public ::testing::Test
+{
+  protected:
+    static constexpr uint32_t Width = 640;
+    static constexpr uint32_t Height = 360;
+    GLFWwindow *mWindow = nullptr;
+    std::unique_ptr<GLStateCache> mStateCache;
+    std::unique_ptr<StreamBuffer> mStreamBuffer;
+    std::unique_ptr<GeometryArena> mStandardArena;
+    std::unique_ptr<GeometryArena> mCompactArena;
+    std::shared_ptr<Pipeline> mForward;
+    LightClusterGrid mLightGrid;
+    GLuint mFramebuffer = 0;
+    GLuint mColor = 0;
+    GLuint mDepth = 0;
+    GLuint mQuery = 0;
+    glm::mat4 mView = glm::lookAt(glm::vec3(0.0f, 0.0f, 6.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 mProjection = glm::perspective(glm::radians(60.0f), float(Width) / float(Height), 0.1f, 100.0f);
+
+    void SetUp() override
+    {
+        if (!glfwInit())
+        {
+            GTEST_SKIP() << "GLFW init failed";
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        mWindow = glfwCreateWindow(64, 64, "", nullptr, nullptr);
+        if (!mWindow)
+        {
+            glfwTerminate();
+            GTEST_SKIP() << "OpenGL 4.6 context unavailable";
+        }
+        glfwMakeContextCurrent(mWindow);
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+        {
+            GTEST_SKIP() << "Failed to load OpenGL functions";
+        }
+        std::filesystem::path shaderDirectory = MENGINE_SHADER_DIRECTORY;
+        MEngine::Editor::ShaderVariantCache::Get().GetPreprocessor().AddIncludeDirectory(shaderDirectory);
+        mForward = std::make_shared<Pipeline>();
+        mForward->VertexShaderPath = shaderDirectory / "ForwardPBR.vert";
+        mForward->FragmentShaderPath = shaderDirectory / "ForwardPBR.frag";
+        EXPECT_TRUE(mForward->Compile());
+
+        mStateCache = std::make_unique<GLStateCache>();
+        mStreamBuffer = std::make_unique<StreamBuffer>();
+        mStandardArena = std::make_unique<GeometryArena>(VertexFormat::Standard);
+        // 紧凑格式同时使用16位索引
+        mCompactArena = std::make_unique<GeometryArena>(VertexFormat::Compact, MEngine::Core::IndexType::UInt16);
+        glCreateTextures(GL_TEXTURE_2D, 1, &mColor);
+        glTextureStorage2D(mColor, 1, GL_RGBA8, Width, Height);
+        glCreateTextures(GL_TEXTURE_2D, 1, &mDepth);
+        glTextureStorage2D(mDepth, 1, GL_DEPTH24_STENCIL8, Width, Height);
+        glCreateFramebuffers(1, &mFramebuffer);
+        glNamedFramebufferTexture(mFramebuffer, GL_COLOR_ATTACHMENT0, mColor, 0);
+        glNamedFramebufferTexture(mFramebuffer, GL_DEPTH_STENCIL_ATTACHMENT, mDepth, 0);
+        glCreateQueries(GL_TIME_ELAPSED, 1, &mQuery);
+
+        PackedLight light;
+        light.colorIntensity = glm::vec4(1.0f, 1.0f, 1.0f, 3.0f);
+        light.directionType =
+            glm::vec4(glm::normalize(glm::vec3(-0.4f, -0.6f, -0.7f)), static_cast<float>(PackedLightType::Directional));
+        std::vector<PackedLight> lights{light};
+        mLightGrid.Build(lights, mView, mProjection, 0.1f, 100.0f);
+    }
+    void TearDown() override
+    {
+        if (!mWindow)
+        {
+            return;
+        }
+        mStandardArena.reset();
+        mCompactArena.reset();
+        mStreamBuffer.reset();
+        mForward.reset();
+        glDeleteFramebuffers(1, &mFramebuffer);
+        glDeleteTextures(1, &mColor);
+        glDeleteTextures(1, &mDepth);
+        glDeleteQueries(1, &mQuery);
+        glfwDestroyWindow(mWindow);
+        glfwTerminate();
+    }
+    /**
+     * @brief 经纬球，不在原点以检验位置反量化的偏移
+     */
+    static MEngine::Core::Mesh MakeSphere(uint32_t segments)
+    {
+        MEngine::Core::Mesh mesh;
+        const float pi = glm::pi<float>();
+        for (uint32_t y = 0; y <= segments; y++)
+        {
+            for (uint32_t x = 0; x <= segments * 2; x++)
+            {
+                float u = float(x) / float(segments * 2), v = float(y) / float(segments);
+                glm::vec3 normal(std::sin(v * pi) * std::cos(u * 2.0f * pi), std::cos(v * pi),
+                                 std::sin(v * pi) * std::sin(u * 2.0f * pi));
+                MEngine::Core::Vertex vertex{};
+                vertex.position = normal * 0.45f + glm::vec3(3.0f, -2.0f, 1.0f);
+                vertex.normal = normal;
+                vertex.tangent = glm::vec3(-std::sin(u * 2.0f * pi), 0.0f, std::cos(u * 2.0f * pi));
+                vertex.bitangent = glm::cross(vertex.normal, vertex.tangent);
+                vertex.texCoord = glm::vec2(u, v);
+                mesh.Vertices.push_back(vertex);
+            }
+        }
+        uint32_t row = segments * 2 + 1;
+        for (uint32_t y = 0; y < segments; y++)
+        {
+            for (uint32_t x = 0; x < segments * 2; x++)
+            {
+                uint32_t a = y * row + x, b = a + 1, c = a + row, d = c + 1;
+                mesh.Indices.insert(mesh.Indices.end(), {a, b, c, b, d, c});
+            }
+        }
+        mesh.RecalculateBounds();
+        return mesh;
+    }
+    /**
+     * @brief 绘制 columns x rows 个实例，返回GPU耗时
+     */
+    float Render(const GeometryRange &range, GeometryArena &arena, uint32_t columns, uint32_t rows)
+    {
+        mStreamBuffer->BeginFrame();
+        // 抵消球心偏移后排成网格
+        std::vector<DrawData> drawData;
+        auto quantization = range.format == VertexFormat::Compact ? range.quantization.GetMatrix() : glm::mat4(1.0f);
+        for (uint32_t y = 0; y < rows; y++)
+        {
+            for (uint32_t x = 0; x < columns; x++)
+            {
+                glm::vec3 offset((float(x) + 0.5f) / float(columns) * 10.0f - 5.0f,
+                                 (float(y) + 0.5f) / float(rows) * 5.6f - 2.8f, 0.0f);
+                auto model = glm::translate(glm::mat4(1.0f), offset - glm::vec3(3.0f, -2.0f, 1.0f));
+                drawData.push_back(DrawData{
+                    .modelMatrix = model * quantization,
+                    .materialIndex = 0,
+                    .vertexFormat = static_cast<uint32_t>(range.format),
+                });
+            }
+        }
+        std::vector<MaterialData> materials(1);
+        materials[0].albedo = glm::vec4(0.8f, 0.7f, 0.6f, 1.0f);
+        materials[0].parameters = glm::vec4(0.1f, 0.4f, 1.0f, 0.0f);
+        auto command = mStreamBuffer->Allocate(sizeof(DrawElementsIndirectCommand), alignof(DrawElementsIndirectCommand));
+        *static_cast<DrawElementsIndirectCommand *>(command.data) = DrawElementsIndirectCommand{
+            .count = range.indexCount,
+            .instanceCount = static_cast<uint32_t>(drawData.size()),
+            .firstIndex = range.firstIndex,
+            .baseVertex = static_cast<int32_t>(range.baseVertex),
+            .baseInstance = 0,
+        };
+        auto bind = [&](GLuint binding, const StreamAllocation &allocation) {
+            mStateCache->BindBufferRange(GL_SHADER_STORAGE_BUFFER, binding, allocation.buffer, allocation.offset,
+                                         allocation.size);
+        };
+        bind(0, mStreamBuffer->WriteStorage(drawData));
+        bind(1, mStreamBuffer->WriteStorage(materials));
+        bind(2, mStreamBuffer->WriteStorage(mLightGrid.GetLights()));
+        bind(3, mStreamBuffer->WriteStorage(mLightGrid.GetClusters()));
+        bind(4, mStreamBuffer->WriteStorage(mLightGrid.GetLightIndices()));
+
+        const float clearColor[] = {0.0f, 0.0f, 0.0f, 1.0f};
+        const float clearDepth = 1.0f;
+        mStateCache->BindFramebuffer(GL_FRAMEBUFFER, mFramebuffer);
+        mStateCache->SetViewport(0, 0, Width, Height);
+        glClearNamedFramebufferfv(mFramebuffer, GL_COLOR, 0, clearColor);
+        glClearNamedFramebufferfv(mFramebuffer, GL_DEPTH, 0, &clearDepth);
+        auto program = mForward->GetProgram();
+        const auto &config = mLightGrid.GetConfig();
+        auto sliceScaleBias = mLightGrid.GetSliceScaleBias();
+        mStateCache->UseProgram(program);
+        mStateCache->BindVertexArray(arena.GetVAO());
+        mStateCache->BindDrawIndirectBuffer(command.buffer);
+        mStateCache->SetBlend(false);
+        mStateCache->SetDepthTest(true);
+        mStateCache->SetDepthWrite(true);
+        glProgramUniformMatrix4fv(program, 0, 1, GL_FALSE, glm::value_ptr(mView));
+        glProgramUniformMatrix4fv(program, 1, 1, GL_FALSE, glm::value_ptr(mProjection));
+        glProgramUniform4ui(program, 3, config.tilesX, config.tilesY, config.slices, mLightGrid.GetDirectionalCount());
+        glProgramUniform4f(program, 4, sliceScaleBias.x, sliceScaleBias.y, float(Width), float(Height));
+        glBeginQuery(GL_TIME_ELAPSED, mQuery);
+        glMultiDrawElementsIndirect(GL_TRIANGLES, arena.GetGLIndexType(), reinterpret_cast<const void *>(command.offset),
+                                    1, 0);
+        glEndQuery(GL_TIME_ELAPSED);
+        mStreamBuffer->EndFrame();
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(mQuery, GL_QUERY_RESULT, &elapsed);
+        return static_cast<float>(elapsed) / 1e6f;
+    }
+    std::vector<uint8_t> ReadOutput()
+    {
+        std::vector<uint8_t> pixels(Width * Height * 4);
+        glGetTextureImage(mColor, 0, GL_RGBA, GL_UNSIGNED_BYTE, static_cast<GLsizei>(pixels.size()), pixels.data());
+        return pixels;
+    }
+};
+
+TEST_F(VertexFormatTest, CompactMatchesStandard)
+{
+    auto sphere = MakeSphere(32);
+    const auto &standard = mStandardArena->Upload(MEngine::Core::UUID(), sphere);
+    const auto &compact = mCompactArena->Upload(MEngine::Core::UUID(), sphere);
+    EXPECT_EQ(compact.format, VertexFormat::Compact);
+    EXPECT_EQ(compact.indexType, MEngine::Core::IndexType::UInt16);
+    EXPECT_EQ(mCompactArena->GetVertexStride(), sizeof(MEngine::Core::CompactVertex));
+
+    Render(standard, *mStandardArena, 8, 4);
+    auto expected = ReadOutput();
+    Render(compact, *mCompactArena, 8, 4);
+    auto actual = ReadOutput();
+    // 位置误差远小于一个像素，只有少数轮廓像素的覆盖可能变化；法线量化引起的着色差异很小
+    size_t differentPixels = 0;
+    for (size_t i = 0; i < expected.size(); i += 4)
+    {
+        int difference = 0;
+        for (size_t c = 0; c < 3; c++)
+        {
+            difference = std::max(difference, std::abs(int(expected[i + c]) - int(actual[i + c])));
+        }
+        differentPixels += difference > 2 ? 1 : 0;
+    }
+    EXPECT_LT(differentPixels, expected.size() / 4 / 1000);
+}
+
+TEST_F(VertexFormatTest, DISABLED_Benchmark)
+{
+    // 顶点着色器读取带宽为主的场景：高密度网格的大量小实例
+    // 257x513个顶点，16位索引放不下，两者都用32位索引以只比较顶点格式
+    auto sphere = MakeSphere(256);
+    mCompactArena = std::make_unique<GeometryArena>(VertexFormat::Compact);
+    const auto &standard = mStandardArena->Upload(MEngine::Core::UUID(), sphere);
+    const auto &compact = mCompactArena->Upload(MEngine::Core::UUID(), sphere);
+    std::cout << "vertices " << sphere.Vertices.size() << ", triangles " << sphere.Indices.size() / 3 << std::endl;
+    std::cout << "geometry bytes: standard " << mStandardArena->GetUsedBytes() << ", compact "
+              << mCompactArena->GetUsedBytes() << std::endl;
+    for (uint32_t columns : {4u, 16u, 32u})
+    {
+        uint32_t rows = columns / 2;
+        Render(standard, *mStandardArena, columns, rows);
+        Render(compact, *mCompactArena, columns, rows);
+        float standardMs = 0.0f;
+        float compactMs = 0.0f;
+        constexpr int frames = 20;
+        for (int i = 0; i < frames; i++)
+        {
+            standardMs += Render(standard, *mStandardArena, columns, rows);
+            compactMs += Render(compact, *mCompactArena, columns, rows);
+        }
+        std::cout << "instances " << columns * rows << ": standard " << standardMs / frames << " ms, compact "
+                  << compactMs / frames << " ms" << std::endl;
+    }
+}
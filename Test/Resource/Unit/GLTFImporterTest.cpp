@@ -0,0 +1,364 @@
+#include "Importer/FBXImporter.hpp"
+#include "Importer/GLTFImporter.hpp"
+#include "PeakMemory.hpp"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+using namespace MEngine::Editor;
+using namespace MEngine;
+namespace
+{
+/**
+ * @brief 在内存中拼出glTF的二进制缓冲区和描述，写成.glb或内嵌data URI的.gltf
+ */
+class GLTFWriter
+{
+  private:
+    std::vector<uint8_t> mBuffer;
+    nlohmann::json mDocument = {{"asset", {{"version", "2.0"}}}, {"bufferViews", nlohmann::json::array()},
+                                {"accessors", nlohmann::json::array()}};
+
+  public:
+    template <typename T>
+    size_t AddAccessor(const std::vector<T> &data, uint32_t componentType, const std::string &type, size_t count)
+    {
+        while (mBuffer.size() % 4 != 0)
+        {
+            mBuffer.push_back(0);
+        }
+        auto offset = mBuffer.size();
+        mBuffer.resize(offset + data.size() * sizeof(T));
+        std::memcpy(mBuffer.data() + offset, data.data(), data.size() * sizeof(T));
+        mDocument["bufferViews"].push_back(
+            {{"buffer", 0}, {"byteOffset", offset}, {"byteLength", data.size() * sizeof(T)}});
+        mDocument["accessors"].push_back({{"bufferView", mDocument["bufferViews"].size() - 1},
+                                          {"componentType", componentType},
+                                          {"type", type},
+                                          {"count", count}});
+        return mDocument["accessors"].size() - 1;
+    }
+    void AddPrimitive(const nlohmann::json &primitive, const std::string &name = "mesh")
+    {
+        mDocument["meshes"].push_back({{"name", name}, {"primitives", {primitive}}});
+    }
+    void SetNodes(const nlohmann::json &nodes, const nlohmann::json &scenes)
+    {
+        mDocument["nodes"] = nodes;
+        mDocument["scenes"] = scenes;
+    }
+    void WriteGLB(const std::filesystem::path &path)
+    {
+        mDocument["buffers"] = {{{"byteLength", mBuffer.size()}}};
+        auto json = mDocument.dump();
+        while (json.size() % 4 != 0)
+        {
+            json.push_back(' ');
+        }
+        auto bin = mBuffer;
+        while (bin.size() % 4 != 0)
+        {
+            bin.push_back(0);
+        }
+        uint32_t header[3] = {0x46546C67, 2, static_cast<uint32_t>(12 + 8 + json.size() + 8 + bin.size())};
+        uint32_t jsonHeader[2] = {static_cast<uint32_t>(json.size()), 0x4E4F534A};
+        uint32_t binHeader[2] = {static_cast<uint32_t>(bin.size()), 0x004E4942};
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(jsonHeader), sizeof(jsonHeader));
+        file.write(json.data(), json.size());
+        file.write(reinterpret_cast<const char *>(binHeader), sizeof(binHeader));
+        file.write(reinterpret_cast<const char *>(bin.data()), bin.size());
+    }
+    void WriteEmbedded(const std::filesystem::path &path)
+    {
+        static const char *table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        std::string encoded;
+        for (size_t i = 0; i < mBuffer.size(); i += 3)
+        {
+            uint32_t bits = mBuffer[i] << 16;
+            if (i + 1 < mBuffer.size())
+                bits |= mBuffer[i + 1] << 8;
+            if (i + 2 < mBuffer.size())
+                bits |= mBuffer[i + 2];
+            encoded.push_back(table[(bits >> 18) & 63]);
+            encoded.push_back(table[(bits >> 12) & 63]);
+            encoded.push_back(i + 1 < mBuffer.size() ? table[(bits >> 6) & 63] : '=');
+            encoded.push_back(i + 2 < mBuffer.size() ? table[bits & 63] : '=');
+        }
+        mDocument["buffers"] = {
+            {{"byteLength", mBuffer.size()}, {"uri", "data:application/octet-stream;base64," + encoded}}};
+        std::ofstream(path) << mDocument.dump();
+    }
+};
+std::filesystem::path GetTempPath(const std::string &name)
+{
+    auto directory = std::filesystem::temp_directory_path() / "GLTFImporterTest";
+    std::filesystem::create_directories(directory);
+    return directory / name;
+}
+GLTFImporter CreateImporter(const std::filesystem::path &path)
+{
+    GLTFImporter importer;
+    importer.assetPath = path;
+    // 关闭重排和LOD，便于逐顶点比较
+    importer.optimizeMesh = false;
+    importer.lodRatios.clear();
+    return importer;
+}
+// XY平面上的单位正方形，glTF纹理坐标原点在左上角
+const std::vector<float> QuadPositions = {0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0};
+const std::vector<float> QuadTexCoords = {0, 1, 1, 1, 1, 0, 0, 0};
+} // namespace
+TEST(GLTFImporterTest, ImportGLB_ReadsAttributesAndFlipsTexCoords)
+{
+    GLTFWriter writer;
+    auto position = writer.AddAccessor(QuadPositions, 5126, "VEC3", 4);
+    auto normal = writer.AddAccessor(std::vector<float>{0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1}, 5126, "VEC3", 4);
+    auto texCoord = writer.AddAccessor(QuadTexCoords, 5126, "VEC2", 4);
+    auto indices = writer.AddAccessor(std::vector<uint16_t>{0, 1, 2, 0, 2, 3}, 5123, "SCALAR", 6);
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}, {"NORMAL", normal}, {"TEXCOORD_0", texCoord}}},
+                         {"indices", indices}},
+                        "quad");
+    auto path = GetTempPath("quad.glb");
+    writer.WriteGLB(path);
+
+    auto importer = CreateImporter(path);
+    importer.globalScale = 2.0f;
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 1u);
+    auto &mesh = *result.Meshes[0];
+    EXPECT_EQ(mesh.Name, "quad");
+    ASSERT_EQ(mesh.Vertices.size(), 4u);
+    EXPECT_EQ(mesh.Indices, (std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+    EXPECT_FLOAT_EQ(mesh.Vertices[2].position.x, 2.0f);
+    EXPECT_FLOAT_EQ(mesh.Vertices[2].position.y, 2.0f);
+    EXPECT_FLOAT_EQ(mesh.Vertices[0].normal.z, 1.0f);
+    EXPECT_FLOAT_EQ(mesh.Vertices[0].texCoord.y, 0.0f);
+    EXPECT_FLOAT_EQ(mesh.Vertices[2].texCoord.y, 1.0f);
+    // 没有切线时由纹理坐标生成，翻转后V沿+Y增长
+    EXPECT_NEAR(mesh.Vertices[0].tangent.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(mesh.Vertices[0].bitangent.y, 1.0f, 1e-5f);
+    EXPECT_EQ(importer.meshIDs.size(), 1u);
+}
+TEST(GLTFImporterTest, ImportEmbedded_ReadsTangentsAndComputesNormals)
+{
+    GLTFWriter writer;
+    auto position = writer.AddAccessor(QuadPositions, 5126, "VEC3", 4);
+    auto tangent = writer.AddAccessor(std::vector<float>{1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1}, 5126, "VEC4", 4);
+    auto indices = writer.AddAccessor(std::vector<uint32_t>{0, 1, 2, 0, 2, 3}, 5125, "SCALAR", 6);
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}, {"TANGENT", tangent}}}, {"indices", indices}});
+    auto path = GetTempPath("quad.gltf");
+    writer.WriteEmbedded(path);
+
+    auto importer = CreateImporter(path);
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 1u);
+    auto &mesh = *result.Meshes[0];
+    EXPECT_EQ(mesh.Indices, (std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+    EXPECT_NEAR(mesh.Vertices[1].normal.z, 1.0f, 1e-5f);
+    EXPECT_NEAR(mesh.Vertices[1].tangent.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(mesh.Vertices[1].bitangent.y, 1.0f, 1e-5f);
+}
+TEST(GLTFImporterTest, ImportWithoutIndices_SkipsNonTriangles)
+{
+    GLTFWriter writer;
+    auto position = writer.AddAccessor(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0}, 5126, "VEC3", 3);
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}}}}, "triangle");
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}}}, {"mode", 1}}, "lines");
+    auto path = GetTempPath("triangle.glb");
+    writer.WriteGLB(path);
+
+    auto importer = CreateImporter(path);
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 1u);
+    EXPECT_EQ(result.Meshes[0]->Name, "triangle");
+    EXPECT_EQ(result.Meshes[0]->Indices, (std::vector<uint32_t>{0, 1, 2}));
+}
+TEST(GLTFImporterTest, ImportNodes_FlattensHierarchy)
+{
+    GLTFWriter writer;
+    auto position = writer.AddAccessor(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0}, 5126, "VEC3", 3);
+    nlohmann::json primitive = {{"attributes", {{"POSITION", position}}}};
+    writer.AddPrimitive(primitive, "single");
+    writer.AddPrimitive(primitive, "double");
+    writer.SetNodes({{{"name", "root"}, {"children", {2, 1}}, {"translation", {1, 0, 0}}},
+                     {{"name", "first"}, {"mesh", 0}},
+                     {{"name", "second"}, {"mesh", 1}, {"scale", {3, 3, 3}}},
+                     {{"name", "unused"}, {"mesh", 0}}},
+                    {{{"nodes", {0}}}});
+    auto path = GetTempPath("nodes.glb");
+    writer.WriteGLB(path);
+
+    auto importer = CreateImporter(path);
+    importer.globalScale = 2.0f;
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 2u);
+    const auto &hierarchy = result.Model->Hierarchy;
+    // 只展开默认场景，子节点按children顺序紧跟父节点
+    EXPECT_EQ(hierarchy.Names, (std::vector<std::string>{"root", "second", "first"}));
+    EXPECT_EQ(hierarchy.Parents, (std::vector<int32_t>{-1, 0, 0}));
+    ASSERT_EQ(hierarchy.GetMeshes(1).size(), 1u);
+    EXPECT_EQ(hierarchy.GetMeshes(1)[0], 1u);
+    EXPECT_EQ(hierarchy.GetMeshes(2)[0], 0u);
+    // 平移随globalScale缩放
+    EXPECT_FLOAT_EQ(hierarchy.LocalTransforms[0][3][0], 2.0f);
+    EXPECT_FLOAT_EQ(hierarchy.LocalTransforms[1][0][0], 3.0f);
+}
+TEST(GLTFImporterTest, ImportWithoutNodes_CreatesSingleRoot)
+{
+    GLTFWriter writer;
+    auto position = writer.AddAccessor(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0}, 5126, "VEC3", 3);
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}}}});
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}}}});
+    auto path = GetTempPath("flat.glb");
+    writer.WriteGLB(path);
+
+    auto importer = CreateImporter(path);
+    auto result = importer.Import();
+    const auto &hierarchy = result.Model->Hierarchy;
+    ASSERT_EQ(hierarchy.GetNodeCount(), 1u);
+    EXPECT_EQ(hierarchy.MeshIndices, (std::vector<uint32_t>{0, 1}));
+}
+TEST(GLTFImporterTest, ImportOutOfRangeAccessor_Fails)
+{
+    GLTFWriter writer;
+    auto position = writer.AddAccessor(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0}, 5126, "VEC3", 30);
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}}}});
+    auto path = GetTempPath("broken.glb");
+    writer.WriteGLB(path);
+
+    auto importer = CreateImporter(path);
+    EXPECT_TRUE(importer.Import().Meshes.empty());
+}
+TEST(GLTFImporterTest, ImportMalformedDocument_Fails)
+{
+    // 访问器缺少count、字段类型错误都不应让异常逃出Import
+    GLTFWriter writer;
+    auto position = writer.AddAccessor(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0}, 5126, "VEC3", 3);
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}}}});
+    auto path = GetTempPath("malformed.gltf");
+    writer.WriteEmbedded(path);
+    auto document = nlohmann::json::parse(std::ifstream(path));
+    document["accessors"][0].erase("count");
+    std::ofstream(path) << document.dump();
+    auto importer = CreateImporter(path);
+    ModelImportResult result;
+    EXPECT_NO_THROW(result = importer.Import());
+    EXPECT_TRUE(result.Meshes.empty());
+    EXPECT_EQ(result.Model, nullptr);
+
+    document["accessors"][0]["count"] = "three";
+    std::ofstream(path) << document.dump();
+    EXPECT_NO_THROW(result = importer.Import());
+    EXPECT_EQ(result.Model, nullptr);
+}
+TEST(GLTFImporterTest, ImportExternalBuffer_DecodesURI)
+{
+    const std::vector<float> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    std::ofstream(GetTempPath("my buffer.bin"), std::ios::binary)
+        .write(reinterpret_cast<const char *>(positions.data()), positions.size() * sizeof(float));
+    nlohmann::json document = {
+        {"asset", {{"version", "2.0"}}},
+        {"buffers", {{{"byteLength", positions.size() * sizeof(float)}, {"uri", "my%20buffer.bin"}}}},
+        {"bufferViews", {{{"buffer", 0}, {"byteLength", positions.size() * sizeof(float)}}}},
+        {"accessors", {{{"bufferView", 0}, {"componentType", 5126}, {"type", "VEC3"}, {"count", 3}}}},
+        {"meshes", {{{"primitives", {{{"attributes", {{"POSITION", 0}}}}}}}}}};
+    auto path = GetTempPath("external.gltf");
+    std::ofstream(path) << document.dump();
+    auto importer = CreateImporter(path);
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 1u);
+    EXPECT_EQ(result.Meshes[0]->Vertices.size(), 3u);
+
+    // 非法的转义序列按普通字符处理，找不到文件时走失败路径而不是抛出异常
+    document["buffers"][0]["uri"] = "%zz.bin";
+    std::ofstream(path) << document.dump();
+    EXPECT_NO_THROW(result = importer.Import());
+    EXPECT_EQ(result.Model, nullptr);
+}
+
+namespace
+{
+/**
+ * @brief 100万顶点的网格写一次后复用，生成时的临时数据约170MB，不能算进导入的峰值内存
+ *
+ * @param generated 本次是否在当前进程中生成
+ */
+std::filesystem::path GetBenchmarkFile(bool &generated)
+{
+    constexpr uint32_t size = 1024;
+    auto path = GetTempPath("benchmark_grid.glb");
+    generated = !std::filesystem::exists(path);
+    if (!generated)
+    {
+        return path;
+    }
+    std::vector<float> positions, normals, texCoords;
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            positions.insert(positions.end(), {float(x), 0.0f, float(y)});
+            normals.insert(normals.end(), {0.0f, 1.0f, 0.0f});
+            texCoords.insert(texCoords.end(), {float(x) / size, float(y) / size});
+            if (x + 1 < size && y + 1 < size)
+            {
+                uint32_t v = y * size + x;
+                indices.insert(indices.end(), {v, v + size, v + 1, v + 1, v + size, v + size + 1});
+            }
+        }
+    }
+    GLTFWriter writer;
+    auto count = size_t(size) * size;
+    auto position = writer.AddAccessor(positions, 5126, "VEC3", count);
+    auto normal = writer.AddAccessor(normals, 5126, "VEC3", count);
+    auto texCoord = writer.AddAccessor(texCoords, 5126, "VEC2", count);
+    auto index = writer.AddAccessor(indices, 5125, "SCALAR", indices.size());
+    writer.AddPrimitive({{"attributes", {{"POSITION", position}, {"NORMAL", normal}, {"TEXCOORD_0", texCoord}}},
+                         {"indices", index}});
+    // 先写临时文件再改名，中断时不会留下残缺的基准文件
+    auto temporary = GetTempPath("benchmark_grid.glb.tmp");
+    writer.WriteGLB(temporary);
+    std::filesystem::rename(temporary, path);
+    return path;
+}
+// 峰值内存只统计Import调用；不支持重置峰值的平台上两个基准需分别用--gtest_filter单独运行
+template <typename TImporter> void RunBenchmark(const char *name)
+{
+    bool generated = false;
+    auto path = GetBenchmarkFile(generated);
+    TImporter importer;
+    importer.assetPath = path;
+    importer.optimizeMesh = false;
+    importer.lodRatios.clear();
+    importer.generateMeshlets = false;
+    bool isolated = PeakMemory::Reset();
+    auto start = std::chrono::steady_clock::now();
+    auto result = importer.Import();
+    auto end = std::chrono::steady_clock::now();
+    auto peak = PeakMemory::GetMB();
+    size_t vertices = 0;
+    for (const auto &mesh : result.Meshes)
+    {
+        vertices += mesh->Vertices.size();
+    }
+    GTEST_LOG_(INFO) << name << ": " << std::chrono::duration<double, std::milli>(end - start).count() << " ms, "
+                     << vertices << " vertices, peak memory " << peak << " MB";
+    if (generated && !isolated)
+    {
+        GTEST_LOG_(WARNING) << "Benchmark file was generated in this process, rerun to measure peak memory";
+    }
+}
+} // namespace
+TEST(GLTFImporterTest, DISABLED_BenchmarkNative)
+{
+    RunBenchmark<GLTFImporter>("GLTFImporter");
+}
+TEST(GLTFImporterTest, DISABLED_BenchmarkAssimp)
+{
+    RunBenchmark<FBXImporter>("FBXImporter (assimp)");
+}
@@ -0,0 +1,216 @@
+#include "Importer/FBXImporter.hpp"
+#include "Importer/OBJImporter.hpp"
+#include "PeakMemory.hpp"
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+using namespace MEngine::Editor;
+using namespace MEngine;
+namespace
+{
+std::filesystem::path WriteTempFile(const std::string &name, const std::string &content)
+{
+    auto directory = std::filesystem::temp_directory_path() / "OBJImporterTest";
+    std::filesystem::create_directories(directory);
+    auto path = directory / name;
+    std::ofstream(path, std::ios::binary) << content;
+    return path;
+}
+template <typename TImporter> TImporter CreateImporter(const std::filesystem::path &path)
+{
+    TImporter importer;
+    importer.assetPath = path;
+    // 关闭重排、切分和LOD，便于逐顶点比较
+    importer.optimizeMesh = false;
+    importer.splitLargeMeshes = false;
+    importer.generateMeshlets = false;
+    importer.lodRatios.clear();
+    return importer;
+}
+/**
+ * @brief 生成XZ平面上的size*size网格，每行顶点之后紧跟连接上一行的面，面使用负数索引
+ */
+void WriteGrid(std::ostream &stream, uint32_t size, bool attributes)
+{
+    char buffer[64];
+    auto write = [&](auto value) {
+        auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        stream.write(buffer, end - buffer);
+    };
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            stream << "v ";
+            write(float(x) * 0.5f);
+            stream << " 0 ";
+            write(float(y) * 0.5f);
+            stream << '\n';
+            if (attributes)
+            {
+                stream << "vt ";
+                write(float(x) / size);
+                stream << ' ';
+                write(float(y) / size);
+                stream << "\nvn 0 1 0\n";
+            }
+        }
+        if (y == 0)
+        {
+            continue;
+        }
+        // 当前共有(y+1)*size个顶点，(x, row)的相对索引为row*size+x-(y+1)*size
+        auto relative = [&](uint32_t x, uint32_t row) {
+            return static_cast<int64_t>(row) * size + x - static_cast<int64_t>(y + 1) * size;
+        };
+        auto corner = [&](uint32_t x, uint32_t row) {
+            auto index = relative(x, row);
+            stream << ' ';
+            write(index);
+            if (attributes)
+            {
+                stream << '/';
+                write(index);
+                stream << '/';
+                write(index);
+            }
+        };
+        for (uint32_t x = 0; x + 1 < size; x++)
+        {
+            stream << 'f';
+            corner(x, y - 1);
+            corner(x, y);
+            corner(x + 1, y);
+            corner(x + 1, y - 1);
+            stream << '\n';
+        }
+    }
+}
+} // namespace
+TEST(OBJImporterTest, Import_DeduplicatesCornersInFirstUseOrder)
+{
+    auto path = WriteTempFile("quad.obj", "# quad\n"
+                                          "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+                                          "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+                                          "vn 0 0 1\n"
+                                          "f 1/1/1 2/2/1 3/3/1\n"
+                                          "f 1/1/1 3/3/1 4/4/1\n");
+    auto importer = CreateImporter<OBJImporter>(path);
+    importer.globalScale = 2.0f;
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 1u);
+    auto &mesh = *result.Meshes[0];
+    EXPECT_EQ(mesh.Name, "quad");
+    ASSERT_EQ(mesh.Vertices.size(), 4u);
+    EXPECT_EQ(mesh.Indices, (std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+    EXPECT_FLOAT_EQ(mesh.Vertices[2].position.x, 2.0f);
+    EXPECT_FLOAT_EQ(mesh.Vertices[2].texCoord.y, 1.0f);
+    EXPECT_FLOAT_EQ(mesh.Vertices[3].normal.z, 1.0f);
+    EXPECT_NEAR(mesh.Vertices[0].tangent.x, 1.0f, 1e-5f);
+    EXPECT_NEAR(mesh.Vertices[0].bitangent.y, 1.0f, 1e-5f);
+}
+TEST(OBJImporterTest, Import_SplitsGroupsAndTriangulatesPolygons)
+{
+    auto path = WriteTempFile("groups.obj", "g empty\n"
+                                            "o first\r\n"
+                                            "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\nv 0 1 0\r\n"
+                                            "f -4 -3 -2 -1\r\n"
+                                            "o second\n"
+                                            "v 2 0 0\nv 3 0 0\nv 3 1 0\n"
+                                            "f 5//  6 7\n"
+                                            "f -3 -2 -1 # comment\n"
+                                            "l 1 2\n");
+    auto importer = CreateImporter<OBJImporter>(path);
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 2u);
+    EXPECT_EQ(result.Meshes[0]->Name, "first");
+    EXPECT_EQ(result.Meshes[0]->Indices, (std::vector<uint32_t>{0, 1, 2, 0, 2, 3}));
+    EXPECT_NEAR(result.Meshes[0]->Vertices[0].normal.z, 1.0f, 1e-5f);
+    // 格式错误的面被跳过，后一个面仍能正确解析
+    EXPECT_EQ(result.Meshes[1]->Name, "second");
+    EXPECT_EQ(result.Meshes[1]->Indices, (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_FLOAT_EQ(result.Meshes[1]->Vertices[0].position.x, 2.0f);
+    EXPECT_EQ(importer.meshIDs.size(), 2u);
+}
+TEST(OBJImporterTest, Import_MissingVertex_DropsGroup)
+{
+    auto path = WriteTempFile("missing.obj", "v 0 0 0\nv 1 0 0\nf 1 2 3\n");
+    auto importer = CreateImporter<OBJImporter>(path);
+    EXPECT_TRUE(importer.Import().Meshes.empty());
+}
+TEST(OBJImporterTest, Import_RelativeIndicesAcrossChunks)
+{
+    // 文件超过一个解析块，跨块的负数索引要在合并时换算
+    constexpr uint32_t size = 560;
+    std::ostringstream stream;
+    WriteGrid(stream, size, false);
+    auto path = WriteTempFile("grid.obj", stream.str());
+    ASSERT_GT(std::filesystem::file_size(path), 8u << 20);
+
+    auto importer = CreateImporter<OBJImporter>(path);
+    auto result = importer.Import();
+    ASSERT_EQ(result.Meshes.size(), 1u);
+    auto &mesh = *result.Meshes[0];
+    EXPECT_EQ(mesh.Vertices.size(), size_t(size) * size);
+    ASSERT_EQ(mesh.Indices.size(), size_t(size - 1) * (size - 1) * 6);
+    size_t triangle = 0;
+    for (uint32_t y = 1; y < size; y++)
+    {
+        for (uint32_t x = 0; x + 1 < size; x++, triangle += 2)
+        {
+            const auto &first = mesh.Vertices[mesh.Indices[triangle * 3]].position;
+            const auto &last = mesh.Vertices[mesh.Indices[triangle * 3 + 5]].position;
+            ASSERT_FLOAT_EQ(first.x, x * 0.5f);
+            ASSERT_FLOAT_EQ(first.z, (y - 1) * 0.5f);
+            ASSERT_FLOAT_EQ(last.x, (x + 1) * 0.5f);
+            ASSERT_FLOAT_EQ(last.z, (y - 1) * 0.5f);
+        }
+    }
+}
+
+namespace
+{
+std::filesystem::path GetBenchmarkFile()
+{
+    // 每个网格顶点约占118字节，3000*3000的网格约1GB
+    constexpr uint32_t size = 3000;
+    auto path = std::filesystem::temp_directory_path() / "OBJImporterTest" / "benchmark_1gb.obj";
+    if (!std::filesystem::exists(path))
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream stream(path, std::ios::binary);
+        WriteGrid(stream, size, true);
+    }
+    return path;
+}
+// 峰值内存只统计Import调用；不支持重置峰值的平台上两个基准需分别用--gtest_filter单独运行
+template <typename TImporter> void RunBenchmark(const char *name)
+{
+    auto path = GetBenchmarkFile();
+    auto importer = CreateImporter<TImporter>(path);
+    PeakMemory::Reset();
+    auto start = std::chrono::steady_clock::now();
+    auto result = importer.Import();
+    auto end = std::chrono::steady_clock::now();
+    auto peak = PeakMemory::GetMB();
+    size_t vertices = 0;
+    for (const auto &mesh : result.Meshes)
+    {
+        vertices += mesh->Vertices.size();
+    }
+    GTEST_LOG_(INFO) << name << ": " << std::filesystem::file_size(path) / (1 << 20) << " MB file, "
+                     << std::chrono::duration<double, std::milli>(end - start).count() << " ms, " << vertices
+                     << " vertices, peak memory " << peak << " MB";
+}
+} // namespace
+TEST(OBJImporterTest, DISABLED_Benchmark1GB)
+{
+    RunBenchmark<OBJImporter>("OBJImporter");
+}
+TEST(OBJImporterTest, DISABLED_Benchmark1GBAssimp)
+{
+    RunBenchmark<FBXImporter>("FBXImporter (assimp)");
+}
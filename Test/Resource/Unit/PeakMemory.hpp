@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <string>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+// windows.h必须在psapi.h之前
+#include <psapi.h>
+#elif !defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+/**
+ * @brief 基准测试用的进程峰值内存统计
+ *
+ * Linux读取VmHWM，Windows读取PeakWorkingSetSize，其他平台用ru_maxrss。
+ */
+namespace PeakMemory
+{
+/**
+ * @brief 重置峰值，之后的GetMB只反映重置后的占用；平台不支持重置时返回false
+ */
+inline bool Reset()
+{
+#if defined(__linux__)
+    // 写入5清零VmHWM（Linux 4.0+）
+    std::ofstream file("/proc/self/clear_refs");
+    file << "5";
+    file.flush();
+    return file.good();
+#else
+    return false;
+#endif
+}
+inline size_t GetMB()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize >> 20;
+#elif defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.rfind("VmHWM:", 0) == 0)
+        {
+            return std::stoull(line.substr(6)) >> 10;
+        }
+    }
+    return 0;
+#else
+    // macOS的ru_maxrss单位为字节
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<size_t>(usage.ru_maxrss) >> 20;
+#endif
+}
+} // namespace PeakMemory
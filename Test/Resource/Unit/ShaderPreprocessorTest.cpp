@@ -0,0 +1,135 @@
+#include "Shader/ShaderPreprocessor.hpp"
+#include "Shader/ShaderVariantCache.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+
+using namespace MEngine::Editor;
+
+class ShaderPreprocessorTest : public ::testing::Test
+{
+  protected:
+    std::filesystem::path mTestPath = std::filesystem::current_path() / "Test" / "ShaderPreprocessor";
+    void SetUp() override
+    {
+        std::filesystem::remove_all(mTestPath);
+        std::filesystem::create_directories(mTestPath / "Include");
+        std::filesystem::create_directories(mTestPath / "Library");
+        Write("Include/Common.glsl", "#pragma once\nconst float PI = 3.14159;\n");
+        Write("Include/Lighting.glsl", "#pragma once\n#include \"Common.glsl\"\nfloat Lambert() { return 1.0 / PI; }\n");
+        Write("Library/Noise.glsl", "float Noise() { return 0.5; }\n");
+        Write("Lit.frag", "#version 460 core\n#include \"Include/Lighting.glsl\"\n#include \"Include/Common.glsl\"\n"
+                          "#include <Noise.glsl>\nvoid main() {}\n");
+        Write("Unlit.frag", "#version 460 core\n#include \"Include/Common.glsl\"\nvoid main() {}\n");
+    }
+    void Write(const std::string &name, const std::string &content)
+    {
+        std::ofstream(mTestPath / name) << content;
+    }
+    static size_t Count(const std::string &source, const std::string &pattern)
+    {
+        size_t count = 0;
+        for (auto pos = source.find(pattern); pos != std::string::npos; pos = source.find(pattern, pos + 1))
+        {
+            count++;
+        }
+        return count;
+    }
+};
+
+TEST_F(ShaderPreprocessorTest, ResolvesIncludesOnce)
+{
+    ShaderPreprocessor preprocessor;
+    preprocessor.AddIncludeDirectory(mTestPath / "Library");
+    auto result = preprocessor.Process(mTestPath / "Lit.frag");
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(Count(result.source, "const float PI"), 1u);
+    EXPECT_EQ(Count(result.source, "float Lambert()"), 1u);
+    EXPECT_EQ(Count(result.source, "float Noise()"), 1u);
+    EXPECT_EQ(Count(result.source, "#include"), 0u);
+    EXPECT_TRUE(result.source.starts_with("#version 460 core\n"));
+    EXPECT_EQ(result.dependencies.size(), 4u);
+}
+
+TEST_F(ShaderPreprocessorTest, InsertsDefinesAfterVersion)
+{
+    ShaderPreprocessor preprocessor;
+    auto result = preprocessor.Process(mTestPath / "Unlit.frag", {"NORMAL_MAP", "MAX_LIGHTS=16"});
+    ASSERT_TRUE(result.success);
+    EXPECT_TRUE(result.source.starts_with("#version 460 core\n#define NORMAL_MAP\n#define MAX_LIGHTS 16\n#line 2 0\n"));
+}
+
+TEST_F(ShaderPreprocessorTest, ReportsMissingAndCircularIncludes)
+{
+    ShaderPreprocessor preprocessor;
+    Write("Missing.frag", "#version 460 core\n#include \"Nope.glsl\"\n");
+    EXPECT_FALSE(preprocessor.Process(mTestPath / "Missing.frag").success);
+
+    Write("A.glsl", "#include \"B.glsl\"\n");
+    Write("B.glsl", "#include \"A.glsl\"\n");
+    Write("Cycle.frag", "#version 460 core\n#include \"A.glsl\"\n");
+    auto result = preprocessor.Process(mTestPath / "Cycle.frag");
+    EXPECT_FALSE(result.success);
+    EXPECT_TRUE(result.source.empty());
+}
+
+TEST_F(ShaderPreprocessorTest, TracksDependents)
+{
+    ShaderPreprocessor preprocessor;
+    preprocessor.AddIncludeDirectory(mTestPath / "Library");
+    ASSERT_TRUE(preprocessor.Process(mTestPath / "Lit.frag").success);
+    ASSERT_TRUE(preprocessor.Process(mTestPath / "Unlit.frag").success);
+    EXPECT_EQ(preprocessor.GetDependents(mTestPath / "Include" / "Common.glsl").size(), 2u);
+    auto lightingDependents = preprocessor.GetDependents(mTestPath / "Include" / "Lighting.glsl");
+    ASSERT_EQ(lightingDependents.size(), 1u);
+    EXPECT_EQ(lightingDependents[0], (mTestPath / "Lit.frag").lexically_normal());
+}
+
+TEST_F(ShaderPreprocessorTest, ReloadsChangedInclude)
+{
+    ShaderPreprocessor preprocessor;
+    ASSERT_TRUE(preprocessor.Process(mTestPath / "Unlit.frag").success);
+    Write("Include/Common.glsl", "#pragma once\nconst float TAU = 6.28318;\n");
+    preprocessor.Invalidate(mTestPath / "Include" / "Common.glsl");
+    auto result = preprocessor.Process(mTestPath / "Unlit.frag");
+    EXPECT_NE(result.source.find("TAU"), std::string::npos);
+    EXPECT_EQ(result.source.find("PI"), std::string::npos);
+}
+
+TEST_F(ShaderPreprocessorTest, PollsModifiedIncludeOnce)
+{
+    ShaderPreprocessor preprocessor;
+    ASSERT_TRUE(preprocessor.Process(mTestPath / "Unlit.frag").success);
+    EXPECT_TRUE(preprocessor.PollModifiedFiles().empty());
+    // 显式推后修改时间，不依赖文件系统的时间精度
+    auto common = (mTestPath / "Include" / "Common.glsl").lexically_normal();
+    Write("Include/Common.glsl", "#pragma once\nconst float TAU = 6.28318;\n");
+    std::filesystem::last_write_time(common, std::filesystem::last_write_time(common) + std::chrono::seconds(1));
+    auto modified = preprocessor.PollModifiedFiles();
+    ASSERT_EQ(modified.size(), 1u);
+    EXPECT_EQ(modified[0], common);
+    EXPECT_EQ(preprocessor.GetDependents(modified[0]).size(), 1u);
+    EXPECT_TRUE(preprocessor.PollModifiedFiles().empty());
+}
+
+TEST_F(ShaderPreprocessorTest, VariantsAreCachedByKeywordMask)
+{
+    auto base = std::make_shared<MEngine::Core::Pipeline>();
+    base->Name = "Lit";
+    base->VertexShaderPath = mTestPath / "Unlit.frag";
+    base->FragmentShaderPath = mTestPath / "Lit.frag";
+    base->Keywords = {ShaderKeywords::NormalMap, ShaderKeywords::Shadows, ShaderKeywords::Skinning};
+    auto &cache = ShaderVariantCache::Get();
+    auto mask = ShaderVariantCache::GetKeywordMask(*base, {ShaderKeywords::Shadows, "UNKNOWN"});
+    EXPECT_EQ(mask, 2u);
+
+    auto variant = cache.GetVariant(base, mask);
+    EXPECT_EQ(cache.GetVariant(base, mask), variant);
+    EXPECT_NE(cache.GetVariant(base, 0), variant);
+    EXPECT_EQ(variant->Defines, std::vector<std::string>{ShaderKeywords::Shadows});
+    // 变体在首次使用前不编译
+    EXPECT_EQ(variant->GetCompileStatus(), MEngine::Core::PipelineCompileStatus::NotCompiled);
+    cache.Remove(base.get());
+    EXPECT_EQ(cache.GetVariantCount(), 0u);
+}
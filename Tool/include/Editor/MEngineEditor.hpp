@@ -7,6 +7,7 @@
 #include "UUID.hpp"
 #include <GLFW/glfw3.h>
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <entt/entt.hpp>
 #include <entt/meta/meta.hpp>
@@ -79,6 +80,10 @@ class MEngineEditor
     std::filesystem::path mAssetsPath = std::filesystem::current_path() / "Assets";
     std::filesystem::path mProjectPath = std::filesystem::current_path() / "Project";
 
+    // 着色器文件的检查间隔，避免每帧访问文件系统
+    static constexpr std::chrono::milliseconds ShaderWatchInterval{500};
+    std::chrono::steady_clock::time_point mLastShaderCheck{};
+
     std::vector<Resolution> mResolutions = {{100, 100},   {800, 600},   {1280, 720}, {1920, 1080},
                                             {2560, 1440}, {3840, 2160}, {5120, 2880}};
     Resolution mCurrentResolution = {1280, 720};
@@ -11,16 +11,21 @@
 #include "Component/TransformComponent.hpp"
 #include "Configure.hpp"
 #include "Logger.hpp"
+#include "ModelInstantiator.hpp"
 #include "System/CameraSystem.hpp"
 #include "System/RenderSystem.hpp"
+#include "System/SpatialSystem.hpp"
 #include "System/TransformSystem.hpp"
 #include "UUID.hpp"
 #include <algorithm>
+#include <array>
 #include <boost/di.hpp>
+#include <cstring>
 #include <glm/ext/matrix_float4x4.hpp>
 #include <imgui.h>
 #include <memory>
 #include <thread>
+#include <type_traits>
 namespace MEngine
 {
 using namespace Editor;
@@ -29,6 +34,7 @@ auto injector = DI::make_injector(DI::bind<IConfigure>().to<Configure>().in(DI::
 
                                   DI::bind<RenderSystem>().to<RenderSystem>().in(DI::singleton),
                                   DI::bind<TransformSystem>().to<TransformSystem>().in(DI::singleton),
+                                  DI::bind<SpatialSystem>().to<SpatialSystem>().in(DI::singleton),
                                   DI::bind<CameraSystem>().to<CameraSystem>().in(DI::singleton),
                                   DI::bind<entt::registry>().to<entt::registry>().in(DI::singleton));
 
@@ -241,9 +247,11 @@ void MEngineEditor::InitImGui()
 void MEngineEditor::InitSystems()
 {
     auto transformSystem = injector.create<std::shared_ptr<TransformSystem>>();
+    auto spatialSystem = injector.create<std::shared_ptr<SpatialSystem>>();
     auto cameraSystem = injector.create<std::shared_ptr<CameraSystem>>();
     auto renderSystem = injector.create<std::shared_ptr<RenderSystem>>();
     mSystems.push_back(transformSystem);
+    mSystems.push_back(spatialSystem);
     mSystems.push_back(cameraSystem);
     mSystems.push_back(renderSystem);
     for (auto &system : mSystems)
@@ -263,6 +271,12 @@ void MEngineEditor::Update(float deltaTime)
             ImGui::NewFrame();
             ImGuizmo::BeginFrame();
             EditorUI();
+            // 着色器热重载，编译需要GL上下文，所以在主线程检查
+            if (auto now = std::chrono::steady_clock::now(); now - mLastShaderCheck >= ShaderWatchInterval)
+            {
+                mLastShaderCheck = now;
+                mRenderSystem->PollShaderChanges();
+            }
 
             // Render
             for (auto &system : mSystems)
@@ -382,6 +396,55 @@ void MEngineEditor::RenderToolbarPanel()
         ImGui::Text("SceneView Size: %1.f x %1.f", sceneWindow->ContentSize.x, sceneWindow->ContentSize.y);
         ImGui::SameLine();
         ImGui::TextColored(ImVec4(1, 1, 0, 1), "FPS: %1.f", ImGui::GetIO().Framerate);
+        auto &frameStats = mRenderSystem->GetFrameStats();
+        constexpr float MB = 1024.0f * 1024.0f;
+        // 每行一组统计项，同一行的项之间用SameLine隔开
+        const std::array<std::vector<std::string>, 2> statsRows{{
+            {
+                std::format("Draw Calls: {}  Draws: {}  Instances: {}  Triangles: {}", frameStats.drawCalls,
+                            frameStats.drawCommands, frameStats.instances, frameStats.triangles),
+                std::format("Visible: {}  Culled: {} ({:.2f} ms)  Occluded: {} ({:.2f} ms)  LOD: {}",
+                            frameStats.visibleObjects, frameStats.culledObjects, frameStats.cullTimeMs,
+                            frameStats.occludedObjects, frameStats.occlusionTimeMs, frameStats.lodObjects),
+                std::format("Static batches: {}  Culled: {}  Objects: {}  Rebuilt: {} ({:.2f} ms)",
+                            frameStats.staticBatches, frameStats.culledStaticBatches, frameStats.staticBatchedObjects,
+                            frameStats.staticBatchRebuilds, frameStats.staticBatchTimeMs),
+                std::format("Meshlets: {}  Culled: {} ({:.2f} ms)", frameStats.meshlets, frameStats.culledMeshlets,
+                            frameStats.meshletCullTimeMs),
+                std::format("Lights: {}  Max/Cluster: {} ({:.2f} ms)", frameStats.lights,
+                            frameStats.maxLightsPerCluster, frameStats.lightAssignTimeMs),
+                std::format("Stream: {:.1f} KB (stall {:.2f} ms)", frameStats.streamBytes / 1024.0f,
+                            frameStats.streamStallMs),
+                std::format("State: {} (skipped {})", frameStats.stateChanges, frameStats.redundantStateChanges),
+            },
+            {
+                std::format("Passes: {} (culled {})  RT: {:.1f} MB (pool {:.1f} MB)  Graph: {:.3f} ms",
+                            frameStats.renderPasses, frameStats.culledRenderPasses, frameStats.renderTargetBytes / MB,
+                            frameStats.renderTargetPoolBytes / MB, frameStats.renderGraphSetupMs),
+                std::format("Shadow: {} casters, {} static updates ({:.2f} ms)", frameStats.shadowCasters,
+                            frameStats.staticShadowUpdates, frameStats.shadowTimeMs),
+                std::format("Path: {}  GPU: {:.2f} ms", frameStats.deferred ? "Deferred" : "Forward",
+                            frameStats.gpuTimeMs),
+                std::format("Geometry: {:.1f} MB (compact {})", frameStats.geometryBytes / MB,
+                            frameStats.compactInstances),
+            },
+        }};
+        for (const auto &row : statsRows)
+        {
+            for (size_t i = 0; i < row.size(); i++)
+            {
+                if (i > 0)
+                {
+                    ImGui::SameLine();
+                }
+                ImGui::TextUnformatted(row[i].c_str());
+            }
+        }
+        if (frameStats.compilingPipelines > 0)
+        {
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1, 0.5f, 0, 1), "Compiling shaders: %u", frameStats.compilingPipelines);
+        }
         if (ImGui::RadioButton("Translate", mGuizmoOperation == ImGuizmo::TRANSLATE) || ImGui::IsKeyDown(ImGuiKey_W))
             mGuizmoOperation = ImGuizmo::TRANSLATE;
         ImGui::SameLine();
@@ -628,28 +691,15 @@ void MEngineEditor::RenderHierarchyPanel()
         }
         if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload("ASSET_ITEM"))
         {
-            IM_ASSERT(payload->DataSize == sizeof(mSelectedAsset));
-            auto asset = *(const std::shared_ptr<Asset> *)payload->Data;
-            // switch (asset->Type)
-            // {
-            // case AssetType::None:
-            // case AssetType::Folder:
-            // case AssetType::File:
-            // case AssetType::Material:
-            // case AssetType::Mesh:
-            // case AssetType::PhongMaterial:
-            // case AssetType::Texture2D:
-            // case AssetType::TextureCube:
-            // case AssetType::Model: {
-            //     GetAssetFromModel(asset->ID, mRegistry);
-            //     break;
-            // }
-            // case AssetType::Animation:
-            // case AssetType::Shader:
-            // case AssetType::Audio:
-            // case AssetType::Pipeline:
-            //     break;
-            // }
+            IM_ASSERT(payload->DataSize == sizeof(UUID));
+            // 载荷只保存资源ID，元数据在放下时重新从资源数据库查找
+            UUID assetID;
+            std::memcpy(&assetID, payload->Data, sizeof(UUID));
+            auto meta = AssetDatabase::GetAssetMeta(assetID);
+            if (meta && meta->Type == AssetType::Model)
+            {
+                GetAssetFromModel(meta->ID, mRegistry);
+            }
         }
         ImGui::EndDragDropTarget();
     }
@@ -926,8 +976,9 @@ void MEngineEditor::RenderAssetPanel()
             {
                 if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_None))
                 {
-                    // 设置拖拽数据
-                    ImGui::SetDragDropPayload("ASSET_ITEM", &meta, sizeof(AssetMeta));
+                    // ImGui按字节复制载荷，只能传递可平凡复制的资源ID
+                    static_assert(std::is_trivially_copyable_v<UUID>);
+                    ImGui::SetDragDropPayload("ASSET_ITEM", &meta->ID, sizeof(UUID));
                     // 显示拖拽预览（图标）
                     ImGui::Image(textureID, ImVec2(0, 1), ImVec2(1, 0));
                     // 可选：添加文字说明
@@ -1009,41 +1060,32 @@ void MEngineEditor::LoadUIResources()
 }
 void MEngineEditor::GetAssetFromModel(const UUID &modelID, std::shared_ptr<entt::registry> registry)
 {
-    // auto model = mResourceManager->GetAsset<Model>(modelID);
-    // auto &meshes = model->Meshes;
-    // auto RootNode = model->RootNode;
-    // std::function<entt::entity(std::shared_ptr<Node> node)> traverseNode = [&](std::shared_ptr<Node> node) {
-    //     auto currentNode = registry->create();
-    //     auto &currentNodeTransformComponent = registry->emplace<TransformComponent>(currentNode);
-    //     currentNodeTransformComponent.name = node->Name;
-    //     auto transform = node->Transform;
-    //     TransformSystem::SetModelMatrix(currentNodeTransformComponent, transform);
-    //     // TODO: 添加根据modelmatrix计算localposition,localrotation,localscale
-    //     for (auto index : node->Meshes)
-    //     {
-    //         auto mesh = meshes[index];
-    //         auto entity = registry->create();
-    //         auto &meshComponent = registry->emplace<MeshComponent>(entity);
-    //         auto &materialComponent = registry->emplace<MaterialComponent>(entity);
-    //         auto &transformComponent = registry->emplace<TransformComponent>(entity);
-    //         transformComponent.parent = currentNode;
-    //         meshComponent.modelID = model->ID;
-    //         meshComponent.meshIndex = index;
-    //         currentNodeTransformComponent.children.push_back(entity);
-    //     }
-    //     for (auto child : node->Children)
-    //     {
-    //         auto childAsset = traverseNode(child);
-    //         auto &childTransformComponent = registry->get<TransformComponent>(childAsset);
-    //         childTransformComponent.parent = currentNode;
-    //         currentNodeTransformComponent.children.push_back(childAsset);
-    //         auto childTransform = child->Transform;
-    //         TransformSystem::SetModelMatrix(childTransformComponent, childTransform,
-    //                                         currentNodeTransformComponent.modelMatrix);
-    //     }
-    //     return currentNode;
-    // };
-    // traverseNode(RootNode);
+    auto meta = AssetDatabase::GetAssetMeta(modelID);
+    if (meta == nullptr)
+    {
+        LogError("Model not imported: {}", modelID.ToString());
+        return;
+    }
+    const auto &path = meta->importer->assetPath;
+    std::shared_ptr<Model> model;
+    // 在拖放回调中调用，异常不能逃出ImGui
+    try
+    {
+        model = AssetDatabase::LoadAssetAtPath<Model>(path);
+    }
+    catch (const std::exception &e)
+    {
+        LogError("Failed to load model {}: {}", path.string(), e.what());
+        return;
+    }
+    // 导入失败时导入器返回空模型，错误已由导入器记录
+    if (model == nullptr)
+    {
+        LogError("Failed to import model {}", path.string());
+        return;
+    }
+    auto entities = ModelInstantiator::Instantiate(*registry, *model, modelID);
+    LogInfo("Instantiated model {} with {} entities", path.string(), entities.size());
 }
 GLuint MEngineEditor::CreateTextureFromFile(const std::filesystem::path &path)
 {